@@ -1,14 +1,48 @@
 #!/bin/bash
 
-printf 'Testing AES-256...\n'
-for keyfile in tests/*.key; do
-    test=$(basename ${keyfile%.key})
-    ./test-aes.sh ecb "$test"
-    ./test-aes.sh cbc "$test"
-    ./test-aes.sh ctr "$test"
+# Every AES implementation this machine can run, see ./aes256 impls
+for impl in $(./aes256 impls); do
+    export AES256_IMPL=$impl
+
+    printf 'Testing AES-256 (%s)...\n' "$impl"
+    for keyfile in tests/*.key; do
+        test=$(basename ${keyfile%.key})
+        ./test-aes.sh ecb "$test"
+        ./test-aes.sh cbc "$test"
+        ./test-aes.sh ctr "$test"
+        ./test-aes.sh gcm "$test"
+        ./test-aes.sh xts "$test"
+        ./test-aes.sh cmac "$test"
+        ./test-aes.sh chunked "$test"
+    done
+    ./test-lib.sh batch
+    ./test-lib.sh cbcstreams
+    ./test-lib.sh keystream
+    ./test-lib.sh stream
+    ./test-lib.sh inplace
+
+    printf '\nTesting AES-256 (%s) with 4 threads...\n' "$impl"
+    for keyfile in tests/*.key; do
+        test=$(basename ${keyfile%.key})
+        ./test-aes.sh ecb "$test" 4
+        ./test-aes.sh cbc "$test" 4
+        ./test-aes.sh ctr "$test" 4
+        ./test-aes.sh gcm "$test" 4
+        ./test-aes.sh xts "$test" 4
+        ./test-aes.sh chunked "$test" 4
+    done
+    ./test-lib.sh stream 4
+    ./test-lib.sh inplace 4
+    printf '\n'
 done
+unset AES256_IMPL
+
+printf 'Testing rand...\n'
+./test-rand.sh
+./test-rand.sh 4
+printf '\n'
 
-printf '\nTesting SHA-256...\n'
+printf 'Testing SHA-256...\n'
 for keyfile in tests/*.key; do
     test=$(basename ${keyfile%.key})
     ./test-sha.sh "$test"
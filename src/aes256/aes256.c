@@ -1,173 +1,2343 @@
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
 #include "aes256.h"
-
-#ifdef AES_TABLE
+#include "aesni.h"
+#include "bitslice.h"
+#include "ghash.h"
 #include "tables.h"
+#include "vperm.h"
+
+// Each table-based implementation fills in the tables for its own
+// direction right before using them, so encrypting never builds the
+// inverse tables
+#ifdef AES_LAZYTABLES
+# define INIT_FWD_TABLES() tables_init_fwd()
+# define INIT_INV_TABLES() tables_init_inv()
+#else
+# define INIT_FWD_TABLES()
+# define INIT_INV_TABLES()
 #endif
 
-static void increment_big_128bit(uint32_t *, uint32_t);
-static void aes256_key_exp(const uint32_t *, uint32_t *, int);
-static void aes256_cipher(const uint8_t *, const uint8_t *, const uint8_t *,
-                          uint8_t *, const uint32_t *);
-static void aes256_inv_cipher(const uint8_t *, const uint8_t *, uint8_t *,
-                              const uint32_t *);
+// One column of a T-table round (Section 4.2.1 of The Design of
+// Rijndael) on whole 32-bit columns, for the unrolled implementation.
+// For encryption, s1, s2 and s3 are the columns 1, 2 and 3 to the right
+// of s0 (ShiftRows), and for the equivalent inverse cipher they are to
+// the left (InvShiftRows). T0 is separate because TABLE_ROT() cannot
+// rotate by 0
+#if defined(AES_DUPTABLE)
+# define T0_FWD(col) TABLE_DUP(T_fwd_dup[TABLE_BYTE(col, 0)], 0)
+# define T0_INV(col) TABLE_DUP(T_inv_dup[TABLE_BYTE(col, 0)], 0)
+# define T_FWD(n, col) TABLE_DUP(T_fwd_dup[TABLE_BYTE(col, n)], n)
+# define T_INV(n, col) TABLE_DUP(T_inv_dup[TABLE_BYTE(col, n)], n)
+#elif defined(AES_MONOTABLE)
+# define T0_FWD(col) T0_fwd_words[TABLE_BYTE(col, 0)]
+# define T0_INV(col) T0_inv_words[TABLE_BYTE(col, 0)]
+# define T_FWD(n, col) TABLE_ROT(T0_fwd_words[TABLE_BYTE(col, n)], n)
+# define T_INV(n, col) TABLE_ROT(T0_inv_words[TABLE_BYTE(col, n)], n)
+#else
+# define T0_FWD(col) T0_fwd_words[TABLE_BYTE(col, 0)]
+# define T0_INV(col) T0_inv_words[TABLE_BYTE(col, 0)]
+# define T_FWD(n, col) T##n##_fwd_words[TABLE_BYTE(col, n)]
+# define T_INV(n, col) T##n##_inv_words[TABLE_BYTE(col, n)]
+#endif
+#define FWD_COL(s0, s1, s2, s3, key) \
+    (T0_FWD(s0) ^ T_FWD(1, s1) ^ T_FWD(2, s2) ^ T_FWD(3, s3) ^ (key))
+#define INV_COL(s0, s1, s2, s3, key) \
+    (T0_INV(s0) ^ T_INV(1, s1) ^ T_INV(2, s2) ^ T_INV(3, s3) ^ (key))
+
+// A whole round reading columns s0..s3 and writing columns d0..d3, so
+// that rounds can ping-pong between two sets of locals. key points to
+// the Nb words of the round key
+#define FWD_ROUND(d, s, key) \
+    d##0 = FWD_COL(s##0, s##1, s##2, s##3, (key)[0]); \
+    d##1 = FWD_COL(s##1, s##2, s##3, s##0, (key)[1]); \
+    d##2 = FWD_COL(s##2, s##3, s##0, s##1, (key)[2]); \
+    d##3 = FWD_COL(s##3, s##0, s##1, s##2, (key)[3])
+#define INV_ROUND(d, s, key) \
+    d##0 = INV_COL(s##0, s##3, s##2, s##1, (key)[0]); \
+    d##1 = INV_COL(s##1, s##0, s##3, s##2, (key)[1]); \
+    d##2 = INV_COL(s##2, s##1, s##0, s##3, (key)[2]); \
+    d##3 = INV_COL(s##3, s##2, s##1, s##0, (key)[3])
+
+// The last round has no MixColumns, so go through the S-box directly.
+// With SBOXWORDS, every byte of S_fwd_words[x] is S(x), so we can mask
+// out the one we want instead of assembling the word byte by byte
+#ifdef AES_SBOXWORDS
+# define S_FWD(n, col) (S_fwd_words[TABLE_BYTE(col, n)] & TABLE_MASK(n))
+# define S_INV(n, col) (S_inv_words[TABLE_BYTE(col, n)] & TABLE_MASK(n))
+# define FWD_LAST_COL(s0, s1, s2, s3, key) \
+    (S_FWD(0, s0) ^ S_FWD(1, s1) ^ S_FWD(2, s2) ^ S_FWD(3, s3) ^ (key))
+# define INV_LAST_COL(s0, s1, s2, s3, key) \
+    (S_INV(0, s0) ^ S_INV(1, s1) ^ S_INV(2, s2) ^ S_INV(3, s3) ^ (key))
+#else
+# define FWD_LAST_COL(s0, s1, s2, s3, key) \
+    (TABLE_WORD(s_box_replace(TABLE_BYTE(s0, 0)), \
+                s_box_replace(TABLE_BYTE(s1, 1)), \
+                s_box_replace(TABLE_BYTE(s2, 2)), \
+                s_box_replace(TABLE_BYTE(s3, 3))) ^ (key))
+# define INV_LAST_COL(s0, s1, s2, s3, key) \
+    (TABLE_WORD(inv_s_box_replace(TABLE_BYTE(s0, 0)), \
+                inv_s_box_replace(TABLE_BYTE(s1, 1)), \
+                inv_s_box_replace(TABLE_BYTE(s2, 2)), \
+                inv_s_box_replace(TABLE_BYTE(s3, 3))) ^ (key))
+#endif
+#define FWD_LAST_ROUND(d, s, key) \
+    d##0 = FWD_LAST_COL(s##0, s##1, s##2, s##3, (key)[0]); \
+    d##1 = FWD_LAST_COL(s##1, s##2, s##3, s##0, (key)[1]); \
+    d##2 = FWD_LAST_COL(s##2, s##3, s##0, s##1, (key)[2]); \
+    d##3 = FWD_LAST_COL(s##3, s##0, s##1, s##2, (key)[3])
+#define INV_LAST_ROUND(d, s, key) \
+    d##0 = INV_LAST_COL(s##0, s##3, s##2, s##1, (key)[0]); \
+    d##1 = INV_LAST_COL(s##1, s##0, s##3, s##2, (key)[1]); \
+    d##2 = INV_LAST_COL(s##2, s##1, s##0, s##3, (key)[2]); \
+    d##3 = INV_LAST_COL(s##3, s##2, s##1, s##0, (key)[3])
+
+// Move a state between its byte array form and four column locals
+#define LOAD_COLS(s, state) \
+    s##0 = ((const uint32_t *)(state))[0]; \
+    s##1 = ((const uint32_t *)(state))[1]; \
+    s##2 = ((const uint32_t *)(state))[2]; \
+    s##3 = ((const uint32_t *)(state))[3]
+#define STORE_COLS(state, s) \
+    ((uint32_t *)(state))[0] = s##0; \
+    ((uint32_t *)(state))[1] = s##1; \
+    ((uint32_t *)(state))[2] = s##2; \
+    ((uint32_t *)(state))[3] = s##3
+
+// Number of independent blocks rounds_enc_ecb() and rounds_dec_ecb()
+// interleave, and unrolled_enc_ecb() and unrolled_dec_ecb() too
+#define PAR_BLOCKS 4
+
+// A round of each of PAR_BLOCKS blocks a to d in column locals, e.g.
+// sa0..sa3 into ta0..ta3, one after the other so that the compiler can
+// overlap the lookups of all four
+#define PAR_ROUND(ROUND, to, from, key) \
+    ROUND(to##a, from##a, key); \
+    ROUND(to##b, from##b, key); \
+    ROUND(to##c, from##c, key); \
+    ROUND(to##d, from##d, key)
+#define PAR_LOAD_COLS(s, state) \
+    LOAD_COLS(s##a, (state)[0]); \
+    LOAD_COLS(s##b, (state)[1]); \
+    LOAD_COLS(s##c, (state)[2]); \
+    LOAD_COLS(s##d, (state)[3])
+#define PAR_STORE_COLS(state, s) \
+    STORE_COLS((state)[0], s##a); \
+    STORE_COLS((state)[1], s##b); \
+    STORE_COLS((state)[2], s##c); \
+    STORE_COLS((state)[3], s##d)
+
+// CTR and CBC decryption built on top of an ECB function work through
+// their input in chunks of this many blocks, which is a multiple of
+// both PAR_BLOCKS and BS_BLOCKS
+#define CHUNK_BLOCKS 64
+#define CHUNK(remaining) ((remaining) < CHUNK_BLOCKS? (remaining) : CHUNK_BLOCKS)
+
+// The _mt modes hand the thread pool ranges of at most this many blocks
+// (64 KiB), so every range but the last is whole chunks, and there are
+// enough of them for idle threads to steal
+#define MT_GRAIN (64 * CHUNK_BLOCKS)
+
+// CMAC messages up to this many blocks go through the CBC code in a
+// single call, straight from a buffer on the stack
+#define CMAC_FAST_BLOCKS 4
+// CMAC always runs at least one block, even for an empty message
+#define CMAC_BLOCKS(len) ((len)? ((len) + (4 * Nb) - 1) / (4 * Nb) : 1)
+
+// How many blocks of output CTR_DRBG works out in one go
+#define DRBG_CHUNK_BLOCKS (DRBG_MAX_REQUEST / (4 * Nb))
+
+// The buffer of an aes256_keystream_t, 64 KiB, unless asked otherwise
+#define KEYSTREAM_BLOCKS (64 * CHUNK_BLOCKS)
+
+typedef void ecb_fn_t(const uint8_t *, const uint32_t *, uint8_t *, int);
+typedef void round_fn_t(uint8_t *, const uint32_t *);
+typedef void lanes_fn_t(const uint8_t *, const uint32_t *, uint8_t *);
+
+// One entry in the registry of implementations. All of them produce and
+// take the same key schedules, so a schedule expanded by one works with
+// any other. The x86 backends bring their own CBC and CTR; the rest
+// leave those NULL and get them from their ECB functions, see
+// ecb_enc_cbc(), ecb_dec_cbc() and ecb_ctr()
+typedef struct {
+    const char *name;
+    // NULL if it works everywhere
+    int (*available)(void);
+    void (*key_exp)(const uint8_t *, uint32_t *, int);
+    ecb_fn_t *enc_ecb;
+    ecb_fn_t *dec_ecb;
+    void (*enc_cbc)(const uint8_t *, const uint8_t *, const uint32_t *, uint8_t *, int);
+    void (*dec_cbc)(const uint8_t *, const uint8_t *, const uint32_t *, uint8_t *, int);
+    void (*ctr)(const uint8_t *, const uint8_t *, const uint32_t *, uint8_t *, int);
+    // For the batch API, or NULL to run each job through the functions
+    // above instead. An implementation with kernels of its own (other
+    // than the T-table ones) also expands the keys for them, see
+    // lanes_key_exp()
+    lanes_fn_t *enc_lanes;
+    lanes_fn_t *dec_lanes;
+    // Whether GCM computes GHASH with PCLMULQDQ (if this machine has it)
+    // rather than with the 4-bit tables, see ghash.c
+    int clmul;
+} aes256_impl_t;
+
+// A multithreaded mode, shared by all the threads of the pool. in and
+// out always point at the start of the whole buffers, and each range
+// callback below gets told which blocks are its own
+typedef struct {
+    const aes256_impl_t *impl;
+    const uint8_t *iv;
+    // For CBC decryption in place, the IV of every range after the
+    // first, copied out before another thread can decrypt over it
+    const uint8_t *range_ivs;
+    const uint8_t *in;
+    const uint32_t *round_keys;
+    uint8_t *out;
+} mt_job_t;
+
+// An XTS message, shared by the threads of the pool like mt_job_t, but
+// split into data units instead of blocks
+typedef struct {
+    const aes256_impl_t *impl;
+    const aes256_impl_t *tweak_impl;
+    // Inverse schedule for decryption
+    const uint32_t *round_keys;
+    const uint32_t *tweak_keys;
+    const uint8_t *tweak;
+    const uint8_t *in;
+    uint8_t *out;
+    int len;
+    int unit_size;
+    int dec;
+} xts_job_t;
+
+typedef enum {
+    BATCH_ENC_ECB,
+    BATCH_DEC_ECB,
+    BATCH_ENC_CBC,
+    BATCH_DEC_CBC,
+    BATCH_CTR,
+} batch_mode_t;
+
+// The batch API runs up to BATCH_LANES jobs at once, one per lane, and
+// moves every lane one block along per step. Round keys are kept round
+// by round with the lanes side by side, so each round reads the keys of
+// every lane from one place
+typedef struct {
+    uint32_t round_keys[Nr + 1][BATCH_LANES][Nb];
+    // NULL for an idle lane
+    const aes256_job_t *jobs[BATCH_LANES];
+    int next_block[BATCH_LANES];
+    // The previous ciphertext block for CBC, or the counter for CTR
+    uint8_t chain[BATCH_LANES][4 * Nb];
+} batch_t;
+
+static const aes256_impl_t *find_impl(const char *);
+static const aes256_impl_t *fastest_impl(void);
+static int impl_available(const aes256_impl_t *);
+static const aes256_impl_t *current_impl(void);
+static void pick_impl(void);
+static double time_enc_ecb(const aes256_impl_t *);
+static threadpool_t *oneshot_pool(int);
+static void enc_ecb_range(void *, int, int);
+static void dec_ecb_range(void *, int, int);
+static void dec_cbc_range(void *, int, int);
+static void ctr_range(void *, int, int);
+static void enc_cbc_streams(const aes256_impl_t *, const uint32_t *,
+                            aes256_cbc_stream_t *, int);
+static void run_batch(batch_mode_t, const aes256_job_t *, int);
+static void run_job(const aes256_impl_t *, batch_mode_t, const aes256_job_t *, int,
+                    const uint8_t *);
+static void lanes_key_exp(const aes256_impl_t *, const uint8_t *const *,
+                          uint32_t (*)[BATCH_LANES][Nb], int);
+static void table_enc_lanes(const uint8_t *, const uint32_t *, uint8_t *);
+static void table_dec_lanes(const uint8_t *, const uint32_t *, uint8_t *);
+static void expand_key(aes256_ctx_t *, const uint8_t *, int);
+static void enc_ecb_blocks(const aes256_impl_t *, const uint8_t *, const uint32_t *,
+                           uint8_t *, int);
+static void dec_ecb_blocks(const aes256_impl_t *, const uint8_t *, const uint32_t *,
+                           uint8_t *, int);
+static void enc_cbc_blocks(const aes256_impl_t *, const uint8_t *, const uint8_t *,
+                           const uint32_t *, uint8_t *, int);
+static void dec_cbc_blocks(const aes256_impl_t *, const uint8_t *, const uint8_t *,
+                           const uint32_t *, uint8_t *, int);
+static void ctr_blocks(const aes256_impl_t *, const uint8_t *, const uint8_t *,
+                       const uint32_t *, uint8_t *, int);
+static void ecb_enc_cbc(ecb_fn_t *, const uint8_t *, const uint8_t *,
+                        const uint32_t *, uint8_t *, int);
+static void ecb_dec_cbc(ecb_fn_t *, const uint8_t *, const uint8_t *,
+                        const uint32_t *, uint8_t *, int);
+static void ecb_ctr(ecb_fn_t *, const uint8_t *, const uint8_t *,
+                    const uint32_t *, uint8_t *, int);
+static int xts(const aes256_ctx_t *, const aes256_ctx_t *, int, const uint8_t *,
+               const uint8_t *, uint8_t *, int, int, threadpool_t *);
+static void xts_range(void *, int, int);
+static void xts_unit(const aes256_impl_t *, int, const uint32_t *, uint8_t *,
+                     const uint8_t *, uint8_t *, int);
+static void xts_blocks(ecb_fn_t *, const uint32_t *, uint8_t *, const uint8_t *,
+                       uint8_t *, int);
+static inline void xts_mul_alpha(uint8_t *);
+static void increment_little_128bit(uint8_t *, uint64_t);
+static void cmac_subkeys(aes256_ctx_t *);
+static inline void cmac_double(uint8_t *, const uint8_t *);
+static void cmac(const aes256_ctx_t *, const uint8_t *, int, uint8_t *);
+static void cmac_batch(const aes256_ctx_t *, aes256_cmac_msg_t *, int);
+static void cmac_last_block(const aes256_ctx_t *, const uint8_t *, int, uint8_t *);
+static void gcm(const aes256_ctx_t *, int, const uint8_t *, int, const uint8_t *,
+                int, const uint8_t *, uint8_t *, int, uint8_t *);
+static void gcm_ctr_blocks(const aes256_impl_t *, uint8_t *, const uint8_t *,
+                           const uint32_t *, uint8_t *, int);
+static void *keystream_main(void *);
+static void ctr_bytes(const aes256_ctx_t *, const uint8_t *, uint64_t, int,
+                      const uint8_t *, uint8_t *, int);
+static inline void xor_bytes(uint8_t *, const uint8_t *, const uint8_t *, int);
+static void stream_blocks(aes256_stream_t *, const uint8_t *, uint8_t *, int);
+static int stream_ctr(aes256_stream_t *, const uint8_t *, uint8_t *, int);
+static int drbg_pad(uint8_t *, const uint8_t *, int);
+static int drbg_entropy(uint8_t *);
+static void drbg_request(aes256_drbg_t *, uint8_t *, int, const uint8_t *);
+static void drbg_update(aes256_drbg_t *, const uint8_t *);
+static void drbg_key_init(void);
+static void drbg_thread_free(void *);
+static void wipe(void *, size_t);
+static void increment_big_128bit(uint8_t *, uint64_t);
+static void increment_big_32bit(uint8_t *, uint32_t);
+static void key_exp_sbox(const uint8_t *, uint32_t *, int);
+static void key_exp_bitslice(const uint8_t *, uint32_t *, int);
+static void key_exp_onthefly(const uint8_t *, uint32_t *, int);
+static void aes256_key_exp(const uint32_t *, uint32_t *, int, uint32_t (*)(uint32_t));
+static inline void next_key_window(uint32_t *, int);
+static inline void prev_key_window(uint32_t *, int);
+static inline uint32_t inv_mix_key_col(uint32_t);
+static void unrolled_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void unrolled_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void onthefly_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void onthefly_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void table_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void table_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void monotable_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void monotable_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void original_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static void original_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+static inline void rounds_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int,
+                                  round_fn_t *, round_fn_t *);
+static inline void rounds_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int,
+                                  round_fn_t *, round_fn_t *);
+static void original_fwd_round(uint8_t *, const uint32_t *);
+static void original_inv_round(uint8_t *, const uint32_t *);
+static void table_fwd_round(uint8_t *, const uint32_t *);
+static void table_inv_round(uint8_t *, const uint32_t *);
+static void monotable_fwd_round(uint8_t *, const uint32_t *);
+static void monotable_inv_round(uint8_t *, const uint32_t *);
+static void fwd_last_round(uint8_t *, const uint32_t *);
+static void inv_last_round(uint8_t *, const uint32_t *);
 static void add_round_key(uint8_t *, const uint32_t *);
 static void sub_bytes(uint8_t *);
 static void inv_sub_bytes(uint8_t *);
 static void shift_rows(uint8_t *);
 static void inv_shift_rows(uint8_t *);
-#ifndef AES_TABLE
 static void mix_columns(uint8_t *);
-#endif
 static void inv_mix_columns(uint8_t *);
 static inline uint8_t xtime(uint8_t);
 static inline void copy_state(uint8_t *, const uint8_t *);
 static inline uint8_t s_box_replace(uint8_t);
 static inline uint8_t inv_s_box_replace(uint8_t);
-static inline uint32_t sub_word(uint32_t);
+static uint32_t sub_word(uint32_t);
 static inline uint32_t rot_word(uint32_t);
 
-void aes256_enc_ecb(const uint8_t *in, const uint8_t *key, uint8_t *out, int nblocks) {
-    uint32_t round_keys[Nb * (Nr + 1)];
+// Every implementation we have, roughly fastest first. Which one to use
+// is decided at runtime, see current_impl()
+static const aes256_impl_t impls[] = {
+#ifdef AESNI_SUPPORTED
+    {.name = "aesni", .available = aesni_available, .key_exp = aesni_key_exp,
+     .enc_ecb = aesni_enc_ecb, .dec_ecb = aesni_dec_ecb, .enc_cbc = aesni_enc_cbc,
+     .dec_cbc = aesni_dec_cbc, .ctr = aesni_ctr, .enc_lanes = aesni_enc_lanes,
+     .dec_lanes = aesni_dec_lanes, .clmul = 1},
+#endif
+#ifdef VPERM_SUPPORTED
+    {.name = "vperm", .available = vperm_available, .key_exp = vperm_key_exp,
+     .enc_ecb = vperm_enc_ecb, .dec_ecb = vperm_dec_ecb, .enc_cbc = vperm_enc_cbc,
+     .dec_cbc = vperm_dec_cbc, .ctr = vperm_ctr, .clmul = 1},
+#endif
+    // The T-table implementations all share the T-table lanes kernels
+    {.name = "unrolled", .key_exp = key_exp_sbox,
+     .enc_ecb = unrolled_enc_ecb, .dec_ecb = unrolled_dec_ecb,
+     .enc_lanes = table_enc_lanes, .dec_lanes = table_dec_lanes},
+    {.name = "monotable", .key_exp = key_exp_sbox,
+     .enc_ecb = monotable_enc_ecb, .dec_ecb = monotable_dec_ecb,
+     .enc_lanes = table_enc_lanes, .dec_lanes = table_dec_lanes},
+    {.name = "table", .key_exp = key_exp_sbox,
+     .enc_ecb = table_enc_ecb, .dec_ecb = table_dec_ecb,
+     .enc_lanes = table_enc_lanes, .dec_lanes = table_dec_lanes},
+    // Keeps only Nk words of its schedule, see key_exp_onthefly()
+    {.name = "onthefly", .key_exp = key_exp_onthefly,
+     .enc_ecb = onthefly_enc_ecb, .dec_ecb = onthefly_dec_ecb},
+    // Key expansion uses the same circuit, so no S-box lookups at all
+    {.name = "bitslice", .key_exp = key_exp_bitslice,
+     .enc_ecb = bitslice_enc_ecb, .dec_ecb = bitslice_dec_ecb},
+    {.name = "original", .key_exp = key_exp_sbox,
+     .enc_ecb = original_enc_ecb, .dec_ecb = original_dec_ecb,
+     .enc_lanes = table_enc_lanes, .dec_lanes = table_dec_lanes},
+};
+#define NUM_IMPLS ((int)(sizeof impls / sizeof impls[0]))
+
+// "Rcon[i] contains the values given by [x^{i-1},{00},{00},{00}]"
+// attempt to construct this in an endianness-safe way. note that
+// Rcon[0] is never accessed, and that the size has to be spelled out
+// for the zero bytes of Rcon[7]
+static const uint8_t rcon_bytes[4 * (Nr / 2 + 1)] = {
+    [4] = 0x01, [8] = 0x02,
+    [12] = 0x04, [16] = 0x08,
+    [20] = 0x10, [24] = 0x20,
+    [28] = 0x40,
+};
+
+// The implementation in use, set by aes256_set_impl() or on first use
+static const aes256_impl_t *impl;
+static pthread_once_t impl_once = PTHREAD_ONCE_INIT;
+
+// Both key schedules for a key, along with the implementation that
+// expanded them, since onthefly only keeps part of a schedule. Otherwise
+// the inverse schedule has already been through InvMixColumns for the
+// equivalent inverse cipher
+struct aes256_ctx {
+    const aes256_impl_t *impl;
+    uint32_t round_keys[Nb * (Nr + 1)];
+    uint32_t inv_round_keys[Nb * (Nr + 1)];
+    // The CMAC subkeys K1 and K2, see cmac_subkeys()
+    uint8_t cmac_k1[4 * Nb];
+    uint8_t cmac_k2[4 * Nb];
+};
+
+// Blocks of keystream are numbered from the initial counter, and block
+// n lives in ring[n % nblocks]. The ring holds blocks [tail, head),
+// while the thread fills in the next ones up to tail + nblocks, so the
+// two never touch the same slot. Only the thread moves head and only
+// aes256_keystream_xor() moves tail, and a miss can move tail past head,
+// which just means the buffer is empty until the thread catches up
+struct aes256_keystream {
+    // A copy, so the caller's context can go away first
+    aes256_ctx_t ctx;
+    uint8_t init_ctr[4 * Nb];
+    uint8_t (*ring)[4 * Nb];
+    int nblocks;
+    // Bytes handed out so far
+    uint64_t pos;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    // Signalled whenever tail moves, which makes room in the ring
+    pthread_cond_t room;
+    uint64_t head;
+    uint64_t tail;
+    int shutdown;
+    aes256_keystream_stats_t stats;
+};
+
+// One message going through aes256_stream_update()
+struct aes256_stream {
+    // A copy, so the caller's context can go away first
+    aes256_ctx_t ctx;
+    aes256_stream_mode_t mode;
+    threadpool_t *pool;
+    // The IV for the next block of CBC, or the counter for the next
+    // block of CTR keystream
+    uint8_t chain[4 * Nb];
+    // Input we cannot do anything with yet: part of a block, or for ECB
+    // and CBC decryption, the last whole block, which might be the
+    // padding
+    uint8_t buf[4 * Nb];
+    int buf_len;
+    // The last block of CTR keystream, of which only the bytes from
+    // used on are left
+    uint8_t keystream[4 * Nb];
+    int used;
+};
+
+// The working state of CTR_DRBG: the key, already expanded, and V, the
+// counter block the output is the CTR keystream of
+struct aes256_drbg {
+    aes256_ctx_t ctx;
+    uint8_t v[4 * Nb];
+    unsigned long reseed_counter;
+};
+
+// Every thread's instance for aes256_drbg_thread(), freed when the
+// thread exits
+static pthread_key_t drbg_key;
+static pthread_once_t drbg_once = PTHREAD_ONCE_INIT;
+
+// Use the implementation called name from now on. Existing contexts
+// keep using the one they were set up with. Returns -1 if there is no
+// such implementation or this machine cannot run it
+int aes256_set_impl(const char *name) {
+    const aes256_impl_t *found = find_impl(name);
+    if (!found) {
+        return -1;
+    }
+
+    impl = found;
+    return 0;
+}
+
+// Name of the implementation in use, picking one if need be
+const char *aes256_get_impl(void) {
+    return current_impl()->name;
+}
+
+// Name of the nth implementation this machine can run, or NULL past the
+// last one
+const char *aes256_impl_name(int n) {
+    for (int i = 0; i < NUM_IMPLS; i++) {
+        if (impl_available(&impls[i]) && !n--) {
+            return impls[i].name;
+        }
+    }
+
+    return NULL;
+}
+
+// Expand key once for any number of calls to the aes256_ctx_*()
+// functions below. Returns NULL if we are out of memory
+aes256_ctx_t *aes256_ctx_init(const uint8_t *key) {
+    aes256_ctx_t *ctx;
+    if (!(ctx = malloc(sizeof *ctx))) {
+        return NULL;
+    }
+
+    ctx->impl = current_impl();
+    expand_key(ctx, key, 0);
+    expand_key(ctx, key, 1);
+    cmac_subkeys(ctx);
+    return ctx;
+}
+
+void aes256_ctx_free(aes256_ctx_t *ctx) {
+    if (!ctx) {
+        return;
+    }
+
+    // Do not leave the key schedule lying around on the heap
+    wipe(ctx, sizeof *ctx);
+    free(ctx);
+}
+
+void aes256_ctx_enc_ecb(const aes256_ctx_t *ctx, const uint8_t *in, uint8_t *out,
+                        int nblocks) {
+    enc_ecb_blocks(ctx->impl, in, ctx->round_keys, out, nblocks);
+}
+
+void aes256_ctx_dec_ecb(const aes256_ctx_t *ctx, const uint8_t *in, uint8_t *out,
+                        int nblocks) {
+    dec_ecb_blocks(ctx->impl, in, ctx->inv_round_keys, out, nblocks);
+}
+
+void aes256_ctx_enc_cbc(const aes256_ctx_t *ctx, const uint8_t *iv,
+                        const uint8_t *in, uint8_t *out, int nblocks) {
+    enc_cbc_blocks(ctx->impl, iv, in, ctx->round_keys, out, nblocks);
+}
+
+void aes256_ctx_dec_cbc(const aes256_ctx_t *ctx, const uint8_t *iv,
+                        const uint8_t *in, uint8_t *out, int nblocks) {
+    dec_cbc_blocks(ctx->impl, iv, in, ctx->inv_round_keys, out, nblocks);
+}
+
+void aes256_ctx_ctr(const aes256_ctx_t *ctx, const uint8_t *init_ctr,
+                    const uint8_t *in, uint8_t *out, int nblocks) {
+    ctr_blocks(ctx->impl, init_ctr, in, ctx->round_keys, out, nblocks);
+}
+
+// CTR on the len bytes of a message starting at byte offset, which
+// need not be on a block boundary, without the bytes before them. in
+// and out only hold those len bytes. This is what lets us decrypt a
+// window of a large file without reading the rest
+void aes256_ctx_ctr_range(const aes256_ctx_t *ctx, const uint8_t *init_ctr,
+                          uint64_t offset, const uint8_t *in, uint8_t *out, int len) {
+    ctr_bytes(ctx, init_ctr, offset / (4 * Nb), offset % (4 * Nb), in, out, len);
+}
+
+// Start generating the keystream of CTR from init_ctr into a buffer of
+// nblocks blocks (or KEYSTREAM_BLOCKS if 0). Returns NULL if we are out
+// of memory or cannot start the thread
+aes256_keystream_t *aes256_keystream_init(const aes256_ctx_t *ctx,
+                                          const uint8_t *init_ctr, int nblocks) {
+    aes256_keystream_t *ks;
+    if (!(ks = calloc(1, sizeof *ks))) {
+        return NULL;
+    }
+
+    ks->nblocks = nblocks > 0? nblocks : KEYSTREAM_BLOCKS;
+    if (!(ks->ring = malloc(ks->nblocks * sizeof *ks->ring))) {
+        free(ks);
+        return NULL;
+    }
+    ks->ctx = *ctx;
+    copy_state(ks->init_ctr, init_ctr);
+
+    pthread_mutex_init(&ks->lock, NULL);
+    pthread_cond_init(&ks->room, NULL);
+    if (pthread_create(&ks->thread, NULL, keystream_main, ks)) {
+        pthread_cond_destroy(&ks->room);
+        pthread_mutex_destroy(&ks->lock);
+        free(ks->ring);
+        free(ks);
+        return NULL;
+    }
+
+    return ks;
+}
+
+void aes256_keystream_free(aes256_keystream_t *ks) {
+    if (!ks) {
+        return;
+    }
+
+    pthread_mutex_lock(&ks->lock);
+    ks->shutdown = 1;
+    pthread_cond_signal(&ks->room);
+    pthread_mutex_unlock(&ks->lock);
+    pthread_join(ks->thread, NULL);
+
+    pthread_cond_destroy(&ks->room);
+    pthread_mutex_destroy(&ks->lock);
+
+    // The keystream is as good as the key, so wipe both
+    wipe(ks->ring, ks->nblocks * sizeof *ks->ring);
+    wipe(&ks->ctx, sizeof ks->ctx);
+    free(ks->ring);
+    free(ks);
+}
+
+// XOR the next len bytes of keystream into in. The blocks the thread
+// already has cost a copy and an XOR each, and the rest go through
+// ctr_bytes(), the same as aes256_ctx_ctr_range() would
+void aes256_keystream_xor(aes256_keystream_t *ks, const uint8_t *in, uint8_t *out,
+                          int len) {
+    if (len <= 0) {
+        return;
+    }
+
+    uint64_t block = ks->pos / (4 * Nb);
+    int offset = ks->pos % (4 * Nb);
+
+    pthread_mutex_lock(&ks->lock);
+    uint64_t head = ks->head;
+    pthread_mutex_unlock(&ks->lock);
+
+    int done = 0;
+    for (; block < head && done < len; block++) {
+        const uint8_t *keystream = ks->ring[block % ks->nblocks];
+        int n = len - done < 4 * Nb - offset? len - done : 4 * Nb - offset;
+
+        if (n == 4 * Nb) {
+            copy_state(out + done, in + done);
+            add_round_key(out + done, (const uint32_t *)keystream);
+        } else {
+            xor_bytes(out + done, in + done, keystream + offset, n);
+        }
+        done += n;
+        offset = 0;
+    }
+
+    int missed = len - done;
+    if (missed) {
+        ctr_bytes(&ks->ctx, ks->init_ctr, block, offset, in + done, out + done, missed);
+    }
+
+    ks->pos += len;
+
+    pthread_mutex_lock(&ks->lock);
+    // Keep a partly used block around for next time
+    ks->tail = ks->pos / (4 * Nb);
+    if (missed) {
+        ks->stats.misses++;
+        ks->stats.miss_blocks += (offset + missed + 4 * Nb - 1) / (4 * Nb);
+    } else {
+        ks->stats.hits++;
+    }
+    pthread_cond_signal(&ks->room);
+    pthread_mutex_unlock(&ks->lock);
+}
+
+void aes256_keystream_stats(aes256_keystream_t *ks, aes256_keystream_stats_t *stats) {
+    pthread_mutex_lock(&ks->lock);
+    *stats = ks->stats;
+    pthread_mutex_unlock(&ks->lock);
+}
+
+// Start a message in mode. iv is the IV for CBC or the initial counter
+// for CTR, and ignored for ECB. pool can be NULL. Returns NULL if we are
+// out of memory
+aes256_stream_t *aes256_stream_init(const aes256_ctx_t *ctx, aes256_stream_mode_t mode,
+                                    const uint8_t *iv, threadpool_t *pool) {
+    aes256_stream_t *st;
+    if (!(st = calloc(1, sizeof *st))) {
+        return NULL;
+    }
+
+    st->ctx = *ctx;
+    st->mode = mode;
+    st->pool = pool;
+    if (mode != STREAM_ENC_ECB && mode != STREAM_DEC_ECB) {
+        copy_state(st->chain, iv);
+    }
+    st->used = 4 * Nb;
+    return st;
+}
+
+void aes256_stream_free(aes256_stream_t *st) {
+    if (!st) {
+        return;
+    }
+
+    wipe(st, sizeof *st);
+    free(st);
+}
+
+// Encrypt or decrypt the next len bytes of the message from in to out,
+// and return how many bytes of output that made. That is exactly len
+// for CTR, but ECB and CBC only put out whole blocks, and hold back the
+// last one when decrypting, so out needs room for len + BLOCK_SIZE - 1
+// bytes. out can be in for CTR, or whenever nothing is buffered from
+// the last update, since output then lines up with input byte for byte;
+// otherwise the two must not overlap
+int aes256_stream_update(aes256_stream_t *st, const uint8_t *in, uint8_t *out, int len) {
+    if (st->mode == STREAM_CTR) {
+        return stream_ctr(st, in, out, len);
+    }
+
+    int hold = st->mode == STREAM_DEC_ECB || st->mode == STREAM_DEC_CBC;
+    int written = 0;
+
+    // Top up a partial block left over from last time, and only go
+    // through it once there is more input after it to decrypt
+    if (st->buf_len) {
+        int n = len < 4 * Nb - st->buf_len? len : 4 * Nb - st->buf_len;
+        memcpy(st->buf + st->buf_len, in, n);
+        st->buf_len += n;
+        in += n;
+        len -= n;
+
+        if (st->buf_len < 4 * Nb || (hold && !len)) {
+            return 0;
+        }
+        stream_blocks(st, st->buf, out, 1);
+        st->buf_len = 0;
+        written += 4 * Nb;
+    }
+
+    int nblocks = len / (4 * Nb);
+    int rem = len % (4 * Nb);
+    if (hold && nblocks && !rem) {
+        nblocks--;
+        rem = 4 * Nb;
+    }
+
+    if (nblocks) {
+        stream_blocks(st, in, out + written, nblocks);
+        written += nblocks * (4 * Nb);
+    }
+    memcpy(st->buf, in + nblocks * (4 * Nb), rem);
+    st->buf_len = rem;
+
+    return written;
+}
+
+// Finish the message, writing whatever is left to out, which needs room
+// for BLOCK_SIZE bytes. ECB and CBC encryption put out the padding,
+// and decryption the last block minus its padding. Returns how many
+// bytes that made, or -1 if the message does not end in a block padded
+// the PKCS#5 way
+int aes256_stream_final(aes256_stream_t *st, uint8_t *out) {
+    switch (st->mode) {
+        case STREAM_CTR:
+            return 0;
+
+        case STREAM_ENC_ECB:
+        case STREAM_ENC_CBC: {
+            // Always at least one byte of padding, so a whole block of
+            // it if the message ends on a block boundary
+            int fill = 4 * Nb - st->buf_len;
+            memset(st->buf + st->buf_len, fill, fill);
+            stream_blocks(st, st->buf, out, 1);
+            st->buf_len = 0;
+            return 4 * Nb;
+        }
+
+        case STREAM_DEC_ECB:
+        case STREAM_DEC_CBC:
+            break;
+    }
+
+    if (st->buf_len != 4 * Nb) {
+        return -1;
+    }
+
+    uint8_t block[4 * Nb];
+    stream_blocks(st, st->buf, block, 1);
+    st->buf_len = 0;
+
+    // Look at every padding byte whatever the first one says, so the
+    // time this takes does not say how much padding there was
+    int fill = block[4 * Nb - 1];
+    int bad = !fill || fill > 4 * Nb;
+    for (int i = 0; i < 4 * Nb; i++) {
+        bad |= (i >= 4 * Nb - fill) & (block[i] != fill);
+    }
+
+    if (bad) {
+        wipe(block, sizeof block);
+        return -1;
+    }
+    memcpy(out, block, 4 * Nb - fill);
+    wipe(block, sizeof block);
+    return 4 * Nb - fill;
+}
+
+// Instantiate CTR_DRBG from a DRBG_SEED_SIZE-byte seed, or one from
+// /dev/urandom if seed is NULL, and a personalization string of up to
+// DRBG_SEED_SIZE bytes. Returns NULL if we are out of memory, cannot
+// read /dev/urandom, or the personalization string is too long
+aes256_drbg_t *aes256_drbg_init(const uint8_t *seed, const uint8_t *pers, int pers_len) {
+    aes256_drbg_t *drbg;
+    if (!(drbg = calloc(1, sizeof *drbg))) {
+        return NULL;
+    }
+
+    // Instantiating is reseeding from a zero key and V
+    uint8_t zero_key[4 * Nk] = {0};
+    drbg->ctx.impl = current_impl();
+    expand_key(&drbg->ctx, zero_key, 0);
+    if (aes256_drbg_reseed(drbg, seed, pers, pers_len) < 0) {
+        aes256_drbg_free(drbg);
+        return NULL;
+    }
+
+    return drbg;
+}
+
+void aes256_drbg_free(aes256_drbg_t *drbg) {
+    if (!drbg) {
+        return;
+    }
+
+    // Anyone with the state can work out everything it generates next
+    wipe(drbg, sizeof *drbg);
+    free(drbg);
+}
+
+// Mix a fresh DRBG_SEED_SIZE-byte seed (from /dev/urandom if NULL) and
+// up to DRBG_SEED_SIZE bytes of additional input into the state.
+// Returns -1 if we cannot read /dev/urandom or the additional input is
+// too long
+int aes256_drbg_reseed(aes256_drbg_t *drbg, const uint8_t *seed, const uint8_t *add,
+                       int add_len) {
+    uint8_t material[DRBG_SEED_SIZE], entropy[DRBG_SEED_SIZE];
+    if (drbg_pad(material, add, add_len) < 0) {
+        return -1;
+    }
+    if (!seed) {
+        if (drbg_entropy(entropy) < 0) {
+            return -1;
+        }
+        seed = entropy;
+    }
+
+    for (int i = 0; i < DRBG_SEED_SIZE; i++) {
+        material[i] ^= seed[i];
+    }
+    drbg_update(drbg, material);
+    drbg->reseed_counter = 1;
+
+    wipe(entropy, sizeof entropy);
+    wipe(material, sizeof material);
+    return 0;
+}
+
+// Fill out with len random bytes, mixing up to DRBG_SEED_SIZE bytes of
+// additional input into the first request. Anything longer than
+// DRBG_MAX_REQUEST is split into as many requests as it takes, each
+// CTR over its chunk followed by a fresh key, so this is about as fast
+// as CTR encryption with the occasional key expansion. Returns -1 if
+// the additional input is too long or a reseed that is due fails
+int aes256_drbg_generate(aes256_drbg_t *drbg, uint8_t *out, int len, const uint8_t *add,
+                         int add_len) {
+    uint8_t material[DRBG_SEED_SIZE];
+    if (drbg_pad(material, add, add_len) < 0) {
+        return -1;
+    }
+
+    // Step done by what each request actually made, so that it never
+    // goes past len, which could wrap when len is close to INT_MAX
+    int done = 0;
+    do {
+        if (drbg->reseed_counter > DRBG_RESEED_INTERVAL
+                && aes256_drbg_reseed(drbg, NULL, NULL, 0) < 0) {
+            wipe(material, sizeof material);
+            return -1;
+        }
+
+        int n = len - done < DRBG_MAX_REQUEST? len - done : DRBG_MAX_REQUEST;
+        drbg_request(drbg, out + done, n, done || !add_len? NULL : material);
+        done += n;
+    } while (done < len);
+
+    wipe(material, sizeof material);
+    return 0;
+}
+
+// Number of requests since the last reseed, counting from 1
+unsigned long aes256_drbg_reseed_counter(const aes256_drbg_t *drbg) {
+    return drbg->reseed_counter;
+}
+
+// This thread's own instance, seeded from /dev/urandom the first time
+// it asks, so threads never share one or need to lock it. Returns NULL
+// if it cannot be instantiated. It goes away with the thread
+aes256_drbg_t *aes256_drbg_thread(void) {
+    pthread_once(&drbg_once, drbg_key_init);
+
+    aes256_drbg_t *drbg = pthread_getspecific(drbg_key);
+    if (!drbg) {
+        // Tell threads apart even if they somehow get the same seed,
+        // the way SP 800-90A suggests personalization strings for
+        pthread_t self = pthread_self();
+        uint8_t pers[sizeof self < DRBG_SEED_SIZE? sizeof self : DRBG_SEED_SIZE];
+        memcpy(pers, &self, sizeof pers);
+
+        if ((drbg = aes256_drbg_init(NULL, pers, sizeof pers))
+                && pthread_setspecific(drbg_key, drbg)) {
+            aes256_drbg_free(drbg);
+            drbg = NULL;
+        }
+    }
+
+    return drbg;
+}
+
+// CBC encryption of many streams under the same key. Each stream is as
+// serial as ever, but one block from each of up to CHUNK_BLOCKS streams
+// can go through the ECB code together, so this interleaves them the
+// same way ECB interleaves blocks. The output is the same as running
+// aes256_ctx_enc_cbc() on every stream in turn
+void aes256_ctx_enc_cbc_streams(const aes256_ctx_t *ctx, aes256_cbc_stream_t *streams,
+                                int nstreams) {
+    enc_cbc_streams(ctx->impl, ctx->round_keys, streams, nstreams);
+}
+
+void aes256_ctx_enc_gcm(const aes256_ctx_t *ctx, const uint8_t *iv, int iv_len,
+                        const uint8_t *aad, int aad_len, const uint8_t *in,
+                        uint8_t *out, int len, uint8_t *tag) {
+    gcm(ctx, 0, iv, iv_len, aad, aad_len, in, out, len, tag);
+}
+
+// Checks every byte of the tag no matter where the first difference
+// is, so the time it takes does not give away how much of a forged tag
+// was right
+int aes256_ctx_dec_gcm(const aes256_ctx_t *ctx, const uint8_t *iv, int iv_len,
+                       const uint8_t *aad, int aad_len, const uint8_t *in,
+                       uint8_t *out, int len, const uint8_t *tag) {
+    uint8_t want[GCM_TAG_SIZE];
+    gcm(ctx, 1, iv, iv_len, aad, aad_len, in, out, len, want);
+
+    uint8_t diff = 0;
+    for (int i = 0; i < GCM_TAG_SIZE; i++) {
+        diff |= want[i] ^ tag[i];
+    }
+
+    if (diff) {
+        // Do not hand back plaintext we cannot vouch for
+        if (len) {
+            memset(out, 0, len);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+void aes256_ctx_cmac(const aes256_ctx_t *ctx, const uint8_t *in, int len,
+                     uint8_t *mac) {
+    cmac(ctx, in, len, mac);
+}
+
+// CMAC of many messages under the same key, a block from each of up to
+// CHUNK_BLOCKS messages per call into the ECB code, the same way
+// aes256_ctx_enc_cbc_streams() works. Messages of a block or two still
+// keep the ECB code busy, since the next message starts as soon as
+// one finishes
+void aes256_ctx_cmac_batch(const aes256_ctx_t *ctx, aes256_cmac_msg_t *msgs,
+                           int nmsgs) {
+    cmac_batch(ctx, msgs, nmsgs);
+}
+
+int aes256_ctx_enc_xts(const aes256_ctx_t *ctx, const aes256_ctx_t *tweak_ctx,
+                       const uint8_t *tweak, const uint8_t *in, uint8_t *out,
+                       int len, int unit_size, threadpool_t *pool) {
+    return xts(ctx, tweak_ctx, 0, tweak, in, out, len, unit_size, pool);
+}
+
+int aes256_ctx_dec_xts(const aes256_ctx_t *ctx, const aes256_ctx_t *tweak_ctx,
+                       const uint8_t *tweak, const uint8_t *in, uint8_t *out,
+                       int len, int unit_size, threadpool_t *pool) {
+    return xts(ctx, tweak_ctx, 1, tweak, in, out, len, unit_size, pool);
+}
+
+void aes256_xts_tweak_add(uint8_t *tweak, uint64_t n) {
+    increment_little_128bit(tweak, n);
+}
+
+// The _mt versions of the modes above split the blocks between the
+// threads of pool (see threadpool.h), which all share the same key
+// schedule. Their output is identical to the serial versions, which is
+// what a NULL pool gets you. There is no CBC encryption version since
+// every block of CBC encryption depends on the one before it
+void aes256_ctx_enc_ecb_mt(const aes256_ctx_t *ctx, const uint8_t *in,
+                           uint8_t *out, int nblocks, threadpool_t *pool) {
+    mt_job_t job = {.impl = ctx->impl, .in = in, .round_keys = ctx->round_keys,
+                    .out = out};
+    threadpool_parallel_for(pool, nblocks, MT_GRAIN, enc_ecb_range, &job);
+}
+
+void aes256_ctx_dec_ecb_mt(const aes256_ctx_t *ctx, const uint8_t *in,
+                           uint8_t *out, int nblocks, threadpool_t *pool) {
+    mt_job_t job = {.impl = ctx->impl, .in = in,
+                    .round_keys = ctx->inv_round_keys, .out = out};
+    threadpool_parallel_for(pool, nblocks, MT_GRAIN, dec_ecb_range, &job);
+}
+
+void aes256_ctx_dec_cbc_mt(const aes256_ctx_t *ctx, const uint8_t *iv,
+                           const uint8_t *in, uint8_t *out, int nblocks,
+                           threadpool_t *pool) {
+    mt_job_t job = {.impl = ctx->impl, .iv = iv, .in = in,
+                    .round_keys = ctx->inv_round_keys, .out = out};
+
+    // Every range but the first starts from the last ciphertext block of
+    // the range before it, which in place might already be plaintext.
+    // If we cannot save them first, do it all on this thread, which
+    // reads each one before overwriting it
+    uint8_t *range_ivs = NULL;
+    int nranges = (nblocks + MT_GRAIN - 1) / MT_GRAIN;
+    if (pool && in == out && nranges > 1) {
+        if ((range_ivs = malloc((nranges - 1) * (4 * Nb)))) {
+            for (int r = 1; r < nranges; r++) {
+                copy_state(range_ivs + (r - 1) * (4 * Nb),
+                           in + (size_t)(r * MT_GRAIN - 1) * (4 * Nb));
+            }
+            job.range_ivs = range_ivs;
+        } else {
+            pool = NULL;
+        }
+    }
+
+    threadpool_parallel_for(pool, nblocks, MT_GRAIN, dec_cbc_range, &job);
+    free(range_ivs);
+}
+
+void aes256_ctx_ctr_mt(const aes256_ctx_t *ctx, const uint8_t *init_ctr,
+                       const uint8_t *in, uint8_t *out, int nblocks,
+                       threadpool_t *pool) {
+    mt_job_t job = {.impl = ctx->impl, .iv = init_ctr, .in = in,
+                    .round_keys = ctx->round_keys, .out = out};
+    threadpool_parallel_for(pool, nblocks, MT_GRAIN, ctr_range, &job);
+}
+
+// The original one-shot API. These expand only the schedule they need
+// into a context on the stack and go through the functions above
+void aes256_enc_ecb(const uint8_t *in, const uint8_t *key, uint8_t *out, int nblocks) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    aes256_ctx_enc_ecb(&ctx, in, out, nblocks);
+}
+
+void aes256_dec_ecb(const uint8_t *in, const uint8_t *key, uint8_t *out, int nblocks) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 1);
+    aes256_ctx_dec_ecb(&ctx, in, out, nblocks);
+}
+
+void aes256_enc_cbc(const uint8_t *iv, const uint8_t *in, const uint8_t *key,
+                    uint8_t *out, int nblocks) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    aes256_ctx_enc_cbc(&ctx, iv, in, out, nblocks);
+}
+
+void aes256_dec_cbc(const uint8_t *iv, const uint8_t *in, const uint8_t *key,
+                    uint8_t *out, int nblocks) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 1);
+    aes256_ctx_dec_cbc(&ctx, iv, in, out, nblocks);
+}
+
+void aes256_ctr(const uint8_t *init_ctr, const uint8_t *in, const uint8_t *key,
+                uint8_t *out, int nblocks) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    aes256_ctx_ctr(&ctx, init_ctr, in, out, nblocks);
+}
+
+void aes256_ctr_range(const uint8_t *init_ctr, const uint8_t *in, const uint8_t *key,
+                      uint8_t *out, uint64_t offset, int len) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    aes256_ctx_ctr_range(&ctx, init_ctr, offset, in, out, len);
+}
+
+void aes256_enc_gcm(const uint8_t *iv, int iv_len, const uint8_t *aad, int aad_len,
+                    const uint8_t *in, const uint8_t *key, uint8_t *out, int len,
+                    uint8_t *tag) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    aes256_ctx_enc_gcm(&ctx, iv, iv_len, aad, aad_len, in, out, len, tag);
+}
+
+// GCM decrypts with the forward cipher too, so this only needs the
+// forward key schedule
+int aes256_dec_gcm(const uint8_t *iv, int iv_len, const uint8_t *aad, int aad_len,
+                   const uint8_t *in, const uint8_t *key, uint8_t *out, int len,
+                   const uint8_t *tag) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    return aes256_ctx_dec_gcm(&ctx, iv, iv_len, aad, aad_len, in, out, len, tag);
+}
+
+void aes256_cmac(const uint8_t *in, const uint8_t *key, int len, uint8_t *mac) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    cmac_subkeys(&ctx);
+    aes256_ctx_cmac(&ctx, in, len, mac);
+}
+
+// key is the data key followed by the tweak key. Only the tweak key's
+// forward schedule is ever used
+int aes256_enc_xts(const uint8_t *tweak, const uint8_t *in, const uint8_t *key,
+                   uint8_t *out, int len, int unit_size, int nthreads) {
+    aes256_ctx_t ctx = {.impl = current_impl()}, tweak_ctx = {.impl = ctx.impl};
+    expand_key(&ctx, key, 0);
+    expand_key(&tweak_ctx, key + 4 * Nk, 0);
+    threadpool_t *pool = oneshot_pool(nthreads);
+    int ret = aes256_ctx_enc_xts(&ctx, &tweak_ctx, tweak, in, out, len, unit_size, pool);
+    threadpool_destroy(pool);
+    return ret;
+}
+
+int aes256_dec_xts(const uint8_t *tweak, const uint8_t *in, const uint8_t *key,
+                   uint8_t *out, int len, int unit_size, int nthreads) {
+    aes256_ctx_t ctx = {.impl = current_impl()}, tweak_ctx = {.impl = ctx.impl};
+    expand_key(&ctx, key, 1);
+    expand_key(&tweak_ctx, key + 4 * Nk, 0);
+    threadpool_t *pool = oneshot_pool(nthreads);
+    int ret = aes256_ctx_dec_xts(&ctx, &tweak_ctx, tweak, in, out, len, unit_size, pool);
+    threadpool_destroy(pool);
+    return ret;
+}
+
+void aes256_enc_ecb_mt(const uint8_t *in, const uint8_t *key, uint8_t *out,
+                       int nblocks, int nthreads) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    threadpool_t *pool = oneshot_pool(nthreads);
+    aes256_ctx_enc_ecb_mt(&ctx, in, out, nblocks, pool);
+    threadpool_destroy(pool);
+}
+
+void aes256_dec_ecb_mt(const uint8_t *in, const uint8_t *key, uint8_t *out,
+                       int nblocks, int nthreads) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 1);
+    threadpool_t *pool = oneshot_pool(nthreads);
+    aes256_ctx_dec_ecb_mt(&ctx, in, out, nblocks, pool);
+    threadpool_destroy(pool);
+}
+
+void aes256_dec_cbc_mt(const uint8_t *iv, const uint8_t *in, const uint8_t *key,
+                       uint8_t *out, int nblocks, int nthreads) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 1);
+    threadpool_t *pool = oneshot_pool(nthreads);
+    aes256_ctx_dec_cbc_mt(&ctx, iv, in, out, nblocks, pool);
+    threadpool_destroy(pool);
+}
+
+void aes256_ctr_mt(const uint8_t *init_ctr, const uint8_t *in, const uint8_t *key,
+                   uint8_t *out, int nblocks, int nthreads) {
+    aes256_ctx_t ctx = {.impl = current_impl()};
+    expand_key(&ctx, key, 0);
+    threadpool_t *pool = oneshot_pool(nthreads);
+    aes256_ctx_ctr_mt(&ctx, init_ctr, in, out, nblocks, pool);
+    threadpool_destroy(pool);
+}
+
+// Many messages, each under its own key, without expanding the keys one
+// at a time or waiting on one message to finish before starting the
+// next. Messages of a single block still have up to BATCH_LANES blocks
+// in flight. The output is the same as running each job through the
+// one-shot functions above
+void aes256_batch_enc_ecb(const aes256_job_t *jobs, int njobs) {
+    run_batch(BATCH_ENC_ECB, jobs, njobs);
+}
+
+void aes256_batch_dec_ecb(const aes256_job_t *jobs, int njobs) {
+    run_batch(BATCH_DEC_ECB, jobs, njobs);
+}
+
+void aes256_batch_enc_cbc(const aes256_job_t *jobs, int njobs) {
+    run_batch(BATCH_ENC_CBC, jobs, njobs);
+}
+
+void aes256_batch_dec_cbc(const aes256_job_t *jobs, int njobs) {
+    run_batch(BATCH_DEC_CBC, jobs, njobs);
+}
+
+void aes256_batch_ctr(const aes256_job_t *jobs, int njobs) {
+    run_batch(BATCH_CTR, jobs, njobs);
+}
+
+void get_fwd_table_entry(int table_num, uint8_t idx, uint8_t *out) {
+    uint8_t b1 = s_box_replace(idx);
+    uint8_t b2 = xtime(b1);
+    // {03}.b = ({01} ^ {02}).b = b ^ {02}.b
+    uint8_t b3 = b1 ^ b2;
+
+    uint8_t entries[] = {b2, b1, b1, b3};
+    *out++ = entries[(4 - table_num) % 4];
+    *out++ = entries[(5 - table_num) % 4];
+    *out++ = entries[(6 - table_num) % 4];
+    *out   = entries[(7 - table_num) % 4];
+}
+
+void get_inv_table_entry(int table_num, uint8_t idx, uint8_t *out) {
+    uint8_t b = inv_s_box_replace(idx);
+    uint8_t xb = xtime(b); // x.b = {02}.b
+    uint8_t x2b = xtime(xb); // x^2.b = {04}.b
+    uint8_t x3b = xtime(x2b); // x^3.b = {08}.b
+
+    // {0e}.b = ({02} ^ {04} ^ {08}).b = {02}.b ^ {04}.b ^ {08}.b
+    uint8_t x321b = xb ^ x2b ^ x3b;
+    // {0b}.b = ({01} ^ {02} ^ {08}).b = b ^ {02}.b ^ {08}.b
+    uint8_t x310b = b ^ xb ^ x3b;
+    // {0d}.b = ({01} ^ {04} ^ {08}).b = b ^ {04}.b ^ {08}.b
+    uint8_t x320b = b ^ x2b ^ x3b;
+    // {09}.b = ({01} ^ {08}).b        = b ^ {08}.b
+    uint8_t x30b = b ^ x3b;
+
+    uint8_t entries[] = {x321b, x30b, x320b, x310b};
+    *out++ = entries[(4 - table_num) % 4];
+    *out++ = entries[(5 - table_num) % 4];
+    *out++ = entries[(6 - table_num) % 4];
+    *out   = entries[(7 - table_num) % 4];
+}
+
+// For the last-round tables, which have no MixColumns to bake in
+uint8_t get_fwd_sbox_entry(uint8_t idx) {
+    return s_box_replace(idx);
+}
+
+uint8_t get_inv_sbox_entry(uint8_t idx) {
+    return inv_s_box_replace(idx);
+}
+
+// The one-shot _mt functions start a pool for just the one call. We
+// skip it for a single thread, and fall back on the serial code if we
+// cannot get one
+static threadpool_t *oneshot_pool(int nthreads) {
+    return nthreads > 1? threadpool_create(nthreads, 0) : NULL;
+}
+
+static void enc_ecb_range(void *arg, int first_block, int nblocks) {
+    const mt_job_t *job = arg;
+    size_t offset = (size_t)first_block * (4 * Nb);
+
+    enc_ecb_blocks(job->impl, job->in + offset, job->round_keys,
+                   job->out + offset, nblocks);
+}
+
+static void dec_ecb_range(void *arg, int first_block, int nblocks) {
+    const mt_job_t *job = arg;
+    size_t offset = (size_t)first_block * (4 * Nb);
+
+    dec_ecb_blocks(job->impl, job->in + offset, job->round_keys,
+                   job->out + offset, nblocks);
+}
+
+static void dec_cbc_range(void *arg, int first_block, int nblocks) {
+    const mt_job_t *job = arg;
+    size_t offset = (size_t)first_block * (4 * Nb);
+    // Every range except the first picks up where the previous one left
+    // off, so its IV is the ciphertext block right before it
+    const uint8_t *iv = job->iv;
+    if (first_block && job->range_ivs) {
+        iv = job->range_ivs + (first_block / MT_GRAIN - 1) * (4 * Nb);
+    } else if (first_block) {
+        iv = job->in + offset - (Nb * 4);
+    }
+
+    dec_cbc_blocks(job->impl, iv, job->in + offset, job->round_keys,
+                   job->out + offset, nblocks);
+}
+
+static void ctr_range(void *arg, int first_block, int nblocks) {
+    const mt_job_t *job = arg;
+    // Past 2 GiB the byte offset no longer fits in an int
+    size_t offset = (size_t)first_block * (4 * Nb);
+    uint8_t ctr[4 * Nb];
+
+    // Seek to the counter the serial version would use for our first
+    // block
+    copy_state(ctr, job->iv);
+    increment_big_128bit(ctr, first_block);
+    ctr_blocks(job->impl, ctr, job->in + offset, job->round_keys,
+               job->out + offset, nblocks);
+}
+
+// Keep up to CHUNK_BLOCKS streams going at once, starting the next one
+// as soon as a stream runs out of blocks. Each step XORs the next block
+// of every stream with its IV, encrypts them all with one enc_ecb call,
+// and makes the results the new IVs
+static void enc_cbc_streams(const aes256_impl_t *cur, const uint32_t *round_keys,
+                            aes256_cbc_stream_t *streams, int nstreams) {
+    aes256_cbc_stream_t *active[CHUNK_BLOCKS];
+    int next_block[CHUNK_BLOCKS];
+    int nactive = 0, next_stream = 0;
+
+    for (;;) {
+        while (nactive < CHUNK_BLOCKS && next_stream < nstreams) {
+            aes256_cbc_stream_t *stream = &streams[next_stream++];
+            if (stream->nblocks > 0) {
+                active[nactive] = stream;
+                next_block[nactive++] = 0;
+            }
+        }
+
+        if (!nactive) {
+            break;
+        }
+
+        uint8_t blocks[CHUNK_BLOCKS][4 * Nb];
+        for (int i = 0; i < nactive; i++) {
+            copy_state(blocks[i], active[i]->in + (size_t)next_block[i] * (4 * Nb));
+            add_round_key(blocks[i], (const uint32_t *)active[i]->iv);
+        }
+
+        cur->enc_ecb(blocks[0], round_keys, blocks[0], nactive);
+
+        // Hand back the results and drop finished streams, keeping the
+        // rest at the front so they stay contiguous for enc_ecb
+        int still_active = 0;
+        for (int i = 0; i < nactive; i++) {
+            copy_state(active[i]->out + (size_t)next_block[i] * (4 * Nb), blocks[i]);
+            copy_state(active[i]->iv, blocks[i]);
+
+            if (++next_block[i] < active[i]->nblocks) {
+                active[still_active] = active[i];
+                next_block[still_active++] = next_block[i];
+            }
+        }
+        nactive = still_active;
+    }
+}
+
+// Work through jobs BATCH_LANES at a time, starting the next job in a
+// lane as soon as the one in it is done. Each step gathers one input
+// block per lane, runs them all through the lanes kernel of the
+// implementation in use, and then does the chaining for each lane
+static void run_batch(batch_mode_t mode, const aes256_job_t *jobs, int njobs) {
+    const aes256_impl_t *cur = current_impl();
+    int dec = mode == BATCH_DEC_ECB || mode == BATCH_DEC_CBC;
+    lanes_fn_t *lanes = dec? cur->dec_lanes : cur->enc_lanes;
+    batch_t batch;
+    int next_job = 0;
+
+    // Borrowing the T-table kernels would bring back the key- and
+    // data-dependent lookups that bitslice and vperm are there to avoid,
+    // so without kernels of its own an implementation takes the jobs one
+    // at a time through its single-key functions
+    if (!lanes) {
+        for (int j = 0; j < njobs; j++) {
+            if (jobs[j].nblocks > 0) {
+                run_job(cur, mode, &jobs[j], 0, jobs[j].iv);
+            }
+        }
+        return;
+    }
+
+    // Idle lanes still go through the kernel, on zeroes
+    memset(&batch, 0, sizeof batch);
+
+    for (;;) {
+        const uint8_t *new_keys[BATCH_LANES] = {0};
+        int nactive = 0;
+
+        for (int l = 0; l < BATCH_LANES; l++) {
+            while (!batch.jobs[l] && next_job < njobs) {
+                const aes256_job_t *job = &jobs[next_job++];
+                if (job->nblocks <= 0) {
+                    continue;
+                }
+
+                batch.jobs[l] = job;
+                batch.next_block[l] = 0;
+                new_keys[l] = job->key;
+                if (mode != BATCH_ENC_ECB && mode != BATCH_DEC_ECB) {
+                    copy_state(batch.chain[l], job->iv);
+                }
+            }
+            nactive += batch.jobs[l] != NULL;
+        }
+
+        if (!nactive) {
+            break;
+        }
+        lanes_key_exp(cur, new_keys, batch.round_keys, dec);
+
+        // Once no jobs are left to start, lanes only go idle from here.
+        // When most of them have, the single-key code does better on
+        // what is left, since it can interleave blocks of the same job,
+        // except in CBC encryption where every block waits on the last
+        if (next_job == njobs && nactive < BATCH_LANES / 2 && mode != BATCH_ENC_CBC) {
+            for (int l = 0; l < BATCH_LANES; l++) {
+                if (batch.jobs[l]) {
+                    run_job(cur, mode, batch.jobs[l], batch.next_block[l],
+                            batch.chain[l]);
+                }
+            }
+            break;
+        }
+
+        uint8_t in[BATCH_LANES][4 * Nb] = {{0}};
+        uint8_t out[BATCH_LANES][4 * Nb];
+
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (!batch.jobs[l]) {
+                continue;
+            }
+
+            const uint8_t *in_block = batch.jobs[l]->in + (size_t)batch.next_block[l] * (4 * Nb);
+            if (mode == BATCH_CTR) {
+                copy_state(in[l], batch.chain[l]);
+            } else {
+                copy_state(in[l], in_block);
+                if (mode == BATCH_ENC_CBC) {
+                    add_round_key(in[l], (const uint32_t *)batch.chain[l]);
+                }
+            }
+        }
+
+        lanes(in[0], batch.round_keys[0][0], out[0]);
+
+        for (int l = 0; l < BATCH_LANES; l++) {
+            const aes256_job_t *job = batch.jobs[l];
+            if (!job) {
+                continue;
+            }
+
+            size_t offset = (size_t)batch.next_block[l] * (4 * Nb);
+            switch (mode) {
+                case BATCH_ENC_CBC:
+                    copy_state(batch.chain[l], out[l]);
+                    break;
+
+                case BATCH_DEC_CBC:
+                    add_round_key(out[l], (const uint32_t *)batch.chain[l]);
+                    // in[l] is a copy, in case the job is in place
+                    copy_state(batch.chain[l], in[l]);
+                    break;
+
+                case BATCH_CTR:
+                    add_round_key(out[l], (const uint32_t *)(job->in + offset));
+                    increment_big_128bit(batch.chain[l], 1);
+                    break;
+
+                default:
+                    break;
+            }
+            copy_state(job->out + offset, out[l]);
+
+            if (++batch.next_block[l] == job->nblocks) {
+                batch.jobs[l] = NULL;
+            }
+        }
+    }
+
+    wipe(&batch, sizeof batch);
+}
+
+// job from block first_block on through the single-key functions, with
+// chain as the IV for CBC or the counter for CTR, which means expanding
+// its key again in the layout cur wants
+static void run_job(const aes256_impl_t *cur, batch_mode_t mode, const aes256_job_t *job,
+                    int first_block, const uint8_t *chain) {
+    size_t offset = (size_t)first_block * (4 * Nb);
+    int nblocks = job->nblocks - first_block;
+    aes256_ctx_t ctx = {.impl = cur};
+
+    expand_key(&ctx, job->key, mode == BATCH_DEC_ECB || mode == BATCH_DEC_CBC);
+    switch (mode) {
+        case BATCH_ENC_ECB:
+            aes256_ctx_enc_ecb(&ctx, job->in + offset, job->out + offset, nblocks);
+            break;
+
+        case BATCH_DEC_ECB:
+            aes256_ctx_dec_ecb(&ctx, job->in + offset, job->out + offset, nblocks);
+            break;
+
+        case BATCH_ENC_CBC:
+            aes256_ctx_enc_cbc(&ctx, chain, job->in + offset, job->out + offset, nblocks);
+            break;
+
+        case BATCH_DEC_CBC:
+            aes256_ctx_dec_cbc(&ctx, chain, job->in + offset, job->out + offset, nblocks);
+            break;
+
+        case BATCH_CTR:
+            aes256_ctx_ctr(&ctx, chain, job->in + offset, job->out + offset, nblocks);
+            break;
+    }
+}
+
+// Registered and runnable on this machine, or for "fastest", the
+// fastest one that is
+static const aes256_impl_t *find_impl(const char *name) {
+    if (!strcmp(name, "fastest")) {
+        return fastest_impl();
+    }
+
+    for (int i = 0; i < NUM_IMPLS; i++) {
+        if (!strcmp(impls[i].name, name)) {
+            return impl_available(&impls[i])? &impls[i] : NULL;
+        }
+    }
+
+    return NULL;
+}
+
+static int impl_available(const aes256_impl_t *candidate) {
+    return !candidate->available || candidate->available();
+}
+
+// Every context gets its implementation from here, so the first call
+// (always before any worker threads exist) settles which implementation
+// we use
+static const aes256_impl_t *current_impl(void) {
+    pthread_once(&impl_once, pick_impl);
+    return impl;
+}
+
+// Unless aes256_set_impl() got here first, use $AES256_IMPL if set, and
+// otherwise the first one in impls this machine can run. That order
+// goes from hardware AES through vector permutes to the T-tables, which
+// is fastest first for any build with optimization. Timing them all
+// instead (see fastest_impl()) would cost every run a few milliseconds
+// and fill in every table LAZYTABLES leaves for later
+static void pick_impl(void) {
+    if (impl) {
+        return;
+    }
+
+    const char *name = getenv("AES256_IMPL");
+    if (name && name[0]) {
+        if ((impl = find_impl(name))) {
+            return;
+        }
+        fprintf(stderr, "AES256_IMPL=%s is not available here, ignoring it\n", name);
+    }
+
+    for (int i = 0; i < NUM_IMPLS && !impl; i++) {
+        if (impl_available(&impls[i])) {
+            impl = &impls[i];
+        }
+    }
+}
+
+// Time every implementation on a few blocks and return the fastest,
+// which depends on the compiler flags: vperm is several times faster
+// than the T-tables at -O2, but all those intrinsics suffer more than
+// table lookups do at -O0
+static const aes256_impl_t *fastest_impl(void) {
+    const aes256_impl_t *fastest = NULL;
+    double best = 0;
+
+    for (int i = 0; i < NUM_IMPLS; i++) {
+        if (!impl_available(&impls[i])) {
+            continue;
+        }
+
+        double elapsed = time_enc_ecb(&impls[i]);
+        if (!fastest || elapsed < best) {
+            fastest = &impls[i];
+            best = elapsed;
+        }
+    }
+
+    return fastest;
+}
+
+// Best of a few runs of candidate's ECB encryption on some zeroes, in
+// seconds
+static double time_enc_ecb(const aes256_impl_t *candidate) {
+    static const uint32_t key[Nk];
+    uint32_t round_keys[Nb * (Nr + 1)];
+    uint8_t blocks[64][4 * Nb] = {{0}};
+    double best = 0;
+
+    candidate->key_exp((const uint8_t *)key, round_keys, 0);
+
+    for (int run = 0; run < 3; run++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        candidate->enc_ecb(blocks[0], round_keys, blocks[0], 64);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        if (!run || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+// Fill in the forward or inverse key schedule of ctx with the key
+// expansion of its implementation
+static void expand_key(aes256_ctx_t *ctx, const uint8_t *key, int inv_mix_cols) {
+    ctx->impl->key_exp(key, inv_mix_cols? ctx->inv_round_keys : ctx->round_keys,
+                       inv_mix_cols);
+}
+
+static void enc_ecb_blocks(const aes256_impl_t *cur, const uint8_t *in,
+                           const uint32_t *round_keys, uint8_t *out, int nblocks) {
+    cur->enc_ecb(in, round_keys, out, nblocks);
+}
+
+static void dec_ecb_blocks(const aes256_impl_t *cur, const uint8_t *in,
+                           const uint32_t *round_keys, uint8_t *out, int nblocks) {
+    cur->dec_ecb(in, round_keys, out, nblocks);
+}
+
+static void enc_cbc_blocks(const aes256_impl_t *cur, const uint8_t *iv,
+                           const uint8_t *in, const uint32_t *round_keys, uint8_t *out,
+                           int nblocks) {
+    if (cur->enc_cbc) {
+        cur->enc_cbc(iv, in, round_keys, out, nblocks);
+    } else {
+        ecb_enc_cbc(cur->enc_ecb, iv, in, round_keys, out, nblocks);
+    }
+}
+
+static void dec_cbc_blocks(const aes256_impl_t *cur, const uint8_t *iv,
+                           const uint8_t *in, const uint32_t *round_keys, uint8_t *out,
+                           int nblocks) {
+    if (cur->dec_cbc) {
+        cur->dec_cbc(iv, in, round_keys, out, nblocks);
+    } else {
+        ecb_dec_cbc(cur->dec_ecb, iv, in, round_keys, out, nblocks);
+    }
+}
+
+static void ctr_blocks(const aes256_impl_t *cur, const uint8_t *init_ctr,
+                       const uint8_t *in, const uint32_t *round_keys, uint8_t *out,
+                       int nblocks) {
+    if (cur->ctr) {
+        cur->ctr(init_ctr, in, round_keys, out, nblocks);
+    } else {
+        ecb_ctr(cur->enc_ecb, init_ctr, in, round_keys, out, nblocks);
+    }
+}
+
+// CBC encryption on top of enc_ecb. Every block depends on the
+// ciphertext block before it, so this goes one block at a time
+static void ecb_enc_cbc(ecb_fn_t *enc_ecb, const uint8_t *iv, const uint8_t *in,
+                        const uint32_t *round_keys, uint8_t *out, int nblocks) {
+    const uint8_t *next_iv = iv;
+
+    for (int b = 0; b < nblocks; b++) {
+        uint8_t block[4 * Nb];
+        copy_state(block, in + (size_t)b * (4 * Nb));
+        add_round_key(block, (const uint32_t *)next_iv);
+        enc_ecb(block, round_keys, out + (size_t)b * (4 * Nb), 1);
+        next_iv = out + (size_t)b * (4 * Nb);
+    }
+}
+
+// CBC decryption on top of dec_ecb. Unlike encryption, every block only
+// depends on ciphertext we already have, so we can decrypt a whole
+// chunk at a time and do the CBC XORs afterwards. The XORs need the
+// ciphertext, so copy each chunk out first in case in == out
+static void ecb_dec_cbc(ecb_fn_t *dec_ecb, const uint8_t *iv, const uint8_t *in,
+                        const uint32_t *round_keys, uint8_t *out, int nblocks) {
+    uint8_t next_iv[4 * Nb];
+    copy_state(next_iv, iv);
+
+    for (int b = 0; b < nblocks; b += CHUNK_BLOCKS) {
+        int chunk = CHUNK(nblocks - b);
+        uint8_t ciphertext[CHUNK_BLOCKS][4 * Nb];
+        memcpy(ciphertext, in + (size_t)b * (4 * Nb), Nb * 4 * chunk);
+
+        dec_ecb(ciphertext[0], round_keys, out + (size_t)b * (4 * Nb), chunk);
+        for (int i = 0; i < chunk; i++) {
+            add_round_key(out + (size_t)(b + i) * (4 * Nb), (const uint32_t *)next_iv);
+            copy_state(next_iv, ciphertext[i]);
+        }
+    }
+}
+
+// CTR on top of enc_ecb: encrypt a chunk of counters at once, then XOR
+// the keystream into the input
+static void ecb_ctr(ecb_fn_t *enc_ecb, const uint8_t *init_ctr, const uint8_t *in,
+                    const uint32_t *round_keys, uint8_t *out, int nblocks) {
+    uint8_t ctr[4 * Nb];
+    copy_state(ctr, init_ctr);
+
+    for (int b = 0; b < nblocks; b += CHUNK_BLOCKS) {
+        int chunk = CHUNK(nblocks - b);
+        uint8_t keystream[CHUNK_BLOCKS][4 * Nb];
+        for (int i = 0; i < chunk; i++) {
+            copy_state(keystream[i], ctr);
+            increment_big_128bit(ctr, 1);
+        }
+
+        enc_ecb(keystream[0], round_keys, keystream[0], chunk);
+
+        for (int i = 0; i < chunk; i++) {
+            uint8_t *out_block = out + (size_t)(b + i) * (4 * Nb);
+            copy_state(out_block, in + (size_t)(b + i) * (4 * Nb));
+            add_round_key(out_block, (const uint32_t *)keystream[i]);
+        }
+    }
+}
+
+// The thread behind an aes256_keystream_t. It tops the ring up a chunk
+// at a time, whenever at least a chunk of it is free, encrypting the
+// counters in place
+static void *keystream_main(void *arg) {
+    aes256_keystream_t *ks = arg;
+    uint64_t nblocks = ks->nblocks;
+    uint64_t refill = nblocks < CHUNK_BLOCKS? nblocks : CHUNK_BLOCKS;
+
+    pthread_mutex_lock(&ks->lock);
+    for (;;) {
+        uint64_t first;
+        while (!ks->shutdown
+               && ks->tail + nblocks - (first = ks->head > ks->tail? ks->head : ks->tail) < refill) {
+            pthread_cond_wait(&ks->room, &ks->lock);
+        }
+        if (ks->shutdown) {
+            break;
+        }
+
+        // Up to a chunk, without wrapping around the end of the ring
+        uint64_t n = ks->tail + nblocks - first;
+        n = n < CHUNK_BLOCKS? n : CHUNK_BLOCKS;
+        n = n < nblocks - first % nblocks? n : nblocks - first % nblocks;
+        pthread_mutex_unlock(&ks->lock);
+
+        uint8_t (*blocks)[4 * Nb] = ks->ring + first % nblocks;
+        uint8_t ctr[4 * Nb];
+        copy_state(ctr, ks->init_ctr);
+        increment_big_128bit(ctr, first);
+        for (uint64_t i = 0; i < n; i++) {
+            copy_state(blocks[i], ctr);
+            increment_big_128bit(ctr, 1);
+        }
+        enc_ecb_blocks(ks->ctx.impl, blocks[0], ks->ctx.round_keys, blocks[0], n);
+
+        pthread_mutex_lock(&ks->lock);
+        ks->head = first + n;
+    }
+    pthread_mutex_unlock(&ks->lock);
+
+    return NULL;
+}
+
+// CTR on len bytes starting offset bytes into block block of the
+// message. Whole blocks go through ctr_blocks() in one go, and partial
+// ones at either end get a block of keystream of their own
+static void ctr_bytes(const aes256_ctx_t *ctx, const uint8_t *init_ctr, uint64_t block,
+                      int offset, const uint8_t *in, uint8_t *out, int len) {
+    uint8_t ctr[4 * Nb];
+    copy_state(ctr, init_ctr);
+    increment_big_128bit(ctr, block);
+
+    while (len) {
+        int whole = offset? 0 : len / (4 * Nb);
+
+        if (whole) {
+            ctr_blocks(ctx->impl, ctr, in, ctx->round_keys, out, whole);
+            increment_big_128bit(ctr, whole);
+            whole *= 4 * Nb;
+        } else {
+            uint8_t keystream[4 * Nb];
+            enc_ecb_blocks(ctx->impl, ctr, ctx->round_keys, keystream, 1);
+            increment_big_128bit(ctr, 1);
+            whole = len < 4 * Nb - offset? len : 4 * Nb - offset;
+            xor_bytes(out, in, keystream + offset, whole);
+            offset = 0;
+        }
+
+        in += whole;
+        out += whole;
+        len -= whole;
+    }
+}
+
+static inline void xor_bytes(uint8_t *out, const uint8_t *in, const uint8_t *keystream,
+                             int len) {
+    for (int i = 0; i < len; i++) {
+        out[i] = in[i] ^ keystream[i];
+    }
+}
+
+// Whole blocks of ECB or CBC for aes256_stream_update(), carrying the
+// CBC chain on to the next call
+static void stream_blocks(aes256_stream_t *st, const uint8_t *in, uint8_t *out,
+                          int nblocks) {
+    switch (st->mode) {
+        case STREAM_ENC_ECB:
+            aes256_ctx_enc_ecb_mt(&st->ctx, in, out, nblocks, st->pool);
+            break;
+
+        case STREAM_DEC_ECB:
+            aes256_ctx_dec_ecb_mt(&st->ctx, in, out, nblocks, st->pool);
+            break;
+
+        case STREAM_ENC_CBC:
+            enc_cbc_blocks(st->ctx.impl, st->chain, in, st->ctx.round_keys, out, nblocks);
+            copy_state(st->chain, out + (nblocks - 1) * (4 * Nb));
+            break;
+
+        case STREAM_DEC_CBC: {
+            // Keep the last ciphertext block before it gets decrypted, in
+            // case in == out
+            uint8_t next_chain[4 * Nb];
+            copy_state(next_chain, in + (nblocks - 1) * (4 * Nb));
+            aes256_ctx_dec_cbc_mt(&st->ctx, st->chain, in, out, nblocks, st->pool);
+            copy_state(st->chain, next_chain);
+            break;
+        }
+
+        case STREAM_CTR:
+            break;
+    }
+}
+
+// CTR for aes256_stream_update(): the rest of the last block of
+// keystream first, then whole blocks, then a new block of keystream
+// for whatever is left, keeping the rest of it for next time
+static int stream_ctr(aes256_stream_t *st, const uint8_t *in, uint8_t *out, int len) {
+    int done = 0;
+    for (; st->used < 4 * Nb && done < len; st->used++, done++) {
+        out[done] = in[done] ^ st->keystream[st->used];
+    }
+
+    int nblocks = (len - done) / (4 * Nb);
+    if (nblocks) {
+        aes256_ctx_ctr_mt(&st->ctx, st->chain, in + done, out + done, nblocks, st->pool);
+        increment_big_128bit(st->chain, nblocks);
+        done += nblocks * (4 * Nb);
+    }
+
+    if (done < len) {
+        enc_ecb_blocks(st->ctx.impl, st->chain, st->ctx.round_keys, st->keystream, 1);
+        increment_big_128bit(st->chain, 1);
+        st->used = 0;
+        for (; done < len; st->used++, done++) {
+            out[done] = in[done] ^ st->keystream[st->used];
+        }
+    }
+
+    return len;
+}
+
+// Zero-pad len bytes of in (or nothing, for NULL) out to a whole seed,
+// which is all that CTR_DRBG without a derivation function does with
+// additional input. Returns -1 if it does not fit
+static int drbg_pad(uint8_t *padded, const uint8_t *in, int len) {
+    if (len < 0 || len > DRBG_SEED_SIZE || (len && !in)) {
+        return -1;
+    }
+
+    memset(padded, 0, DRBG_SEED_SIZE);
+    if (len) {
+        memcpy(padded, in, len);
+    }
+    return 0;
+}
+
+static int drbg_entropy(uint8_t *seed) {
+    FILE *f;
+    if (!(f = fopen("/dev/urandom", "r"))) {
+        return -1;
+    }
+
+    size_t got = fread(seed, 1, DRBG_SEED_SIZE, f);
+    fclose(f);
+    return got == DRBG_SEED_SIZE? 0 : -1;
+}
+
+// One generate request of up to DRBG_MAX_REQUEST bytes (SP 800-90A,
+// Section 10.2.1.5.1). The output is the keystream of CTR from V + 1,
+// so it goes through ctr_blocks() over zeroes, and then the key and V
+// move on, with add (if not NULL) mixed in before and after
+static void drbg_request(aes256_drbg_t *drbg, uint8_t *out, int len, const uint8_t *add) {
+    static const uint8_t zeroes[DRBG_SEED_SIZE];
+    if (add) {
+        drbg_update(drbg, add);
+    }
+
+    int nblocks = len / (4 * Nb);
+    int rem = len % (4 * Nb);
+    uint8_t ctr[4 * Nb];
+    copy_state(ctr, drbg->v);
+    increment_big_128bit(ctr, 1);
+
+    if (nblocks) {
+        memset(out, 0, nblocks * (4 * Nb));
+        ctr_blocks(drbg->ctx.impl, ctr, out, drbg->ctx.round_keys, out, nblocks);
+        increment_big_128bit(drbg->v, nblocks);
+        increment_big_128bit(ctr, nblocks);
+    }
+    if (rem) {
+        uint8_t block[4 * Nb];
+        enc_ecb_blocks(drbg->ctx.impl, ctr, drbg->ctx.round_keys, block, 1);
+        increment_big_128bit(drbg->v, 1);
+        memcpy(out + nblocks * (4 * Nb), block, rem);
+        wipe(block, sizeof block);
+    }
+
+    drbg_update(drbg, add? add : zeroes);
+    drbg->reseed_counter++;
+}
+
+// CTR_DRBG_Update: the next DRBG_SEED_SIZE bytes of output, XORed with
+// data, become the new key and V
+static void drbg_update(aes256_drbg_t *drbg, const uint8_t *data) {
+    uint8_t temp[DRBG_SEED_SIZE];
+    uint8_t ctr[4 * Nb];
+    copy_state(ctr, drbg->v);
+    increment_big_128bit(ctr, 1);
+    ctr_blocks(drbg->ctx.impl, ctr, data, drbg->ctx.round_keys, temp,
+               DRBG_SEED_SIZE / (4 * Nb));
+
+    expand_key(&drbg->ctx, temp, 0);
+    copy_state(drbg->v, temp + 4 * Nk);
+    wipe(temp, sizeof temp);
+}
+
+static void drbg_key_init(void) {
+    pthread_key_create(&drbg_key, drbg_thread_free);
+}
+
+static void drbg_thread_free(void *drbg) {
+    aes256_drbg_free(drbg);
+}
+
+// memset() that the compiler cannot leave out for memory that is about
+// to go away
+static void wipe(void *buf, size_t len) {
+    volatile uint8_t *bytes = buf;
+    for (size_t i = 0; i < len; i++) {
+        bytes[i] = 0;
+    }
+}
+
+// RFC 4493 derives K1 and K2 from the encryption of the zero block, so
+// they are as much a part of the key as the schedule, and get worked
+// out once per key along with it
+static void cmac_subkeys(aes256_ctx_t *ctx) {
+    uint8_t l[4 * Nb] = {0};
+    enc_ecb_blocks(ctx->impl, l, ctx->round_keys, l, 1);
+    cmac_double(ctx->cmac_k1, l);
+    cmac_double(ctx->cmac_k2, ctx->cmac_k1);
+}
+
+// Multiply by x in GF(2^128), big endian this time: a 128-bit shift
+// left, reducing by x^128 + x^7 + x^2 + x + 1
+static inline void cmac_double(uint8_t *out, const uint8_t *in) {
+    uint8_t carry = in[0] >> 7;
 
-    aes256_key_exp((const uint32_t *)key, round_keys, 0);
+    for (int i = 0; i < 4 * Nb - 1; i++) {
+        out[i] = (in[i] << 1) | (in[i + 1] >> 7);
+    }
+    out[4 * Nb - 1] = (in[4 * Nb - 1] << 1) ^ (carry? 0x87 : 0);
+}
 
-    for (int b = 0; b < nblocks; b++) {
-        aes256_cipher(NULL, NULL, in + (Nb * 4 * b), out + (Nb * 4 * b), round_keys);
+// CMAC is CBC encryption with a zero IV, keeping only the last block,
+// which gets K1 or K2 mixed in first. Short messages, which is most of
+// them, get copied to the stack with the last block ready and
+// encrypted with a single call, so the only per-message work is
+// len / 16 + 1 block encryptions. Longer ones run all but the last
+// block through the CBC code a chunk at a time
+static void cmac(const aes256_ctx_t *ctx, const uint8_t *in, int len, uint8_t *mac) {
+    static const uint8_t zero_iv[4 * Nb];
+    const aes256_impl_t *cur = ctx->impl;
+    int nblocks = CMAC_BLOCKS(len);
+    int last = Nb * 4 * (nblocks - 1);
+
+    if (nblocks <= CMAC_FAST_BLOCKS) {
+        uint8_t blocks[CMAC_FAST_BLOCKS][4 * Nb];
+        if (last) {
+            memcpy(blocks, in, last);
+        }
+        cmac_last_block(ctx, in + last, len - last, blocks[nblocks - 1]);
+        enc_cbc_blocks(cur, zero_iv, blocks[0], ctx->round_keys, blocks[0], nblocks);
+        copy_state(mac, blocks[nblocks - 1]);
+        return;
+    }
+
+    uint8_t chain[4 * Nb] = {0};
+    for (int b = 0; b < nblocks - 1; b += CHUNK_BLOCKS) {
+        int chunk = CHUNK(nblocks - 1 - b);
+        uint8_t out[CHUNK_BLOCKS][4 * Nb];
+        enc_cbc_blocks(cur, chain, in + (Nb * 4 * b), ctx->round_keys, out[0], chunk);
+        copy_state(chain, out[chunk - 1]);
     }
+
+    uint8_t block[4 * Nb];
+    cmac_last_block(ctx, in + last, len - last, block);
+    enc_cbc_blocks(cur, chain, block, ctx->round_keys, mac, 1);
 }
 
-void aes256_dec_ecb(const uint8_t *in, const uint8_t *key, uint8_t *out, int nblocks) {
-    uint32_t round_keys[Nb * (Nr + 1)];
+// The CBC state of each message is its mac, which starts out as zeroes
+static void cmac_batch(const aes256_ctx_t *ctx, aes256_cmac_msg_t *msgs, int nmsgs) {
+    aes256_cmac_msg_t *active[CHUNK_BLOCKS];
+    int next_block[CHUNK_BLOCKS];
+    int nactive = 0, next_msg = 0;
+
+    for (;;) {
+        while (nactive < CHUNK_BLOCKS && next_msg < nmsgs) {
+            aes256_cmac_msg_t *msg = &msgs[next_msg++];
+            memset(msg->mac, 0, sizeof msg->mac);
+            active[nactive] = msg;
+            next_block[nactive++] = 0;
+        }
 
-    aes256_key_exp((const uint32_t *)key, round_keys, 1);
+        if (!nactive) {
+            break;
+        }
 
-    for (int b = 0; b < nblocks; b++) {
-        aes256_inv_cipher(NULL, in + (Nb * 4 * b), out + (Nb * 4 * b), round_keys);
+        uint8_t blocks[CHUNK_BLOCKS][4 * Nb];
+        for (int i = 0; i < nactive; i++) {
+            size_t offset = (size_t)next_block[i] * (4 * Nb);
+            if (next_block[i] == CMAC_BLOCKS(active[i]->len) - 1) {
+                cmac_last_block(ctx, active[i]->in + offset, active[i]->len - offset,
+                                blocks[i]);
+            } else {
+                copy_state(blocks[i], active[i]->in + offset);
+            }
+            add_round_key(blocks[i], (const uint32_t *)active[i]->mac);
+        }
+
+        ctx->impl->enc_ecb(blocks[0], ctx->round_keys, blocks[0], nactive);
+
+        // Drop finished messages, keeping the rest at the front so they
+        // stay contiguous for enc_ecb
+        int still_active = 0;
+        for (int i = 0; i < nactive; i++) {
+            copy_state(active[i]->mac, blocks[i]);
+
+            if (++next_block[i] < CMAC_BLOCKS(active[i]->len)) {
+                active[still_active] = active[i];
+                next_block[still_active++] = next_block[i];
+            }
+        }
+        nactive = still_active;
     }
 }
 
-void aes256_enc_cbc(const uint8_t *iv, const uint8_t *in, const uint8_t *key,
-                    uint8_t *out, int nblocks) {
-    uint32_t round_keys[Nb * (Nr + 1)];
-
-    aes256_key_exp((const uint32_t *)key, round_keys, 0);
+// The last block of a CMAC message, given the len bytes left of it: a
+// whole block gets K1, and anything shorter (even nothing) gets padded
+// with a 1 bit and then zeroes, and K2
+static void cmac_last_block(const aes256_ctx_t *ctx, const uint8_t *in, int len,
+                            uint8_t *block) {
+    if (len == 4 * Nb) {
+        copy_state(block, in);
+        add_round_key(block, (const uint32_t *)ctx->cmac_k1);
+        return;
+    }
 
-    const uint8_t *next_iv = iv;
-    for (int b = 0; b < nblocks; b++) {
-        aes256_cipher(next_iv, NULL, in + (Nb * 4 * b), out + (Nb * 4 * b), round_keys);
-        next_iv = out + (Nb * 4 * b);
+    memset(block, 0, 4 * Nb);
+    if (len) {
+        memcpy(block, in, len);
     }
+    block[len] = 0x80;
+    add_round_key(block, (const uint32_t *)ctx->cmac_k2);
 }
 
-void aes256_dec_cbc(const uint8_t *iv, const uint8_t *in, const uint8_t *key,
-                    uint8_t *out, int nblocks) {
-    uint32_t round_keys[Nb * (Nr + 1)];
+// XTS over len bytes in data units of unit_size bytes, the data units
+// split between the threads of pool. Ranges of units cover about as
+// many blocks as the ranges of the other _mt modes
+static int xts(const aes256_ctx_t *ctx, const aes256_ctx_t *tweak_ctx, int dec,
+               const uint8_t *tweak, const uint8_t *in, uint8_t *out, int len,
+               int unit_size, threadpool_t *pool) {
+    // Ciphertext stealing needs a whole block to steal from, in every
+    // data unit up to and including a short last one
+    if (unit_size < 4 * Nb || len < 0
+            || (len % unit_size && len % unit_size < 4 * Nb)) {
+        return -1;
+    }
 
-    aes256_key_exp((const uint32_t *)key, round_keys, 1);
+    xts_job_t job = {.impl = ctx->impl, .tweak_impl = tweak_ctx->impl,
+                     .round_keys = dec? ctx->inv_round_keys : ctx->round_keys,
+                     .tweak_keys = tweak_ctx->round_keys, .tweak = tweak,
+                     .in = in, .out = out, .len = len, .unit_size = unit_size,
+                     .dec = dec};
+    int nunits = len / unit_size + (len % unit_size != 0);
+    // Data units past MT_GRAIN blocks get a range each
+    int unit_blocks = unit_size / (4 * Nb);
+    int grain = unit_blocks < MT_GRAIN? MT_GRAIN / unit_blocks : 1;
+
+    threadpool_parallel_for(pool, nunits, grain, xts_range, &job);
+    return 0;
+}
 
-    const uint8_t *next_iv = iv;
-    for (int b = 0; b < nblocks; b++) {
-        aes256_inv_cipher(next_iv, in + (Nb * 4 * b), out + (Nb * 4 * b), round_keys);
-        next_iv = in + (Nb * 4 * b);
+// Data unit u gets the initial tweak plus u, encrypted with the tweak
+// key
+static void xts_range(void *arg, int first_unit, int nunits) {
+    const xts_job_t *job = arg;
+
+    for (int u = first_unit; u < first_unit + nunits; u++) {
+        int offset = u * job->unit_size;
+        int unit_len = job->len - offset < job->unit_size? job->len - offset
+                                                          : job->unit_size;
+        uint8_t t[4 * Nb];
+
+        copy_state(t, job->tweak);
+        increment_little_128bit(t, u);
+        enc_ecb_blocks(job->tweak_impl, t, job->tweak_keys, t, 1);
+        xts_unit(job->impl, job->dec, job->round_keys, t, job->in + offset,
+                 job->out + offset, unit_len);
     }
 }
 
-void aes256_ctr(const uint8_t *init_ctr, const uint8_t *in, const uint8_t *key,
-                uint8_t *out, int nblocks) {
-    uint32_t round_keys[Nb * (Nr + 1)];
+// One data unit, starting from the encrypted tweak t. A partial block
+// at the end gets ciphertext stealing: the last whole block is
+// encrypted first, the partial block takes the start of its ciphertext,
+// and the rest pads out the partial block, which gets encrypted with the
+// next tweak and takes the whole block's place. Decryption has to undo
+// the second encryption first, so it uses the two tweaks the other way
+// around
+static void xts_unit(const aes256_impl_t *cur, int dec, const uint32_t *round_keys,
+                     uint8_t *t, const uint8_t *in, uint8_t *out, int len) {
+    ecb_fn_t *ecb = dec? cur->dec_ecb : cur->enc_ecb;
+    int rem = len % (4 * Nb);
+    int nblocks = len / (4 * Nb) - (rem != 0);
+
+    xts_blocks(ecb, round_keys, t, in, out, nblocks);
+    if (!rem) {
+        return;
+    }
 
-    aes256_key_exp((const uint32_t *)key, round_keys, 0);
+    const uint8_t *in_last = in + (Nb * 4 * nblocks);
+    uint8_t *out_last = out + (Nb * 4 * nblocks);
+    uint8_t t_next[4 * Nb];
+    copy_state(t_next, t);
+    xts_mul_alpha(t_next);
+
+    uint8_t whole[4 * Nb], stolen[4 * Nb];
+    xts_blocks(ecb, round_keys, dec? t_next : t, in_last, whole, 1);
+    // Read the partial block before overwriting it, in case in == out
+    memcpy(stolen, in_last + (4 * Nb), rem);
+    memcpy(stolen + rem, whole + rem, 4 * Nb - rem);
+    memcpy(out_last + (4 * Nb), whole, rem);
+    xts_blocks(ecb, round_keys, dec? t : t_next, stolen, out_last, 1);
+}
 
-    uint8_t ctr[4 * Nb];
-    copy_state(ctr, init_ctr);
-    for (int b = 0; b < nblocks; b++) {
-        aes256_cipher(NULL, in + (Nb * 4 * b), ctr, out + (Nb * 4 * b), round_keys);
-        increment_big_128bit((uint32_t *)ctr, 1);
+// XTS on whole blocks: XOR each block with its tweak before and after
+// the cipher, a chunk of blocks per ECB call. Leaves t at the tweak for
+// the block after the last
+static void xts_blocks(ecb_fn_t *ecb, const uint32_t *round_keys, uint8_t *t,
+                       const uint8_t *in, uint8_t *out, int nblocks) {
+    for (int b = 0; b < nblocks; b += CHUNK_BLOCKS) {
+        int chunk = CHUNK(nblocks - b);
+        uint8_t tweaks[CHUNK_BLOCKS][4 * Nb];
+        uint8_t blocks[CHUNK_BLOCKS][4 * Nb];
+
+        for (int i = 0; i < chunk; i++) {
+            copy_state(tweaks[i], t);
+            copy_state(blocks[i], in + (Nb * 4 * (b + i)));
+            add_round_key(blocks[i], (const uint32_t *)tweaks[i]);
+            xts_mul_alpha(t);
+        }
+
+        ecb(blocks[0], round_keys, blocks[0], chunk);
+
+        for (int i = 0; i < chunk; i++) {
+            uint8_t *out_block = out + (Nb * 4 * (b + i));
+            copy_state(out_block, blocks[i]);
+            add_round_key(out_block, (const uint32_t *)tweaks[i]);
+        }
     }
 }
 
-void get_fwd_table_entry(int table_num, uint8_t idx, uint8_t *out) {
-    uint8_t b1 = s_box_replace(idx);
-    uint8_t b2 = xtime(b1);
-    // {03}.b = ({01} ^ {02}).b = b ^ {02}.b
-    uint8_t b3 = b1 ^ b2;
+// Multiply a tweak by x in GF(2^128). Unlike GCM, XTS keeps its field
+// elements in little endian with the bits in the usual order, so this
+// is a 128-bit shift left, reducing by x^128 + x^7 + x^2 + x + 1
+static inline void xts_mul_alpha(uint8_t *t) {
+    uint8_t carry = t[4 * Nb - 1] >> 7;
 
-    uint8_t entries[] = {b2, b1, b1, b3};
-    *out++ = entries[(4 - table_num) % 4];
-    *out++ = entries[(5 - table_num) % 4];
-    *out++ = entries[(6 - table_num) % 4];
-    *out   = entries[(7 - table_num) % 4];
+    for (int i = 4 * Nb - 1; i > 0; i--) {
+        t[i] = (t[i] << 1) | (t[i - 1] >> 7);
+    }
+    t[0] = (t[0] << 1) ^ (carry? 0x87 : 0);
 }
 
-void get_inv_table_entry(int table_num, uint8_t idx, uint8_t *out) {
-    uint8_t b = inv_s_box_replace(idx);
-    uint8_t xb = xtime(b); // x.b = {02}.b
-    uint8_t x2b = xtime(xb); // x^2.b = {04}.b
-    uint8_t x3b = xtime(x2b); // x^3.b = {08}.b
+// GCM with the key schedule in ctx, leaving the tag for the AAD and the
+// ciphertext (out for encryption, in for decryption) in tag. Each chunk
+// gets hashed right after it is encrypted, or right before it is
+// decrypted, while it is still in L1, so this reads and writes the
+// message once instead of making a second pass over it for the hash.
+// Hashing first for decryption also keeps it working in place
+static void gcm(const aes256_ctx_t *ctx, int dec, const uint8_t *iv, int iv_len,
+                const uint8_t *aad, int aad_len, const uint8_t *in, uint8_t *out,
+                int len, uint8_t *tag) {
+    const aes256_impl_t *cur = ctx->impl;
+
+    // The hash subkey H is the encryption of the zero block
+    uint8_t h[4 * Nb] = {0};
+    enc_ecb_blocks(cur, h, ctx->round_keys, h, 1);
+    ghash_key_t ghash;
+    ghash_init(&ghash, h, cur->clmul);
+
+    // The pre-counter block J0. A GCM_IV_SIZE IV gets a 32-bit counter
+    // starting at 1 after it, and anything else gets hashed
+    uint8_t j0[4 * Nb] = {0};
+    if (iv_len == GCM_IV_SIZE) {
+        memcpy(j0, iv, GCM_IV_SIZE);
+        j0[4 * Nb - 1] = 1;
+    } else {
+        ghash_update(&ghash, j0, iv, iv_len);
+        ghash_lengths(&ghash, j0, 0, iv_len);
+    }
 
-    // {0e}.b = ({02} ^ {04} ^ {08}).b = {02}.b ^ {04}.b ^ {08}.b
-    uint8_t x321b = xb ^ x2b ^ x3b;
-    // {0b}.b = ({01} ^ {02} ^ {08}).b = b ^ {02}.b ^ {08}.b
-    uint8_t x310b = b ^ xb ^ x3b;
-    // {0d}.b = ({01} ^ {04} ^ {08}).b = b ^ {04}.b ^ {08}.b
-    uint8_t x320b = b ^ x2b ^ x3b;
-    // {09}.b = ({01} ^ {08}).b        = b ^ {08}.b
-    uint8_t x30b = b ^ x3b;
+    uint8_t y[4 * Nb] = {0};
+    ghash_update(&ghash, y, aad, aad_len);
 
-    uint8_t entries[] = {x321b, x30b, x320b, x310b};
-    *out++ = entries[(4 - table_num) % 4];
-    *out++ = entries[(5 - table_num) % 4];
-    *out++ = entries[(6 - table_num) % 4];
-    *out   = entries[(7 - table_num) % 4];
+    // The message itself starts at J0 + 1
+    uint8_t ctr[4 * Nb];
+    copy_state(ctr, j0);
+    increment_big_32bit(ctr, 1);
+
+    int nblocks = len / (Nb * 4);
+    for (int b = 0; b < nblocks; b += CHUNK_BLOCKS) {
+        int chunk = CHUNK(nblocks - b);
+        const uint8_t *in_chunk = in + (Nb * 4 * b);
+        uint8_t *out_chunk = out + (Nb * 4 * b);
+
+        if (dec) {
+            ghash_update(&ghash, y, in_chunk, Nb * 4 * chunk);
+        }
+        gcm_ctr_blocks(cur, ctr, in_chunk, ctx->round_keys, out_chunk, chunk);
+        if (!dec) {
+            ghash_update(&ghash, y, out_chunk, Nb * 4 * chunk);
+        }
+    }
+
+    // A partial last block uses the first few bytes of one more block of
+    // keystream
+    int rem = len % (Nb * 4);
+    if (rem) {
+        uint8_t block[4 * Nb] = {0};
+        memcpy(block, in + len - rem, rem);
+        if (dec) {
+            ghash_update(&ghash, y, block, rem);
+        }
+        gcm_ctr_blocks(cur, ctr, block, ctx->round_keys, block, 1);
+        memcpy(out + len - rem, block, rem);
+        if (!dec) {
+            ghash_update(&ghash, y, block, rem);
+        }
+    }
+
+    ghash_lengths(&ghash, y, aad_len, len);
+
+    // The tag is the hash encrypted with J0 as the counter
+    gcm_ctr_blocks(cur, j0, y, ctx->round_keys, tag, 1);
 }
 
-static inline uint32_t big_endian_add(uint32_t a, uint32_t b, int *overflow) {
-    uint8_t *bytes = (uint8_t *)(&a);
-    uint32_t native = (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8)
-                      | bytes[3];
-    uint32_t sum = native + b;
-    *overflow = sum < native;
-    uint8_t big_sum[4] = {(sum >> 24) & 0xff, (sum >> 16) & 0xff,
-                          (sum >> 8) & 0xff, sum & 0xff};
-    return *(uint32_t *)big_sum;
+// CTR for GCM, whose counter is only the last 32 bits of the counter
+// block, wrapping around without carrying into the rest. ctr_blocks()
+// carries, so stop it at the wraparound and start it again from zero.
+// With a GCM_IV_SIZE IV that never happens, since the counter starts
+// at 2 and an int of blocks is not enough to get to 2^32, but a hashed
+// IV can start it anywhere. Leaves ctr at the counter after the last
+// block
+static void gcm_ctr_blocks(const aes256_impl_t *cur, uint8_t *ctr, const uint8_t *in,
+                           const uint32_t *round_keys, uint8_t *out, int nblocks) {
+    while (nblocks > 0) {
+        uint32_t low = (uint32_t)ctr[12] << 24 | (uint32_t)ctr[13] << 16
+                       | (uint32_t)ctr[14] << 8 | ctr[15];
+        // 2^32 blocks to go if low is 0, which is more than we have
+        uint64_t until_wrap = ((uint64_t)1 << 32) - low;
+        int n = (uint64_t)nblocks < until_wrap? nblocks : (int)until_wrap;
+
+        ctr_blocks(cur, ctr, in, round_keys, out, n);
+        increment_big_32bit(ctr, n);
+        in += Nb * 4 * n;
+        out += Nb * 4 * n;
+        nblocks -= n;
+    }
 }
 
 // The CTR cipher mode puts us in a tough situation where we need to
 // add n to a 128-bit counter in big endian on a big or little endian
-// system. For convenience, use a 32-bit addend n. We will only overflow
-// that when our input hits 64GiB, which is far beyond what we plan to
-// use this implementation for.
-static void increment_big_128bit(uint32_t *limbs, uint32_t n) {
-    int overflow;
-    limbs[3] = big_endian_add(limbs[3], n, &overflow);
-    if (overflow) {
-        limbs[2] = big_endian_add(limbs[2], 1, &overflow);
-    } else {
-        return;
+// system. Add one byte at a time starting from the least significant
+// end and carry as we go. This handles any 64-bit n, which lets
+// aes256_ctr_mt() seek each thread straight to its first block
+static void increment_big_128bit(uint8_t *ctr, uint64_t n) {
+    unsigned int carry = 0;
+
+    for (int i = 4 * Nb - 1; i >= 0 && (n || carry); i--) {
+        unsigned int sum = ctr[i] + (n & 0xff) + carry;
+        ctr[i] = sum & 0xff;
+        carry = sum >> 8;
+        n >>= 8;
     }
-    if (overflow) {
-        limbs[1] = big_endian_add(limbs[1], 1, &overflow);
-    } else {
-        return;
+}
+
+// XTS numbers data units in little endian, so the other way around
+// from increment_big_128bit()
+static void increment_little_128bit(uint8_t *ctr, uint64_t n) {
+    unsigned int carry = 0;
+
+    for (int i = 0; i < 4 * Nb && (n || carry); i++) {
+        unsigned int sum = ctr[i] + (n & 0xff) + carry;
+        ctr[i] = sum & 0xff;
+        carry = sum >> 8;
+        n >>= 8;
     }
-    if (overflow) {
-        limbs[0] = big_endian_add(limbs[0], 1, &overflow);
+}
+
+// Add n to the last 32 bits of a counter block in big endian, wrapping
+// around instead of carrying into the rest, as GCM does
+static void increment_big_32bit(uint8_t *ctr, uint32_t n) {
+    uint32_t low = (uint32_t)ctr[12] << 24 | (uint32_t)ctr[13] << 16
+                   | (uint32_t)ctr[14] << 8 | ctr[15];
+    low += n;
+
+    for (int i = 4 * Nb - 1; i >= 4 * Nb - 4; i--) {
+        ctr[i] = low & 0xff;
+        low >>= 8;
     }
 }
 
+// Key expansion for everything but the x86 backends. bitslice computes
+// SubWord with its S-box circuit, so that key bytes never index a table
+// either
+static void key_exp_sbox(const uint8_t *key, uint32_t *round_keys, int inv_mix_cols) {
+    aes256_key_exp((const uint32_t *)key, round_keys, inv_mix_cols, sub_word);
+}
+
+static void key_exp_bitslice(const uint8_t *key, uint32_t *round_keys, int inv_mix_cols) {
+    aes256_key_exp((const uint32_t *)key, round_keys, inv_mix_cols, bitslice_sub_word);
+}
+
 // Modified key schedule generation from Section 5.3.5 of the AES spec
-static void aes256_key_exp(const uint32_t *key, uint32_t *round_keys, int inv_mix_cols) {
-    // "Rcon[i] contains the values given by [x^{i-1},{00},{00},{00}]"
-    // attempt to construct this in an endianness-safe way. note that
-    // Rcon[0] is never accessed in the algorithm below
-    static const uint8_t rcon_bytes[] = {
-        [4] = 0x01, [8] = 0x02,
-        [12] = 0x04, [16] = 0x08,
-        [20] = 0x10, [24] = 0x20,
-        [28] = 0x40,
-    };
+static void aes256_key_exp(const uint32_t *key, uint32_t *round_keys, int inv_mix_cols,
+                           uint32_t (*sub_word)(uint32_t)) {
     const uint32_t *rcon = (uint32_t *)rcon_bytes;
     uint32_t temp;
     int i;
@@ -194,131 +2364,601 @@ static void aes256_key_exp(const uint32_t *key, uint32_t *round_keys, int inv_mi
     }
 }
 
-static void aes256_cipher(const uint8_t *xor_before, const uint8_t *xor_after,
-                          const uint8_t *in, uint8_t *out,
-                          const uint32_t *round_keys) {
-    uint8_t state[4 * Nb];
-    copy_state(state, in);
+// aes256_key_exp() for every lane with a key in keys at once, in the
+// batch_t layout. The loops over lanes are innermost, so the S-box
+// lookups for different lanes do not wait on each other. That is only
+// for the T-table kernels: an implementation with lanes kernels of its
+// own has a faster key expansion too, so use that one key at a time and
+// move the result into place
+static void lanes_key_exp(const aes256_impl_t *cur, const uint8_t *const *keys,
+                          uint32_t (*round_keys)[BATCH_LANES][Nb], int inv_mix_cols) {
+    const uint32_t *rcon = (uint32_t *)rcon_bytes;
+
+    if (cur->enc_lanes != table_enc_lanes) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (!keys[l]) {
+                continue;
+            }
 
-    // For CBC
-    if (xor_before) {
-        add_round_key(state, (uint32_t *)xor_before);
+            uint32_t lane_keys[Nb * (Nr + 1)];
+            cur->key_exp(keys[l], lane_keys, inv_mix_cols);
+            for (int r = 0; r <= Nr; r++) {
+                memcpy(round_keys[r][l], lane_keys + (Nb * r), sizeof round_keys[r][l]);
+            }
+        }
+        return;
     }
 
-    add_round_key(state, round_keys);
+    // Word i of the schedule for lane l
+#define LANE_WORD(i, l) round_keys[(i) / Nb][l][(i) % Nb]
+
+    for (int i = 0; i < Nk; i++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (keys[l]) {
+                memcpy(&LANE_WORD(i, l), keys[l] + (4 * i), sizeof (uint32_t));
+            }
+        }
+    }
 
-#ifdef AES_TABLE
-    for (int round = 1; round < Nr; round++) {
-        uint8_t new_state[4 * Nb];
-        for (int j = 0; j < Nb; j++) {
-            const uint8_t *t0, *t1, *t2, *t3;
-            t0 = T0_fwd[state[4*j]];
-# ifdef AES_MONOTABLE
-            t1 = T0_fwd[state[4*((j + 1) % Nb) + 1]];
-            t2 = T0_fwd[state[4*((j + 2) % Nb) + 2]];
-            t3 = T0_fwd[state[4*((j + 3) % Nb) + 3]];
-# else
-            t1 = T1_fwd[state[4*((j + 1) % Nb) + 1]];
-            t2 = T2_fwd[state[4*((j + 2) % Nb) + 2]];
-            t3 = T3_fwd[state[4*((j + 3) % Nb) + 3]];
-# endif
+    for (int i = Nk; i < Nb * (Nr + 1); i++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (!keys[l]) {
+                continue;
+            }
 
-            for (int k = 0; k < 4; k++) {
-# ifdef AES_MONOTABLE
-                new_state[4*j + k] = t0[k] ^ t1[(k + 3) % 4] ^ t2[(k + 2) % 4] ^ t3[(k + 1) % 4];
-# else
-                new_state[4*j + k] = t0[k] ^ t1[k] ^ t2[k] ^ t3[k];
-# endif
+            uint32_t temp = LANE_WORD(i - 1, l);
+            if (!(i % Nk)) {
+                temp = sub_word(rot_word(temp)) ^ rcon[i / Nk];
+            } else if (i % Nk == 4) {
+                temp = sub_word(temp);
             }
+            LANE_WORD(i, l) = LANE_WORD(i - Nk, l) ^ temp;
         }
+    }
+#undef LANE_WORD
 
-        add_round_key(new_state, round_keys + (Nb * round));
-        copy_state(state, new_state);
+    if (inv_mix_cols) {
+        for (int r = 1; r < Nr; r++) {
+            for (int l = 0; l < BATCH_LANES; l++) {
+                if (keys[l]) {
+                    inv_mix_columns((uint8_t *)round_keys[r][l]);
+                }
+            }
+        }
     }
+}
 
-    sub_bytes(state);
-    shift_rows(state);
-    add_round_key(state, round_keys + (Nb * Nr));
-#else
-    for (int round = 1; round <= Nr; round++) {
-        sub_bytes(state);
-        shift_rows(state);
-        if (round < Nr) {
-            mix_columns(state);
+// onthefly never stores a whole schedule. Instead, it keeps a window of
+// Nk words that slides along the schedule as the rounds need them,
+// which is two round keys at a time. All it needs to start from is the
+// key itself, or for decryption the last window, whose first half is
+// the last round key. The kernel only ever touches those 32 bytes, but
+// an aes256_ctx_t still has room for two whole schedules, since which
+// implementation it gets is only known at runtime
+static void key_exp_onthefly(const uint8_t *key, uint32_t *round_keys, int inv) {
+    memcpy(round_keys, key, Nk * sizeof *round_keys);
+
+    if (inv) {
+        for (int k = 1; k <= Nr / 2; k++) {
+            next_key_window(round_keys, k);
+        }
+    }
+}
+
+// Slide window from words Nk * (k - 1) onwards of the schedule to words
+// Nk * k onwards. This is the recurrence in aes256_key_exp(), except
+// that the word Nk back is the one being overwritten
+static inline void next_key_window(uint32_t *window, int k) {
+    const uint32_t *rcon = (uint32_t *)rcon_bytes;
+
+    window[0] ^= sub_word(rot_word(window[Nk - 1])) ^ rcon[k];
+    for (int i = 1; i < Nk; i++) {
+        window[i] ^= i == 4? sub_word(window[i - 1]) : window[i - 1];
+    }
+}
+
+// The reverse of next_key_window(): every word is the XOR of the word
+// Nk after it and some function of the word Nk - 1 after it, so go from
+// the back
+static inline void prev_key_window(uint32_t *window, int k) {
+    const uint32_t *rcon = (uint32_t *)rcon_bytes;
+
+    for (int i = Nk - 1; i > 0; i--) {
+        window[i] ^= i == 4? sub_word(window[i - 1]) : window[i - 1];
+    }
+    window[0] ^= sub_word(rot_word(window[Nk - 1])) ^ rcon[k];
+}
+
+// InvMixColumns on one round key column for the equivalent inverse
+// cipher. The inverse T-tables compute InvMixColumns(InvSubBytes(x)), so
+// go through SubBytes first
+static inline uint32_t inv_mix_key_col(uint32_t col) {
+    uint32_t sub = sub_word(col);
+    return INV_COL(sub, sub, sub, sub, 0);
+}
+
+// The word tables with the four state columns kept in locals and all
+// 14 rounds unrolled. This is the scalar kernel we would actually port
+// to Vortex. Blocks go PAR_BLOCKS at a time, all sixteen of their
+// columns in locals, and whatever is left over one at a time
+static void unrolled_enc_ecb(const uint8_t *in, const uint32_t *round_keys,
+                             uint8_t *out, int nblocks) {
+    INIT_FWD_TABLES();
+    int b = 0;
+
+    for (; b + PAR_BLOCKS <= nblocks; b += PAR_BLOCKS) {
+        uint8_t state[PAR_BLOCKS][4 * Nb];
+        for (int i = 0; i < PAR_BLOCKS; i++) {
+            copy_state(state[i], in + (size_t)(b + i) * (4 * Nb));
+            add_round_key(state[i], round_keys);
+        }
+
+        uint32_t sa0, sa1, sa2, sa3, sb0, sb1, sb2, sb3,
+                 sc0, sc1, sc2, sc3, sd0, sd1, sd2, sd3;
+        uint32_t ta0, ta1, ta2, ta3, tb0, tb1, tb2, tb3,
+                 tc0, tc1, tc2, tc3, td0, td1, td2, td3;
+        PAR_LOAD_COLS(s, state);
+
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 1));
+        PAR_ROUND(FWD_ROUND, s, t, round_keys + (Nb * 2));
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 3));
+        PAR_ROUND(FWD_ROUND, s, t, round_keys + (Nb * 4));
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 5));
+        PAR_ROUND(FWD_ROUND, s, t, round_keys + (Nb * 6));
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 7));
+        PAR_ROUND(FWD_ROUND, s, t, round_keys + (Nb * 8));
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 9));
+        PAR_ROUND(FWD_ROUND, s, t, round_keys + (Nb * 10));
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 11));
+        PAR_ROUND(FWD_ROUND, s, t, round_keys + (Nb * 12));
+        PAR_ROUND(FWD_ROUND, t, s, round_keys + (Nb * 13));
+        PAR_ROUND(FWD_LAST_ROUND, s, t, round_keys + (Nb * Nr));
+        PAR_STORE_COLS(state, s);
+
+        for (int i = 0; i < PAR_BLOCKS; i++) {
+            copy_state(out + (size_t)(b + i) * (4 * Nb), state[i]);
+        }
+    }
+
+    for (; b < nblocks; b++) {
+        uint8_t state[4 * Nb];
+        copy_state(state, in + (size_t)b * (4 * Nb));
+        add_round_key(state, round_keys);
+
+        uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+        LOAD_COLS(s, state);
+
+        FWD_ROUND(t, s, round_keys + (Nb * 1));
+        FWD_ROUND(s, t, round_keys + (Nb * 2));
+        FWD_ROUND(t, s, round_keys + (Nb * 3));
+        FWD_ROUND(s, t, round_keys + (Nb * 4));
+        FWD_ROUND(t, s, round_keys + (Nb * 5));
+        FWD_ROUND(s, t, round_keys + (Nb * 6));
+        FWD_ROUND(t, s, round_keys + (Nb * 7));
+        FWD_ROUND(s, t, round_keys + (Nb * 8));
+        FWD_ROUND(t, s, round_keys + (Nb * 9));
+        FWD_ROUND(s, t, round_keys + (Nb * 10));
+        FWD_ROUND(t, s, round_keys + (Nb * 11));
+        FWD_ROUND(s, t, round_keys + (Nb * 12));
+        FWD_ROUND(t, s, round_keys + (Nb * 13));
+        FWD_LAST_ROUND(s, t, round_keys + (Nb * Nr));
+        STORE_COLS(state, s);
+
+        copy_state(out + (size_t)b * (4 * Nb), state);
+    }
+}
+
+// Equivalent inverse cipher from Section 5.3.5 of AES spec, blocks
+// interleaved the same way as unrolled_enc_ecb()
+static void unrolled_dec_ecb(const uint8_t *in, const uint32_t *round_keys,
+                             uint8_t *out, int nblocks) {
+    INIT_INV_TABLES();
+    int b = 0;
+
+    for (; b + PAR_BLOCKS <= nblocks; b += PAR_BLOCKS) {
+        uint8_t state[PAR_BLOCKS][4 * Nb];
+        for (int i = 0; i < PAR_BLOCKS; i++) {
+            copy_state(state[i], in + (size_t)(b + i) * (4 * Nb));
+            add_round_key(state[i], round_keys + (Nb * Nr));
+        }
+
+        uint32_t sa0, sa1, sa2, sa3, sb0, sb1, sb2, sb3,
+                 sc0, sc1, sc2, sc3, sd0, sd1, sd2, sd3;
+        uint32_t ta0, ta1, ta2, ta3, tb0, tb1, tb2, tb3,
+                 tc0, tc1, tc2, tc3, td0, td1, td2, td3;
+        PAR_LOAD_COLS(s, state);
+
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 13));
+        PAR_ROUND(INV_ROUND, s, t, round_keys + (Nb * 12));
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 11));
+        PAR_ROUND(INV_ROUND, s, t, round_keys + (Nb * 10));
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 9));
+        PAR_ROUND(INV_ROUND, s, t, round_keys + (Nb * 8));
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 7));
+        PAR_ROUND(INV_ROUND, s, t, round_keys + (Nb * 6));
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 5));
+        PAR_ROUND(INV_ROUND, s, t, round_keys + (Nb * 4));
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 3));
+        PAR_ROUND(INV_ROUND, s, t, round_keys + (Nb * 2));
+        PAR_ROUND(INV_ROUND, t, s, round_keys + (Nb * 1));
+        PAR_ROUND(INV_LAST_ROUND, s, t, round_keys);
+        PAR_STORE_COLS(state, s);
+
+        for (int i = 0; i < PAR_BLOCKS; i++) {
+            copy_state(out + (size_t)(b + i) * (4 * Nb), state[i]);
+        }
+    }
+
+    for (; b < nblocks; b++) {
+        uint8_t state[4 * Nb];
+        copy_state(state, in + (size_t)b * (4 * Nb));
+        add_round_key(state, round_keys + (Nb * Nr));
+
+        uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+        LOAD_COLS(s, state);
+
+        INV_ROUND(t, s, round_keys + (Nb * 13));
+        INV_ROUND(s, t, round_keys + (Nb * 12));
+        INV_ROUND(t, s, round_keys + (Nb * 11));
+        INV_ROUND(s, t, round_keys + (Nb * 10));
+        INV_ROUND(t, s, round_keys + (Nb * 9));
+        INV_ROUND(s, t, round_keys + (Nb * 8));
+        INV_ROUND(t, s, round_keys + (Nb * 7));
+        INV_ROUND(s, t, round_keys + (Nb * 6));
+        INV_ROUND(t, s, round_keys + (Nb * 5));
+        INV_ROUND(s, t, round_keys + (Nb * 4));
+        INV_ROUND(t, s, round_keys + (Nb * 3));
+        INV_ROUND(s, t, round_keys + (Nb * 2));
+        INV_ROUND(t, s, round_keys + (Nb * 1));
+        INV_LAST_ROUND(s, t, round_keys);
+        STORE_COLS(state, s);
+
+        copy_state(out + (size_t)b * (4 * Nb), state);
+    }
+}
+
+// unrolled with the key schedule derived as the rounds go, from the
+// window key_exp_onthefly() left in round_keys. Every block slides its
+// own copy of the window, the way a Vortex lane would, so no block
+// needs more than Nk words of key at once
+static void onthefly_enc_ecb(const uint8_t *in, const uint32_t *round_keys,
+                             uint8_t *out, int nblocks) {
+    INIT_FWD_TABLES();
+
+    for (int b = 0; b < nblocks; b++) {
+        uint32_t window[Nk];
+        memcpy(window, round_keys, sizeof window);
+
+        uint8_t state[4 * Nb];
+        copy_state(state, in + (size_t)b * (4 * Nb));
+        add_round_key(state, window);
+
+        uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+        LOAD_COLS(s, state);
+
+        // Window k holds round keys 2k and 2k + 1
+        FWD_ROUND(t, s, window + Nb);
+        for (int k = 1; k < Nr / 2; k++) {
+            next_key_window(window, k);
+            FWD_ROUND(s, t, window);
+            FWD_ROUND(t, s, window + Nb);
+        }
+        next_key_window(window, Nr / 2);
+        FWD_LAST_ROUND(s, t, window);
+        STORE_COLS(state, s);
+
+        copy_state(out + (size_t)b * (4 * Nb), state);
+    }
+}
+
+// The equivalent inverse cipher needs round keys 1 to Nr - 1 through
+// InvMixColumns, which we do to each one as the window gets to it
+static void onthefly_dec_ecb(const uint8_t *in, const uint32_t *round_keys,
+                             uint8_t *out, int nblocks) {
+    INIT_INV_TABLES();
+
+    for (int b = 0; b < nblocks; b++) {
+        uint32_t window[Nk], inv_keys[Nk];
+        memcpy(window, round_keys, sizeof window);
+
+        uint8_t state[4 * Nb];
+        copy_state(state, in + (size_t)b * (4 * Nb));
+        add_round_key(state, window);
+
+        uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+        LOAD_COLS(s, state);
+
+        for (int k = Nr / 2; k > 1; k--) {
+            prev_key_window(window, k);
+            for (int i = 0; i < Nk; i++) {
+                inv_keys[i] = inv_mix_key_col(window[i]);
+            }
+            INV_ROUND(t, s, inv_keys + Nb);
+            INV_ROUND(s, t, inv_keys);
+        }
+        // Round key 0 skips InvMixColumns
+        prev_key_window(window, 1);
+        for (int i = Nb; i < Nk; i++) {
+            inv_keys[i] = inv_mix_key_col(window[i]);
+        }
+        INV_ROUND(t, s, inv_keys + Nb);
+        INV_LAST_ROUND(s, t, window);
+        STORE_COLS(state, s);
+
+        copy_state(out + (size_t)b * (4 * Nb), state);
+    }
+}
+
+// One block per lane of the batch API, each under its lane's own round
+// keys, using the word tables like unrolled. Each round runs on every
+// lane before moving on to the next, like rounds_enc_ecb()
+static void table_enc_lanes(const uint8_t *in, const uint32_t *lane_keys, uint8_t *out) {
+    const uint32_t (*round_keys)[BATCH_LANES][Nb] =
+        (const uint32_t (*)[BATCH_LANES][Nb])lane_keys;
+    uint32_t s[BATCH_LANES][Nb], t[BATCH_LANES][Nb];
+    INIT_FWD_TABLES();
+
+    memcpy(s, in, sizeof s);
+    for (int l = 0; l < BATCH_LANES; l++) {
+        for (int c = 0; c < Nb; c++) {
+            s[l][c] ^= round_keys[0][l][c];
+        }
+    }
+
+    for (int r = 1; r < Nr; r++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            for (int c = 0; c < Nb; c++) {
+                t[l][c] = FWD_COL(s[l][c], s[l][(c + 1) % Nb], s[l][(c + 2) % Nb],
+                                  s[l][(c + 3) % Nb], round_keys[r][l][c]);
+            }
+        }
+        memcpy(s, t, sizeof s);
+    }
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        for (int c = 0; c < Nb; c++) {
+            t[l][c] = FWD_LAST_COL(s[l][c], s[l][(c + 1) % Nb], s[l][(c + 2) % Nb],
+                                   s[l][(c + 3) % Nb], round_keys[Nr][l][c]);
+        }
+    }
+    memcpy(out, t, sizeof t);
+}
+
+// table_enc_lanes() for the equivalent inverse cipher
+static void table_dec_lanes(const uint8_t *in, const uint32_t *lane_keys, uint8_t *out) {
+    const uint32_t (*round_keys)[BATCH_LANES][Nb] =
+        (const uint32_t (*)[BATCH_LANES][Nb])lane_keys;
+    uint32_t s[BATCH_LANES][Nb], t[BATCH_LANES][Nb];
+    INIT_INV_TABLES();
+
+    memcpy(s, in, sizeof s);
+    for (int l = 0; l < BATCH_LANES; l++) {
+        for (int c = 0; c < Nb; c++) {
+            s[l][c] ^= round_keys[Nr][l][c];
         }
-        add_round_key(state, round_keys + (Nb * round));
     }
-#endif
 
-    // For CTR
-    if (xor_after) {
-        add_round_key(state, (uint32_t *)xor_after);
-    }
-
-    copy_state(out, state);
-}
-
-// Equivalent inverse cipher from Section 5.3.5 of AES spec
-static void aes256_inv_cipher(const uint8_t *xor_after, const uint8_t *in,
-                              uint8_t *out, const uint32_t *round_keys) {
-    uint8_t state[4 * Nb];
-
-    copy_state(state, in);
-
-    add_round_key(state, round_keys + (Nb * Nr));
-
-#ifdef AES_TABLE
-    for (int round = Nr - 1; round > 0; round--) {
-        uint8_t new_state[4 * Nb];
-        for (int j = 0; j < Nb; j++) {
-            const uint8_t *t0, *t1, *t2, *t3;
-            t0 = T0_inv[state[4*j]];
-# ifdef AES_MONOTABLE
-            t1 = T0_inv[state[4*((j + 3) % Nb) + 1]];
-            t2 = T0_inv[state[4*((j + 2) % Nb) + 2]];
-            t3 = T0_inv[state[4*((j + 1) % Nb) + 3]];
-# else
-            t1 = T1_inv[state[4*((j + 3) % Nb) + 1]];
-            t2 = T2_inv[state[4*((j + 2) % Nb) + 2]];
-            t3 = T3_inv[state[4*((j + 1) % Nb) + 3]];
-# endif
-
-            for (int k = 0; k < 4; k++) {
-# ifdef AES_MONOTABLE
-                new_state[4*j + k] = t0[k] ^ t1[(k + 3) % 4] ^ t2[(k + 2) % 4] ^ t3[(k + 1) % 4];
-# else
-                new_state[4*j + k] = t0[k] ^ t1[k] ^ t2[k] ^ t3[k];
-# endif
+    for (int r = Nr - 1; r > 0; r--) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            for (int c = 0; c < Nb; c++) {
+                t[l][c] = INV_COL(s[l][c], s[l][(c + 3) % Nb], s[l][(c + 2) % Nb],
+                                  s[l][(c + 1) % Nb], round_keys[r][l][c]);
+            }
+        }
+        memcpy(s, t, sizeof s);
+    }
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        for (int c = 0; c < Nb; c++) {
+            t[l][c] = INV_LAST_COL(s[l][c], s[l][(c + 3) % Nb], s[l][(c + 2) % Nb],
+                                   s[l][(c + 1) % Nb], round_keys[0][l][c]);
+        }
+    }
+    memcpy(out, t, sizeof t);
+}
+
+// Separate tables T0, T1, T2, T3 (Section 4.2.1 of The Design of
+// Rijndael)
+static void table_enc_ecb(const uint8_t *in, const uint32_t *round_keys,
+                          uint8_t *out, int nblocks) {
+    INIT_FWD_TABLES();
+    rounds_enc_ecb(in, round_keys, out, nblocks, table_fwd_round, fwd_last_round);
+}
+
+static void table_dec_ecb(const uint8_t *in, const uint32_t *round_keys,
+                          uint8_t *out, int nblocks) {
+    INIT_INV_TABLES();
+    rounds_dec_ecb(in, round_keys, out, nblocks, table_inv_round, inv_last_round);
+}
+
+// Only T0, rotating the result to get T1, T2, T3
+static void monotable_enc_ecb(const uint8_t *in, const uint32_t *round_keys,
+                              uint8_t *out, int nblocks) {
+    INIT_FWD_TABLES();
+    rounds_enc_ecb(in, round_keys, out, nblocks, monotable_fwd_round, fwd_last_round);
+}
+
+static void monotable_dec_ecb(const uint8_t *in, const uint32_t *round_keys,
+                              uint8_t *out, int nblocks) {
+    INIT_INV_TABLES();
+    rounds_dec_ecb(in, round_keys, out, nblocks, monotable_inv_round, inv_last_round);
+}
+
+// The original naïve implementation, straight from the AES spec
+static void original_enc_ecb(const uint8_t *in, const uint32_t *round_keys,
+                             uint8_t *out, int nblocks) {
+    rounds_enc_ecb(in, round_keys, out, nblocks, original_fwd_round, fwd_last_round);
+}
+
+static void original_dec_ecb(const uint8_t *in, const uint32_t *round_keys,
+                             uint8_t *out, int nblocks) {
+    rounds_dec_ecb(in, round_keys, out, nblocks, original_inv_round, inv_last_round);
+}
+
+// ECB for the implementations that go one round at a time, on
+// PAR_BLOCKS independent blocks at once, running each round on every
+// block before moving on to the next round. None of the table lookups
+// for one block depend on those for another, so this gives the CPU
+// PAR_BLOCKS times as much work to overlap while it waits on loads
+static inline void rounds_enc_ecb(const uint8_t *in, const uint32_t *round_keys,
+                                  uint8_t *out, int nblocks, round_fn_t *round,
+                                  round_fn_t *last_round) {
+    for (int b = 0; b < nblocks; b += PAR_BLOCKS) {
+        int batch = nblocks - b < PAR_BLOCKS? nblocks - b : PAR_BLOCKS;
+        uint8_t state[PAR_BLOCKS][4 * Nb];
+
+        for (int i = 0; i < batch; i++) {
+            copy_state(state[i], in + (size_t)(b + i) * (4 * Nb));
+            add_round_key(state[i], round_keys);
+        }
+
+        for (int r = 1; r < Nr; r++) {
+            for (int i = 0; i < batch; i++) {
+                round(state[i], round_keys + (Nb * r));
+            }
+        }
+
+        for (int i = 0; i < batch; i++) {
+            last_round(state[i], round_keys + (Nb * Nr));
+            copy_state(out + (size_t)(b + i) * (4 * Nb), state[i]);
+        }
+    }
+}
+
+// rounds_enc_ecb() for the equivalent inverse cipher from Section 5.3.5
+// of AES spec
+static inline void rounds_dec_ecb(const uint8_t *in, const uint32_t *round_keys,
+                                  uint8_t *out, int nblocks, round_fn_t *round,
+                                  round_fn_t *last_round) {
+    for (int b = 0; b < nblocks; b += PAR_BLOCKS) {
+        int batch = nblocks - b < PAR_BLOCKS? nblocks - b : PAR_BLOCKS;
+        uint8_t state[PAR_BLOCKS][4 * Nb];
+
+        for (int i = 0; i < batch; i++) {
+            copy_state(state[i], in + (size_t)(b + i) * (4 * Nb));
+            add_round_key(state[i], round_keys + (Nb * Nr));
+        }
+
+        for (int r = Nr - 1; r > 0; r--) {
+            for (int i = 0; i < batch; i++) {
+                round(state[i], round_keys + (Nb * r));
             }
         }
 
-        add_round_key(new_state, round_keys + (Nb * round));
-        copy_state(state, new_state);
+        for (int i = 0; i < batch; i++) {
+            last_round(state[i], round_keys);
+            copy_state(out + (size_t)(b + i) * (4 * Nb), state[i]);
+        }
     }
+}
+
+// One full round of the cipher: SubBytes, ShiftRows, MixColumns and
+// AddRoundKey
+static void original_fwd_round(uint8_t *state, const uint32_t *round_key) {
+    sub_bytes(state);
+    shift_rows(state);
+    mix_columns(state);
+    add_round_key(state, round_key);
+}
 
+// One round of the equivalent inverse cipher, so InvMixColumns comes
+// before AddRoundKey with a transformed round key
+static void original_inv_round(uint8_t *state, const uint32_t *round_key) {
     inv_sub_bytes(state);
     inv_shift_rows(state);
-    add_round_key(state, round_keys);
-#else
-    for (int round = Nr - 1; round >= 0; round--) {
-        inv_sub_bytes(state);
-        inv_shift_rows(state);
-        if (round > 0) {
-            inv_mix_columns(state);
+    inv_mix_columns(state);
+    add_round_key(state, round_key);
+}
+
+// original_fwd_round() with every column looked up in T0-T3
+static void table_fwd_round(uint8_t *state, const uint32_t *round_key) {
+    uint8_t new_state[4 * Nb];
+    for (int j = 0; j < Nb; j++) {
+        const uint8_t *t0, *t1, *t2, *t3;
+        t0 = T0_fwd[state[4*j]];
+        t1 = T1_fwd[state[4*((j + 1) % Nb) + 1]];
+        t2 = T2_fwd[state[4*((j + 2) % Nb) + 2]];
+        t3 = T3_fwd[state[4*((j + 3) % Nb) + 3]];
+
+        for (int k = 0; k < 4; k++) {
+            new_state[4*j + k] = t0[k] ^ t1[k] ^ t2[k] ^ t3[k];
+        }
+    }
+
+    add_round_key(new_state, round_key);
+    copy_state(state, new_state);
+}
+
+static void table_inv_round(uint8_t *state, const uint32_t *round_key) {
+    uint8_t new_state[4 * Nb];
+    for (int j = 0; j < Nb; j++) {
+        const uint8_t *t0, *t1, *t2, *t3;
+        t0 = T0_inv[state[4*j]];
+        t1 = T1_inv[state[4*((j + 3) % Nb) + 1]];
+        t2 = T2_inv[state[4*((j + 2) % Nb) + 2]];
+        t3 = T3_inv[state[4*((j + 1) % Nb) + 3]];
+
+        for (int k = 0; k < 4; k++) {
+            new_state[4*j + k] = t0[k] ^ t1[k] ^ t2[k] ^ t3[k];
+        }
+    }
+
+    add_round_key(new_state, round_key);
+    copy_state(state, new_state);
+}
+
+// table_fwd_round() with T1, T2 and T3 read out of T0 rotated
+static void monotable_fwd_round(uint8_t *state, const uint32_t *round_key) {
+    uint8_t new_state[4 * Nb];
+    for (int j = 0; j < Nb; j++) {
+        const uint8_t *t0, *t1, *t2, *t3;
+        t0 = T0_fwd[state[4*j]];
+        t1 = T0_fwd[state[4*((j + 1) % Nb) + 1]];
+        t2 = T0_fwd[state[4*((j + 2) % Nb) + 2]];
+        t3 = T0_fwd[state[4*((j + 3) % Nb) + 3]];
+
+        for (int k = 0; k < 4; k++) {
+            new_state[4*j + k] = t0[k] ^ t1[(k + 3) % 4] ^ t2[(k + 2) % 4] ^ t3[(k + 1) % 4];
         }
-        add_round_key(state, round_keys + (Nb * round));
     }
-#endif
 
-    // For CBC
-    if (xor_after) {
-        add_round_key(state, (uint32_t *)xor_after);
+    add_round_key(new_state, round_key);
+    copy_state(state, new_state);
+}
+
+static void monotable_inv_round(uint8_t *state, const uint32_t *round_key) {
+    uint8_t new_state[4 * Nb];
+    for (int j = 0; j < Nb; j++) {
+        const uint8_t *t0, *t1, *t2, *t3;
+        t0 = T0_inv[state[4*j]];
+        t1 = T0_inv[state[4*((j + 3) % Nb) + 1]];
+        t2 = T0_inv[state[4*((j + 2) % Nb) + 2]];
+        t3 = T0_inv[state[4*((j + 1) % Nb) + 3]];
+
+        for (int k = 0; k < 4; k++) {
+            new_state[4*j + k] = t0[k] ^ t1[(k + 3) % 4] ^ t2[(k + 2) % 4] ^ t3[(k + 1) % 4];
+        }
     }
 
-    copy_state(out, state);
+    add_round_key(new_state, round_key);
+    copy_state(state, new_state);
+}
+
+// The last round of the cipher, which skips MixColumns
+static void fwd_last_round(uint8_t *state, const uint32_t *round_key) {
+    sub_bytes(state);
+    shift_rows(state);
+    add_round_key(state, round_key);
+}
+
+// The last round of the inverse cipher, which skips InvMixColumns
+static void inv_last_round(uint8_t *state, const uint32_t *round_key) {
+    inv_sub_bytes(state);
+    inv_shift_rows(state);
+    add_round_key(state, round_key);
 }
 
-static inline uint32_t sub_word(uint32_t word) {
+static uint32_t sub_word(uint32_t word) {
     uint8_t *bytes = (uint8_t *)&word;
 
     for (int i = 0; i < 4; i++) {
@@ -379,7 +3019,6 @@ static void inv_shift_rows(uint8_t *state) {
     copy_state(state, new);
 }
 
-#ifndef AES_TABLE
 static void mix_columns(uint8_t *state) {
     uint32_t *state_cols = (uint32_t *)state;
 
@@ -397,7 +3036,6 @@ static void mix_columns(uint8_t *state) {
         state_cols[i] = new;
     }
 }
-#endif
 
 static void inv_mix_columns(uint8_t *state) {
     uint32_t *state_cols = (uint32_t *)state;
@@ -2,6 +2,7 @@
 #define AES256_H
 
 #include <stdint.h>
+#include "threadpool.h"
 
 // 4 32-bit columns in an AES state
 #define Nb 4
@@ -12,6 +13,229 @@
 
 #define BLOCK_SIZE (4 * Nb)
 
+// Implementations are picked at runtime, by default the first one this
+// machine can run in order of preference, aesni, vperm, unrolled and so
+// on (or $AES256_IMPL if set). The name "fastest" times them all and
+// picks the one that wins. aes256_impl_name(n) lists them, returning
+// NULL after the last one
+extern int aes256_set_impl(const char *);
+extern const char *aes256_get_impl(void);
+extern const char *aes256_impl_name(int);
+
+// Opaque holder for the expanded key schedules of one key. Set one up
+// with aes256_ctx_init() to avoid expanding the same key on every call.
+//
+// Every mode here, with or without a pool, can work in place: out can
+// be the same buffer as in (but not overlap it any other way), and gets
+// the same result as a separate buffer would. The exceptions are
+// aes256_stream_update() for ECB and CBC, see below, and
+// container_enc() and container_dec(), which move the data by a header
+typedef struct aes256_ctx aes256_ctx_t;
+
+extern aes256_ctx_t *aes256_ctx_init(const uint8_t *);
+extern void aes256_ctx_free(aes256_ctx_t *);
+extern void aes256_ctx_enc_ecb(const aes256_ctx_t *, const uint8_t *, uint8_t *, int);
+extern void aes256_ctx_dec_ecb(const aes256_ctx_t *, const uint8_t *, uint8_t *, int);
+extern void aes256_ctx_enc_cbc(const aes256_ctx_t *, const uint8_t *,
+                               const uint8_t *, uint8_t *, int);
+extern void aes256_ctx_dec_cbc(const aes256_ctx_t *, const uint8_t *,
+                               const uint8_t *, uint8_t *, int);
+extern void aes256_ctx_ctr(const aes256_ctx_t *, const uint8_t *,
+                           const uint8_t *, uint8_t *, int);
+
+// CTR keystream for one message, worked out ahead of time by a thread
+// of its own into a ring buffer of the given number of blocks, so that
+// encrypting is only an XOR. Successive calls to aes256_keystream_xor()
+// carry on where the last one left off, byte by byte, as if the pieces
+// were one message. Whatever the buffer does not have yet gets
+// generated on the spot. Only one thread at a time should call
+// aes256_keystream_xor() on the same keystream
+typedef struct aes256_keystream aes256_keystream_t;
+
+// How many calls to aes256_keystream_xor() found all the keystream they
+// needed in the buffer (hits) or had to generate some of it (misses),
+// and how many blocks they generated
+typedef struct {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long miss_blocks;
+} aes256_keystream_stats_t;
+
+extern aes256_keystream_t *aes256_keystream_init(const aes256_ctx_t *, const uint8_t *, int);
+extern void aes256_keystream_free(aes256_keystream_t *);
+extern void aes256_keystream_xor(aes256_keystream_t *, const uint8_t *, uint8_t *, int);
+extern void aes256_keystream_stats(aes256_keystream_t *, aes256_keystream_stats_t *);
+
+// Incremental encryption and decryption of one message that does not
+// have to be in memory all at once: aes256_stream_update() takes it a
+// piece of any size at a time, and aes256_stream_final() finishes it.
+// Partial blocks, the CBC chain and CTR keystream carry over between
+// calls, and ECB and CBC add PKCS#5 padding in aes256_stream_final()
+// (or check and strip it, for decryption). Whole blocks go across the
+// threads of the pool given to aes256_stream_init(), like the _mt
+// functions, except for CBC encryption. An update can be in place
+// whenever nothing is left over from the one before it, e.g. the first
+// one, or for CTR any of them
+typedef enum {
+    STREAM_ENC_ECB,
+    STREAM_DEC_ECB,
+    STREAM_ENC_CBC,
+    STREAM_DEC_CBC,
+    STREAM_CTR,
+} aes256_stream_mode_t;
+
+typedef struct aes256_stream aes256_stream_t;
+
+extern aes256_stream_t *aes256_stream_init(const aes256_ctx_t *, aes256_stream_mode_t,
+                                           const uint8_t *, threadpool_t *);
+extern void aes256_stream_free(aes256_stream_t *);
+extern int aes256_stream_update(aes256_stream_t *, const uint8_t *, uint8_t *, int);
+extern int aes256_stream_final(aes256_stream_t *, uint8_t *);
+
+// One CBC encryption in progress (e.g., one file) for
+// aes256_ctx_enc_cbc_streams(). iv starts out as the IV and is left as
+// the last ciphertext block, so passing the stream again with the next
+// in, out and nblocks carries on where the last call stopped
+typedef struct {
+    uint8_t iv[BLOCK_SIZE];
+    const uint8_t *in;
+    uint8_t *out;
+    int nblocks;
+} aes256_cbc_stream_t;
+
+extern void aes256_ctx_enc_cbc_streams(const aes256_ctx_t *, aes256_cbc_stream_t *, int);
+
+// One message for the aes256_batch_*() functions, each under its own
+// key. iv is the IV for CBC or the initial counter for CTR, and ignored
+// for ECB
+typedef struct {
+    const uint8_t *key;
+    const uint8_t *iv;
+    const uint8_t *in;
+    uint8_t *out;
+    int nblocks;
+} aes256_job_t;
+
+// How many jobs the aes256_batch_*() functions work on side by side
+#define BATCH_LANES 8
+
+extern void aes256_batch_enc_ecb(const aes256_job_t *, int);
+extern void aes256_batch_dec_ecb(const aes256_job_t *, int);
+extern void aes256_batch_enc_cbc(const aes256_job_t *, int);
+extern void aes256_batch_dec_cbc(const aes256_job_t *, int);
+extern void aes256_batch_ctr(const aes256_job_t *, int);
+
+// GCM: CTR encryption plus a GCM_TAG_SIZE-byte tag authenticating the
+// ciphertext and any additional data (AAD) passed alongside it, all in
+// one pass. Lengths are in bytes, since GCM does not pad, and IVs can
+// be any length but GCM_IV_SIZE is the one to use. Decryption returns
+// -1 and zeroes out if the tag does not match
+#define GCM_IV_SIZE 12
+#define GCM_TAG_SIZE BLOCK_SIZE
+
+extern void aes256_ctx_enc_gcm(const aes256_ctx_t *, const uint8_t *, int,
+                               const uint8_t *, int, const uint8_t *, uint8_t *,
+                               int, uint8_t *);
+extern int aes256_ctx_dec_gcm(const aes256_ctx_t *, const uint8_t *, int,
+                              const uint8_t *, int, const uint8_t *, uint8_t *,
+                              int, const uint8_t *);
+extern void aes256_enc_gcm(const uint8_t *, int, const uint8_t *, int,
+                           const uint8_t *, const uint8_t *, uint8_t *, int,
+                           uint8_t *);
+extern int aes256_dec_gcm(const uint8_t *, int, const uint8_t *, int,
+                          const uint8_t *, const uint8_t *, uint8_t *, int,
+                          const uint8_t *);
+
+// XTS (IEEE 1619) for disk images and page stores: the message is a
+// run of data units (e.g., sectors or pages) of unit_size bytes, each
+// encrypted on its own under a tweak counting up from the one given, in
+// little endian, so any one unit can be rewritten without the others.
+// The key is really two, one for the data and one for the tweaks, which
+// take a context each (XTS_KEY_SIZE bytes for the one-shot versions).
+// Every unit, a short last one included, needs at least a whole block,
+// and a partial block at the end of one gets ciphertext stealing.
+// Units are split between the threads of pool like the _mt modes below.
+// Returns -1 if the lengths do not work out
+#define XTS_KEY_SIZE (2 * 4 * Nk)
+
+extern int aes256_ctx_enc_xts(const aes256_ctx_t *, const aes256_ctx_t *,
+                              const uint8_t *, const uint8_t *, uint8_t *, int,
+                              int, threadpool_t *);
+extern int aes256_ctx_dec_xts(const aes256_ctx_t *, const aes256_ctx_t *,
+                              const uint8_t *, const uint8_t *, uint8_t *, int,
+                              int, threadpool_t *);
+extern int aes256_enc_xts(const uint8_t *, const uint8_t *, const uint8_t *,
+                          uint8_t *, int, int, int);
+extern int aes256_dec_xts(const uint8_t *, const uint8_t *, const uint8_t *,
+                          uint8_t *, int, int, int);
+// Add n to a tweak in little endian, which turns the tweak of one data
+// unit into that of the unit n further on
+extern void aes256_xts_tweak_add(uint8_t *, uint64_t);
+
+// AES-CMAC (RFC 4493), a CMAC_SIZE-byte MAC of len bytes. The context
+// keeps the subkeys K1 and K2 next to the key schedule, so every message
+// after the first costs only its own block encryptions
+#define CMAC_SIZE BLOCK_SIZE
+
+extern void aes256_ctx_cmac(const aes256_ctx_t *, const uint8_t *, int, uint8_t *);
+extern void aes256_cmac(const uint8_t *, const uint8_t *, int, uint8_t *);
+
+// One message for aes256_ctx_cmac_batch(), which leaves its MAC in mac
+typedef struct {
+    const uint8_t *in;
+    int len;
+    uint8_t mac[CMAC_SIZE];
+} aes256_cmac_msg_t;
+
+extern void aes256_ctx_cmac_batch(const aes256_ctx_t *, aes256_cmac_msg_t *, int);
+
+// CTR on a byte range of a longer message, from any byte offset, given
+// only the bytes in the range
+extern void aes256_ctx_ctr_range(const aes256_ctx_t *, const uint8_t *, uint64_t,
+                                 const uint8_t *, uint8_t *, int);
+extern void aes256_ctr_range(const uint8_t *, const uint8_t *, const uint8_t *,
+                             uint8_t *, uint64_t, int);
+
+// CTR_DRBG (NIST SP 800-90A) with AES-256 and no derivation function,
+// for generating keys and IVs locally instead of reading /dev/urandom
+// for every one. Seeds are DRBG_SEED_SIZE bytes, as are additional
+// inputs and personalization strings at most. Instances reseed from
+// /dev/urandom every DRBG_RESEED_INTERVAL requests, where a request is
+// up to DRBG_MAX_REQUEST bytes of a call to aes256_drbg_generate().
+// Instances are not thread safe, so every thread should use its own,
+// e.g. the one aes256_drbg_thread() gives it
+#define DRBG_SEED_SIZE (4 * Nk + BLOCK_SIZE)
+#define DRBG_MAX_REQUEST (1 << 16)
+#define DRBG_RESEED_INTERVAL (1UL << 20)
+
+typedef struct aes256_drbg aes256_drbg_t;
+
+extern aes256_drbg_t *aes256_drbg_init(const uint8_t *, const uint8_t *, int);
+extern void aes256_drbg_free(aes256_drbg_t *);
+extern int aes256_drbg_reseed(aes256_drbg_t *, const uint8_t *, const uint8_t *, int);
+extern int aes256_drbg_generate(aes256_drbg_t *, uint8_t *, int, const uint8_t *, int);
+extern unsigned long aes256_drbg_reseed_counter(const aes256_drbg_t *);
+extern aes256_drbg_t *aes256_drbg_thread(void);
+
+// Multithreaded ECB, CBC decryption and CTR, split across the threads
+// of pool, or run serially given NULL. The one-shot versions take a
+// thread count instead
+extern void aes256_ctx_enc_ecb_mt(const aes256_ctx_t *, const uint8_t *,
+                                  uint8_t *, int, threadpool_t *);
+extern void aes256_ctx_dec_ecb_mt(const aes256_ctx_t *, const uint8_t *,
+                                  uint8_t *, int, threadpool_t *);
+extern void aes256_ctx_dec_cbc_mt(const aes256_ctx_t *, const uint8_t *,
+                                  const uint8_t *, uint8_t *, int,
+                                  threadpool_t *);
+extern void aes256_ctx_ctr_mt(const aes256_ctx_t *, const uint8_t *,
+                              const uint8_t *, uint8_t *, int, threadpool_t *);
+extern void aes256_enc_ecb_mt(const uint8_t *, const uint8_t *, uint8_t *, int, int);
+extern void aes256_dec_ecb_mt(const uint8_t *, const uint8_t *, uint8_t *, int, int);
+extern void aes256_dec_cbc_mt(const uint8_t *, const uint8_t *, const uint8_t *,
+                              uint8_t *, int, int);
+extern void aes256_ctr_mt(const uint8_t *, const uint8_t *, const uint8_t *,
+                          uint8_t *, int, int);
+
 extern void aes256_enc_ecb(const uint8_t *, const uint8_t *, uint8_t *, int);
 extern void aes256_dec_ecb(const uint8_t *, const uint8_t *, uint8_t *, int);
 extern void aes256_enc_cbc(const uint8_t *, const uint8_t *, const uint8_t *,
@@ -22,5 +246,7 @@ extern void aes256_ctr(const uint8_t *, const uint8_t *, const uint8_t *,
                        uint8_t *, int);
 extern void get_fwd_table_entry(int, uint8_t, uint8_t *);
 extern void get_inv_table_entry(int, uint8_t, uint8_t *);
+extern uint8_t get_fwd_sbox_entry(uint8_t);
+extern uint8_t get_inv_sbox_entry(uint8_t);
 
 #endif
@@ -0,0 +1,338 @@
+#include "aes256.h"
+#include "aesni.h"
+
+#ifdef AESNI_SUPPORTED
+
+#include <cpuid.h>
+#include <wmmintrin.h>
+
+// Compile only these functions for AES-NI so that the rest of the
+// binary still runs on CPUs without it. Everything here must be
+// reached through aesni_available() first
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+
+// Number of independent blocks to keep in flight. AESENC has a latency
+// of several cycles but a throughput of one per cycle, so ECB, CTR and
+// CBC decryption can hide most of that latency by interleaving
+#define AESNI_PAR 4
+
+AESNI_TARGET static inline void load_round_keys(const uint32_t *, __m128i *);
+AESNI_TARGET static inline __m128i aesni_cipher(__m128i, const __m128i *);
+AESNI_TARGET static inline __m128i aesni_inv_cipher(__m128i, const __m128i *);
+AESNI_TARGET static inline __m128i ctr_block(uint64_t, uint64_t);
+AESNI_TARGET static inline __m128i lane_key(const uint32_t *, int, int);
+
+int aesni_available(void) {
+    // -1 means we have not asked CPUID yet
+    static int available = -1;
+
+    if (available < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        available = __get_cpuid(1, &eax, &ebx, &ecx, &edx)
+                    && (ecx & bit_AES) && (edx & bit_SSE2);
+    }
+
+    return available;
+}
+
+AESNI_TARGET
+void aesni_enc_ecb(const uint8_t *in, const uint32_t *key_sched, uint8_t *out, int nblocks) {
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    int b = 0;
+
+    for (; b + AESNI_PAR <= nblocks; b += AESNI_PAR) {
+        __m128i state[AESNI_PAR];
+        for (int i = 0; i < AESNI_PAR; i++) {
+            state[i] = _mm_xor_si128(_mm_loadu_si128(in_blocks + b + i), round_keys[0]);
+        }
+        for (int round = 1; round < Nr; round++) {
+            for (int i = 0; i < AESNI_PAR; i++) {
+                state[i] = _mm_aesenc_si128(state[i], round_keys[round]);
+            }
+        }
+        for (int i = 0; i < AESNI_PAR; i++) {
+            _mm_storeu_si128(out_blocks + b + i,
+                             _mm_aesenclast_si128(state[i], round_keys[Nr]));
+        }
+    }
+
+    for (; b < nblocks; b++) {
+        __m128i state = _mm_loadu_si128(in_blocks + b);
+        _mm_storeu_si128(out_blocks + b, aesni_cipher(state, round_keys));
+    }
+}
+
+AESNI_TARGET
+void aesni_dec_ecb(const uint8_t *in, const uint32_t *key_sched, uint8_t *out, int nblocks) {
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    int b = 0;
+
+    for (; b + AESNI_PAR <= nblocks; b += AESNI_PAR) {
+        __m128i state[AESNI_PAR];
+        for (int i = 0; i < AESNI_PAR; i++) {
+            state[i] = _mm_xor_si128(_mm_loadu_si128(in_blocks + b + i), round_keys[Nr]);
+        }
+        for (int round = Nr - 1; round > 0; round--) {
+            for (int i = 0; i < AESNI_PAR; i++) {
+                state[i] = _mm_aesdec_si128(state[i], round_keys[round]);
+            }
+        }
+        for (int i = 0; i < AESNI_PAR; i++) {
+            _mm_storeu_si128(out_blocks + b + i,
+                             _mm_aesdeclast_si128(state[i], round_keys[0]));
+        }
+    }
+
+    for (; b < nblocks; b++) {
+        __m128i state = _mm_loadu_si128(in_blocks + b);
+        _mm_storeu_si128(out_blocks + b, aesni_inv_cipher(state, round_keys));
+    }
+}
+
+// CBC encryption is inherently serial, so there is nothing to interleave
+AESNI_TARGET
+void aesni_enc_cbc(const uint8_t *iv, const uint8_t *in, const uint32_t *key_sched,
+                   uint8_t *out, int nblocks) {
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    __m128i next_iv = _mm_loadu_si128((const __m128i *)iv);
+
+    for (int b = 0; b < nblocks; b++) {
+        __m128i state = _mm_xor_si128(_mm_loadu_si128(in_blocks + b), next_iv);
+        next_iv = aesni_cipher(state, round_keys);
+        _mm_storeu_si128(out_blocks + b, next_iv);
+    }
+}
+
+AESNI_TARGET
+void aesni_dec_cbc(const uint8_t *iv, const uint8_t *in, const uint32_t *key_sched,
+                   uint8_t *out, int nblocks) {
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    __m128i next_iv = _mm_loadu_si128((const __m128i *)iv);
+    int b = 0;
+
+    for (; b + AESNI_PAR <= nblocks; b += AESNI_PAR) {
+        __m128i ciphertext[AESNI_PAR], state[AESNI_PAR];
+        for (int i = 0; i < AESNI_PAR; i++) {
+            ciphertext[i] = _mm_loadu_si128(in_blocks + b + i);
+            state[i] = _mm_xor_si128(ciphertext[i], round_keys[Nr]);
+        }
+        for (int round = Nr - 1; round > 0; round--) {
+            for (int i = 0; i < AESNI_PAR; i++) {
+                state[i] = _mm_aesdec_si128(state[i], round_keys[round]);
+            }
+        }
+        for (int i = 0; i < AESNI_PAR; i++) {
+            state[i] = _mm_aesdeclast_si128(state[i], round_keys[0]);
+            _mm_storeu_si128(out_blocks + b + i, _mm_xor_si128(state[i], next_iv));
+            next_iv = ciphertext[i];
+        }
+    }
+
+    for (; b < nblocks; b++) {
+        __m128i ciphertext = _mm_loadu_si128(in_blocks + b);
+        __m128i state = aesni_inv_cipher(ciphertext, round_keys);
+        _mm_storeu_si128(out_blocks + b, _mm_xor_si128(state, next_iv));
+        next_iv = ciphertext;
+    }
+}
+
+AESNI_TARGET
+void aesni_ctr(const uint8_t *init_ctr, const uint8_t *in, const uint32_t *key_sched,
+               uint8_t *out, int nblocks) {
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+
+    // Keep the big endian counter as two native 64-bit halves so that
+    // incrementing it is just an add with carry
+    uint64_t ctr_hi = 0, ctr_lo = 0;
+    for (int i = 0; i < 8; i++) {
+        ctr_hi = (ctr_hi << 8) | init_ctr[i];
+        ctr_lo = (ctr_lo << 8) | init_ctr[8 + i];
+    }
+
+    int b = 0;
+
+    for (; b + AESNI_PAR <= nblocks; b += AESNI_PAR) {
+        __m128i state[AESNI_PAR];
+        for (int i = 0; i < AESNI_PAR; i++) {
+            state[i] = _mm_xor_si128(ctr_block(ctr_hi, ctr_lo), round_keys[0]);
+            ctr_hi += !++ctr_lo;
+        }
+        for (int round = 1; round < Nr; round++) {
+            for (int i = 0; i < AESNI_PAR; i++) {
+                state[i] = _mm_aesenc_si128(state[i], round_keys[round]);
+            }
+        }
+        for (int i = 0; i < AESNI_PAR; i++) {
+            state[i] = _mm_aesenclast_si128(state[i], round_keys[Nr]);
+            _mm_storeu_si128(out_blocks + b + i,
+                             _mm_xor_si128(state[i], _mm_loadu_si128(in_blocks + b + i)));
+        }
+    }
+
+    for (; b < nblocks; b++) {
+        __m128i state = aesni_cipher(ctr_block(ctr_hi, ctr_lo), round_keys);
+        _mm_storeu_si128(out_blocks + b,
+                         _mm_xor_si128(state, _mm_loadu_si128(in_blocks + b)));
+        ctr_hi += !++ctr_lo;
+    }
+}
+
+// The batch API has BATCH_LANES blocks in flight under as many keys, so
+// this is aesni_enc_ecb() with a different round key for every block
+AESNI_TARGET
+void aesni_enc_lanes(const uint8_t *in, const uint32_t *lane_keys, uint8_t *out) {
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    __m128i state[BATCH_LANES];
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        state[l] = _mm_xor_si128(_mm_loadu_si128(in_blocks + l), lane_key(lane_keys, 0, l));
+    }
+    for (int round = 1; round < Nr; round++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            state[l] = _mm_aesenc_si128(state[l], lane_key(lane_keys, round, l));
+        }
+    }
+    for (int l = 0; l < BATCH_LANES; l++) {
+        _mm_storeu_si128(out_blocks + l,
+                         _mm_aesenclast_si128(state[l], lane_key(lane_keys, Nr, l)));
+    }
+}
+
+AESNI_TARGET
+void aesni_dec_lanes(const uint8_t *in, const uint32_t *lane_keys, uint8_t *out) {
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    __m128i state[BATCH_LANES];
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        state[l] = _mm_xor_si128(_mm_loadu_si128(in_blocks + l), lane_key(lane_keys, Nr, l));
+    }
+    for (int round = Nr - 1; round > 0; round--) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            state[l] = _mm_aesdec_si128(state[l], lane_key(lane_keys, round, l));
+        }
+    }
+    for (int l = 0; l < BATCH_LANES; l++) {
+        _mm_storeu_si128(out_blocks + l,
+                         _mm_aesdeclast_si128(state[l], lane_key(lane_keys, 0, l)));
+    }
+}
+
+// Round key round of lane in the batch API layout, which keeps the
+// lanes side by side for every round
+AESNI_TARGET
+static inline __m128i lane_key(const uint32_t *lane_keys, int round, int lane) {
+    return _mm_loadu_si128((const __m128i *)(lane_keys + (Nb * (BATCH_LANES * round + lane))));
+}
+
+// Assemble a counter block from its native halves. x86 is always little
+// endian, so swap each half back to big endian
+AESNI_TARGET
+static inline __m128i ctr_block(uint64_t hi, uint64_t lo) {
+    return _mm_set_epi64x((long long)__builtin_bswap64(lo),
+                          (long long)__builtin_bswap64(hi));
+}
+
+AESNI_TARGET
+static inline __m128i aesni_cipher(__m128i state, const __m128i *round_keys) {
+    state = _mm_xor_si128(state, round_keys[0]);
+    for (int round = 1; round < Nr; round++) {
+        state = _mm_aesenc_si128(state, round_keys[round]);
+    }
+    return _mm_aesenclast_si128(state, round_keys[Nr]);
+}
+
+// Equivalent inverse cipher, same as aes256_inv_cipher. AESDEC expects
+// round keys that have already been through InvMixColumns
+AESNI_TARGET
+static inline __m128i aesni_inv_cipher(__m128i state, const __m128i *round_keys) {
+    state = _mm_xor_si128(state, round_keys[Nr]);
+    for (int round = Nr - 1; round > 0; round--) {
+        state = _mm_aesdec_si128(state, round_keys[round]);
+    }
+    return _mm_aesdeclast_si128(state, round_keys[0]);
+}
+
+// Each step of the AES-256 key schedule produces one round key from the
+// previous two. even_key() handles the rounds where the previous odd
+// round key goes through RotWord, SubWord and Rcon (i % Nk == 0), and
+// odd_key() handles the SubWord-only rounds (i % Nk == 4). The
+// AESKEYGENASSIST immediate has to be a constant, hence the macro
+AESNI_TARGET
+static inline __m128i prefix_xor(__m128i key) {
+    // w0, w0^w1, w0^w1^w2, w0^w1^w2^w3
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, _mm_slli_si128(key, 8));
+}
+
+#define EVEN_KEY(prev_even, prev_odd, rcon) \
+    _mm_xor_si128(prefix_xor(prev_even), \
+                  _mm_shuffle_epi32(_mm_aeskeygenassist_si128((prev_odd), (rcon)), 0xff))
+#define ODD_KEY(prev_odd, prev_even) \
+    _mm_xor_si128(prefix_xor(prev_odd), \
+                  _mm_shuffle_epi32(_mm_aeskeygenassist_si128((prev_even), 0), 0xaa))
+
+// Same schedule as aes256_key_exp(), including the InvMixColumns (here,
+// AESIMC) step on the middle round keys for the equivalent inverse
+// cipher. The result has the same layout in memory too, so either
+// function can fill a schedule for either backend
+AESNI_TARGET
+void aesni_key_exp(const uint8_t *key, uint32_t *key_sched, int inv_mix_cols) {
+    __m128i round_keys[Nr + 1];
+
+    round_keys[0] = _mm_loadu_si128((const __m128i *)key);
+    round_keys[1] = _mm_loadu_si128((const __m128i *)(key + BLOCK_SIZE));
+    round_keys[2] = EVEN_KEY(round_keys[0], round_keys[1], 0x01);
+    round_keys[3] = ODD_KEY(round_keys[1], round_keys[2]);
+    round_keys[4] = EVEN_KEY(round_keys[2], round_keys[3], 0x02);
+    round_keys[5] = ODD_KEY(round_keys[3], round_keys[4]);
+    round_keys[6] = EVEN_KEY(round_keys[4], round_keys[5], 0x04);
+    round_keys[7] = ODD_KEY(round_keys[5], round_keys[6]);
+    round_keys[8] = EVEN_KEY(round_keys[6], round_keys[7], 0x08);
+    round_keys[9] = ODD_KEY(round_keys[7], round_keys[8]);
+    round_keys[10] = EVEN_KEY(round_keys[8], round_keys[9], 0x10);
+    round_keys[11] = ODD_KEY(round_keys[9], round_keys[10]);
+    round_keys[12] = EVEN_KEY(round_keys[10], round_keys[11], 0x20);
+    round_keys[13] = ODD_KEY(round_keys[11], round_keys[12]);
+    round_keys[14] = EVEN_KEY(round_keys[12], round_keys[13], 0x40);
+
+    if (inv_mix_cols) {
+        for (int r = 1; r < Nr; r++) {
+            round_keys[r] = _mm_aesimc_si128(round_keys[r]);
+        }
+    }
+
+    for (int r = 0; r <= Nr; r++) {
+        _mm_storeu_si128((__m128i *)(key_sched + (Nb * r)), round_keys[r]);
+    }
+}
+
+AESNI_TARGET
+static inline void load_round_keys(const uint32_t *key_sched, __m128i *round_keys) {
+    for (int r = 0; r <= Nr; r++) {
+        round_keys[r] = _mm_loadu_si128((const __m128i *)(key_sched + (Nb * r)));
+    }
+}
+
+#endif
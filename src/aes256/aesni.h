@@ -0,0 +1,27 @@
+#ifndef AESNI_H
+#define AESNI_H
+
+#include <stdint.h>
+
+// The AES-NI backend only makes sense on x86. Elsewhere (e.g., Vortex)
+// it is left out of the registry and we stick to the portable code
+#if defined(__x86_64__) || defined(__i386__)
+#define AESNI_SUPPORTED
+
+extern int aesni_available(void);
+extern void aesni_key_exp(const uint8_t *, uint32_t *, int);
+// These take a key schedule from aesni_key_exp() instead of the key
+extern void aesni_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+extern void aesni_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+extern void aesni_enc_cbc(const uint8_t *, const uint8_t *, const uint32_t *,
+                          uint8_t *, int);
+extern void aesni_dec_cbc(const uint8_t *, const uint8_t *, const uint32_t *,
+                          uint8_t *, int);
+extern void aesni_ctr(const uint8_t *, const uint8_t *, const uint32_t *,
+                      uint8_t *, int);
+// One block per lane of the batch API, each under that lane's own keys
+extern void aesni_enc_lanes(const uint8_t *, const uint32_t *, uint8_t *);
+extern void aesni_dec_lanes(const uint8_t *, const uint32_t *, uint8_t *);
+#endif
+
+#endif
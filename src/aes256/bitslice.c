@@ -0,0 +1,466 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "aes256.h"
+#include "bitslice.h"
+
+// A bitsliced AES state for BS_BLOCKS blocks: q[p][i] holds bit i of
+// byte p of every block, with block k in bit k. Every transformation
+// is then a fixed sequence of bitwise operations on whole words, with
+// no table lookups or branches that depend on the data or the key, so
+// the timing does not depend on either (or on what is in the cache)
+typedef bs_word_t bs_state_t[4 * Nb][8];
+
+// How many of the remaining blocks the next batch covers
+#define BS_BATCH(remaining) ((remaining) < BS_BLOCKS? (remaining) : BS_BLOCKS)
+
+static void cipher_batch(const uint8_t *, uint8_t *, const uint32_t *, int);
+static void inv_cipher_batch(const uint8_t *, uint8_t *, const uint32_t *, int);
+static void load_state(bs_state_t, const uint8_t *, int);
+static void store_state(uint8_t *, bs_state_t, int);
+static inline uint64_t transpose8(uint64_t);
+static void add_round_key(bs_state_t, const uint32_t *);
+static void sub_bytes(bs_state_t);
+static void inv_sub_bytes(bs_state_t);
+static void shift_rows(bs_state_t);
+static void inv_shift_rows(bs_state_t);
+static void mix_columns(bs_state_t);
+static void inv_mix_columns(bs_state_t);
+static inline void s_box(bs_word_t *);
+static inline void inv_affine(bs_word_t *);
+static inline void xtime(bs_word_t *, const bs_word_t *);
+static inline void copy_byte(bs_word_t *, const bs_word_t *);
+
+// BS_BLOCKS blocks per batch. The last partial batch still costs as
+// much as a full one
+void bitslice_enc_ecb(const uint8_t *in, const uint32_t *round_keys, uint8_t *out,
+                      int nblocks) {
+    for (int b = 0; b < nblocks; b += BS_BLOCKS) {
+        cipher_batch(in + (size_t)b * BLOCK_SIZE, out + (size_t)b * BLOCK_SIZE,
+                     round_keys, BS_BATCH(nblocks - b));
+    }
+}
+
+// Takes the same InvMixColumns'd schedule as every other dec_ecb
+void bitslice_dec_ecb(const uint8_t *in, const uint32_t *round_keys, uint8_t *out,
+                      int nblocks) {
+    for (int b = 0; b < nblocks; b += BS_BLOCKS) {
+        inv_cipher_batch(in + (size_t)b * BLOCK_SIZE, out + (size_t)b * BLOCK_SIZE,
+                         round_keys, BS_BATCH(nblocks - b));
+    }
+}
+
+// Up to BS_BLOCKS blocks at once
+static void cipher_batch(const uint8_t *in, uint8_t *out, const uint32_t *round_keys,
+                         int nblocks) {
+    bs_state_t state;
+    load_state(state, in, nblocks);
+
+    add_round_key(state, round_keys);
+
+    for (int round = 1; round <= Nr; round++) {
+        sub_bytes(state);
+        shift_rows(state);
+        if (round < Nr) {
+            mix_columns(state);
+        }
+        add_round_key(state, round_keys + (Nb * round));
+    }
+
+    store_state(out, state, nblocks);
+}
+
+// Equivalent inverse cipher from Section 5.3.5 of the AES spec
+static void inv_cipher_batch(const uint8_t *in, uint8_t *out,
+                             const uint32_t *round_keys, int nblocks) {
+    bs_state_t state;
+    load_state(state, in, nblocks);
+
+    add_round_key(state, round_keys + (Nb * Nr));
+
+    for (int round = Nr - 1; round >= 0; round--) {
+        inv_sub_bytes(state);
+        inv_shift_rows(state);
+        if (round > 0) {
+            inv_mix_columns(state);
+        }
+        add_round_key(state, round_keys + (Nb * round));
+    }
+
+    store_state(out, state, nblocks);
+}
+
+// SubWord for the key schedule, so that key expansion does not look up
+// key bytes in the S-box either. Uses four lanes of a single byte
+uint32_t bitslice_sub_word(uint32_t word) {
+    uint8_t *bytes = (uint8_t *)&word;
+    bs_word_t planes[8] = {0};
+
+    for (int k = 0; k < 4; k++) {
+        for (int i = 0; i < 8; i++) {
+            planes[i] |= (bs_word_t)((bytes[k] >> i) & 1) << k;
+        }
+    }
+
+    s_box(planes);
+
+    for (int k = 0; k < 4; k++) {
+        bytes[k] = 0;
+        for (int i = 0; i < 8; i++) {
+            bytes[k] |= ((planes[i] >> k) & 1) << i;
+        }
+    }
+
+    return word;
+}
+
+// Transpose nblocks blocks into bitsliced form, 8 blocks at a time. Any
+// lanes past nblocks are zero and their results get thrown away
+static void load_state(bs_state_t state, const uint8_t *in, int nblocks) {
+    for (int p = 0; p < 4 * Nb; p++) {
+        for (int i = 0; i < 8; i++) {
+            state[p][i] = 0;
+        }
+
+        for (int k = 0; k < nblocks; k += 8) {
+            // Byte r of rows holds byte p of block k + r
+            uint64_t rows = 0;
+            for (int r = 0; r < 8 && k + r < nblocks; r++) {
+                rows |= (uint64_t)in[BLOCK_SIZE * (k + r) + p] << (8 * r);
+            }
+
+            // Now byte i holds bit i of each of those blocks
+            uint64_t cols = transpose8(rows);
+            for (int i = 0; i < 8; i++) {
+                state[p][i] |= (bs_word_t)((cols >> (8 * i)) & 0xff) << k;
+            }
+        }
+    }
+}
+
+// Inverse of load_state()
+static void store_state(uint8_t *out, bs_state_t state, int nblocks) {
+    for (int p = 0; p < 4 * Nb; p++) {
+        for (int k = 0; k < nblocks; k += 8) {
+            uint64_t cols = 0;
+            for (int i = 0; i < 8; i++) {
+                cols |= (uint64_t)((state[p][i] >> k) & 0xff) << (8 * i);
+            }
+
+            uint64_t rows = transpose8(cols);
+            for (int r = 0; r < 8 && k + r < nblocks; r++) {
+                out[BLOCK_SIZE * (k + r) + p] = (rows >> (8 * r)) & 0xff;
+            }
+        }
+    }
+}
+
+// Transpose the 8x8 bit matrix whose row r is byte r of x, i.e., bit c
+// of byte r trades places with bit r of byte c. From Hacker's Delight
+// (2nd ed.), Section 7-3
+static inline uint64_t transpose8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+// The round key is the same for every block, so each of its bits turns
+// into either an all-zeroes or all-ones mask
+static void add_round_key(bs_state_t state, const uint32_t *round_keys) {
+    const uint8_t *key_bytes = (const uint8_t *)round_keys;
+
+    for (int p = 0; p < 4 * Nb; p++) {
+        for (int i = 0; i < 8; i++) {
+            state[p][i] ^= -(bs_word_t)((key_bytes[p] >> i) & 1);
+        }
+    }
+}
+
+static void sub_bytes(bs_state_t state) {
+    for (int p = 0; p < 4 * Nb; p++) {
+        s_box(state[p]);
+    }
+}
+
+// S^-1(y) = A^-1(S(A^-1(y))), where A^-1 is the inverse of the S-box
+// affine transformation (including its constant). The inner A^-1
+// undoes the affine step S is about to apply, leaving just the
+// inversion, which is its own inverse
+static void inv_sub_bytes(bs_state_t state) {
+    for (int p = 0; p < 4 * Nb; p++) {
+        inv_affine(state[p]);
+        s_box(state[p]);
+        inv_affine(state[p]);
+    }
+}
+
+// Byte p = 4c + r is row r of column c. ShiftRows only moves whole
+// bytes around, so it is free aside from the copying
+static void shift_rows(bs_state_t state) {
+    bs_state_t new;
+    for (int c = 0; c < Nb; c++) {
+        for (int r = 0; r < 4; r++) {
+            copy_byte(new[4*c + r], state[4*((c + r) % Nb) + r]);
+        }
+    }
+    for (int p = 0; p < 4 * Nb; p++) {
+        copy_byte(state[p], new[p]);
+    }
+}
+
+static void inv_shift_rows(bs_state_t state) {
+    bs_state_t new;
+    for (int c = 0; c < Nb; c++) {
+        for (int r = 0; r < 4; r++) {
+            copy_byte(new[4*((c + r) % Nb) + r], state[4*c + r]);
+        }
+    }
+    for (int p = 0; p < 4 * Nb; p++) {
+        copy_byte(state[p], new[p]);
+    }
+}
+
+static void mix_columns(bs_state_t state) {
+    for (int c = 0; c < Nb; c++) {
+        bs_word_t *col[4] = {state[4*c], state[4*c + 1], state[4*c + 2], state[4*c + 3]};
+        bs_word_t new[4][8];
+
+        // {02}.a_r ^ {03}.a_{r+1} ^ a_{r+2} ^ a_{r+3}
+        //     = {02}.(a_r ^ a_{r+1}) ^ a_{r+1} ^ a_{r+2} ^ a_{r+3}
+        for (int r = 0; r < 4; r++) {
+            bs_word_t sum[8];
+            for (int i = 0; i < 8; i++) {
+                sum[i] = col[r][i] ^ col[(r + 1) % 4][i];
+            }
+            xtime(new[r], sum);
+            for (int i = 0; i < 8; i++) {
+                new[r][i] ^= col[(r + 1) % 4][i] ^ col[(r + 2) % 4][i]
+                             ^ col[(r + 3) % 4][i];
+            }
+        }
+
+        for (int r = 0; r < 4; r++) {
+            copy_byte(col[r], new[r]);
+        }
+    }
+}
+
+// InvMixColumns is MixColumns after XORing {04}.(a_0 ^ a_2) into rows 0
+// and 2 and {04}.(a_1 ^ a_3) into rows 1 and 3 (The Design of Rijndael,
+// Section 4.1.3)
+static void inv_mix_columns(bs_state_t state) {
+    for (int c = 0; c < Nb; c++) {
+        bs_word_t *col[4] = {state[4*c], state[4*c + 1], state[4*c + 2], state[4*c + 3]};
+
+        for (int r = 0; r < 2; r++) {
+            bs_word_t sum[8], twice[8], four_times[8];
+            for (int i = 0; i < 8; i++) {
+                sum[i] = col[r][i] ^ col[r + 2][i];
+            }
+            xtime(twice, sum);
+            xtime(four_times, twice);
+            for (int i = 0; i < 8; i++) {
+                col[r][i] ^= four_times[i];
+                col[r + 2][i] ^= four_times[i];
+            }
+        }
+    }
+
+    mix_columns(state);
+}
+
+// The S-box circuit by Boyar and Peralta ("A depth-16 circuit for the
+// AES S-box", 2011): 113 gates, 32 of them AND. x0 is the most
+// significant bit
+static inline void s_box(bs_word_t *q) {
+    bs_word_t x0, x1, x2, x3, x4, x5, x6, x7;
+    bs_word_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    bs_word_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    bs_word_t y20, y21;
+    bs_word_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    bs_word_t z10, z11, z12, z13, z14, z15, z16, z17;
+    bs_word_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    bs_word_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    bs_word_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    bs_word_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    bs_word_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    bs_word_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    bs_word_t t60, t61, t62, t63, t64, t65, t66, t67;
+    bs_word_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    // Top linear transformation
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // Non-linear section
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // Bottom linear transformation
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+// b_i = b_{i+2} ^ b_{i+5} ^ b_{i+7} ^ {05}_i (indices mod 8), the
+// inverse of the affine transformation in Section 5.1.1 of the AES spec
+static inline void inv_affine(bs_word_t *q) {
+    bs_word_t new[8];
+    for (int i = 0; i < 8; i++) {
+        new[i] = q[(i + 2) % 8] ^ q[(i + 5) % 8] ^ q[(i + 7) % 8];
+    }
+    new[0] = ~new[0];
+    new[2] = ~new[2];
+    copy_byte(q, new);
+}
+
+// {02}.a: shift every bit up one place and reduce by the AES polynomial
+// x^8 + x^4 + x^3 + x + 1 when the top bit falls off
+static inline void xtime(bs_word_t *out, const bs_word_t *a) {
+    out[0] = a[7];
+    out[1] = a[0] ^ a[7];
+    out[2] = a[1];
+    out[3] = a[2] ^ a[7];
+    out[4] = a[3] ^ a[7];
+    out[5] = a[4];
+    out[6] = a[5];
+    out[7] = a[6];
+}
+
+static inline void copy_byte(bs_word_t *dest, const bs_word_t *src) {
+    for (int i = 0; i < 8; i++) {
+        dest[i] = src[i];
+    }
+}
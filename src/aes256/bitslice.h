@@ -0,0 +1,18 @@
+#ifndef BITSLICE_H
+#define BITSLICE_H
+
+#include <stdint.h>
+
+// Each bit of a bs_word_t belongs to a different block, so this is
+// also how many blocks the bitsliced kernels process at once. 32 bits
+// matches Vortex; switch to uint64_t for 64 blocks on 64-bit hosts
+typedef uint32_t bs_word_t;
+#define BS_BLOCKS ((int)(8 * sizeof (bs_word_t)))
+
+// Same interface as aesni_enc_ecb() and aesni_dec_ecb(), processing
+// BS_BLOCKS blocks at a time
+extern void bitslice_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+extern void bitslice_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+extern uint32_t bitslice_sub_word(uint32_t);
+
+#endif
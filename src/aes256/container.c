@@ -0,0 +1,286 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "container.h"
+
+// The chunked container format, see container.h. This only works on
+// buffers; reading just the parts of a file that one chunk needs is up
+// to the caller, which is what the fixed-size header and footer are for
+
+// One container being encrypted or decrypted, shared by the threads of
+// the pool, a chunk per iteration
+typedef struct {
+    const aes256_ctx_t *ctx;
+    const container_header_t *header;
+    const uint8_t *in;
+    uint8_t *out;
+    // The index in the container, and whether any chunk failed to
+    // decrypt
+    uint8_t *index;
+    const container_entry_t *entries;
+    pthread_mutex_t lock;
+    int failed;
+} container_job_t;
+
+static void enc_range(void *, int, int);
+static void dec_range(void *, int, int);
+static void chunk_iv(const container_header_t *, uint64_t, uint8_t *);
+static void write_header(container_header_t *, int, uint64_t, const uint8_t *);
+static void write_entry(uint8_t *, const container_entry_t *);
+static inline uint64_t load_big_64(const uint8_t *);
+static inline void store_big_64(uint8_t *, uint64_t);
+static inline uint32_t load_big_32(const uint8_t *);
+static inline void store_big_32(uint8_t *, uint32_t);
+
+// Bytes of container for len bytes of data in chunks of chunk_size, or
+// 0 if that would take more than CONTAINER_MAX_CHUNKS chunks. Since the
+// length can come straight from a header we have not checked yet, none
+// of this can be allowed to wrap
+uint64_t container_size(uint64_t len, int chunk_size) {
+    uint64_t nchunks = container_num_chunks(len, chunk_size);
+    uint64_t overhead = CONTAINER_HEADER_SIZE + nchunks * CONTAINER_ENTRY_SIZE
+                        + CONTAINER_FOOTER_SIZE;
+    if (nchunks > CONTAINER_MAX_CHUNKS || len > UINT64_MAX - overhead) {
+        return 0;
+    }
+
+    return len + overhead;
+}
+
+// There is always at least one chunk, so that even an empty container
+// has a tag vouching for its header
+uint64_t container_num_chunks(uint64_t data_len, int chunk_size) {
+    return data_len? data_len / chunk_size + (data_len % chunk_size != 0) : 1;
+}
+
+// Encrypt len bytes into a container of container_size() bytes at out,
+// with chunks of chunk_size bytes encrypted under the GCM_IV_SIZE-byte
+// nonce (and ones derived from it) split between the threads of pool.
+// To encrypt in place, put the data where it goes in the container, at
+// in = out + CONTAINER_HEADER_SIZE. Returns -1, having written nothing,
+// if container_size() says it cannot be done
+int container_enc(const aes256_ctx_t *ctx, const uint8_t *nonce, int chunk_size,
+                  const uint8_t *in, uint64_t len, uint8_t *out, threadpool_t *pool) {
+    if (!container_size(len, chunk_size)) {
+        return -1;
+    }
+
+    container_header_t header;
+    write_header(&header, chunk_size, len, nonce);
+    memcpy(out, header.raw, CONTAINER_HEADER_SIZE);
+
+    int nchunks = container_num_chunks(len, chunk_size);
+    uint8_t *index = out + CONTAINER_HEADER_SIZE + len;
+    container_job_t job = {.ctx = ctx, .header = &header, .in = in,
+                           .out = out + CONTAINER_HEADER_SIZE, .index = index};
+    threadpool_parallel_for(pool, nchunks, 1, enc_range, &job);
+
+    uint8_t *footer = index + (uint64_t)nchunks * CONTAINER_ENTRY_SIZE;
+    store_big_64(footer, nchunks);
+    memcpy(footer + 8, CONTAINER_INDEX_MAGIC, 8);
+    return 0;
+}
+
+// Decrypt a whole container of in_len bytes into out, which needs room
+// for its data length (at most in_len), and set out_len to that. Returns
+// -1 if it is not a container we can read (or we are out of memory)
+// and -2 if a chunk fails to authenticate, in which case out is all
+// zeroes. To decrypt in place, leave the data where it is, at
+// out = in + CONTAINER_HEADER_SIZE
+int container_dec(const aes256_ctx_t *ctx, const uint8_t *in, uint64_t in_len,
+                  uint8_t *out, uint64_t *out_len, threadpool_t *pool) {
+    container_header_t header;
+    uint64_t nchunks;
+    if (in_len < CONTAINER_HEADER_SIZE + CONTAINER_FOOTER_SIZE
+            || container_parse_header(in, &header) < 0
+            || container_parse_footer(in + in_len - CONTAINER_FOOTER_SIZE, &nchunks) < 0
+            || header.data_len > in_len
+            || nchunks != container_num_chunks(header.data_len, header.chunk_size)
+            || in_len != container_size(header.data_len, header.chunk_size)) {
+        return -1;
+    }
+
+    // Every chunk has to be right where the chunk size says, so the
+    // data cannot overlap itself, the index, or anything else
+    container_entry_t *entries;
+    if (!(entries = malloc(nchunks * sizeof *entries))) {
+        return -1;
+    }
+    const uint8_t *index = in + CONTAINER_HEADER_SIZE + header.data_len;
+    for (uint64_t c = 0; c < nchunks; c++) {
+        uint64_t first = c * header.chunk_size;
+        uint64_t rest = header.data_len - first;
+
+        container_parse_entry(index + c * CONTAINER_ENTRY_SIZE, &entries[c]);
+        if (entries[c].offset != CONTAINER_HEADER_SIZE + first
+                || (uint64_t)entries[c].len != (rest < (uint64_t)header.chunk_size?
+                                                rest : (uint64_t)header.chunk_size)) {
+            free(entries);
+            return -1;
+        }
+    }
+
+    container_job_t job = {.ctx = ctx, .header = &header, .in = in, .out = out,
+                           .entries = entries};
+    pthread_mutex_init(&job.lock, NULL);
+    threadpool_parallel_for(pool, nchunks, 1, dec_range, &job);
+    pthread_mutex_destroy(&job.lock);
+    free(entries);
+
+    if (job.failed) {
+        if (header.data_len) {
+            memset(out, 0, header.data_len);
+        }
+        return -2;
+    }
+
+    *out_len = header.data_len;
+    return 0;
+}
+
+// Returns -1 if this is not a header we understand
+int container_parse_header(const uint8_t *raw, container_header_t *header) {
+    if (memcmp(raw, CONTAINER_MAGIC, 8)
+            || load_big_32(raw + 8) != CONTAINER_VERSION) {
+        return -1;
+    }
+
+    uint32_t chunk_size = load_big_32(raw + 12);
+    if (!chunk_size || chunk_size > INT32_MAX) {
+        return -1;
+    }
+
+    header->chunk_size = chunk_size;
+    header->data_len = load_big_64(raw + 16);
+    memcpy(header->nonce, raw + 24, GCM_IV_SIZE);
+    memcpy(header->raw, raw, CONTAINER_HEADER_SIZE);
+    return 0;
+}
+
+// Returns -1 if the index does not end here
+int container_parse_footer(const uint8_t *raw, uint64_t *nchunks) {
+    if (memcmp(raw + 8, CONTAINER_INDEX_MAGIC, 8)) {
+        return -1;
+    }
+
+    *nchunks = load_big_64(raw);
+    return 0;
+}
+
+void container_parse_entry(const uint8_t *raw, container_entry_t *entry) {
+    entry->offset = load_big_64(raw);
+    uint32_t len = load_big_32(raw + 8);
+    entry->len = len > INT32_MAX? -1 : (int)len;
+    memcpy(entry->tag, raw + 12, GCM_TAG_SIZE);
+}
+
+// Decrypt chunk number chunk, with its entry in the index, from in,
+// which holds just that chunk. Returns -1 and zeroes out if the chunk
+// does not authenticate, or if the entry does not make sense for this
+// header
+int container_dec_chunk(const aes256_ctx_t *ctx, const container_header_t *header,
+                        int chunk, const container_entry_t *entry, const uint8_t *in,
+                        uint8_t *out) {
+    if (entry->offset != CONTAINER_HEADER_SIZE + (uint64_t)chunk * header->chunk_size
+            || entry->len < 0 || entry->len > header->chunk_size) {
+        return -1;
+    }
+
+    uint8_t iv[GCM_IV_SIZE];
+    chunk_iv(header, chunk, iv);
+    return aes256_ctx_dec_gcm(ctx, iv, GCM_IV_SIZE, header->raw, CONTAINER_HEADER_SIZE,
+                              in, out, entry->len, entry->tag);
+}
+
+static void enc_range(void *arg, int first_chunk, int nchunks) {
+    container_job_t *job = arg;
+    const container_header_t *header = job->header;
+
+    for (int c = first_chunk; c < first_chunk + nchunks; c++) {
+        uint64_t first = (uint64_t)c * header->chunk_size;
+        uint64_t rest = header->data_len - first;
+        container_entry_t entry = {
+            .offset = CONTAINER_HEADER_SIZE + first,
+            .len = rest < (uint64_t)header->chunk_size? (int)rest : header->chunk_size,
+        };
+
+        uint8_t iv[GCM_IV_SIZE];
+        chunk_iv(header, c, iv);
+        aes256_ctx_enc_gcm(job->ctx, iv, GCM_IV_SIZE, header->raw, CONTAINER_HEADER_SIZE,
+                           job->in + first, job->out + first, entry.len, entry.tag);
+        write_entry(job->index + (uint64_t)c * CONTAINER_ENTRY_SIZE, &entry);
+    }
+}
+
+static void dec_range(void *arg, int first_chunk, int nchunks) {
+    container_job_t *job = arg;
+    int failed = 0;
+
+    for (int c = first_chunk; c < first_chunk + nchunks; c++) {
+        const container_entry_t *entry = &job->entries[c];
+        uint64_t first = entry->offset - CONTAINER_HEADER_SIZE;
+
+        if (container_dec_chunk(job->ctx, job->header, c, entry, job->in + entry->offset,
+                                job->out + first) < 0) {
+            failed = 1;
+        }
+    }
+
+    if (failed) {
+        pthread_mutex_lock(&job->lock);
+        job->failed = 1;
+        pthread_mutex_unlock(&job->lock);
+    }
+}
+
+// The nonce with the chunk number XORed into the end, which keeps the
+// IVs of every chunk distinct
+static void chunk_iv(const container_header_t *header, uint64_t chunk, uint8_t *iv) {
+    uint8_t number[8];
+    store_big_64(number, chunk);
+
+    memcpy(iv, header->nonce, GCM_IV_SIZE);
+    for (int i = 0; i < 8; i++) {
+        iv[GCM_IV_SIZE - 8 + i] ^= number[i];
+    }
+}
+
+static void write_header(container_header_t *header, int chunk_size, uint64_t data_len,
+                         const uint8_t *nonce) {
+    header->chunk_size = chunk_size;
+    header->data_len = data_len;
+    memcpy(header->nonce, nonce, GCM_IV_SIZE);
+
+    memcpy(header->raw, CONTAINER_MAGIC, 8);
+    store_big_32(header->raw + 8, CONTAINER_VERSION);
+    store_big_32(header->raw + 12, chunk_size);
+    store_big_64(header->raw + 16, data_len);
+    memcpy(header->raw + 24, nonce, GCM_IV_SIZE);
+}
+
+static void write_entry(uint8_t *raw, const container_entry_t *entry) {
+    store_big_64(raw, entry->offset);
+    store_big_32(raw + 8, entry->len);
+    memcpy(raw + 12, entry->tag, GCM_TAG_SIZE);
+}
+
+static inline uint64_t load_big_64(const uint8_t *bytes) {
+    return (uint64_t)load_big_32(bytes) << 32 | load_big_32(bytes + 4);
+}
+
+static inline void store_big_64(uint8_t *bytes, uint64_t word) {
+    store_big_32(bytes, word >> 32);
+    store_big_32(bytes + 4, word & 0xffffffff);
+}
+
+static inline uint32_t load_big_32(const uint8_t *bytes) {
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16
+           | (uint32_t)bytes[2] << 8 | bytes[3];
+}
+
+static inline void store_big_32(uint8_t *bytes, uint32_t word) {
+    bytes[0] = word >> 24;
+    bytes[1] = word >> 16;
+    bytes[2] = word >> 8;
+    bytes[3] = word;
+}
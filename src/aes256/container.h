@@ -0,0 +1,58 @@
+#ifndef CONTAINER_H
+#define CONTAINER_H
+
+#include <stdint.h>
+#include "aes256.h"
+#include "threadpool.h"
+
+// A file format for encrypted data that can be decrypted in parallel or
+// a piece at a time: a header, then the data in chunks of a fixed size
+// (but the last), each encrypted with GCM on its own, then an index
+// with the offset, length and tag of every chunk, and a footer saying
+// how many there are. Every chunk gets its own IV, the nonce from the
+// header with the chunk number XORed into its last 8 bytes, and
+// authenticates the header as AAD, so chunks cannot be swapped,
+// dropped, or moved to another file under the same key. Numbers are
+// big endian
+#define CONTAINER_MAGIC "AES256CT"
+#define CONTAINER_INDEX_MAGIC "AES256IX"
+#define CONTAINER_VERSION 1
+
+// Magic, version, chunk size, data length, nonce
+#define CONTAINER_HEADER_SIZE (8 + 4 + 4 + 8 + GCM_IV_SIZE)
+// Offset, length, tag
+#define CONTAINER_ENTRY_SIZE (8 + 4 + GCM_TAG_SIZE)
+// Number of chunks, index magic
+#define CONTAINER_FOOTER_SIZE (8 + 8)
+// Chunks get numbered with ints, and the threads split them up that way
+#define CONTAINER_MAX_CHUNKS INT32_MAX
+
+typedef struct {
+    int chunk_size;
+    uint64_t data_len;
+    uint8_t nonce[GCM_IV_SIZE];
+    // The header as it appears in the file, which every chunk
+    // authenticates
+    uint8_t raw[CONTAINER_HEADER_SIZE];
+} container_header_t;
+
+typedef struct {
+    uint64_t offset;
+    int len;
+    uint8_t tag[GCM_TAG_SIZE];
+} container_entry_t;
+
+extern uint64_t container_size(uint64_t, int);
+extern uint64_t container_num_chunks(uint64_t, int);
+extern int container_enc(const aes256_ctx_t *, const uint8_t *, int,
+                         const uint8_t *, uint64_t, uint8_t *, threadpool_t *);
+extern int container_dec(const aes256_ctx_t *, const uint8_t *, uint64_t, uint8_t *,
+                         uint64_t *, threadpool_t *);
+extern int container_parse_header(const uint8_t *, container_header_t *);
+extern int container_parse_footer(const uint8_t *, uint64_t *);
+extern void container_parse_entry(const uint8_t *, container_entry_t *);
+extern int container_dec_chunk(const aes256_ctx_t *, const container_header_t *,
+                               int, const container_entry_t *, const uint8_t *,
+                               uint8_t *);
+
+#endif
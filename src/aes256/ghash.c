@@ -0,0 +1,291 @@
+#include <string.h>
+#include "ghash.h"
+
+// GHASH, the universal hash behind GCM: Y = (Y ^ X) * H for every block
+// X, in GF(2^128) with the bits of each byte in reverse order (see
+// NIST SP 800-38D). The portable version is Shoup's method with a table
+// of 16 multiples of H, which is only 256 bytes, so it still fits in
+// Vortex local memory next to the AES tables. x86 CPUs with PCLMULQDQ
+// multiply directly instead
+
+static void table_init(ghash_key_t *, const uint8_t *);
+static void table_mult(const ghash_key_t *, uint8_t *);
+static inline uint64_t load_big_64(const uint8_t *);
+static inline void store_big_64(uint8_t *, uint64_t);
+
+#ifdef CLMUL_SUPPORTED
+
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+// Compile only these functions for PCLMULQDQ so that the rest of the
+// binary still runs on CPUs without it. Everything here must be
+// reached through clmul_available() first
+#define CLMUL_TARGET __attribute__((target("pclmul,sse2,ssse3")))
+
+CLMUL_TARGET static void clmul_init(ghash_key_t *, const uint8_t *);
+CLMUL_TARGET static void clmul_update(const ghash_key_t *, uint8_t *,
+                                      const uint8_t *, int);
+CLMUL_TARGET static inline __m128i reverse_bytes(__m128i);
+CLMUL_TARGET static inline void clmul_wide(__m128i, __m128i, __m128i *, __m128i *);
+CLMUL_TARGET static inline __m128i clmul_reduce(__m128i, __m128i);
+
+int clmul_available(void) {
+    // -1 means we have not asked CPUID yet
+    static int available = -1;
+
+    if (available < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        available = __get_cpuid(1, &eax, &ebx, &ecx, &edx)
+                    && (ecx & bit_PCLMUL) && (ecx & bit_SSSE3) && (edx & bit_SSE2);
+    }
+
+    return available;
+}
+
+#else
+
+int clmul_available(void) {
+    return 0;
+}
+
+#endif
+
+// Precompute whatever ghash_update() needs for the subkey h (the
+// encryption of the zero block). With clmul, use PCLMULQDQ if this
+// machine has it
+void ghash_init(ghash_key_t *key, const uint8_t *h, int clmul) {
+    memset(key, 0, sizeof *key);
+
+#ifdef CLMUL_SUPPORTED
+    if (clmul && clmul_available()) {
+        clmul_init(key, h);
+        return;
+    }
+#else
+    (void)clmul;
+#endif
+
+    table_init(key, h);
+}
+
+// Fold len bytes of data into the running hash y. GCM pads the AAD and
+// the ciphertext with zeroes to a whole block, so a partial block at
+// the end gets the same, but only the last call for either may have one
+void ghash_update(const ghash_key_t *key, uint8_t *y, const uint8_t *data,
+                  int len) {
+    int nblocks = len / 16;
+    int rem = len % 16;
+
+#ifdef CLMUL_SUPPORTED
+    if (key->clmul) {
+        clmul_update(key, y, data, nblocks);
+    } else
+#endif
+    {
+        for (int b = 0; b < nblocks; b++) {
+            for (int i = 0; i < 16; i++) {
+                y[i] ^= data[16 * b + i];
+            }
+            table_mult(key, y);
+        }
+    }
+
+    if (rem) {
+        uint8_t last[16] = {0};
+        memcpy(last, data + 16 * nblocks, rem);
+        ghash_update(key, y, last, 16);
+    }
+}
+
+// Fold in the block GCM ends the hash with, holding the lengths in bits
+// of the two inputs, given here in bytes
+void ghash_lengths(const ghash_key_t *key, uint8_t *y, uint64_t len_a,
+                   uint64_t len_c) {
+    uint8_t block[16];
+    store_big_64(block, len_a * 8);
+    store_big_64(block + 8, len_c * 8);
+    ghash_update(key, y, block, 16);
+}
+
+// Every multiple of H by a 4-bit polynomial. Index 8 is H itself, since
+// the bits are reversed, and indices 4, 2 and 1 are H times x, x^2 and
+// x^3, which is a shift right. The rest are sums of those
+static void table_init(ghash_key_t *key, const uint8_t *h) {
+    uint64_t hh = load_big_64(h);
+    uint64_t hl = load_big_64(h + 8);
+
+    key->hh[8] = hh;
+    key->hl[8] = hl;
+    for (int i = 4; i > 0; i >>= 1) {
+        // Shifting out a 1 means reducing by x^128 + x^7 + x^2 + x + 1
+        uint64_t carry = (hl & 1)? 0xe100000000000000 : 0;
+        hl = (hh << 63) | (hl >> 1);
+        hh = (hh >> 1) ^ carry;
+        key->hh[i] = hh;
+        key->hl[i] = hl;
+    }
+
+    for (int i = 2; i <= 8; i *= 2) {
+        for (int j = 1; j < i; j++) {
+            key->hh[i + j] = key->hh[i] ^ key->hh[j];
+            key->hl[i + j] = key->hl[i] ^ key->hl[j];
+        }
+    }
+}
+
+// y = y * H, a nibble at a time from the last byte to the first. Each
+// step shifts the product 4 bits along and reduces the 4 bits that fall
+// off the end with a second, fixed table
+static void table_mult(const ghash_key_t *key, uint8_t *y) {
+    static const uint64_t reduce[16] = {
+        0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+        0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+    };
+    uint64_t zh = 0, zl = 0;
+
+    for (int i = 15; i >= 0; i--) {
+        int nibbles[2] = {y[i] & 0xf, y[i] >> 4};
+
+        for (int n = 0; n < 2; n++) {
+            int rem = zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (reduce[rem] << 48);
+            zh ^= key->hh[nibbles[n]];
+            zl ^= key->hl[nibbles[n]];
+        }
+    }
+
+    store_big_64(y, zh);
+    store_big_64(y + 8, zl);
+}
+
+static inline uint64_t load_big_64(const uint8_t *bytes) {
+    uint64_t word = 0;
+    for (int i = 0; i < 8; i++) {
+        word = (word << 8) | bytes[i];
+    }
+    return word;
+}
+
+static inline void store_big_64(uint8_t *bytes, uint64_t word) {
+    for (int i = 7; i >= 0; i--) {
+        bytes[i] = word & 0xff;
+        word >>= 8;
+    }
+}
+
+#ifdef CLMUL_SUPPORTED
+
+// Keep H, H^2, H^3 and H^4 around, so that clmul_update() can multiply
+// four blocks by them and reduce once for all four
+CLMUL_TARGET
+static void clmul_init(ghash_key_t *key, const uint8_t *h) {
+    __m128i h1 = reverse_bytes(_mm_loadu_si128((const __m128i *)h));
+    __m128i power = h1;
+
+    for (int i = 0; i < GHASH_POWERS; i++) {
+        _mm_storeu_si128((__m128i *)key->powers[i], power);
+
+        __m128i lo, hi;
+        clmul_wide(power, h1, &lo, &hi);
+        power = clmul_reduce(lo, hi);
+    }
+
+    key->clmul = 1;
+}
+
+// Y = (Y ^ X1) * H^4 ^ X2 * H^3 ^ X3 * H^2 ^ X4 * H is the same as four
+// rounds of Y = (Y ^ X) * H, but the four products are independent, so
+// their PCLMULQDQs overlap and they share a single reduction
+CLMUL_TARGET
+static void clmul_update(const ghash_key_t *key, uint8_t *y, const uint8_t *data,
+                         int nblocks) {
+    __m128i powers[GHASH_POWERS];
+    for (int i = 0; i < GHASH_POWERS; i++) {
+        powers[i] = _mm_loadu_si128((const __m128i *)key->powers[i]);
+    }
+
+    const __m128i *blocks = (const __m128i *)data;
+    __m128i acc = reverse_bytes(_mm_loadu_si128((const __m128i *)y));
+    int b = 0;
+
+    for (; b + GHASH_POWERS <= nblocks; b += GHASH_POWERS) {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+        for (int i = 0; i < GHASH_POWERS; i++) {
+            __m128i x = reverse_bytes(_mm_loadu_si128(blocks + b + i));
+            if (!i) {
+                x = _mm_xor_si128(x, acc);
+            }
+
+            __m128i prod_lo, prod_hi;
+            clmul_wide(x, powers[GHASH_POWERS - 1 - i], &prod_lo, &prod_hi);
+            lo = _mm_xor_si128(lo, prod_lo);
+            hi = _mm_xor_si128(hi, prod_hi);
+        }
+
+        acc = clmul_reduce(lo, hi);
+    }
+
+    for (; b < nblocks; b++) {
+        __m128i x = reverse_bytes(_mm_loadu_si128(blocks + b));
+        __m128i lo, hi;
+        clmul_wide(_mm_xor_si128(acc, x), powers[0], &lo, &hi);
+        acc = clmul_reduce(lo, hi);
+    }
+
+    _mm_storeu_si128((__m128i *)y, reverse_bytes(acc));
+}
+
+CLMUL_TARGET
+static inline __m128i reverse_bytes(__m128i block) {
+    const __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                      8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(block, mask);
+}
+
+// The 256-bit carry-less product of a and b, without reducing it
+CLMUL_TARGET
+static inline void clmul_wide(__m128i a, __m128i b, __m128i *lo, __m128i *hi) {
+    __m128i ll = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i hh = _mm_clmulepi64_si128(a, b, 0x11);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                                _mm_clmulepi64_si128(a, b, 0x01));
+
+    *lo = _mm_xor_si128(ll, _mm_slli_si128(mid, 8));
+    *hi = _mm_xor_si128(hh, _mm_srli_si128(mid, 8));
+}
+
+// Reduce a 256-bit product modulo x^128 + x^7 + x^2 + x + 1, following
+// Gueron and Kounavis, "Intel Carry-Less Multiplication Instruction and
+// its Usage for Computing the GCM Mode" (2010), Algorithm 5. With the
+// bits reversed the product comes out one bit short, so shift it left
+// by one first
+CLMUL_TARGET
+static inline __m128i clmul_reduce(__m128i lo, __m128i hi) {
+    __m128i lo_carry = _mm_srli_epi32(lo, 31);
+    __m128i hi_carry = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    hi = _mm_or_si128(hi, _mm_srli_si128(lo_carry, 12));
+    hi = _mm_or_si128(hi, _mm_slli_si128(hi_carry, 4));
+    lo = _mm_or_si128(lo, _mm_slli_si128(lo_carry, 4));
+
+    __m128i a = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31),
+                                            _mm_slli_epi32(lo, 30)),
+                              _mm_slli_epi32(lo, 25));
+    __m128i a_hi = _mm_srli_si128(a, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(a, 12));
+
+    __m128i b = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1),
+                                            _mm_srli_epi32(lo, 2)),
+                              _mm_srli_epi32(lo, 7));
+    b = _mm_xor_si128(b, a_hi);
+
+    return _mm_xor_si128(hi, _mm_xor_si128(lo, b));
+}
+
+#endif
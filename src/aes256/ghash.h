@@ -0,0 +1,33 @@
+#ifndef GHASH_H
+#define GHASH_H
+
+#include <stdint.h>
+
+// The carry-less multiply backend only makes sense on x86. Elsewhere
+// (e.g., Vortex) GHASH always uses the 4-bit tables
+#if defined(__x86_64__) || defined(__i386__)
+#define CLMUL_SUPPORTED
+#endif
+
+// How many blocks the carry-less multiply backend folds into the hash
+// at once, using the powers of H up to this one
+#define GHASH_POWERS 4
+
+// The GHASH subkey H along with whatever we precomputed from it
+typedef struct {
+    // Every 4-bit multiple of H, split into the high and low 64 bits of
+    // the 128-bit GCM field element
+    uint64_t hh[16];
+    uint64_t hl[16];
+    // H, H^2, ..., H^GHASH_POWERS with their bytes reversed for
+    // PCLMULQDQ, if clmul is set
+    uint8_t powers[GHASH_POWERS][16];
+    int clmul;
+} ghash_key_t;
+
+extern int clmul_available(void);
+extern void ghash_init(ghash_key_t *, const uint8_t *, int);
+extern void ghash_update(const ghash_key_t *, uint8_t *, const uint8_t *, int);
+extern void ghash_lengths(const ghash_key_t *, uint8_t *, uint64_t, uint64_t);
+
+#endif
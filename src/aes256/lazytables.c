@@ -0,0 +1,119 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "aes256.h"
+
+#ifdef AES_LAZYTABLES
+#include "tables.h"
+
+// The same tables tables.c defines, but zero-initialized, so they take
+// no space in the binary and nothing touches their pages until
+// tables_init_fwd() or tables_init_inv() fills them in
+uint8_t T0_fwd[256][4] TABLE_ALIGN;
+uint8_t T1_fwd[256][4] TABLE_ALIGN;
+uint8_t T2_fwd[256][4] TABLE_ALIGN;
+uint8_t T3_fwd[256][4] TABLE_ALIGN;
+uint8_t T0_inv[256][4] TABLE_ALIGN;
+uint8_t T1_inv[256][4] TABLE_ALIGN;
+uint8_t T2_inv[256][4] TABLE_ALIGN;
+uint8_t T3_inv[256][4] TABLE_ALIGN;
+
+#ifdef AES_DUPTABLE
+uint8_t T_fwd_dup[256][8] TABLE_ALIGN;
+uint8_t T_inv_dup[256][8] TABLE_ALIGN;
+#else
+uint32_t T0_fwd_words[256] TABLE_ALIGN;
+uint32_t T0_inv_words[256] TABLE_ALIGN;
+# ifndef AES_MONOTABLE
+uint32_t T1_fwd_words[256] TABLE_ALIGN;
+uint32_t T2_fwd_words[256] TABLE_ALIGN;
+uint32_t T3_fwd_words[256] TABLE_ALIGN;
+uint32_t T1_inv_words[256] TABLE_ALIGN;
+uint32_t T2_inv_words[256] TABLE_ALIGN;
+uint32_t T3_inv_words[256] TABLE_ALIGN;
+# endif
+#endif
+
+#ifdef AES_SBOXWORDS
+uint32_t S_fwd_words[256] TABLE_ALIGN;
+uint32_t S_inv_words[256] TABLE_ALIGN;
+#endif
+
+static void fill_tables(int);
+static void fill_fwd_tables(void);
+static void fill_inv_tables(void);
+
+static pthread_once_t fwd_once = PTHREAD_ONCE_INIT;
+static pthread_once_t inv_once = PTHREAD_ONCE_INIT;
+
+// Safe to call from every thread before every batch of blocks: after
+// the first call, pthread_once() is just a load and a branch
+void tables_init_fwd(void) {
+    pthread_once(&fwd_once, fill_fwd_tables);
+}
+
+void tables_init_inv(void) {
+    pthread_once(&inv_once, fill_inv_tables);
+}
+
+static void fill_fwd_tables(void) {
+    fill_tables(0);
+}
+
+static void fill_inv_tables(void) {
+    fill_tables(1);
+}
+
+// Write out every table for one direction, using the same entries
+// `make tablegen` prints. This covers every table-based implementation,
+// whichever one ends up running
+static void fill_tables(int dec) {
+    uint8_t (*bytes[])[4] = {
+        dec? T0_inv : T0_fwd,
+        dec? T1_inv : T1_fwd,
+        dec? T2_inv : T2_fwd,
+        dec? T3_inv : T3_fwd,
+    };
+#ifdef AES_DUPTABLE
+    uint8_t (*dup)[8] = dec? T_inv_dup : T_fwd_dup;
+#else
+    uint32_t *words[] = {
+        dec? T0_inv_words : T0_fwd_words,
+# ifndef AES_MONOTABLE
+        dec? T1_inv_words : T1_fwd_words,
+        dec? T2_inv_words : T2_fwd_words,
+        dec? T3_inv_words : T3_fwd_words,
+# endif
+    };
+#endif
+#ifdef AES_SBOXWORDS
+    uint32_t *sbox_words = dec? S_inv_words : S_fwd_words;
+#endif
+
+    for (int byte = 0; byte < 256; byte++) {
+        for (int table_num = 0; table_num < 4; table_num++) {
+            if (dec) {
+                get_inv_table_entry(table_num, byte, bytes[table_num][byte]);
+            } else {
+                get_fwd_table_entry(table_num, byte, bytes[table_num][byte]);
+            }
+
+            // Word tables keep byte k of the entry at byte k in memory
+#ifndef AES_DUPTABLE
+            if (table_num < (int)(sizeof words / sizeof words[0])) {
+                memcpy(&words[table_num][byte], bytes[table_num][byte], 4);
+            }
+#endif
+        }
+
+#ifdef AES_DUPTABLE
+        memcpy(dup[byte], bytes[0][byte], 4);
+        memcpy(dup[byte] + 4, bytes[0][byte], 4);
+#endif
+#ifdef AES_SBOXWORDS
+        memset(&sbox_words[byte], dec? get_inv_sbox_entry(byte) : get_fwd_sbox_entry(byte),
+               sizeof sbox_words[byte]);
+#endif
+    }
+}
+#endif
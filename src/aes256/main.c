@@ -1,8 +1,15 @@
+#include <limits.h>
+#include <pthread.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/stat.h>
 #include "aes256.h"
 #include "common.h"
+#include "container.h"
+#include "selftest.h"
 
 typedef enum {
     ENCRYPT_ECB,
@@ -11,28 +18,156 @@ typedef enum {
     DECRYPT_CBC,
     ENCRYPT_CTR,
     DECRYPT_CTR,
+    ENCRYPT_GCM,
+    DECRYPT_GCM,
+    ENCRYPT_XTS,
+    DECRYPT_XTS,
+    MAC_CMAC,
+    ENCRYPT_CHUNKED,
+    DECRYPT_CHUNKED,
 } aes_mode_t;
 
+// Most of the library counts bytes in ints, so files bigger than that
+// go through it this much at a time: a whole number of blocks, and of
+// any power of two sector size up to it
+#define PIECE_SIZE (1 << 30)
+
+// The random bytes for every file of `aes256 rand', which the threads
+// of the pool fill in a few DRBG requests at a time
+typedef struct {
+    uint8_t *out;
+    int len;
+    pthread_mutex_t lock;
+    int failed;
+} rand_job_t;
+
+static void list_impls(FILE *);
 static int tablegen(void);
-static char *pad(char *, int *, int);
-static char *zeropad(char *, int *, int);
-static int write_to_file(char *, char *, int);
+static void print_byte_table(int, int);
+static void print_word_table(int, int);
+static void print_dup_table(int);
+static void print_sbox_words(int);
+static void get_table_entry(int, int, int, uint8_t *);
+static void report_footprint(void);
+static int rand_files(char *, char **, int, int, int);
+static void rand_range(void *, int, int);
+static int read_chunk(char *, int, container_header_t *, container_entry_t *,
+                      mapped_file_t *);
 
 // Should behave equivalently to:
 // openssl aes-256-ecb -in skittles.png -out skittles.enc.expected -K $(hexdump -e '16/1 "%02x"' skittles.key)
 // (with -d for decryption)
 int main(int argc, char **argv) {
-    int do_tablegen = 0;
-    int args_ok = 0;
-    if (argc-1 >= 1) {
-        do_tablegen = !strcmp(argv[1], "tablegen");
-        args_ok = ((do_tablegen && argc-1 == 1) || (!do_tablegen && argc-1 == 5));
+    static const struct option long_opts[] = {
+        {"impl", required_argument, NULL, 'i'},
+        {"pin", no_argument, NULL, 'p'},
+        {"sector-size", required_argument, NULL, 's'},
+        {"first-sector", required_argument, NULL, 'f'},
+        {"offset", required_argument, NULL, 'o'},
+        {"length", required_argument, NULL, 'l'},
+        {"chunk-size", required_argument, NULL, 'c'},
+        {"chunk", required_argument, NULL, 'n'},
+        {0},
+    };
+    int nthreads = 1;
+    int pin = 0;
+    // XTS data units, a page by default, and the number of the one the
+    // file starts at, whose tweak is the IV plus that
+    int sector_size = 4096;
+    off_t first_sector = 0;
+    // With either of these, CTR only reads and decrypts length bytes
+    // (by default the rest of the file) from offset on
+    int ranged = 0;
+    off_t offset = 0;
+    off_t length = -1;
+    // Container chunks, a MiB by default. With chunk, dec-chunked only
+    // reads and decrypts that one
+    int chunk_size = 1 << 20;
+    int chunk = -1;
+    const char *impl = NULL;
+    int args_ok = 1;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "j:", long_opts, NULL)) != -1) {
+        switch (opt) {
+            case 'j':
+                nthreads = atoi(optarg);
+                args_ok = args_ok && nthreads > 0;
+                break;
+
+            case 'i':
+                impl = optarg;
+                break;
+
+            case 'p':
+                pin = 1;
+                break;
+
+            case 's':
+                sector_size = atoi(optarg);
+                args_ok = args_ok && sector_size >= BLOCK_SIZE;
+                break;
+
+            case 'f':
+                first_sector = strtoll(optarg, NULL, 10);
+                args_ok = args_ok && first_sector >= 0;
+                break;
+
+            case 'o':
+                ranged = 1;
+                offset = strtoll(optarg, NULL, 10);
+                args_ok = args_ok && offset >= 0;
+                break;
+
+            case 'l':
+                ranged = 1;
+                length = strtoll(optarg, NULL, 10);
+                args_ok = args_ok && length >= 0;
+                break;
+
+            case 'c':
+                chunk_size = atoi(optarg);
+                args_ok = args_ok && chunk_size > 0;
+                break;
+
+            case 'n':
+                chunk = atoi(optarg);
+                args_ok = args_ok && chunk >= 0;
+                break;
+
+            default:
+                args_ok = 0;
+        }
+    }
+    // Positional arguments after the options
+    char **args = argv + optind;
+    int nargs = argc - optind;
+
+    int do_tablegen = 0, do_impls = 0, do_rand = 0, do_selftest = 0;
+    if (args_ok && nargs >= 1) {
+        do_tablegen = !strcmp(args[0], "tablegen");
+        do_impls = !strcmp(args[0], "impls");
+        do_rand = !strcmp(args[0], "rand");
+        do_selftest = !strcmp(args[0], "selftest");
+        args_ok = (((do_tablegen || do_impls) && nargs == 1)
+                   || (do_rand && nargs >= 3)
+                   || (do_selftest && nargs == 2)
+                   || (!do_tablegen && !do_impls && !do_rand && !do_selftest && nargs == 5));
+    } else {
+        args_ok = 0;
     }
 
     if (!args_ok) {
-        fprintf(stderr, "usage: %s {enc,dec}-{ecb,cbc,ctr} <ivfile> <infile> <keyfile> <outfile>\n"
+        fprintf(stderr, "usage: %s [-j <threads>] [--pin] [--impl <impl>] [--sector-size <bytes>] [--first-sector <n>] {enc,dec}-{ecb,cbc,ctr,gcm,xts} <ivfile> <infile> <keyfile> <outfile>\n"
+                        "       %s [--offset <bytes>] [--length <bytes>] {enc,dec}-ctr <ivfile> <infile> <keyfile> <outfile>\n"
+                        "       %s [-j <threads>] [--chunk-size <bytes>] enc-chunked <ivfile> <infile> <keyfile> <outfile>\n"
+                        "       %s [-j <threads>] [--chunk <n>] dec-chunked <ivfile> <infile> <keyfile> <outfile>\n"
+                        "       %s cmac <ivfile> <infile> <keyfile> <macfile>\n"
+                        "       %s [-j <threads>] rand <bytes> <outfile>...\n"
+                        "       %s [-j <threads>] selftest <test>\n"
+                        "       %s impls\n"
                         "       %s tablegen\n",
-                argv[0], argv[0]);
+                argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+                argv[0]);
         return 1;
     }
 
@@ -40,13 +175,37 @@ int main(int argc, char **argv) {
         return tablegen();
     }
 
+    if (do_impls) {
+        list_impls(stdout);
+        return 0;
+    }
+
+    if (impl && aes256_set_impl(impl) < 0) {
+        fprintf(stderr, "no implementation `%s' on this machine, try one of:\n", impl);
+        list_impls(stderr);
+        return 1;
+    }
+
+    if (do_rand) {
+        return rand_files(args[1], args + 2, nargs - 2, nthreads, pin);
+    }
+
+    if (do_selftest) {
+        threadpool_t *pool = nthreads > 1 || pin? threadpool_create(nthreads, pin) : NULL;
+        int failed = selftest(args[1], pool);
+        threadpool_destroy(pool);
+        return failed != 0;
+    }
+
     char *modestr, *ivpath, *inpath, *keypath, *outpath,
          *ivbuf, *inbuf, *keybuf, *outbuf;
-    modestr = argv[1];
-    ivpath = argv[2];
-    inpath = argv[3];
-    keypath = argv[4];
-    outpath = argv[5];
+    // The input and output files, mapped
+    mapped_file_t in, out;
+    modestr = args[0];
+    ivpath = args[1];
+    inpath = args[2];
+    keypath = args[3];
+    outpath = args[4];
 
     aes_mode_t mode;
     if (!strcmp(modestr, "enc-ecb")) {
@@ -61,218 +220,629 @@ int main(int argc, char **argv) {
         mode = ENCRYPT_CTR;
     } else if (!strcmp(modestr, "dec-ctr")) {
         mode = DECRYPT_CTR;
+    } else if (!strcmp(modestr, "enc-gcm")) {
+        mode = ENCRYPT_GCM;
+    } else if (!strcmp(modestr, "dec-gcm")) {
+        mode = DECRYPT_GCM;
+    } else if (!strcmp(modestr, "enc-xts")) {
+        mode = ENCRYPT_XTS;
+    } else if (!strcmp(modestr, "dec-xts")) {
+        mode = DECRYPT_XTS;
+    } else if (!strcmp(modestr, "cmac")) {
+        // Like ECB, ignores the IV
+        mode = MAC_CMAC;
+    } else if (!strcmp(modestr, "enc-chunked")) {
+        mode = ENCRYPT_CHUNKED;
+    } else if (!strcmp(modestr, "dec-chunked")) {
+        // The nonce is in the header, so this ignores the IV
+        mode = DECRYPT_CHUNKED;
     } else {
         fprintf(stderr, "please specify enc, dec, or tablegen for first argument\n");
         return 1;
     }
 
-    int pad_input = mode == ENCRYPT_ECB || mode == ENCRYPT_CBC;
+    // ECB, CBC and CTR go through a stream, which pads ECB and CBC
     int streaming = mode == ENCRYPT_CTR || mode == DECRYPT_CTR;
+    int padded = mode == ENCRYPT_ECB || mode == DECRYPT_ECB
+                 || mode == ENCRYPT_CBC || mode == DECRYPT_CBC;
+    // GCM neither pads nor needs to, and carries the tag after the
+    // ciphertext
+    int gcm = mode == ENCRYPT_GCM || mode == DECRYPT_GCM;
+    // XTS takes a key twice the size, and the IV is the tweak for the
+    // first sector
+    int xts = mode == ENCRYPT_XTS || mode == DECRYPT_XTS;
+    int chunked = mode == ENCRYPT_CHUNKED || mode == DECRYPT_CHUNKED;
     int need_iv = mode == ENCRYPT_CBC || mode == DECRYPT_CBC
-                  || mode == ENCRYPT_CTR || mode == DECRYPT_CTR;
+                  || mode == ENCRYPT_CTR || mode == DECRYPT_CTR || gcm || xts
+                  || mode == ENCRYPT_CHUNKED;
+    int want_key_len = xts? XTS_KEY_SIZE : 4 * Nk;
+
+    // Only CTR can start decrypting in the middle of a block, let alone
+    // in the middle of a file
+    if (ranged && !streaming) {
+        fprintf(stderr, "--offset and --length only work with CTR\n");
+        return 1;
+    }
+    if (chunk >= 0 && mode != DECRYPT_CHUNKED) {
+        fprintf(stderr, "--chunk only works with dec-chunked\n");
+        return 1;
+    }
 
-    int in_len, key_len, iv_len, prepad_len;
+    size_t in_len;
+    int key_len, iv_len;
 
     if (read_to_buf(keypath, &keybuf, &key_len) < 0) {
         return 1;
     }
 
-    if (key_len != 32) {
-        fprintf(stderr, "keyfile `%s' is not 256 bits!\n", keypath);
+    if (key_len != want_key_len) {
+        fprintf(stderr, "keyfile `%s' is not %d bits!\n", keypath, 8 * want_key_len);
         free(keybuf);
         return 1;
     }
 
-    if (read_to_buf(inpath, &inbuf, &in_len) < 0) {
+    // A single chunk of a container comes with the header and index
+    // entry it needs to decrypt it
+    container_header_t header;
+    container_entry_t entry;
+    int read_failed;
+    if (chunk >= 0) {
+        read_failed = read_chunk(inpath, chunk, &header, &entry, &in) < 0;
+    } else if (ranged) {
+        read_failed = map_input(inpath, offset, length, &in) < 0;
+    } else {
+        read_failed = map_input(inpath, 0, -1, &in) < 0;
+    }
+    if (read_failed) {
         free(keybuf);
         return 1;
     }
+    inbuf = in.buf;
+    in_len = in.len;
 
     if (need_iv) {
         if (read_to_buf(ivpath, &ivbuf, &iv_len) < 0) {
             free(keybuf);
-            free(inbuf);
+            unmap_input(&in);
             return 1;
         }
 
-        if (iv_len != BLOCK_SIZE) {
-            fprintf(stderr, "IV `%s' is not %d bytes!\n", ivpath, BLOCK_SIZE);
+        // GCM takes IVs of any length, though GCM_IV_SIZE is best
+        if (gcm? !iv_len : iv_len != BLOCK_SIZE) {
+            if (gcm) {
+                fprintf(stderr, "IV `%s' is empty!\n", ivpath);
+            } else {
+                fprintf(stderr, "IV `%s' is not %d bytes!\n", ivpath, BLOCK_SIZE);
+            }
             free(keybuf);
+            unmap_input(&in);
+            free(ivbuf);
             return 1;
         }
     } else {
         ivbuf = NULL;
     }
 
-    if (pad_input) {
-        char *padbuf;
-        prepad_len = in_len;
-        if (!(padbuf = pad(inbuf, &in_len, BLOCK_SIZE))) {
-            free(inbuf);
+    if (mode == DECRYPT_GCM && in_len < GCM_TAG_SIZE) {
+        fprintf(stderr, "`%s' is too short to end in a %d-byte tag!\n",
+                inpath, GCM_TAG_SIZE);
+        unmap_input(&in);
+        free(keybuf);
+        free(ivbuf);
+        return 1;
+    }
+
+    // A GCM message or a MAC cannot be split up, so those are as big as
+    // the library goes. Everything else takes files of any size
+    if ((gcm || mode == MAC_CMAC) && in_len > INT_MAX) {
+        fprintf(stderr, "`%s' is too big for %s, which takes at most %d bytes\n",
+                inpath, gcm? "GCM" : "CMAC", INT_MAX);
+        unmap_input(&in);
+        free(keybuf);
+        free(ivbuf);
+        return 1;
+    }
+
+    // The cipher reads straight out of the input mapping and writes
+    // straight into the output one, which starts out big enough for
+    // anything the mode could write and gets cut down to what it did.
+    // A stream can put out up to a block more than it takes in, the
+    // padding, even though decryption ends up with less
+    size_t out_len = in_len;
+    if (padded) {
+        out_len = in_len + BLOCK_SIZE;
+    } else if (mode == ENCRYPT_GCM) {
+        out_len = in_len + GCM_TAG_SIZE;
+    } else if (mode == DECRYPT_GCM) {
+        out_len = in_len - GCM_TAG_SIZE;
+    } else if (mode == MAC_CMAC) {
+        out_len = CMAC_SIZE;
+    } else if (mode == ENCRYPT_CHUNKED) {
+        uint64_t size = container_size(in_len, chunk_size);
+        if (!size || size > SIZE_MAX) {
+            fprintf(stderr, "`%s' is too big to put in a container\n", inpath);
+            unmap_input(&in);
             free(keybuf);
             free(ivbuf);
             return 1;
         }
-        inbuf = padbuf;
-    } else if (streaming) {
-        char *zeropadbuf = NULL;
-        prepad_len = in_len;
-        // Subtle: with an empty input, inbuf is NULL
-        if (inbuf && !(zeropadbuf = zeropad(inbuf, &in_len, BLOCK_SIZE))) {
-            free(inbuf);
+        out_len = size;
+    }
+
+    // XTS encrypts its tweaks under the second half of the key
+    aes256_ctx_t *ctx, *tweak_ctx = NULL;
+    if (!(ctx = aes256_ctx_init((uint8_t *)keybuf))
+            || (xts && !(tweak_ctx = aes256_ctx_init((uint8_t *)keybuf + 4 * Nk)))) {
+        perror("aes256_ctx_init");
+        aes256_ctx_free(ctx);
+        unmap_input(&in);
+        free(keybuf);
+        free(ivbuf);
+        return 1;
+    }
+
+    // With a single thread, skip the pool and let the _mt functions fall
+    // back to the serial versions. If we cannot start one, do the same
+    threadpool_t *pool = NULL;
+    if (nthreads > 1 || pin) {
+        pool = threadpool_create(nthreads, pin);
+    }
+
+    // ECB, CBC and whole-file CTR take the whole file as one update (or
+    // a few, past PIECE_SIZE), but the stream handles the padding and
+    // the partial block at the end all the same
+    aes256_stream_t *st = NULL;
+    if (padded || (streaming && !ranged)) {
+        aes256_stream_mode_t stream_mode =
+            mode == ENCRYPT_ECB? STREAM_ENC_ECB
+            : mode == DECRYPT_ECB? STREAM_DEC_ECB
+            : mode == ENCRYPT_CBC? STREAM_ENC_CBC
+            : mode == DECRYPT_CBC? STREAM_DEC_CBC : STREAM_CTR;
+
+        if (!(st = aes256_stream_init(ctx, stream_mode, (uint8_t *)ivbuf, pool))) {
+            perror("aes256_stream_init");
+            threadpool_destroy(pool);
+            aes256_ctx_free(ctx);
+            unmap_input(&in);
             free(keybuf);
             free(ivbuf);
             return 1;
         }
-        inbuf = zeropadbuf;
-    } else {
-        prepad_len = in_len;
     }
 
-    if (!(outbuf = calloc(1, in_len))) {
-        perror("calloc");
-        free(inbuf);
+    if (map_output(outpath, out_len, &out) < 0) {
+        aes256_stream_free(st);
+        threadpool_destroy(pool);
+        aes256_ctx_free(tweak_ctx);
+        aes256_ctx_free(ctx);
+        unmap_input(&in);
         free(keybuf);
         free(ivbuf);
         return 1;
     }
+    outbuf = out.buf;
+
+    // Whether the mode accepted its input, which only GCM (the tag), XTS
+    // (the sector lengths), containers (both) and padded modes (the
+    // padding) check
+    int ok = 1;
+    int malformed = 0;
 
     // overall, these casts are probably the safest we could do anywhere
-    // for anything
-    int nblocks = in_len / BLOCK_SIZE;
+    // for anything. CBC encryption and GCM cannot run in parallel at all
     switch (mode) {
         case ENCRYPT_ECB:
-            aes256_enc_ecb((uint8_t *)inbuf, (uint8_t *)keybuf, (uint8_t *)outbuf, nblocks);
+        case DECRYPT_ECB:
+        case ENCRYPT_CBC:
+        case DECRYPT_CBC:
+        case ENCRYPT_CTR:
+        case DECRYPT_CTR:
+            if (st) {
+                size_t at = 0, done = 0;
+                do {
+                    int n = in_len - at < PIECE_SIZE? (int)(in_len - at) : PIECE_SIZE;
+                    done += aes256_stream_update(st, (uint8_t *)inbuf + at,
+                                                 (uint8_t *)outbuf + done, n);
+                    at += n;
+                } while (at < in_len);
+
+                int last = aes256_stream_final(st, (uint8_t *)outbuf + done);
+                ok = last >= 0;
+                out_len = done + last;
+            } else {
+                size_t at = 0;
+                do {
+                    int n = in_len - at < PIECE_SIZE? (int)(in_len - at) : PIECE_SIZE;
+                    aes256_ctx_ctr_range(ctx, (uint8_t *)ivbuf, offset + at,
+                                         (uint8_t *)inbuf + at, (uint8_t *)outbuf + at, n);
+                    at += n;
+                } while (at < in_len);
+            }
             break;
 
-        case DECRYPT_ECB:
-            aes256_dec_ecb((uint8_t *)inbuf, (uint8_t *)keybuf, (uint8_t *)outbuf, nblocks);
+        case ENCRYPT_GCM:
+            aes256_ctx_enc_gcm(ctx, (uint8_t *)ivbuf, iv_len, NULL, 0,
+                               (uint8_t *)inbuf, (uint8_t *)outbuf, in_len,
+                               (uint8_t *)outbuf + in_len);
             break;
 
-        case ENCRYPT_CBC:
-            aes256_enc_cbc((uint8_t *)ivbuf, (uint8_t *)inbuf, (uint8_t *)keybuf,
-                           (uint8_t *)outbuf, nblocks);
+        case DECRYPT_GCM:
+            ok = !aes256_ctx_dec_gcm(ctx, (uint8_t *)ivbuf, iv_len, NULL, 0,
+                                     (uint8_t *)inbuf, (uint8_t *)outbuf,
+                                     in_len - GCM_TAG_SIZE,
+                                     (uint8_t *)inbuf + in_len - GCM_TAG_SIZE);
             break;
 
-        case DECRYPT_CBC:
-            aes256_dec_cbc((uint8_t *)ivbuf, (uint8_t *)inbuf, (uint8_t *)keybuf,
-                           (uint8_t *)outbuf, nblocks);
+        case ENCRYPT_XTS:
+        case DECRYPT_XTS: {
+            // Whole sectors at a time, each piece starting from the tweak
+            // of its first sector, so only the last one can be short
+            int piece = sector_size > PIECE_SIZE? sector_size
+                        : PIECE_SIZE / sector_size * sector_size;
+            uint8_t tweak[BLOCK_SIZE];
+            size_t at = 0;
+            do {
+                int n = in_len - at < (size_t)piece? (int)(in_len - at) : piece;
+                memcpy(tweak, ivbuf, BLOCK_SIZE);
+                aes256_xts_tweak_add(tweak, first_sector + at / sector_size);
+
+                if (mode == ENCRYPT_XTS) {
+                    ok = !aes256_ctx_enc_xts(ctx, tweak_ctx, tweak, (uint8_t *)inbuf + at,
+                                             (uint8_t *)outbuf + at, n, sector_size, pool);
+                } else {
+                    ok = !aes256_ctx_dec_xts(ctx, tweak_ctx, tweak, (uint8_t *)inbuf + at,
+                                             (uint8_t *)outbuf + at, n, sector_size, pool);
+                }
+                at += n;
+            } while (ok && at < in_len);
             break;
+        }
 
-        case ENCRYPT_CTR:
-        case DECRYPT_CTR:
-            aes256_ctr((uint8_t *)ivbuf, (uint8_t *)inbuf, (uint8_t *)keybuf,
-                       (uint8_t *)outbuf, nblocks);
+        case MAC_CMAC:
+            aes256_ctx_cmac(ctx, (uint8_t *)inbuf, in_len, (uint8_t *)outbuf);
+            break;
+
+        case ENCRYPT_CHUNKED:
+            container_enc(ctx, (uint8_t *)ivbuf, chunk_size, (uint8_t *)inbuf, in_len,
+                          (uint8_t *)outbuf, pool);
+            break;
+
+        case DECRYPT_CHUNKED:
+            if (chunk >= 0) {
+                ok = !container_dec_chunk(ctx, &header, chunk, &entry, (uint8_t *)inbuf,
+                                          (uint8_t *)outbuf);
+            } else {
+                uint64_t data_len;
+                int ret = container_dec(ctx, (uint8_t *)inbuf, in_len, (uint8_t *)outbuf,
+                                        &data_len, pool);
+                ok = !ret;
+                malformed = ret == -1;
+                if (ok) {
+                    out_len = data_len;
+                }
+            }
             break;
     }
 
-    free(inbuf);
+    aes256_stream_free(st);
+    threadpool_destroy(pool);
+    aes256_ctx_free(tweak_ctx);
+    aes256_ctx_free(ctx);
+    unmap_input(&in);
     free(keybuf);
     free(ivbuf);
 
-    int write_size;
-    if (streaming) {
-        write_size = prepad_len;
-    } else if (pad_input) {
-        write_size = in_len;
-    } else if (in_len) { // decrypt
-        // Read the last padded PKCS#5 byte
-        write_size = in_len - outbuf[in_len - 1];
-    } else { // decrypt and input length == 0
-        write_size = 0;
+    if (!ok && malformed) {
+        fprintf(stderr, "`%s' is not a container we can read\n", inpath);
+    } else if (!ok && padded) {
+        fprintf(stderr, "`%s' does not end in a block padded the PKCS#5 way\n", inpath);
+    } else if (!ok && (gcm || chunked)) {
+        fprintf(stderr, "`%s' failed authentication, not writing it out\n", inpath);
+    } else if (!ok) {
+        fprintf(stderr, "`%s' ends in a sector shorter than %d bytes, which XTS "
+                        "cannot encrypt\n", inpath, BLOCK_SIZE);
+    }
+    if (!ok) {
+        discard_output(&out);
+        return 1;
     }
 
-    if (write_to_file(outpath, outbuf, write_size) < 0) {
-        free(outbuf);
+    if (finish_output(&out, out_len) < 0) {
         return 1;
     }
 
-    free(outbuf);
     return 0;
 }
 
+// One per line, so scripts can loop over them
+static void list_impls(FILE *fp) {
+    const char *name;
+    for (int i = 0; (name = aes256_impl_name(i)); i++) {
+        fprintf(fp, "%s\n", name);
+    }
+}
+
 static int tablegen(void) {
-    printf("#include \"tables.h\"\n\n");
+    printf("// Generated by `make tablegen`. The preprocessor directives pick\n"
+           "// out the tables each AES_IMPL uses, see tables.h\n"
+           "#include \"tables.h\"\n\n"
+           "#ifndef AES_LAZYTABLES\n\n");
 
     for (int dec = 0; dec < 2; dec++) {
         for (int table_num = 0; table_num < 4; table_num++) {
-            printf("const uint8_t T%d_%s[256][4] = {\n", table_num, dec? "inv" : "fwd");
+            print_byte_table(dec, table_num);
+        }
+    }
 
-            for (int byte = 0; byte < 256; byte++) {
-                uint8_t entries[4];
-                if (dec) {
-                    get_inv_table_entry(table_num, byte, entries);
-                } else {
-                    get_fwd_table_entry(table_num, byte, entries);
-                }
-                printf("%s{0x%02x, 0x%02x, 0x%02x, 0x%02x},%s",
-                       (byte % 4)? "" : "    ",
-                       entries[0], entries[1], entries[2], entries[3],
-                       ((byte + 1) % 4)? " " : "\n");
-            }
+    // The unrolled implementation reads one of these layouts instead
+    printf("#ifdef AES_DUPTABLE\n\n");
+    for (int dec = 0; dec < 2; dec++) {
+        print_dup_table(dec);
+    }
+    printf("#else\n\n");
 
-            printf("};\n\n");
+    for (int dec = 0; dec < 2; dec++) {
+        for (int table_num = 0; table_num < 4; table_num++) {
+            if (table_num == 1) {
+                printf("# ifndef AES_MONOTABLE\n");
+            }
+            print_word_table(dec, table_num);
         }
+        printf("# endif\n\n");
     }
+    printf("#endif\n\n");
 
+    printf("#ifdef AES_SBOXWORDS\n\n");
+    for (int dec = 0; dec < 2; dec++) {
+        print_sbox_words(dec);
+    }
+    printf("#endif\n\n");
+
+    printf("#endif\n");
+
+    report_footprint();
     return 0;
 }
 
-// PKCS #5 padding
-static char *pad(char *buf, int *len, int block_size) {
-    int padded_len = *len + (block_size - (*len % block_size));
+static void print_byte_table(int dec, int table_num) {
+    printf("const uint8_t T%d_%s[256][4] TABLE_ALIGN = {\n", table_num, dec? "inv" : "fwd");
+
+    for (int byte = 0; byte < 256; byte++) {
+        uint8_t entries[4];
+        get_table_entry(dec, table_num, byte, entries);
+        printf("%s{0x%02x, 0x%02x, 0x%02x, 0x%02x},%s",
+               (byte % 4)? "" : "    ",
+               entries[0], entries[1], entries[2], entries[3],
+               ((byte + 1) % 4)? " " : "\n");
+    }
+
+    printf("};\n\n");
+}
+
+// Spell out each word with TABLE_WORD() so the memory layout of each
+// entry matches the byte tables regardless of endianness
+static void print_word_table(int dec, int table_num) {
+    printf("const uint32_t T%d_%s_words[256] TABLE_ALIGN = {\n", table_num, dec? "inv" : "fwd");
+
+    for (int byte = 0; byte < 256; byte++) {
+        uint8_t entries[4];
+        get_table_entry(dec, table_num, byte, entries);
+        printf("%sTABLE_WORD(0x%02x, 0x%02x, 0x%02x, 0x%02x),%s",
+               (byte % 2)? "" : "    ",
+               entries[0], entries[1], entries[2], entries[3],
+               ((byte + 1) % 2)? " " : "\n");
+    }
+
+    printf("};\n\n");
+}
+
+// T0 with every entry written out twice, see TABLE_DUP()
+static void print_dup_table(int dec) {
+    printf("const uint8_t T_%s_dup[256][8] TABLE_ALIGN = {\n", dec? "inv" : "fwd");
+
+    for (int byte = 0; byte < 256; byte++) {
+        uint8_t e[4];
+        get_table_entry(dec, 0, byte, e);
+        printf("%s{0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x},%s",
+               (byte % 2)? "" : "    ",
+               e[0], e[1], e[2], e[3], e[0], e[1], e[2], e[3],
+               ((byte + 1) % 2)? " " : "\n");
+    }
 
-    char *padded;
-    if (!(padded = realloc(buf, padded_len))) {
-        perror("realloc");
-        return NULL;
+    printf("};\n\n");
+}
+
+// All four bytes are the same, so endianness does not matter here
+static void print_sbox_words(int dec) {
+    printf("const uint32_t S_%s_words[256] TABLE_ALIGN = {\n", dec? "inv" : "fwd");
+
+    for (int byte = 0; byte < 256; byte++) {
+        uint8_t entry = dec? get_inv_sbox_entry(byte) : get_fwd_sbox_entry(byte);
+        printf("%s0x%02x%02x%02x%02x,%s",
+               (byte % 8)? "" : "    ",
+               entry, entry, entry, entry,
+               ((byte + 1) % 8)? " " : "\n");
     }
 
-    // PKCS #5 padding says to pad with bytes holding difference between
-    // padded and unpadded size
-    int fill = padded_len - *len;
-    memset(padded + *len, fill, padded_len - *len);
+    printf("};\n\n");
+}
 
-    *len = padded_len;
-    return padded;
+static void get_table_entry(int dec, int table_num, int byte, uint8_t *entries) {
+    if (dec) {
+        get_inv_table_entry(table_num, byte, entries);
+    } else {
+        get_fwd_table_entry(table_num, byte, entries);
+    }
+}
+
+// How much each layout costs per direction (the cipher and the inverse
+// cipher each have their own tables). This is what has to fit in
+// Vortex local memory or in L1, so print it to stderr alongside the
+// tables themselves
+static void report_footprint(void) {
+    static const struct {
+        const char *name;
+        const char *used_by;
+        int bytes;
+    } layouts[] = {
+        {"T0-T3 bytes", "table", 4 * 256 * 4},
+        {"T0 bytes", "monotable", 256 * 4},
+        {"T0-T3 words", "unrolled", 4 * 256 * 4},
+        {"T0 words", "unrolled + MONOTABLE", 256 * 4},
+        {"Duplicated T0", "unrolled + DUPTABLE", 256 * 8},
+        {"S-box bytes", "all but bitslice", 256},
+        {"S-box words (last round)", "unrolled + SBOXWORDS", 256 * 4},
+    };
+    const int line = 64;
+
+    fprintf(stderr, "%-26s %-26s %6s %8s %10s\n",
+            "layout (per direction)", "--impl + AES_IMPL", "bytes", "lines", "unaligned");
+    for (size_t i = 0; i < sizeof layouts / sizeof layouts[0]; i++) {
+        int lines = (layouts[i].bytes + line - 1) / line;
+        // Without ALIGNED, a table can straddle one more line
+        fprintf(stderr, "%-26s %-26s %6d %8d %10d\n",
+                layouts[i].name, layouts[i].used_by, layouts[i].bytes, lines, lines + 1);
+    }
 }
 
-static char *zeropad(char *buf, int *len, int block_size) {
-    if (!(*len % block_size)) {
-        // Already in good shape
-        return buf;
+// Write bytes random bytes to each file in paths, e.g. keys or IVs,
+// from CTR_DRBG. Each thread of the pool draws from its own instance
+static int rand_files(char *bytes, char **paths, int npaths, int nthreads, int pin) {
+    int nbytes = atoi(bytes);
+    if (nbytes < 0 || (nbytes && npaths > INT_MAX / nbytes)) {
+        fprintf(stderr, "cannot make %d files of `%s' bytes\n", npaths, bytes);
+        return 1;
+    }
+
+    rand_job_t job = {.len = nbytes * npaths};
+    if (job.len && !(job.out = malloc(job.len))) {
+        perror("malloc");
+        return 1;
+    }
+
+    threadpool_t *pool = NULL;
+    if (nthreads > 1 || pin) {
+        pool = threadpool_create(nthreads, pin);
     }
 
-    int padded_len = *len + (block_size - (*len % block_size));
+    // A MiB per range, so that threads do not keep handing work around
+    int nrequests = job.len / DRBG_MAX_REQUEST + (job.len % DRBG_MAX_REQUEST != 0);
+    pthread_mutex_init(&job.lock, NULL);
+    threadpool_parallel_for(pool, nrequests, 16, rand_range, &job);
+    pthread_mutex_destroy(&job.lock);
+    threadpool_destroy(pool);
 
-    char *padded;
-    if (!(padded = realloc(buf, padded_len))) {
-        perror("realloc");
-        return NULL;
+    if (job.failed) {
+        fprintf(stderr, "could not seed the random number generator from /dev/urandom\n");
+        free(job.out);
+        return 1;
     }
 
-    memset(padded + *len, 0, padded_len - *len);
+    for (int f = 0; f < npaths; f++) {
+        mapped_file_t out;
+        if (map_output(paths[f], nbytes, &out) < 0) {
+            free(job.out);
+            return 1;
+        }
+        if (nbytes) {
+            memcpy(out.buf, job.out + f * nbytes, nbytes);
+        }
+        if (finish_output(&out, nbytes) < 0) {
+            free(job.out);
+            return 1;
+        }
+    }
 
-    *len = padded_len;
-    return padded;
+    free(job.out);
+    return 0;
 }
 
+static void rand_range(void *arg, int first, int count) {
+    rand_job_t *job = arg;
+    long start = (long)first * DRBG_MAX_REQUEST;
+    long end = (long)(first + count) * DRBG_MAX_REQUEST;
+    if (end > job->len) {
+        end = job->len;
+    }
+
+    aes256_drbg_t *drbg = aes256_drbg_thread();
+    if (!drbg || aes256_drbg_generate(drbg, job->out + start, end - start, NULL, 0) < 0) {
+        pthread_mutex_lock(&job->lock);
+        job->failed = 1;
+        pthread_mutex_unlock(&job->lock);
+    }
+}
 
-static int write_to_file(char *path, char *buf, int len) {
-    FILE *f;
-    if (!(f = fopen(path, "w"))) {
-        perror("fopen");
+// Read chunk number chunk of the container at path and no more than it
+// takes to decrypt it: the header, the footer, and the chunk's entry in
+// the index
+static int read_chunk(char *path, int chunk, container_header_t *header,
+                      container_entry_t *entry, mapped_file_t *file) {
+    struct stat st;
+    if (stat(path, &st) < 0) {
+        perror("stat");
         return -1;
     }
 
-    for (int i = 0; i < len; i++) {
-        if (putc(buf[i], f) == EOF) {
-            perror("putc");
-            fclose(f);
+    char *buf;
+    int len;
+    uint64_t nchunks;
+    int valid = st.st_size >= CONTAINER_HEADER_SIZE + CONTAINER_FOOTER_SIZE;
+
+    if (valid) {
+        if (read_range_to_buf(path, 0, CONTAINER_HEADER_SIZE, &buf, &len) < 0) {
+            return -1;
+        }
+        valid = len == CONTAINER_HEADER_SIZE && !container_parse_header((uint8_t *)buf, header);
+        free(buf);
+    }
+
+    if (valid) {
+        if (read_range_to_buf(path, st.st_size - CONTAINER_FOOTER_SIZE,
+                              CONTAINER_FOOTER_SIZE, &buf, &len) < 0) {
             return -1;
         }
+        // Which also makes sure the index is where the header says it
+        // is, before we go looking for it
+        valid = len == CONTAINER_FOOTER_SIZE && !container_parse_footer((uint8_t *)buf, &nchunks)
+                && nchunks == container_num_chunks(header->data_len, header->chunk_size)
+                && (uint64_t)st.st_size == container_size(header->data_len, header->chunk_size);
+        free(buf);
+    }
+
+    if (!valid) {
+        fprintf(stderr, "`%s' is not a container we can read\n", path);
+        return -1;
+    }
+    if ((uint64_t)chunk >= nchunks) {
+        fprintf(stderr, "`%s' only has %llu chunks\n", path, (unsigned long long)nchunks);
+        return -1;
+    }
+
+    // The index sits right before the footer
+    off_t index = st.st_size - CONTAINER_FOOTER_SIZE - (off_t)nchunks * CONTAINER_ENTRY_SIZE;
+    if (read_range_to_buf(path, index + (off_t)chunk * CONTAINER_ENTRY_SIZE,
+                          CONTAINER_ENTRY_SIZE, &buf, &len) < 0) {
+        return -1;
+    }
+    valid = len == CONTAINER_ENTRY_SIZE;
+    if (valid) {
+        container_parse_entry((uint8_t *)buf, entry);
+        valid = entry->len >= 0;
+    }
+    free(buf);
+
+    if (!valid || map_input(path, entry->offset, entry->len, file) < 0) {
+        if (!valid) {
+            fprintf(stderr, "`%s' is not a container we can read\n", path);
+        }
+        return -1;
+    }
+    if (file->len != (size_t)entry->len) {
+        fprintf(stderr, "`%s' ends partway through chunk %d\n", path, chunk);
+        unmap_input(file);
+        return -1;
     }
 
-    fclose(f);
     return 0;
 }
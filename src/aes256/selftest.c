@@ -0,0 +1,676 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "aes256.h"
+#include "selftest.h"
+
+// Checks of the library functions that have nothing to compare against
+// in openssl, each held to the plain single-key functions instead,
+// which test-aes.sh already holds to openssl. The data all comes from
+// rand() seeded the same way every time, so a failure always comes
+// back the same
+
+#define NUM_BATCH_JOBS 21
+// More streams than go through the ECB code in one call
+#define NUM_CBC_STREAMS 70
+// A ring small enough to wrap many times over the message
+#define KEYSTREAM_RING 8
+#define KEYSTREAM_LEN (4096 * BLOCK_SIZE + 13)
+#define STREAM_MAX_LEN (300 * BLOCK_SIZE)
+// Enough blocks to go between the threads of a pool in several pieces,
+// and a few bytes more for the modes that take partial blocks
+#define IN_PLACE_LEN (5 * 4096 * BLOCK_SIZE + 3 * BLOCK_SIZE + 7)
+#define IN_PLACE_SECTOR 4096
+
+typedef int selftest_fn_t(threadpool_t *);
+
+static selftest_fn_t test_batch;
+static selftest_fn_t test_cbc_streams;
+static selftest_fn_t test_keystream;
+static selftest_fn_t test_drbg;
+static selftest_fn_t test_stream;
+static selftest_fn_t test_in_place;
+static int stream_split(aes256_stream_t *, const uint8_t *, uint8_t *, int);
+static void single_key(int, const aes256_ctx_t *, const uint8_t *, const uint8_t *,
+                       uint8_t *, int);
+static void fill(uint8_t *, int);
+static int report(int, const char *, ...);
+
+static const struct {
+    const char *name;
+    selftest_fn_t *fn;
+} tests[] = {
+    {"batch", test_batch},
+    {"cbcstreams", test_cbc_streams},
+    {"keystream", test_keystream},
+    {"drbg", test_drbg},
+    {"stream", test_stream},
+    {"inplace", test_in_place},
+};
+#define NUM_TESTS ((int)(sizeof tests / sizeof tests[0]))
+
+// The batch modes in the order single_key() takes them
+static const char *const batch_modes[] = {"enc-ecb", "dec-ecb", "enc-cbc", "dec-cbc", "ctr"};
+static void (*const batch_fns[])(const aes256_job_t *, int) = {
+    aes256_batch_enc_ecb, aes256_batch_dec_ecb, aes256_batch_enc_cbc,
+    aes256_batch_dec_cbc, aes256_batch_ctr,
+};
+
+// Run the test called name with the threads of pool (or none), printing
+// a line for every check. Returns how many failed, or -1 if there is no
+// such test
+int selftest(const char *name, threadpool_t *pool) {
+    for (int i = 0; i < NUM_TESTS; i++) {
+        if (!strcmp(tests[i].name, name)) {
+            srand(1);
+            return tests[i].fn(pool);
+        }
+    }
+
+    fprintf(stderr, "no self test `%s'\n", name);
+    return -1;
+}
+
+// Every batch mode against each job run on its own, with some jobs
+// empty, some one block, and some long enough to outlast the rest and
+// finish through the single-key code, both into a separate buffer and
+// in place
+static int test_batch(threadpool_t *pool) {
+    static const int nblocks[NUM_BATCH_JOBS] = {
+        1, 0, 3, 1, 1, 17, 2, 0, 1, 5, 64, 1, 1, 9, 1, 4, 1, 33, 1, 2, 100,
+    };
+    uint8_t keys[NUM_BATCH_JOBS][4 * Nk], ivs[NUM_BATCH_JOBS][BLOCK_SIZE];
+    int offsets[NUM_BATCH_JOBS], total = 0;
+    int failed = 0;
+    (void)pool;
+
+    for (int j = 0; j < NUM_BATCH_JOBS; j++) {
+        fill(keys[j], sizeof keys[j]);
+        fill(ivs[j], sizeof ivs[j]);
+        offsets[j] = total;
+        total += nblocks[j] * BLOCK_SIZE;
+    }
+
+    uint8_t *in = malloc(total), *want = malloc(total), *got = malloc(total);
+    if (!in || !want || !got) {
+        perror("malloc");
+        free(in);
+        free(want);
+        free(got);
+        return 1;
+    }
+    fill(in, total);
+
+    for (int mode = 0; mode < 5; mode++) {
+        for (int j = 0; j < NUM_BATCH_JOBS; j++) {
+            aes256_ctx_t *ctx = aes256_ctx_init(keys[j]);
+            single_key(mode, ctx, ivs[j], in + offsets[j], want + offsets[j], nblocks[j]);
+            aes256_ctx_free(ctx);
+        }
+
+        for (int in_place = 0; in_place <= 1; in_place++) {
+            aes256_job_t jobs[NUM_BATCH_JOBS];
+            memset(got, 0, total);
+            if (in_place) {
+                memcpy(got, in, total);
+            }
+
+            for (int j = 0; j < NUM_BATCH_JOBS; j++) {
+                jobs[j] = (aes256_job_t){
+                    .key = keys[j], .iv = ivs[j],
+                    .in = (in_place? got : in) + offsets[j], .out = got + offsets[j],
+                    .nblocks = nblocks[j],
+                };
+            }
+            batch_fns[mode](jobs, NUM_BATCH_JOBS);
+
+            failed += report(!memcmp(got, want, total), "batch %s%s", batch_modes[mode],
+                             in_place? " in place" : "");
+        }
+    }
+
+    free(in);
+    free(want);
+    free(got);
+    return failed;
+}
+
+// CBC encryption of many streams of uneven lengths, some empty, each
+// split between two calls, against encrypting each stream on its own.
+// After each call iv has to be the last ciphertext block so far, or
+// still the IV if there has not been one
+static int test_cbc_streams(threadpool_t *pool) {
+    uint8_t key[4 * Nk], ivs[NUM_CBC_STREAMS][BLOCK_SIZE];
+    int nblocks[NUM_CBC_STREAMS], offsets[NUM_CBC_STREAMS], total = 0;
+    int failed = 0;
+    (void)pool;
+
+    fill(key, sizeof key);
+    for (int i = 0; i < NUM_CBC_STREAMS; i++) {
+        fill(ivs[i], sizeof ivs[i]);
+        nblocks[i] = i % 7? rand() % 40 : 0;
+        offsets[i] = total;
+        total += nblocks[i] * BLOCK_SIZE;
+    }
+
+    uint8_t *in = malloc(total), *want = malloc(total), *got = malloc(total);
+    aes256_ctx_t *ctx = NULL;
+    if (!in || !want || !got || !(ctx = aes256_ctx_init(key))) {
+        perror("selftest");
+        free(in);
+        free(want);
+        free(got);
+        return 1;
+    }
+    fill(in, total);
+    memset(got, 0, total);
+
+    for (int i = 0; i < NUM_CBC_STREAMS; i++) {
+        aes256_ctx_enc_cbc(ctx, ivs[i], in + offsets[i], want + offsets[i], nblocks[i]);
+    }
+
+    aes256_cbc_stream_t streams[NUM_CBC_STREAMS];
+    int first[NUM_CBC_STREAMS];
+    for (int i = 0; i < NUM_CBC_STREAMS; i++) {
+        first[i] = nblocks[i]? rand() % (nblocks[i] + 1) : 0;
+        memcpy(streams[i].iv, ivs[i], BLOCK_SIZE);
+        streams[i].in = in + offsets[i];
+        streams[i].out = got + offsets[i];
+        streams[i].nblocks = first[i];
+    }
+
+    for (int call = 0; call < 2; call++) {
+        if (call) {
+            for (int i = 0; i < NUM_CBC_STREAMS; i++) {
+                streams[i].in = in + offsets[i] + first[i] * BLOCK_SIZE;
+                streams[i].out = got + offsets[i] + first[i] * BLOCK_SIZE;
+                streams[i].nblocks = nblocks[i] - first[i];
+            }
+        }
+        aes256_ctx_enc_cbc_streams(ctx, streams, NUM_CBC_STREAMS);
+
+        int chained = 1;
+        for (int i = 0; i < NUM_CBC_STREAMS; i++) {
+            int done = call? nblocks[i] : first[i];
+            const uint8_t *last = done? want + offsets[i] + (done - 1) * BLOCK_SIZE : ivs[i];
+            chained &= !memcmp(streams[i].iv, last, BLOCK_SIZE);
+        }
+        failed += report(chained, "cbc streams iv after call %d", call + 1);
+    }
+    failed += report(!memcmp(got, want, total), "cbc streams");
+
+    aes256_ctx_free(ctx);
+    free(in);
+    free(want);
+    free(got);
+    return failed;
+}
+
+// A message XORed with a keystream in pieces of random lengths, against
+// a CTR range over all of it. Some pieces are longer than the ring, so
+// they have to miss, and every so often a short one comes after giving
+// the thread time to fill the ring, so it should hit
+static int test_keystream(threadpool_t *pool) {
+    uint8_t key[4 * Nk], iv[BLOCK_SIZE];
+    int len = KEYSTREAM_LEN, calls = 0;
+    int failed = 0;
+    (void)pool;
+
+    fill(key, sizeof key);
+    fill(iv, sizeof iv);
+
+    uint8_t *in = malloc(len), *want = malloc(len), *got = malloc(len);
+    aes256_ctx_t *ctx = NULL;
+    aes256_keystream_t *ks = NULL;
+    if (!in || !want || !got || !(ctx = aes256_ctx_init(key))
+            || !(ks = aes256_keystream_init(ctx, iv, KEYSTREAM_RING))) {
+        perror("selftest");
+        free(in);
+        free(want);
+        free(got);
+        aes256_ctx_free(ctx);
+        return 1;
+    }
+    fill(in, len);
+    aes256_ctx_ctr_range(ctx, iv, 0, in, want, len);
+
+    for (int at = 0; at < len; calls++) {
+        int n;
+        if (calls % 8 == 7) {
+            usleep(10000);
+            n = rand() % (2 * BLOCK_SIZE) + 1;
+        } else {
+            n = rand() % (3 * KEYSTREAM_RING * BLOCK_SIZE) + 1;
+        }
+        n = n < len - at? n : len - at;
+        aes256_keystream_xor(ks, in + at, got + at, n);
+        at += n;
+    }
+
+    aes256_keystream_stats_t stats;
+    aes256_keystream_stats(ks, &stats);
+    failed += report(!memcmp(got, want, len), "keystream xor");
+    failed += report(stats.hits + stats.misses == (unsigned long)calls,
+                     "keystream counts every call");
+    failed += report(stats.hits > 0 && stats.misses > 0 && stats.miss_blocks >= stats.misses,
+                     "keystream hits and misses");
+
+    aes256_keystream_free(ks);
+    aes256_ctx_free(ctx);
+    free(in);
+    free(want);
+    free(got);
+    return failed;
+}
+
+// Known answers for CTR_DRBG, worked out the way the CAVP vectors for
+// AES-256 without a derivation function are: instantiate with entropy
+// and a personalization string, reseed with more entropy and additional
+// input, then generate twice with additional input and keep the second
+// output. The inputs are counting bytes, and the answers come from
+// OpenSSL's CTR-DRBG (AES-256-CTR, use_df=0) fed the same entropy.
+// The second case leaves out the additional inputs, but keeps the
+// personalization string, since OpenSSL puts its own in place of an
+// empty one
+static int test_drbg(threadpool_t *pool) {
+    static const uint8_t want_add[64] = {
+        0x7b, 0xaa, 0x89, 0x33, 0xe4, 0x02, 0x6b, 0x02, 0x4b, 0xc7, 0x36, 0xe9,
+        0x55, 0xf6, 0xe4, 0x89, 0x9b, 0xa0, 0x87, 0x0f, 0x4c, 0xa9, 0x80, 0xc7,
+        0xd8, 0x38, 0xb6, 0x35, 0x7d, 0x91, 0x4a, 0x63, 0x96, 0x62, 0x5b, 0xc2,
+        0x92, 0x95, 0x47, 0x0f, 0x11, 0x20, 0x40, 0x93, 0xdf, 0x0a, 0xc6, 0xef,
+        0x23, 0x6a, 0x0d, 0x0f, 0x50, 0x5b, 0x66, 0x2d, 0xf4, 0x60, 0xad, 0xa7,
+        0xdd, 0xfa, 0x26, 0x1b,
+    };
+    static const uint8_t want_no_add[64] = {
+        0xf2, 0x14, 0x72, 0xf0, 0x85, 0xbf, 0xc0, 0x62, 0x1b, 0xff, 0x3d, 0x0e,
+        0xfa, 0x33, 0x89, 0x3c, 0x53, 0x59, 0xe0, 0x7a, 0x08, 0x90, 0x70, 0xf4,
+        0x50, 0xed, 0x0c, 0xb6, 0x26, 0xd1, 0x16, 0x30, 0xbc, 0xc6, 0xc1, 0x34,
+        0xf0, 0xcc, 0xbb, 0x9e, 0x15, 0xe5, 0x3a, 0x72, 0xb4, 0x2b, 0x2e, 0x36,
+        0x25, 0xcc, 0x33, 0x6f, 0x43, 0x0e, 0x2f, 0xc3, 0xb3, 0x11, 0x98, 0xb9,
+        0xa9, 0xf2, 0x6b, 0x78,
+    };
+    uint8_t entropy[DRBG_SEED_SIZE], reseed_entropy[DRBG_SEED_SIZE];
+    uint8_t pers[4 * Nk], reseed_add[4 * Nk], add1[4 * Nk], add2[4 * Nk];
+    uint8_t out[64];
+    int failed = 0;
+    (void)pool;
+
+    for (int i = 0; i < DRBG_SEED_SIZE; i++) {
+        entropy[i] = i;
+        reseed_entropy[i] = 0x80 + i;
+    }
+    for (int i = 0; i < 4 * Nk; i++) {
+        pers[i] = 0x40 + i;
+        add1[i] = 0x60 + i;
+        add2[i] = 0xa0 + i;
+        reseed_add[i] = 0xc0 + i;
+    }
+
+    for (int with_add = 1; with_add >= 0; with_add--) {
+        int add_len = with_add? 4 * Nk : 0;
+        aes256_drbg_t *drbg = aes256_drbg_init(entropy, pers, sizeof pers);
+        if (!drbg) {
+            perror("selftest");
+            return failed + 1;
+        }
+
+        int ok = !aes256_drbg_reseed(drbg, reseed_entropy, reseed_add, add_len)
+                 && aes256_drbg_reseed_counter(drbg) == 1
+                 && !aes256_drbg_generate(drbg, out, sizeof out, add1, add_len)
+                 && !aes256_drbg_generate(drbg, out, sizeof out, add2, add_len)
+                 && aes256_drbg_reseed_counter(drbg) == 3;
+        failed += report(ok && !memcmp(out, with_add? want_add : want_no_add, sizeof out),
+                         "drbg known answer%s", with_add? "" : " without additional input");
+        aes256_drbg_free(drbg);
+    }
+
+    // Additional input longer than a seed is an error, not truncated
+    aes256_drbg_t *drbg = aes256_drbg_init(entropy, NULL, 0);
+    uint8_t too_long[DRBG_SEED_SIZE + 1] = {0};
+    failed += report(drbg && aes256_drbg_generate(drbg, out, sizeof out, too_long,
+                                                  sizeof too_long) < 0,
+                     "drbg rejects long additional input");
+    aes256_drbg_free(drbg);
+    return failed;
+}
+
+// Streams fed a message split at random points, so partial blocks
+// carry over between updates and decryption has to hold back the last
+// block for the padding, against the padded message through the
+// single-call functions. Lengths around a block boundary, where the
+// padding is a whole block or a single byte, and longer ones that go
+// across the threads of pool. Decryption has to turn down padding that
+// is wrong in any of the ways it can be, and lengths that are not
+// whole blocks
+static int test_stream(threadpool_t *pool) {
+    static const int lens[] = {
+        0, 1, 15, 16, 17, 31, 32, 33, 100, 64 * BLOCK_SIZE - 1, STREAM_MAX_LEN - BLOCK_SIZE,
+    };
+    static const char *const names[] = {"enc-ecb", "dec-ecb", "enc-cbc", "dec-cbc", "ctr"};
+    uint8_t key[4 * Nk], iv[BLOCK_SIZE];
+    int failed = 0;
+
+    fill(key, sizeof key);
+    fill(iv, sizeof iv);
+
+    uint8_t *in = malloc(STREAM_MAX_LEN), *padded = malloc(STREAM_MAX_LEN);
+    uint8_t *want = malloc(STREAM_MAX_LEN), *got = malloc(STREAM_MAX_LEN);
+    aes256_ctx_t *ctx = NULL;
+    if (!in || !padded || !want || !got || !(ctx = aes256_ctx_init(key))) {
+        perror("selftest");
+        free(in);
+        free(padded);
+        free(want);
+        free(got);
+        return 1;
+    }
+
+    for (int l = 0; l < (int)(sizeof lens / sizeof lens[0]); l++) {
+        int len = lens[l];
+        int fill_len = BLOCK_SIZE - len % BLOCK_SIZE;
+        int padded_len = len + fill_len;
+        fill(in, len);
+        memcpy(padded, in, len);
+        memset(padded + len, fill_len, fill_len);
+
+        for (int m = 0; m < 5; m++) {
+            aes256_stream_mode_t mode = (aes256_stream_mode_t)m;
+            int want_len = mode == STREAM_CTR? len : padded_len;
+            // Decryption streams get the padded encryption, and should
+            // give back the message
+            switch (mode) {
+                case STREAM_ENC_ECB:
+                case STREAM_DEC_ECB:
+                    aes256_ctx_enc_ecb(ctx, padded, want, padded_len / BLOCK_SIZE);
+                    break;
+
+                case STREAM_ENC_CBC:
+                case STREAM_DEC_CBC:
+                    aes256_ctx_enc_cbc(ctx, iv, padded, want, padded_len / BLOCK_SIZE);
+                    break;
+
+                case STREAM_CTR:
+                    aes256_ctx_ctr_range(ctx, iv, 0, in, want, len);
+                    break;
+            }
+
+            aes256_stream_t *st = aes256_stream_init(ctx, mode, iv, pool);
+            int got_len;
+            if (mode == STREAM_DEC_ECB || mode == STREAM_DEC_CBC) {
+                got_len = stream_split(st, want, got, padded_len);
+                failed += report(got_len == len && !memcmp(got, in, len),
+                                 "%s stream of %d bytes", names[m], len);
+            } else {
+                got_len = stream_split(st, in, got, len);
+                failed += report(got_len == want_len && !memcmp(got, want, want_len),
+                                 "%s stream of %d bytes", names[m], len);
+            }
+            aes256_stream_free(st);
+        }
+    }
+
+    // Each a last block that decrypts to bad padding: a zero, more than a
+    // block, and a run of 3s broken by its first byte, its last but one
+    // byte, and the byte just before the padding (which is fine)
+    static const struct {
+        int at;
+        uint8_t byte;
+        int good;
+    } last_bytes[] = {
+        {BLOCK_SIZE - 1, 0, 0}, {BLOCK_SIZE - 1, BLOCK_SIZE + 1, 0},
+        {BLOCK_SIZE - 3, 4, 0}, {BLOCK_SIZE - 2, 4, 0}, {BLOCK_SIZE - 4, 4, 1},
+    };
+    for (int b = 0; b < (int)(sizeof last_bytes / sizeof last_bytes[0]); b++) {
+        int len = 5 * BLOCK_SIZE;
+        fill(padded, len);
+        memset(padded + len - 3, 3, 3);
+        padded[len - BLOCK_SIZE + last_bytes[b].at] = last_bytes[b].byte;
+
+        for (int cbc = 0; cbc <= 1; cbc++) {
+            if (cbc) {
+                aes256_ctx_enc_cbc(ctx, iv, padded, want, len / BLOCK_SIZE);
+            } else {
+                aes256_ctx_enc_ecb(ctx, padded, want, len / BLOCK_SIZE);
+            }
+
+            aes256_stream_t *st = aes256_stream_init(
+                ctx, cbc? STREAM_DEC_CBC : STREAM_DEC_ECB, iv, pool);
+            int got_len = stream_split(st, want, got, len);
+            aes256_stream_free(st);
+
+            int passed = last_bytes[b].good? got_len == len - 3 : got_len < 0;
+            failed += report(passed, "%s stream %s padding ending %02x at byte %d",
+                             cbc? "dec-cbc" : "dec-ecb",
+                             last_bytes[b].good? "accepts" : "rejects",
+                             last_bytes[b].byte, last_bytes[b].at);
+        }
+    }
+
+    for (int cbc = 0; cbc <= 1; cbc++) {
+        aes256_stream_t *st = aes256_stream_init(
+            ctx, cbc? STREAM_DEC_CBC : STREAM_DEC_ECB, iv, pool);
+        failed += report(stream_split(st, want, got, 3 * BLOCK_SIZE + 5) < 0,
+                         "%s stream rejects partial block", cbc? "dec-cbc" : "dec-ecb");
+        aes256_stream_free(st);
+    }
+
+    aes256_ctx_free(ctx);
+    free(in);
+    free(padded);
+    free(want);
+    free(got);
+    return failed;
+}
+
+// Put len bytes of in through st in updates of random lengths, some of
+// them empty, and finish it. Returns how many bytes came out, or -1 if
+// aes256_stream_final() turned the message down
+static int stream_split(aes256_stream_t *st, const uint8_t *in, uint8_t *out, int len) {
+    int done = 0;
+    for (int at = 0; at < len;) {
+        int n = rand() % (3 * BLOCK_SIZE) == 0? 0 : rand() % (5 * BLOCK_SIZE) + 1;
+        if (rand() % 8 == 0) {
+            n = rand() % (100 * BLOCK_SIZE);
+        }
+        n = n < len - at? n : len - at;
+        done += aes256_stream_update(st, in + at, out + done, n);
+        at += n;
+    }
+
+    int last = aes256_stream_final(st, out + done);
+    return last < 0? -1 : done + last;
+}
+
+// Every mode run with out the same buffer as in, threads or not, against
+// the same mode into a separate buffer without threads. Streams are in
+// place in every update that the header promises: all of them for CTR,
+// and for ECB and CBC encryption, any that ends on a block boundary
+static int test_in_place(threadpool_t *pool) {
+    uint8_t key[XTS_KEY_SIZE], iv[BLOCK_SIZE], tag[GCM_TAG_SIZE], want_tag[GCM_TAG_SIZE];
+    int len = IN_PLACE_LEN, nblocks = len / BLOCK_SIZE;
+    int failed = 0;
+
+    fill(key, sizeof key);
+    fill(iv, sizeof iv);
+
+    uint8_t *in = malloc(len), *want = malloc(len), *got = malloc(len);
+    aes256_ctx_t *ctx = NULL, *tweak_ctx = NULL;
+    if (!in || !want || !got || !(ctx = aes256_ctx_init(key))
+            || !(tweak_ctx = aes256_ctx_init(key + 4 * Nk))) {
+        perror("selftest");
+        free(in);
+        free(want);
+        free(got);
+        aes256_ctx_free(ctx);
+        return 1;
+    }
+    fill(in, len);
+
+    aes256_ctx_enc_ecb(ctx, in, want, nblocks);
+    memcpy(got, in, len);
+    aes256_ctx_enc_ecb_mt(ctx, got, got, nblocks, pool);
+    failed += report(!memcmp(got, want, nblocks * BLOCK_SIZE), "in place enc-ecb");
+
+    aes256_ctx_dec_ecb(ctx, in, want, nblocks);
+    memcpy(got, in, len);
+    aes256_ctx_dec_ecb_mt(ctx, got, got, nblocks, pool);
+    failed += report(!memcmp(got, want, nblocks * BLOCK_SIZE), "in place dec-ecb");
+
+    aes256_ctx_enc_cbc(ctx, iv, in, want, nblocks);
+    memcpy(got, in, len);
+    aes256_ctx_enc_cbc(ctx, iv, got, got, nblocks);
+    failed += report(!memcmp(got, want, nblocks * BLOCK_SIZE), "in place enc-cbc");
+
+    aes256_ctx_dec_cbc(ctx, iv, in, want, nblocks);
+    memcpy(got, in, len);
+    aes256_ctx_dec_cbc_mt(ctx, iv, got, got, nblocks, pool);
+    failed += report(!memcmp(got, want, nblocks * BLOCK_SIZE), "in place dec-cbc");
+
+    aes256_ctx_ctr(ctx, iv, in, want, nblocks);
+    memcpy(got, in, len);
+    aes256_ctx_ctr_mt(ctx, iv, got, got, nblocks, pool);
+    failed += report(!memcmp(got, want, nblocks * BLOCK_SIZE), "in place ctr");
+
+    // From partway through a block to partway through another
+    aes256_ctx_ctr_range(ctx, iv, 37, in, want, len - 37);
+    memcpy(got, in, len);
+    aes256_ctx_ctr_range(ctx, iv, 37, got, got, len - 37);
+    failed += report(!memcmp(got, want, len - 37), "in place ctr range");
+
+    aes256_ctx_enc_gcm(ctx, iv, GCM_IV_SIZE, key, 5, in, want, len, want_tag);
+    memcpy(got, in, len);
+    aes256_ctx_enc_gcm(ctx, iv, GCM_IV_SIZE, key, 5, got, got, len, tag);
+    failed += report(!memcmp(got, want, len) && !memcmp(tag, want_tag, sizeof tag),
+                     "in place enc-gcm");
+    failed += report(!aes256_ctx_dec_gcm(ctx, iv, GCM_IV_SIZE, key, 5, got, got, len, tag)
+                     && !memcmp(got, in, len), "in place dec-gcm");
+
+    // The last sector is short, and ends in a partial block to steal
+    // ciphertext for
+    aes256_ctx_enc_xts(ctx, tweak_ctx, iv, in, want, len, IN_PLACE_SECTOR, NULL);
+    memcpy(got, in, len);
+    aes256_ctx_enc_xts(ctx, tweak_ctx, iv, got, got, len, IN_PLACE_SECTOR, pool);
+    failed += report(!memcmp(got, want, len), "in place enc-xts");
+
+    aes256_ctx_dec_xts(ctx, tweak_ctx, iv, in, want, len, IN_PLACE_SECTOR, NULL);
+    memcpy(got, in, len);
+    aes256_ctx_dec_xts(ctx, tweak_ctx, iv, got, got, len, IN_PLACE_SECTOR, pool);
+    failed += report(!memcmp(got, want, len), "in place dec-xts");
+
+    static const aes256_stream_mode_t stream_modes[] = {
+        STREAM_ENC_ECB, STREAM_ENC_CBC, STREAM_DEC_ECB, STREAM_DEC_CBC, STREAM_CTR,
+    };
+    static const char *const stream_names[] = {
+        "enc-ecb", "enc-cbc", "dec-ecb", "dec-cbc", "ctr",
+    };
+    for (int m = 0; m < 5; m++) {
+        aes256_stream_mode_t mode = stream_modes[m];
+        int dec = mode == STREAM_DEC_ECB || mode == STREAM_DEC_CBC;
+        // Decryption holds back a block from every update, so only its
+        // first update can be in place, and it has to be all of it
+        int stream_len = mode == STREAM_CTR? len : nblocks * BLOCK_SIZE;
+        int want_len = stream_len, got_len = 0;
+
+        if (dec) {
+            // Something that unpads, the encryption of in
+            aes256_stream_t *enc = aes256_stream_init(
+                ctx, mode == STREAM_DEC_ECB? STREAM_ENC_ECB : STREAM_ENC_CBC, iv, NULL);
+            int n = aes256_stream_update(enc, in, want, stream_len - BLOCK_SIZE);
+            aes256_stream_final(enc, want + n);
+            aes256_stream_free(enc);
+            memcpy(got, want, stream_len);
+            memcpy(want, in, stream_len - BLOCK_SIZE);
+            want_len = stream_len - BLOCK_SIZE;
+        } else {
+            // ECB and CBC encryption pad, which takes a block more room
+            aes256_stream_t *ref = aes256_stream_init(ctx, mode, iv, NULL);
+            int n = aes256_stream_update(ref, in, want,
+                                         mode == STREAM_CTR? stream_len
+                                                           : stream_len - BLOCK_SIZE);
+            want_len = n + aes256_stream_final(ref, want + n);
+            aes256_stream_free(ref);
+            memcpy(got, in, stream_len);
+        }
+
+        aes256_stream_t *st = aes256_stream_init(ctx, mode, iv, pool);
+        if (dec) {
+            got_len = aes256_stream_update(st, got, got, stream_len);
+        } else {
+            // Pieces of random lengths, whole blocks but for CTR, with
+            // the last block of ECB and CBC left for the padding
+            int end = mode == STREAM_CTR? stream_len : stream_len - BLOCK_SIZE;
+            for (int at = 0; at < end;) {
+                int n = rand() % (3 * 4096 * BLOCK_SIZE);
+                n = mode == STREAM_CTR? n + 1 : (n / BLOCK_SIZE + 1) * BLOCK_SIZE;
+                n = n < end - at? n : end - at;
+                got_len += aes256_stream_update(st, got + at, got + at, n);
+                at += n;
+            }
+        }
+        int last = aes256_stream_final(st, got + got_len);
+        aes256_stream_free(st);
+
+        failed += report(last >= 0 && got_len + last == want_len
+                         && !memcmp(got, want, want_len), "in place %s stream",
+                         stream_names[m]);
+    }
+
+    aes256_ctx_free(ctx);
+    aes256_ctx_free(tweak_ctx);
+    free(in);
+    free(want);
+    free(got);
+    return failed;
+}
+
+// nblocks of ECB encryption or decryption (with no IV), CBC encryption
+// or decryption, or CTR, in the order of batch_modes
+static void single_key(int mode, const aes256_ctx_t *ctx, const uint8_t *iv,
+                       const uint8_t *in, uint8_t *out, int nblocks) {
+    switch (mode) {
+        case 0:
+            aes256_ctx_enc_ecb(ctx, in, out, nblocks);
+            break;
+
+        case 1:
+            aes256_ctx_dec_ecb(ctx, in, out, nblocks);
+            break;
+
+        case 2:
+            aes256_ctx_enc_cbc(ctx, iv, in, out, nblocks);
+            break;
+
+        case 3:
+            aes256_ctx_dec_cbc(ctx, iv, in, out, nblocks);
+            break;
+
+        default:
+            aes256_ctx_ctr(ctx, iv, in, out, nblocks);
+            break;
+    }
+}
+
+static void fill(uint8_t *buf, int len) {
+    for (int i = 0; i < len; i++) {
+        buf[i] = rand();
+    }
+}
+
+// Print whether the check described by the format passed, the way the
+// test scripts do, and return 1 if it failed
+static int report(int passed, const char *format, ...) {
+    char what[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(what, sizeof what, format, args);
+    va_end(args);
+
+    if (passed) {
+        printf("✅ %s passed\n", what);
+    } else {
+        printf("🙏 %s failed, start praying son\n", what);
+    }
+    return !passed;
+}
@@ -0,0 +1,10 @@
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+#include "threadpool.h"
+
+// `aes256 selftest <name>', checks of the library that the files
+// test-aes.sh runs through the CLI cannot reach, see selftest.c
+extern int selftest(const char *, threadpool_t *);
+
+#endif
@@ -1,6 +1,10 @@
+// Generated by `make tablegen`. The preprocessor directives pick
+// out the tables each AES_IMPL uses, see tables.h
 #include "tables.h"
 
-const uint8_t T0_fwd[256][4] = {
+#ifndef AES_LAZYTABLES
+
+const uint8_t T0_fwd[256][4] TABLE_ALIGN = {
     {0xc6, 0x63, 0x63, 0xa5}, {0xf8, 0x7c, 0x7c, 0x84}, {0xee, 0x77, 0x77, 0x99}, {0xf6, 0x7b, 0x7b, 0x8d},
     {0xff, 0xf2, 0xf2, 0x0d}, {0xd6, 0x6b, 0x6b, 0xbd}, {0xde, 0x6f, 0x6f, 0xb1}, {0x91, 0xc5, 0xc5, 0x54},
     {0x60, 0x30, 0x30, 0x50}, {0x02, 0x01, 0x01, 0x03}, {0xce, 0x67, 0x67, 0xa9}, {0x56, 0x2b, 0x2b, 0x7d},
@@ -67,8 +71,7 @@ const uint8_t T0_fwd[256][4] = {
     {0x7b, 0xb0, 0xb0, 0xcb}, {0xa8, 0x54, 0x54, 0xfc}, {0x6d, 0xbb, 0xbb, 0xd6}, {0x2c, 0x16, 0x16, 0x3a},
 };
 
-#ifndef AES_MONOTABLE
-const uint8_t T1_fwd[256][4] = {
+const uint8_t T1_fwd[256][4] TABLE_ALIGN = {
     {0xa5, 0xc6, 0x63, 0x63}, {0x84, 0xf8, 0x7c, 0x7c}, {0x99, 0xee, 0x77, 0x77}, {0x8d, 0xf6, 0x7b, 0x7b},
     {0x0d, 0xff, 0xf2, 0xf2}, {0xbd, 0xd6, 0x6b, 0x6b}, {0xb1, 0xde, 0x6f, 0x6f}, {0x54, 0x91, 0xc5, 0xc5},
     {0x50, 0x60, 0x30, 0x30}, {0x03, 0x02, 0x01, 0x01}, {0xa9, 0xce, 0x67, 0x67}, {0x7d, 0x56, 0x2b, 0x2b},
@@ -135,7 +138,7 @@ const uint8_t T1_fwd[256][4] = {
     {0xcb, 0x7b, 0xb0, 0xb0}, {0xfc, 0xa8, 0x54, 0x54}, {0xd6, 0x6d, 0xbb, 0xbb}, {0x3a, 0x2c, 0x16, 0x16},
 };
 
-const uint8_t T2_fwd[256][4] = {
+const uint8_t T2_fwd[256][4] TABLE_ALIGN = {
     {0x63, 0xa5, 0xc6, 0x63}, {0x7c, 0x84, 0xf8, 0x7c}, {0x77, 0x99, 0xee, 0x77}, {0x7b, 0x8d, 0xf6, 0x7b},
     {0xf2, 0x0d, 0xff, 0xf2}, {0x6b, 0xbd, 0xd6, 0x6b}, {0x6f, 0xb1, 0xde, 0x6f}, {0xc5, 0x54, 0x91, 0xc5},
     {0x30, 0x50, 0x60, 0x30}, {0x01, 0x03, 0x02, 0x01}, {0x67, 0xa9, 0xce, 0x67}, {0x2b, 0x7d, 0x56, 0x2b},
@@ -202,7 +205,7 @@ const uint8_t T2_fwd[256][4] = {
     {0xb0, 0xcb, 0x7b, 0xb0}, {0x54, 0xfc, 0xa8, 0x54}, {0xbb, 0xd6, 0x6d, 0xbb}, {0x16, 0x3a, 0x2c, 0x16},
 };
 
-const uint8_t T3_fwd[256][4] = {
+const uint8_t T3_fwd[256][4] TABLE_ALIGN = {
     {0x63, 0x63, 0xa5, 0xc6}, {0x7c, 0x7c, 0x84, 0xf8}, {0x77, 0x77, 0x99, 0xee}, {0x7b, 0x7b, 0x8d, 0xf6},
     {0xf2, 0xf2, 0x0d, 0xff}, {0x6b, 0x6b, 0xbd, 0xd6}, {0x6f, 0x6f, 0xb1, 0xde}, {0xc5, 0xc5, 0x54, 0x91},
     {0x30, 0x30, 0x50, 0x60}, {0x01, 0x01, 0x03, 0x02}, {0x67, 0x67, 0xa9, 0xce}, {0x2b, 0x2b, 0x7d, 0x56},
@@ -268,9 +271,8 @@ const uint8_t T3_fwd[256][4] = {
     {0x41, 0x41, 0xc3, 0x82}, {0x99, 0x99, 0xb0, 0x29}, {0x2d, 0x2d, 0x77, 0x5a}, {0x0f, 0x0f, 0x11, 0x1e},
     {0xb0, 0xb0, 0xcb, 0x7b}, {0x54, 0x54, 0xfc, 0xa8}, {0xbb, 0xbb, 0xd6, 0x6d}, {0x16, 0x16, 0x3a, 0x2c},
 };
-#endif
 
-const uint8_t T0_inv[256][4] = {
+const uint8_t T0_inv[256][4] TABLE_ALIGN = {
     {0x51, 0xf4, 0xa7, 0x50}, {0x7e, 0x41, 0x65, 0x53}, {0x1a, 0x17, 0xa4, 0xc3}, {0x3a, 0x27, 0x5e, 0x96},
     {0x3b, 0xab, 0x6b, 0xcb}, {0x1f, 0x9d, 0x45, 0xf1}, {0xac, 0xfa, 0x58, 0xab}, {0x4b, 0xe3, 0x03, 0x93},
     {0x20, 0x30, 0xfa, 0x55}, {0xad, 0x76, 0x6d, 0xf6}, {0x88, 0xcc, 0x76, 0x91}, {0xf5, 0x02, 0x4c, 0x25},
@@ -337,8 +339,7 @@ const uint8_t T0_inv[256][4] = {
     {0x7b, 0xcb, 0x84, 0x61}, {0xd5, 0x32, 0xb6, 0x70}, {0x48, 0x6c, 0x5c, 0x74}, {0xd0, 0xb8, 0x57, 0x42},
 };
 
-#ifndef AES_MONOTABLE
-const uint8_t T1_inv[256][4] = {
+const uint8_t T1_inv[256][4] TABLE_ALIGN = {
     {0x50, 0x51, 0xf4, 0xa7}, {0x53, 0x7e, 0x41, 0x65}, {0xc3, 0x1a, 0x17, 0xa4}, {0x96, 0x3a, 0x27, 0x5e},
     {0xcb, 0x3b, 0xab, 0x6b}, {0xf1, 0x1f, 0x9d, 0x45}, {0xab, 0xac, 0xfa, 0x58}, {0x93, 0x4b, 0xe3, 0x03},
     {0x55, 0x20, 0x30, 0xfa}, {0xf6, 0xad, 0x76, 0x6d}, {0x91, 0x88, 0xcc, 0x76}, {0x25, 0xf5, 0x02, 0x4c},
@@ -405,7 +406,7 @@ const uint8_t T1_inv[256][4] = {
     {0x61, 0x7b, 0xcb, 0x84}, {0x70, 0xd5, 0x32, 0xb6}, {0x74, 0x48, 0x6c, 0x5c}, {0x42, 0xd0, 0xb8, 0x57},
 };
 
-const uint8_t T2_inv[256][4] = {
+const uint8_t T2_inv[256][4] TABLE_ALIGN = {
     {0xa7, 0x50, 0x51, 0xf4}, {0x65, 0x53, 0x7e, 0x41}, {0xa4, 0xc3, 0x1a, 0x17}, {0x5e, 0x96, 0x3a, 0x27},
     {0x6b, 0xcb, 0x3b, 0xab}, {0x45, 0xf1, 0x1f, 0x9d}, {0x58, 0xab, 0xac, 0xfa}, {0x03, 0x93, 0x4b, 0xe3},
     {0xfa, 0x55, 0x20, 0x30}, {0x6d, 0xf6, 0xad, 0x76}, {0x76, 0x91, 0x88, 0xcc}, {0x4c, 0x25, 0xf5, 0x02},
@@ -472,7 +473,7 @@ const uint8_t T2_inv[256][4] = {
     {0x84, 0x61, 0x7b, 0xcb}, {0xb6, 0x70, 0xd5, 0x32}, {0x5c, 0x74, 0x48, 0x6c}, {0x57, 0x42, 0xd0, 0xb8},
 };
 
-const uint8_t T3_inv[256][4] = {
+const uint8_t T3_inv[256][4] TABLE_ALIGN = {
     {0xf4, 0xa7, 0x50, 0x51}, {0x41, 0x65, 0x53, 0x7e}, {0x17, 0xa4, 0xc3, 0x1a}, {0x27, 0x5e, 0x96, 0x3a},
     {0xab, 0x6b, 0xcb, 0x3b}, {0x9d, 0x45, 0xf1, 0x1f}, {0xfa, 0x58, 0xab, 0xac}, {0xe3, 0x03, 0x93, 0x4b},
     {0x30, 0xfa, 0x55, 0x20}, {0x76, 0x6d, 0xf6, 0xad}, {0xcc, 0x76, 0x91, 0x88}, {0x02, 0x4c, 0x25, 0xf5},
@@ -538,4 +539,1401 @@ const uint8_t T3_inv[256][4] = {
     {0xa8, 0x01, 0x71, 0x39}, {0x0c, 0xb3, 0xde, 0x08}, {0xb4, 0xe4, 0x9c, 0xd8}, {0x56, 0xc1, 0x90, 0x64},
     {0xcb, 0x84, 0x61, 0x7b}, {0x32, 0xb6, 0x70, 0xd5}, {0x6c, 0x5c, 0x74, 0x48}, {0xb8, 0x57, 0x42, 0xd0},
 };
+
+#ifdef AES_DUPTABLE
+
+const uint8_t T_fwd_dup[256][8] TABLE_ALIGN = {
+    {0xc6, 0x63, 0x63, 0xa5, 0xc6, 0x63, 0x63, 0xa5}, {0xf8, 0x7c, 0x7c, 0x84, 0xf8, 0x7c, 0x7c, 0x84},
+    {0xee, 0x77, 0x77, 0x99, 0xee, 0x77, 0x77, 0x99}, {0xf6, 0x7b, 0x7b, 0x8d, 0xf6, 0x7b, 0x7b, 0x8d},
+    {0xff, 0xf2, 0xf2, 0x0d, 0xff, 0xf2, 0xf2, 0x0d}, {0xd6, 0x6b, 0x6b, 0xbd, 0xd6, 0x6b, 0x6b, 0xbd},
+    {0xde, 0x6f, 0x6f, 0xb1, 0xde, 0x6f, 0x6f, 0xb1}, {0x91, 0xc5, 0xc5, 0x54, 0x91, 0xc5, 0xc5, 0x54},
+    {0x60, 0x30, 0x30, 0x50, 0x60, 0x30, 0x30, 0x50}, {0x02, 0x01, 0x01, 0x03, 0x02, 0x01, 0x01, 0x03},
+    {0xce, 0x67, 0x67, 0xa9, 0xce, 0x67, 0x67, 0xa9}, {0x56, 0x2b, 0x2b, 0x7d, 0x56, 0x2b, 0x2b, 0x7d},
+    {0xe7, 0xfe, 0xfe, 0x19, 0xe7, 0xfe, 0xfe, 0x19}, {0xb5, 0xd7, 0xd7, 0x62, 0xb5, 0xd7, 0xd7, 0x62},
+    {0x4d, 0xab, 0xab, 0xe6, 0x4d, 0xab, 0xab, 0xe6}, {0xec, 0x76, 0x76, 0x9a, 0xec, 0x76, 0x76, 0x9a},
+    {0x8f, 0xca, 0xca, 0x45, 0x8f, 0xca, 0xca, 0x45}, {0x1f, 0x82, 0x82, 0x9d, 0x1f, 0x82, 0x82, 0x9d},
+    {0x89, 0xc9, 0xc9, 0x40, 0x89, 0xc9, 0xc9, 0x40}, {0xfa, 0x7d, 0x7d, 0x87, 0xfa, 0x7d, 0x7d, 0x87},
+    {0xef, 0xfa, 0xfa, 0x15, 0xef, 0xfa, 0xfa, 0x15}, {0xb2, 0x59, 0x59, 0xeb, 0xb2, 0x59, 0x59, 0xeb},
+    {0x8e, 0x47, 0x47, 0xc9, 0x8e, 0x47, 0x47, 0xc9}, {0xfb, 0xf0, 0xf0, 0x0b, 0xfb, 0xf0, 0xf0, 0x0b},
+    {0x41, 0xad, 0xad, 0xec, 0x41, 0xad, 0xad, 0xec}, {0xb3, 0xd4, 0xd4, 0x67, 0xb3, 0xd4, 0xd4, 0x67},
+    {0x5f, 0xa2, 0xa2, 0xfd, 0x5f, 0xa2, 0xa2, 0xfd}, {0x45, 0xaf, 0xaf, 0xea, 0x45, 0xaf, 0xaf, 0xea},
+    {0x23, 0x9c, 0x9c, 0xbf, 0x23, 0x9c, 0x9c, 0xbf}, {0x53, 0xa4, 0xa4, 0xf7, 0x53, 0xa4, 0xa4, 0xf7},
+    {0xe4, 0x72, 0x72, 0x96, 0xe4, 0x72, 0x72, 0x96}, {0x9b, 0xc0, 0xc0, 0x5b, 0x9b, 0xc0, 0xc0, 0x5b},
+    {0x75, 0xb7, 0xb7, 0xc2, 0x75, 0xb7, 0xb7, 0xc2}, {0xe1, 0xfd, 0xfd, 0x1c, 0xe1, 0xfd, 0xfd, 0x1c},
+    {0x3d, 0x93, 0x93, 0xae, 0x3d, 0x93, 0x93, 0xae}, {0x4c, 0x26, 0x26, 0x6a, 0x4c, 0x26, 0x26, 0x6a},
+    {0x6c, 0x36, 0x36, 0x5a, 0x6c, 0x36, 0x36, 0x5a}, {0x7e, 0x3f, 0x3f, 0x41, 0x7e, 0x3f, 0x3f, 0x41},
+    {0xf5, 0xf7, 0xf7, 0x02, 0xf5, 0xf7, 0xf7, 0x02}, {0x83, 0xcc, 0xcc, 0x4f, 0x83, 0xcc, 0xcc, 0x4f},
+    {0x68, 0x34, 0x34, 0x5c, 0x68, 0x34, 0x34, 0x5c}, {0x51, 0xa5, 0xa5, 0xf4, 0x51, 0xa5, 0xa5, 0xf4},
+    {0xd1, 0xe5, 0xe5, 0x34, 0xd1, 0xe5, 0xe5, 0x34}, {0xf9, 0xf1, 0xf1, 0x08, 0xf9, 0xf1, 0xf1, 0x08},
+    {0xe2, 0x71, 0x71, 0x93, 0xe2, 0x71, 0x71, 0x93}, {0xab, 0xd8, 0xd8, 0x73, 0xab, 0xd8, 0xd8, 0x73},
+    {0x62, 0x31, 0x31, 0x53, 0x62, 0x31, 0x31, 0x53}, {0x2a, 0x15, 0x15, 0x3f, 0x2a, 0x15, 0x15, 0x3f},
+    {0x08, 0x04, 0x04, 0x0c, 0x08, 0x04, 0x04, 0x0c}, {0x95, 0xc7, 0xc7, 0x52, 0x95, 0xc7, 0xc7, 0x52},
+    {0x46, 0x23, 0x23, 0x65, 0x46, 0x23, 0x23, 0x65}, {0x9d, 0xc3, 0xc3, 0x5e, 0x9d, 0xc3, 0xc3, 0x5e},
+    {0x30, 0x18, 0x18, 0x28, 0x30, 0x18, 0x18, 0x28}, {0x37, 0x96, 0x96, 0xa1, 0x37, 0x96, 0x96, 0xa1},
+    {0x0a, 0x05, 0x05, 0x0f, 0x0a, 0x05, 0x05, 0x0f}, {0x2f, 0x9a, 0x9a, 0xb5, 0x2f, 0x9a, 0x9a, 0xb5},
+    {0x0e, 0x07, 0x07, 0x09, 0x0e, 0x07, 0x07, 0x09}, {0x24, 0x12, 0x12, 0x36, 0x24, 0x12, 0x12, 0x36},
+    {0x1b, 0x80, 0x80, 0x9b, 0x1b, 0x80, 0x80, 0x9b}, {0xdf, 0xe2, 0xe2, 0x3d, 0xdf, 0xe2, 0xe2, 0x3d},
+    {0xcd, 0xeb, 0xeb, 0x26, 0xcd, 0xeb, 0xeb, 0x26}, {0x4e, 0x27, 0x27, 0x69, 0x4e, 0x27, 0x27, 0x69},
+    {0x7f, 0xb2, 0xb2, 0xcd, 0x7f, 0xb2, 0xb2, 0xcd}, {0xea, 0x75, 0x75, 0x9f, 0xea, 0x75, 0x75, 0x9f},
+    {0x12, 0x09, 0x09, 0x1b, 0x12, 0x09, 0x09, 0x1b}, {0x1d, 0x83, 0x83, 0x9e, 0x1d, 0x83, 0x83, 0x9e},
+    {0x58, 0x2c, 0x2c, 0x74, 0x58, 0x2c, 0x2c, 0x74}, {0x34, 0x1a, 0x1a, 0x2e, 0x34, 0x1a, 0x1a, 0x2e},
+    {0x36, 0x1b, 0x1b, 0x2d, 0x36, 0x1b, 0x1b, 0x2d}, {0xdc, 0x6e, 0x6e, 0xb2, 0xdc, 0x6e, 0x6e, 0xb2},
+    {0xb4, 0x5a, 0x5a, 0xee, 0xb4, 0x5a, 0x5a, 0xee}, {0x5b, 0xa0, 0xa0, 0xfb, 0x5b, 0xa0, 0xa0, 0xfb},
+    {0xa4, 0x52, 0x52, 0xf6, 0xa4, 0x52, 0x52, 0xf6}, {0x76, 0x3b, 0x3b, 0x4d, 0x76, 0x3b, 0x3b, 0x4d},
+    {0xb7, 0xd6, 0xd6, 0x61, 0xb7, 0xd6, 0xd6, 0x61}, {0x7d, 0xb3, 0xb3, 0xce, 0x7d, 0xb3, 0xb3, 0xce},
+    {0x52, 0x29, 0x29, 0x7b, 0x52, 0x29, 0x29, 0x7b}, {0xdd, 0xe3, 0xe3, 0x3e, 0xdd, 0xe3, 0xe3, 0x3e},
+    {0x5e, 0x2f, 0x2f, 0x71, 0x5e, 0x2f, 0x2f, 0x71}, {0x13, 0x84, 0x84, 0x97, 0x13, 0x84, 0x84, 0x97},
+    {0xa6, 0x53, 0x53, 0xf5, 0xa6, 0x53, 0x53, 0xf5}, {0xb9, 0xd1, 0xd1, 0x68, 0xb9, 0xd1, 0xd1, 0x68},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, {0xc1, 0xed, 0xed, 0x2c, 0xc1, 0xed, 0xed, 0x2c},
+    {0x40, 0x20, 0x20, 0x60, 0x40, 0x20, 0x20, 0x60}, {0xe3, 0xfc, 0xfc, 0x1f, 0xe3, 0xfc, 0xfc, 0x1f},
+    {0x79, 0xb1, 0xb1, 0xc8, 0x79, 0xb1, 0xb1, 0xc8}, {0xb6, 0x5b, 0x5b, 0xed, 0xb6, 0x5b, 0x5b, 0xed},
+    {0xd4, 0x6a, 0x6a, 0xbe, 0xd4, 0x6a, 0x6a, 0xbe}, {0x8d, 0xcb, 0xcb, 0x46, 0x8d, 0xcb, 0xcb, 0x46},
+    {0x67, 0xbe, 0xbe, 0xd9, 0x67, 0xbe, 0xbe, 0xd9}, {0x72, 0x39, 0x39, 0x4b, 0x72, 0x39, 0x39, 0x4b},
+    {0x94, 0x4a, 0x4a, 0xde, 0x94, 0x4a, 0x4a, 0xde}, {0x98, 0x4c, 0x4c, 0xd4, 0x98, 0x4c, 0x4c, 0xd4},
+    {0xb0, 0x58, 0x58, 0xe8, 0xb0, 0x58, 0x58, 0xe8}, {0x85, 0xcf, 0xcf, 0x4a, 0x85, 0xcf, 0xcf, 0x4a},
+    {0xbb, 0xd0, 0xd0, 0x6b, 0xbb, 0xd0, 0xd0, 0x6b}, {0xc5, 0xef, 0xef, 0x2a, 0xc5, 0xef, 0xef, 0x2a},
+    {0x4f, 0xaa, 0xaa, 0xe5, 0x4f, 0xaa, 0xaa, 0xe5}, {0xed, 0xfb, 0xfb, 0x16, 0xed, 0xfb, 0xfb, 0x16},
+    {0x86, 0x43, 0x43, 0xc5, 0x86, 0x43, 0x43, 0xc5}, {0x9a, 0x4d, 0x4d, 0xd7, 0x9a, 0x4d, 0x4d, 0xd7},
+    {0x66, 0x33, 0x33, 0x55, 0x66, 0x33, 0x33, 0x55}, {0x11, 0x85, 0x85, 0x94, 0x11, 0x85, 0x85, 0x94},
+    {0x8a, 0x45, 0x45, 0xcf, 0x8a, 0x45, 0x45, 0xcf}, {0xe9, 0xf9, 0xf9, 0x10, 0xe9, 0xf9, 0xf9, 0x10},
+    {0x04, 0x02, 0x02, 0x06, 0x04, 0x02, 0x02, 0x06}, {0xfe, 0x7f, 0x7f, 0x81, 0xfe, 0x7f, 0x7f, 0x81},
+    {0xa0, 0x50, 0x50, 0xf0, 0xa0, 0x50, 0x50, 0xf0}, {0x78, 0x3c, 0x3c, 0x44, 0x78, 0x3c, 0x3c, 0x44},
+    {0x25, 0x9f, 0x9f, 0xba, 0x25, 0x9f, 0x9f, 0xba}, {0x4b, 0xa8, 0xa8, 0xe3, 0x4b, 0xa8, 0xa8, 0xe3},
+    {0xa2, 0x51, 0x51, 0xf3, 0xa2, 0x51, 0x51, 0xf3}, {0x5d, 0xa3, 0xa3, 0xfe, 0x5d, 0xa3, 0xa3, 0xfe},
+    {0x80, 0x40, 0x40, 0xc0, 0x80, 0x40, 0x40, 0xc0}, {0x05, 0x8f, 0x8f, 0x8a, 0x05, 0x8f, 0x8f, 0x8a},
+    {0x3f, 0x92, 0x92, 0xad, 0x3f, 0x92, 0x92, 0xad}, {0x21, 0x9d, 0x9d, 0xbc, 0x21, 0x9d, 0x9d, 0xbc},
+    {0x70, 0x38, 0x38, 0x48, 0x70, 0x38, 0x38, 0x48}, {0xf1, 0xf5, 0xf5, 0x04, 0xf1, 0xf5, 0xf5, 0x04},
+    {0x63, 0xbc, 0xbc, 0xdf, 0x63, 0xbc, 0xbc, 0xdf}, {0x77, 0xb6, 0xb6, 0xc1, 0x77, 0xb6, 0xb6, 0xc1},
+    {0xaf, 0xda, 0xda, 0x75, 0xaf, 0xda, 0xda, 0x75}, {0x42, 0x21, 0x21, 0x63, 0x42, 0x21, 0x21, 0x63},
+    {0x20, 0x10, 0x10, 0x30, 0x20, 0x10, 0x10, 0x30}, {0xe5, 0xff, 0xff, 0x1a, 0xe5, 0xff, 0xff, 0x1a},
+    {0xfd, 0xf3, 0xf3, 0x0e, 0xfd, 0xf3, 0xf3, 0x0e}, {0xbf, 0xd2, 0xd2, 0x6d, 0xbf, 0xd2, 0xd2, 0x6d},
+    {0x81, 0xcd, 0xcd, 0x4c, 0x81, 0xcd, 0xcd, 0x4c}, {0x18, 0x0c, 0x0c, 0x14, 0x18, 0x0c, 0x0c, 0x14},
+    {0x26, 0x13, 0x13, 0x35, 0x26, 0x13, 0x13, 0x35}, {0xc3, 0xec, 0xec, 0x2f, 0xc3, 0xec, 0xec, 0x2f},
+    {0xbe, 0x5f, 0x5f, 0xe1, 0xbe, 0x5f, 0x5f, 0xe1}, {0x35, 0x97, 0x97, 0xa2, 0x35, 0x97, 0x97, 0xa2},
+    {0x88, 0x44, 0x44, 0xcc, 0x88, 0x44, 0x44, 0xcc}, {0x2e, 0x17, 0x17, 0x39, 0x2e, 0x17, 0x17, 0x39},
+    {0x93, 0xc4, 0xc4, 0x57, 0x93, 0xc4, 0xc4, 0x57}, {0x55, 0xa7, 0xa7, 0xf2, 0x55, 0xa7, 0xa7, 0xf2},
+    {0xfc, 0x7e, 0x7e, 0x82, 0xfc, 0x7e, 0x7e, 0x82}, {0x7a, 0x3d, 0x3d, 0x47, 0x7a, 0x3d, 0x3d, 0x47},
+    {0xc8, 0x64, 0x64, 0xac, 0xc8, 0x64, 0x64, 0xac}, {0xba, 0x5d, 0x5d, 0xe7, 0xba, 0x5d, 0x5d, 0xe7},
+    {0x32, 0x19, 0x19, 0x2b, 0x32, 0x19, 0x19, 0x2b}, {0xe6, 0x73, 0x73, 0x95, 0xe6, 0x73, 0x73, 0x95},
+    {0xc0, 0x60, 0x60, 0xa0, 0xc0, 0x60, 0x60, 0xa0}, {0x19, 0x81, 0x81, 0x98, 0x19, 0x81, 0x81, 0x98},
+    {0x9e, 0x4f, 0x4f, 0xd1, 0x9e, 0x4f, 0x4f, 0xd1}, {0xa3, 0xdc, 0xdc, 0x7f, 0xa3, 0xdc, 0xdc, 0x7f},
+    {0x44, 0x22, 0x22, 0x66, 0x44, 0x22, 0x22, 0x66}, {0x54, 0x2a, 0x2a, 0x7e, 0x54, 0x2a, 0x2a, 0x7e},
+    {0x3b, 0x90, 0x90, 0xab, 0x3b, 0x90, 0x90, 0xab}, {0x0b, 0x88, 0x88, 0x83, 0x0b, 0x88, 0x88, 0x83},
+    {0x8c, 0x46, 0x46, 0xca, 0x8c, 0x46, 0x46, 0xca}, {0xc7, 0xee, 0xee, 0x29, 0xc7, 0xee, 0xee, 0x29},
+    {0x6b, 0xb8, 0xb8, 0xd3, 0x6b, 0xb8, 0xb8, 0xd3}, {0x28, 0x14, 0x14, 0x3c, 0x28, 0x14, 0x14, 0x3c},
+    {0xa7, 0xde, 0xde, 0x79, 0xa7, 0xde, 0xde, 0x79}, {0xbc, 0x5e, 0x5e, 0xe2, 0xbc, 0x5e, 0x5e, 0xe2},
+    {0x16, 0x0b, 0x0b, 0x1d, 0x16, 0x0b, 0x0b, 0x1d}, {0xad, 0xdb, 0xdb, 0x76, 0xad, 0xdb, 0xdb, 0x76},
+    {0xdb, 0xe0, 0xe0, 0x3b, 0xdb, 0xe0, 0xe0, 0x3b}, {0x64, 0x32, 0x32, 0x56, 0x64, 0x32, 0x32, 0x56},
+    {0x74, 0x3a, 0x3a, 0x4e, 0x74, 0x3a, 0x3a, 0x4e}, {0x14, 0x0a, 0x0a, 0x1e, 0x14, 0x0a, 0x0a, 0x1e},
+    {0x92, 0x49, 0x49, 0xdb, 0x92, 0x49, 0x49, 0xdb}, {0x0c, 0x06, 0x06, 0x0a, 0x0c, 0x06, 0x06, 0x0a},
+    {0x48, 0x24, 0x24, 0x6c, 0x48, 0x24, 0x24, 0x6c}, {0xb8, 0x5c, 0x5c, 0xe4, 0xb8, 0x5c, 0x5c, 0xe4},
+    {0x9f, 0xc2, 0xc2, 0x5d, 0x9f, 0xc2, 0xc2, 0x5d}, {0xbd, 0xd3, 0xd3, 0x6e, 0xbd, 0xd3, 0xd3, 0x6e},
+    {0x43, 0xac, 0xac, 0xef, 0x43, 0xac, 0xac, 0xef}, {0xc4, 0x62, 0x62, 0xa6, 0xc4, 0x62, 0x62, 0xa6},
+    {0x39, 0x91, 0x91, 0xa8, 0x39, 0x91, 0x91, 0xa8}, {0x31, 0x95, 0x95, 0xa4, 0x31, 0x95, 0x95, 0xa4},
+    {0xd3, 0xe4, 0xe4, 0x37, 0xd3, 0xe4, 0xe4, 0x37}, {0xf2, 0x79, 0x79, 0x8b, 0xf2, 0x79, 0x79, 0x8b},
+    {0xd5, 0xe7, 0xe7, 0x32, 0xd5, 0xe7, 0xe7, 0x32}, {0x8b, 0xc8, 0xc8, 0x43, 0x8b, 0xc8, 0xc8, 0x43},
+    {0x6e, 0x37, 0x37, 0x59, 0x6e, 0x37, 0x37, 0x59}, {0xda, 0x6d, 0x6d, 0xb7, 0xda, 0x6d, 0x6d, 0xb7},
+    {0x01, 0x8d, 0x8d, 0x8c, 0x01, 0x8d, 0x8d, 0x8c}, {0xb1, 0xd5, 0xd5, 0x64, 0xb1, 0xd5, 0xd5, 0x64},
+    {0x9c, 0x4e, 0x4e, 0xd2, 0x9c, 0x4e, 0x4e, 0xd2}, {0x49, 0xa9, 0xa9, 0xe0, 0x49, 0xa9, 0xa9, 0xe0},
+    {0xd8, 0x6c, 0x6c, 0xb4, 0xd8, 0x6c, 0x6c, 0xb4}, {0xac, 0x56, 0x56, 0xfa, 0xac, 0x56, 0x56, 0xfa},
+    {0xf3, 0xf4, 0xf4, 0x07, 0xf3, 0xf4, 0xf4, 0x07}, {0xcf, 0xea, 0xea, 0x25, 0xcf, 0xea, 0xea, 0x25},
+    {0xca, 0x65, 0x65, 0xaf, 0xca, 0x65, 0x65, 0xaf}, {0xf4, 0x7a, 0x7a, 0x8e, 0xf4, 0x7a, 0x7a, 0x8e},
+    {0x47, 0xae, 0xae, 0xe9, 0x47, 0xae, 0xae, 0xe9}, {0x10, 0x08, 0x08, 0x18, 0x10, 0x08, 0x08, 0x18},
+    {0x6f, 0xba, 0xba, 0xd5, 0x6f, 0xba, 0xba, 0xd5}, {0xf0, 0x78, 0x78, 0x88, 0xf0, 0x78, 0x78, 0x88},
+    {0x4a, 0x25, 0x25, 0x6f, 0x4a, 0x25, 0x25, 0x6f}, {0x5c, 0x2e, 0x2e, 0x72, 0x5c, 0x2e, 0x2e, 0x72},
+    {0x38, 0x1c, 0x1c, 0x24, 0x38, 0x1c, 0x1c, 0x24}, {0x57, 0xa6, 0xa6, 0xf1, 0x57, 0xa6, 0xa6, 0xf1},
+    {0x73, 0xb4, 0xb4, 0xc7, 0x73, 0xb4, 0xb4, 0xc7}, {0x97, 0xc6, 0xc6, 0x51, 0x97, 0xc6, 0xc6, 0x51},
+    {0xcb, 0xe8, 0xe8, 0x23, 0xcb, 0xe8, 0xe8, 0x23}, {0xa1, 0xdd, 0xdd, 0x7c, 0xa1, 0xdd, 0xdd, 0x7c},
+    {0xe8, 0x74, 0x74, 0x9c, 0xe8, 0x74, 0x74, 0x9c}, {0x3e, 0x1f, 0x1f, 0x21, 0x3e, 0x1f, 0x1f, 0x21},
+    {0x96, 0x4b, 0x4b, 0xdd, 0x96, 0x4b, 0x4b, 0xdd}, {0x61, 0xbd, 0xbd, 0xdc, 0x61, 0xbd, 0xbd, 0xdc},
+    {0x0d, 0x8b, 0x8b, 0x86, 0x0d, 0x8b, 0x8b, 0x86}, {0x0f, 0x8a, 0x8a, 0x85, 0x0f, 0x8a, 0x8a, 0x85},
+    {0xe0, 0x70, 0x70, 0x90, 0xe0, 0x70, 0x70, 0x90}, {0x7c, 0x3e, 0x3e, 0x42, 0x7c, 0x3e, 0x3e, 0x42},
+    {0x71, 0xb5, 0xb5, 0xc4, 0x71, 0xb5, 0xb5, 0xc4}, {0xcc, 0x66, 0x66, 0xaa, 0xcc, 0x66, 0x66, 0xaa},
+    {0x90, 0x48, 0x48, 0xd8, 0x90, 0x48, 0x48, 0xd8}, {0x06, 0x03, 0x03, 0x05, 0x06, 0x03, 0x03, 0x05},
+    {0xf7, 0xf6, 0xf6, 0x01, 0xf7, 0xf6, 0xf6, 0x01}, {0x1c, 0x0e, 0x0e, 0x12, 0x1c, 0x0e, 0x0e, 0x12},
+    {0xc2, 0x61, 0x61, 0xa3, 0xc2, 0x61, 0x61, 0xa3}, {0x6a, 0x35, 0x35, 0x5f, 0x6a, 0x35, 0x35, 0x5f},
+    {0xae, 0x57, 0x57, 0xf9, 0xae, 0x57, 0x57, 0xf9}, {0x69, 0xb9, 0xb9, 0xd0, 0x69, 0xb9, 0xb9, 0xd0},
+    {0x17, 0x86, 0x86, 0x91, 0x17, 0x86, 0x86, 0x91}, {0x99, 0xc1, 0xc1, 0x58, 0x99, 0xc1, 0xc1, 0x58},
+    {0x3a, 0x1d, 0x1d, 0x27, 0x3a, 0x1d, 0x1d, 0x27}, {0x27, 0x9e, 0x9e, 0xb9, 0x27, 0x9e, 0x9e, 0xb9},
+    {0xd9, 0xe1, 0xe1, 0x38, 0xd9, 0xe1, 0xe1, 0x38}, {0xeb, 0xf8, 0xf8, 0x13, 0xeb, 0xf8, 0xf8, 0x13},
+    {0x2b, 0x98, 0x98, 0xb3, 0x2b, 0x98, 0x98, 0xb3}, {0x22, 0x11, 0x11, 0x33, 0x22, 0x11, 0x11, 0x33},
+    {0xd2, 0x69, 0x69, 0xbb, 0xd2, 0x69, 0x69, 0xbb}, {0xa9, 0xd9, 0xd9, 0x70, 0xa9, 0xd9, 0xd9, 0x70},
+    {0x07, 0x8e, 0x8e, 0x89, 0x07, 0x8e, 0x8e, 0x89}, {0x33, 0x94, 0x94, 0xa7, 0x33, 0x94, 0x94, 0xa7},
+    {0x2d, 0x9b, 0x9b, 0xb6, 0x2d, 0x9b, 0x9b, 0xb6}, {0x3c, 0x1e, 0x1e, 0x22, 0x3c, 0x1e, 0x1e, 0x22},
+    {0x15, 0x87, 0x87, 0x92, 0x15, 0x87, 0x87, 0x92}, {0xc9, 0xe9, 0xe9, 0x20, 0xc9, 0xe9, 0xe9, 0x20},
+    {0x87, 0xce, 0xce, 0x49, 0x87, 0xce, 0xce, 0x49}, {0xaa, 0x55, 0x55, 0xff, 0xaa, 0x55, 0x55, 0xff},
+    {0x50, 0x28, 0x28, 0x78, 0x50, 0x28, 0x28, 0x78}, {0xa5, 0xdf, 0xdf, 0x7a, 0xa5, 0xdf, 0xdf, 0x7a},
+    {0x03, 0x8c, 0x8c, 0x8f, 0x03, 0x8c, 0x8c, 0x8f}, {0x59, 0xa1, 0xa1, 0xf8, 0x59, 0xa1, 0xa1, 0xf8},
+    {0x09, 0x89, 0x89, 0x80, 0x09, 0x89, 0x89, 0x80}, {0x1a, 0x0d, 0x0d, 0x17, 0x1a, 0x0d, 0x0d, 0x17},
+    {0x65, 0xbf, 0xbf, 0xda, 0x65, 0xbf, 0xbf, 0xda}, {0xd7, 0xe6, 0xe6, 0x31, 0xd7, 0xe6, 0xe6, 0x31},
+    {0x84, 0x42, 0x42, 0xc6, 0x84, 0x42, 0x42, 0xc6}, {0xd0, 0x68, 0x68, 0xb8, 0xd0, 0x68, 0x68, 0xb8},
+    {0x82, 0x41, 0x41, 0xc3, 0x82, 0x41, 0x41, 0xc3}, {0x29, 0x99, 0x99, 0xb0, 0x29, 0x99, 0x99, 0xb0},
+    {0x5a, 0x2d, 0x2d, 0x77, 0x5a, 0x2d, 0x2d, 0x77}, {0x1e, 0x0f, 0x0f, 0x11, 0x1e, 0x0f, 0x0f, 0x11},
+    {0x7b, 0xb0, 0xb0, 0xcb, 0x7b, 0xb0, 0xb0, 0xcb}, {0xa8, 0x54, 0x54, 0xfc, 0xa8, 0x54, 0x54, 0xfc},
+    {0x6d, 0xbb, 0xbb, 0xd6, 0x6d, 0xbb, 0xbb, 0xd6}, {0x2c, 0x16, 0x16, 0x3a, 0x2c, 0x16, 0x16, 0x3a},
+};
+
+const uint8_t T_inv_dup[256][8] TABLE_ALIGN = {
+    {0x51, 0xf4, 0xa7, 0x50, 0x51, 0xf4, 0xa7, 0x50}, {0x7e, 0x41, 0x65, 0x53, 0x7e, 0x41, 0x65, 0x53},
+    {0x1a, 0x17, 0xa4, 0xc3, 0x1a, 0x17, 0xa4, 0xc3}, {0x3a, 0x27, 0x5e, 0x96, 0x3a, 0x27, 0x5e, 0x96},
+    {0x3b, 0xab, 0x6b, 0xcb, 0x3b, 0xab, 0x6b, 0xcb}, {0x1f, 0x9d, 0x45, 0xf1, 0x1f, 0x9d, 0x45, 0xf1},
+    {0xac, 0xfa, 0x58, 0xab, 0xac, 0xfa, 0x58, 0xab}, {0x4b, 0xe3, 0x03, 0x93, 0x4b, 0xe3, 0x03, 0x93},
+    {0x20, 0x30, 0xfa, 0x55, 0x20, 0x30, 0xfa, 0x55}, {0xad, 0x76, 0x6d, 0xf6, 0xad, 0x76, 0x6d, 0xf6},
+    {0x88, 0xcc, 0x76, 0x91, 0x88, 0xcc, 0x76, 0x91}, {0xf5, 0x02, 0x4c, 0x25, 0xf5, 0x02, 0x4c, 0x25},
+    {0x4f, 0xe5, 0xd7, 0xfc, 0x4f, 0xe5, 0xd7, 0xfc}, {0xc5, 0x2a, 0xcb, 0xd7, 0xc5, 0x2a, 0xcb, 0xd7},
+    {0x26, 0x35, 0x44, 0x80, 0x26, 0x35, 0x44, 0x80}, {0xb5, 0x62, 0xa3, 0x8f, 0xb5, 0x62, 0xa3, 0x8f},
+    {0xde, 0xb1, 0x5a, 0x49, 0xde, 0xb1, 0x5a, 0x49}, {0x25, 0xba, 0x1b, 0x67, 0x25, 0xba, 0x1b, 0x67},
+    {0x45, 0xea, 0x0e, 0x98, 0x45, 0xea, 0x0e, 0x98}, {0x5d, 0xfe, 0xc0, 0xe1, 0x5d, 0xfe, 0xc0, 0xe1},
+    {0xc3, 0x2f, 0x75, 0x02, 0xc3, 0x2f, 0x75, 0x02}, {0x81, 0x4c, 0xf0, 0x12, 0x81, 0x4c, 0xf0, 0x12},
+    {0x8d, 0x46, 0x97, 0xa3, 0x8d, 0x46, 0x97, 0xa3}, {0x6b, 0xd3, 0xf9, 0xc6, 0x6b, 0xd3, 0xf9, 0xc6},
+    {0x03, 0x8f, 0x5f, 0xe7, 0x03, 0x8f, 0x5f, 0xe7}, {0x15, 0x92, 0x9c, 0x95, 0x15, 0x92, 0x9c, 0x95},
+    {0xbf, 0x6d, 0x7a, 0xeb, 0xbf, 0x6d, 0x7a, 0xeb}, {0x95, 0x52, 0x59, 0xda, 0x95, 0x52, 0x59, 0xda},
+    {0xd4, 0xbe, 0x83, 0x2d, 0xd4, 0xbe, 0x83, 0x2d}, {0x58, 0x74, 0x21, 0xd3, 0x58, 0x74, 0x21, 0xd3},
+    {0x49, 0xe0, 0x69, 0x29, 0x49, 0xe0, 0x69, 0x29}, {0x8e, 0xc9, 0xc8, 0x44, 0x8e, 0xc9, 0xc8, 0x44},
+    {0x75, 0xc2, 0x89, 0x6a, 0x75, 0xc2, 0x89, 0x6a}, {0xf4, 0x8e, 0x79, 0x78, 0xf4, 0x8e, 0x79, 0x78},
+    {0x99, 0x58, 0x3e, 0x6b, 0x99, 0x58, 0x3e, 0x6b}, {0x27, 0xb9, 0x71, 0xdd, 0x27, 0xb9, 0x71, 0xdd},
+    {0xbe, 0xe1, 0x4f, 0xb6, 0xbe, 0xe1, 0x4f, 0xb6}, {0xf0, 0x88, 0xad, 0x17, 0xf0, 0x88, 0xad, 0x17},
+    {0xc9, 0x20, 0xac, 0x66, 0xc9, 0x20, 0xac, 0x66}, {0x7d, 0xce, 0x3a, 0xb4, 0x7d, 0xce, 0x3a, 0xb4},
+    {0x63, 0xdf, 0x4a, 0x18, 0x63, 0xdf, 0x4a, 0x18}, {0xe5, 0x1a, 0x31, 0x82, 0xe5, 0x1a, 0x31, 0x82},
+    {0x97, 0x51, 0x33, 0x60, 0x97, 0x51, 0x33, 0x60}, {0x62, 0x53, 0x7f, 0x45, 0x62, 0x53, 0x7f, 0x45},
+    {0xb1, 0x64, 0x77, 0xe0, 0xb1, 0x64, 0x77, 0xe0}, {0xbb, 0x6b, 0xae, 0x84, 0xbb, 0x6b, 0xae, 0x84},
+    {0xfe, 0x81, 0xa0, 0x1c, 0xfe, 0x81, 0xa0, 0x1c}, {0xf9, 0x08, 0x2b, 0x94, 0xf9, 0x08, 0x2b, 0x94},
+    {0x70, 0x48, 0x68, 0x58, 0x70, 0x48, 0x68, 0x58}, {0x8f, 0x45, 0xfd, 0x19, 0x8f, 0x45, 0xfd, 0x19},
+    {0x94, 0xde, 0x6c, 0x87, 0x94, 0xde, 0x6c, 0x87}, {0x52, 0x7b, 0xf8, 0xb7, 0x52, 0x7b, 0xf8, 0xb7},
+    {0xab, 0x73, 0xd3, 0x23, 0xab, 0x73, 0xd3, 0x23}, {0x72, 0x4b, 0x02, 0xe2, 0x72, 0x4b, 0x02, 0xe2},
+    {0xe3, 0x1f, 0x8f, 0x57, 0xe3, 0x1f, 0x8f, 0x57}, {0x66, 0x55, 0xab, 0x2a, 0x66, 0x55, 0xab, 0x2a},
+    {0xb2, 0xeb, 0x28, 0x07, 0xb2, 0xeb, 0x28, 0x07}, {0x2f, 0xb5, 0xc2, 0x03, 0x2f, 0xb5, 0xc2, 0x03},
+    {0x86, 0xc5, 0x7b, 0x9a, 0x86, 0xc5, 0x7b, 0x9a}, {0xd3, 0x37, 0x08, 0xa5, 0xd3, 0x37, 0x08, 0xa5},
+    {0x30, 0x28, 0x87, 0xf2, 0x30, 0x28, 0x87, 0xf2}, {0x23, 0xbf, 0xa5, 0xb2, 0x23, 0xbf, 0xa5, 0xb2},
+    {0x02, 0x03, 0x6a, 0xba, 0x02, 0x03, 0x6a, 0xba}, {0xed, 0x16, 0x82, 0x5c, 0xed, 0x16, 0x82, 0x5c},
+    {0x8a, 0xcf, 0x1c, 0x2b, 0x8a, 0xcf, 0x1c, 0x2b}, {0xa7, 0x79, 0xb4, 0x92, 0xa7, 0x79, 0xb4, 0x92},
+    {0xf3, 0x07, 0xf2, 0xf0, 0xf3, 0x07, 0xf2, 0xf0}, {0x4e, 0x69, 0xe2, 0xa1, 0x4e, 0x69, 0xe2, 0xa1},
+    {0x65, 0xda, 0xf4, 0xcd, 0x65, 0xda, 0xf4, 0xcd}, {0x06, 0x05, 0xbe, 0xd5, 0x06, 0x05, 0xbe, 0xd5},
+    {0xd1, 0x34, 0x62, 0x1f, 0xd1, 0x34, 0x62, 0x1f}, {0xc4, 0xa6, 0xfe, 0x8a, 0xc4, 0xa6, 0xfe, 0x8a},
+    {0x34, 0x2e, 0x53, 0x9d, 0x34, 0x2e, 0x53, 0x9d}, {0xa2, 0xf3, 0x55, 0xa0, 0xa2, 0xf3, 0x55, 0xa0},
+    {0x05, 0x8a, 0xe1, 0x32, 0x05, 0x8a, 0xe1, 0x32}, {0xa4, 0xf6, 0xeb, 0x75, 0xa4, 0xf6, 0xeb, 0x75},
+    {0x0b, 0x83, 0xec, 0x39, 0x0b, 0x83, 0xec, 0x39}, {0x40, 0x60, 0xef, 0xaa, 0x40, 0x60, 0xef, 0xaa},
+    {0x5e, 0x71, 0x9f, 0x06, 0x5e, 0x71, 0x9f, 0x06}, {0xbd, 0x6e, 0x10, 0x51, 0xbd, 0x6e, 0x10, 0x51},
+    {0x3e, 0x21, 0x8a, 0xf9, 0x3e, 0x21, 0x8a, 0xf9}, {0x96, 0xdd, 0x06, 0x3d, 0x96, 0xdd, 0x06, 0x3d},
+    {0xdd, 0x3e, 0x05, 0xae, 0xdd, 0x3e, 0x05, 0xae}, {0x4d, 0xe6, 0xbd, 0x46, 0x4d, 0xe6, 0xbd, 0x46},
+    {0x91, 0x54, 0x8d, 0xb5, 0x91, 0x54, 0x8d, 0xb5}, {0x71, 0xc4, 0x5d, 0x05, 0x71, 0xc4, 0x5d, 0x05},
+    {0x04, 0x06, 0xd4, 0x6f, 0x04, 0x06, 0xd4, 0x6f}, {0x60, 0x50, 0x15, 0xff, 0x60, 0x50, 0x15, 0xff},
+    {0x19, 0x98, 0xfb, 0x24, 0x19, 0x98, 0xfb, 0x24}, {0xd6, 0xbd, 0xe9, 0x97, 0xd6, 0xbd, 0xe9, 0x97},
+    {0x89, 0x40, 0x43, 0xcc, 0x89, 0x40, 0x43, 0xcc}, {0x67, 0xd9, 0x9e, 0x77, 0x67, 0xd9, 0x9e, 0x77},
+    {0xb0, 0xe8, 0x42, 0xbd, 0xb0, 0xe8, 0x42, 0xbd}, {0x07, 0x89, 0x8b, 0x88, 0x07, 0x89, 0x8b, 0x88},
+    {0xe7, 0x19, 0x5b, 0x38, 0xe7, 0x19, 0x5b, 0x38}, {0x79, 0xc8, 0xee, 0xdb, 0x79, 0xc8, 0xee, 0xdb},
+    {0xa1, 0x7c, 0x0a, 0x47, 0xa1, 0x7c, 0x0a, 0x47}, {0x7c, 0x42, 0x0f, 0xe9, 0x7c, 0x42, 0x0f, 0xe9},
+    {0xf8, 0x84, 0x1e, 0xc9, 0xf8, 0x84, 0x1e, 0xc9}, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0x09, 0x80, 0x86, 0x83, 0x09, 0x80, 0x86, 0x83}, {0x32, 0x2b, 0xed, 0x48, 0x32, 0x2b, 0xed, 0x48},
+    {0x1e, 0x11, 0x70, 0xac, 0x1e, 0x11, 0x70, 0xac}, {0x6c, 0x5a, 0x72, 0x4e, 0x6c, 0x5a, 0x72, 0x4e},
+    {0xfd, 0x0e, 0xff, 0xfb, 0xfd, 0x0e, 0xff, 0xfb}, {0x0f, 0x85, 0x38, 0x56, 0x0f, 0x85, 0x38, 0x56},
+    {0x3d, 0xae, 0xd5, 0x1e, 0x3d, 0xae, 0xd5, 0x1e}, {0x36, 0x2d, 0x39, 0x27, 0x36, 0x2d, 0x39, 0x27},
+    {0x0a, 0x0f, 0xd9, 0x64, 0x0a, 0x0f, 0xd9, 0x64}, {0x68, 0x5c, 0xa6, 0x21, 0x68, 0x5c, 0xa6, 0x21},
+    {0x9b, 0x5b, 0x54, 0xd1, 0x9b, 0x5b, 0x54, 0xd1}, {0x24, 0x36, 0x2e, 0x3a, 0x24, 0x36, 0x2e, 0x3a},
+    {0x0c, 0x0a, 0x67, 0xb1, 0x0c, 0x0a, 0x67, 0xb1}, {0x93, 0x57, 0xe7, 0x0f, 0x93, 0x57, 0xe7, 0x0f},
+    {0xb4, 0xee, 0x96, 0xd2, 0xb4, 0xee, 0x96, 0xd2}, {0x1b, 0x9b, 0x91, 0x9e, 0x1b, 0x9b, 0x91, 0x9e},
+    {0x80, 0xc0, 0xc5, 0x4f, 0x80, 0xc0, 0xc5, 0x4f}, {0x61, 0xdc, 0x20, 0xa2, 0x61, 0xdc, 0x20, 0xa2},
+    {0x5a, 0x77, 0x4b, 0x69, 0x5a, 0x77, 0x4b, 0x69}, {0x1c, 0x12, 0x1a, 0x16, 0x1c, 0x12, 0x1a, 0x16},
+    {0xe2, 0x93, 0xba, 0x0a, 0xe2, 0x93, 0xba, 0x0a}, {0xc0, 0xa0, 0x2a, 0xe5, 0xc0, 0xa0, 0x2a, 0xe5},
+    {0x3c, 0x22, 0xe0, 0x43, 0x3c, 0x22, 0xe0, 0x43}, {0x12, 0x1b, 0x17, 0x1d, 0x12, 0x1b, 0x17, 0x1d},
+    {0x0e, 0x09, 0x0d, 0x0b, 0x0e, 0x09, 0x0d, 0x0b}, {0xf2, 0x8b, 0xc7, 0xad, 0xf2, 0x8b, 0xc7, 0xad},
+    {0x2d, 0xb6, 0xa8, 0xb9, 0x2d, 0xb6, 0xa8, 0xb9}, {0x14, 0x1e, 0xa9, 0xc8, 0x14, 0x1e, 0xa9, 0xc8},
+    {0x57, 0xf1, 0x19, 0x85, 0x57, 0xf1, 0x19, 0x85}, {0xaf, 0x75, 0x07, 0x4c, 0xaf, 0x75, 0x07, 0x4c},
+    {0xee, 0x99, 0xdd, 0xbb, 0xee, 0x99, 0xdd, 0xbb}, {0xa3, 0x7f, 0x60, 0xfd, 0xa3, 0x7f, 0x60, 0xfd},
+    {0xf7, 0x01, 0x26, 0x9f, 0xf7, 0x01, 0x26, 0x9f}, {0x5c, 0x72, 0xf5, 0xbc, 0x5c, 0x72, 0xf5, 0xbc},
+    {0x44, 0x66, 0x3b, 0xc5, 0x44, 0x66, 0x3b, 0xc5}, {0x5b, 0xfb, 0x7e, 0x34, 0x5b, 0xfb, 0x7e, 0x34},
+    {0x8b, 0x43, 0x29, 0x76, 0x8b, 0x43, 0x29, 0x76}, {0xcb, 0x23, 0xc6, 0xdc, 0xcb, 0x23, 0xc6, 0xdc},
+    {0xb6, 0xed, 0xfc, 0x68, 0xb6, 0xed, 0xfc, 0x68}, {0xb8, 0xe4, 0xf1, 0x63, 0xb8, 0xe4, 0xf1, 0x63},
+    {0xd7, 0x31, 0xdc, 0xca, 0xd7, 0x31, 0xdc, 0xca}, {0x42, 0x63, 0x85, 0x10, 0x42, 0x63, 0x85, 0x10},
+    {0x13, 0x97, 0x22, 0x40, 0x13, 0x97, 0x22, 0x40}, {0x84, 0xc6, 0x11, 0x20, 0x84, 0xc6, 0x11, 0x20},
+    {0x85, 0x4a, 0x24, 0x7d, 0x85, 0x4a, 0x24, 0x7d}, {0xd2, 0xbb, 0x3d, 0xf8, 0xd2, 0xbb, 0x3d, 0xf8},
+    {0xae, 0xf9, 0x32, 0x11, 0xae, 0xf9, 0x32, 0x11}, {0xc7, 0x29, 0xa1, 0x6d, 0xc7, 0x29, 0xa1, 0x6d},
+    {0x1d, 0x9e, 0x2f, 0x4b, 0x1d, 0x9e, 0x2f, 0x4b}, {0xdc, 0xb2, 0x30, 0xf3, 0xdc, 0xb2, 0x30, 0xf3},
+    {0x0d, 0x86, 0x52, 0xec, 0x0d, 0x86, 0x52, 0xec}, {0x77, 0xc1, 0xe3, 0xd0, 0x77, 0xc1, 0xe3, 0xd0},
+    {0x2b, 0xb3, 0x16, 0x6c, 0x2b, 0xb3, 0x16, 0x6c}, {0xa9, 0x70, 0xb9, 0x99, 0xa9, 0x70, 0xb9, 0x99},
+    {0x11, 0x94, 0x48, 0xfa, 0x11, 0x94, 0x48, 0xfa}, {0x47, 0xe9, 0x64, 0x22, 0x47, 0xe9, 0x64, 0x22},
+    {0xa8, 0xfc, 0x8c, 0xc4, 0xa8, 0xfc, 0x8c, 0xc4}, {0xa0, 0xf0, 0x3f, 0x1a, 0xa0, 0xf0, 0x3f, 0x1a},
+    {0x56, 0x7d, 0x2c, 0xd8, 0x56, 0x7d, 0x2c, 0xd8}, {0x22, 0x33, 0x90, 0xef, 0x22, 0x33, 0x90, 0xef},
+    {0x87, 0x49, 0x4e, 0xc7, 0x87, 0x49, 0x4e, 0xc7}, {0xd9, 0x38, 0xd1, 0xc1, 0xd9, 0x38, 0xd1, 0xc1},
+    {0x8c, 0xca, 0xa2, 0xfe, 0x8c, 0xca, 0xa2, 0xfe}, {0x98, 0xd4, 0x0b, 0x36, 0x98, 0xd4, 0x0b, 0x36},
+    {0xa6, 0xf5, 0x81, 0xcf, 0xa6, 0xf5, 0x81, 0xcf}, {0xa5, 0x7a, 0xde, 0x28, 0xa5, 0x7a, 0xde, 0x28},
+    {0xda, 0xb7, 0x8e, 0x26, 0xda, 0xb7, 0x8e, 0x26}, {0x3f, 0xad, 0xbf, 0xa4, 0x3f, 0xad, 0xbf, 0xa4},
+    {0x2c, 0x3a, 0x9d, 0xe4, 0x2c, 0x3a, 0x9d, 0xe4}, {0x50, 0x78, 0x92, 0x0d, 0x50, 0x78, 0x92, 0x0d},
+    {0x6a, 0x5f, 0xcc, 0x9b, 0x6a, 0x5f, 0xcc, 0x9b}, {0x54, 0x7e, 0x46, 0x62, 0x54, 0x7e, 0x46, 0x62},
+    {0xf6, 0x8d, 0x13, 0xc2, 0xf6, 0x8d, 0x13, 0xc2}, {0x90, 0xd8, 0xb8, 0xe8, 0x90, 0xd8, 0xb8, 0xe8},
+    {0x2e, 0x39, 0xf7, 0x5e, 0x2e, 0x39, 0xf7, 0x5e}, {0x82, 0xc3, 0xaf, 0xf5, 0x82, 0xc3, 0xaf, 0xf5},
+    {0x9f, 0x5d, 0x80, 0xbe, 0x9f, 0x5d, 0x80, 0xbe}, {0x69, 0xd0, 0x93, 0x7c, 0x69, 0xd0, 0x93, 0x7c},
+    {0x6f, 0xd5, 0x2d, 0xa9, 0x6f, 0xd5, 0x2d, 0xa9}, {0xcf, 0x25, 0x12, 0xb3, 0xcf, 0x25, 0x12, 0xb3},
+    {0xc8, 0xac, 0x99, 0x3b, 0xc8, 0xac, 0x99, 0x3b}, {0x10, 0x18, 0x7d, 0xa7, 0x10, 0x18, 0x7d, 0xa7},
+    {0xe8, 0x9c, 0x63, 0x6e, 0xe8, 0x9c, 0x63, 0x6e}, {0xdb, 0x3b, 0xbb, 0x7b, 0xdb, 0x3b, 0xbb, 0x7b},
+    {0xcd, 0x26, 0x78, 0x09, 0xcd, 0x26, 0x78, 0x09}, {0x6e, 0x59, 0x18, 0xf4, 0x6e, 0x59, 0x18, 0xf4},
+    {0xec, 0x9a, 0xb7, 0x01, 0xec, 0x9a, 0xb7, 0x01}, {0x83, 0x4f, 0x9a, 0xa8, 0x83, 0x4f, 0x9a, 0xa8},
+    {0xe6, 0x95, 0x6e, 0x65, 0xe6, 0x95, 0x6e, 0x65}, {0xaa, 0xff, 0xe6, 0x7e, 0xaa, 0xff, 0xe6, 0x7e},
+    {0x21, 0xbc, 0xcf, 0x08, 0x21, 0xbc, 0xcf, 0x08}, {0xef, 0x15, 0xe8, 0xe6, 0xef, 0x15, 0xe8, 0xe6},
+    {0xba, 0xe7, 0x9b, 0xd9, 0xba, 0xe7, 0x9b, 0xd9}, {0x4a, 0x6f, 0x36, 0xce, 0x4a, 0x6f, 0x36, 0xce},
+    {0xea, 0x9f, 0x09, 0xd4, 0xea, 0x9f, 0x09, 0xd4}, {0x29, 0xb0, 0x7c, 0xd6, 0x29, 0xb0, 0x7c, 0xd6},
+    {0x31, 0xa4, 0xb2, 0xaf, 0x31, 0xa4, 0xb2, 0xaf}, {0x2a, 0x3f, 0x23, 0x31, 0x2a, 0x3f, 0x23, 0x31},
+    {0xc6, 0xa5, 0x94, 0x30, 0xc6, 0xa5, 0x94, 0x30}, {0x35, 0xa2, 0x66, 0xc0, 0x35, 0xa2, 0x66, 0xc0},
+    {0x74, 0x4e, 0xbc, 0x37, 0x74, 0x4e, 0xbc, 0x37}, {0xfc, 0x82, 0xca, 0xa6, 0xfc, 0x82, 0xca, 0xa6},
+    {0xe0, 0x90, 0xd0, 0xb0, 0xe0, 0x90, 0xd0, 0xb0}, {0x33, 0xa7, 0xd8, 0x15, 0x33, 0xa7, 0xd8, 0x15},
+    {0xf1, 0x04, 0x98, 0x4a, 0xf1, 0x04, 0x98, 0x4a}, {0x41, 0xec, 0xda, 0xf7, 0x41, 0xec, 0xda, 0xf7},
+    {0x7f, 0xcd, 0x50, 0x0e, 0x7f, 0xcd, 0x50, 0x0e}, {0x17, 0x91, 0xf6, 0x2f, 0x17, 0x91, 0xf6, 0x2f},
+    {0x76, 0x4d, 0xd6, 0x8d, 0x76, 0x4d, 0xd6, 0x8d}, {0x43, 0xef, 0xb0, 0x4d, 0x43, 0xef, 0xb0, 0x4d},
+    {0xcc, 0xaa, 0x4d, 0x54, 0xcc, 0xaa, 0x4d, 0x54}, {0xe4, 0x96, 0x04, 0xdf, 0xe4, 0x96, 0x04, 0xdf},
+    {0x9e, 0xd1, 0xb5, 0xe3, 0x9e, 0xd1, 0xb5, 0xe3}, {0x4c, 0x6a, 0x88, 0x1b, 0x4c, 0x6a, 0x88, 0x1b},
+    {0xc1, 0x2c, 0x1f, 0xb8, 0xc1, 0x2c, 0x1f, 0xb8}, {0x46, 0x65, 0x51, 0x7f, 0x46, 0x65, 0x51, 0x7f},
+    {0x9d, 0x5e, 0xea, 0x04, 0x9d, 0x5e, 0xea, 0x04}, {0x01, 0x8c, 0x35, 0x5d, 0x01, 0x8c, 0x35, 0x5d},
+    {0xfa, 0x87, 0x74, 0x73, 0xfa, 0x87, 0x74, 0x73}, {0xfb, 0x0b, 0x41, 0x2e, 0xfb, 0x0b, 0x41, 0x2e},
+    {0xb3, 0x67, 0x1d, 0x5a, 0xb3, 0x67, 0x1d, 0x5a}, {0x92, 0xdb, 0xd2, 0x52, 0x92, 0xdb, 0xd2, 0x52},
+    {0xe9, 0x10, 0x56, 0x33, 0xe9, 0x10, 0x56, 0x33}, {0x6d, 0xd6, 0x47, 0x13, 0x6d, 0xd6, 0x47, 0x13},
+    {0x9a, 0xd7, 0x61, 0x8c, 0x9a, 0xd7, 0x61, 0x8c}, {0x37, 0xa1, 0x0c, 0x7a, 0x37, 0xa1, 0x0c, 0x7a},
+    {0x59, 0xf8, 0x14, 0x8e, 0x59, 0xf8, 0x14, 0x8e}, {0xeb, 0x13, 0x3c, 0x89, 0xeb, 0x13, 0x3c, 0x89},
+    {0xce, 0xa9, 0x27, 0xee, 0xce, 0xa9, 0x27, 0xee}, {0xb7, 0x61, 0xc9, 0x35, 0xb7, 0x61, 0xc9, 0x35},
+    {0xe1, 0x1c, 0xe5, 0xed, 0xe1, 0x1c, 0xe5, 0xed}, {0x7a, 0x47, 0xb1, 0x3c, 0x7a, 0x47, 0xb1, 0x3c},
+    {0x9c, 0xd2, 0xdf, 0x59, 0x9c, 0xd2, 0xdf, 0x59}, {0x55, 0xf2, 0x73, 0x3f, 0x55, 0xf2, 0x73, 0x3f},
+    {0x18, 0x14, 0xce, 0x79, 0x18, 0x14, 0xce, 0x79}, {0x73, 0xc7, 0x37, 0xbf, 0x73, 0xc7, 0x37, 0xbf},
+    {0x53, 0xf7, 0xcd, 0xea, 0x53, 0xf7, 0xcd, 0xea}, {0x5f, 0xfd, 0xaa, 0x5b, 0x5f, 0xfd, 0xaa, 0x5b},
+    {0xdf, 0x3d, 0x6f, 0x14, 0xdf, 0x3d, 0x6f, 0x14}, {0x78, 0x44, 0xdb, 0x86, 0x78, 0x44, 0xdb, 0x86},
+    {0xca, 0xaf, 0xf3, 0x81, 0xca, 0xaf, 0xf3, 0x81}, {0xb9, 0x68, 0xc4, 0x3e, 0xb9, 0x68, 0xc4, 0x3e},
+    {0x38, 0x24, 0x34, 0x2c, 0x38, 0x24, 0x34, 0x2c}, {0xc2, 0xa3, 0x40, 0x5f, 0xc2, 0xa3, 0x40, 0x5f},
+    {0x16, 0x1d, 0xc3, 0x72, 0x16, 0x1d, 0xc3, 0x72}, {0xbc, 0xe2, 0x25, 0x0c, 0xbc, 0xe2, 0x25, 0x0c},
+    {0x28, 0x3c, 0x49, 0x8b, 0x28, 0x3c, 0x49, 0x8b}, {0xff, 0x0d, 0x95, 0x41, 0xff, 0x0d, 0x95, 0x41},
+    {0x39, 0xa8, 0x01, 0x71, 0x39, 0xa8, 0x01, 0x71}, {0x08, 0x0c, 0xb3, 0xde, 0x08, 0x0c, 0xb3, 0xde},
+    {0xd8, 0xb4, 0xe4, 0x9c, 0xd8, 0xb4, 0xe4, 0x9c}, {0x64, 0x56, 0xc1, 0x90, 0x64, 0x56, 0xc1, 0x90},
+    {0x7b, 0xcb, 0x84, 0x61, 0x7b, 0xcb, 0x84, 0x61}, {0xd5, 0x32, 0xb6, 0x70, 0xd5, 0x32, 0xb6, 0x70},
+    {0x48, 0x6c, 0x5c, 0x74, 0x48, 0x6c, 0x5c, 0x74}, {0xd0, 0xb8, 0x57, 0x42, 0xd0, 0xb8, 0x57, 0x42},
+};
+
+#else
+
+const uint32_t T0_fwd_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0xc6, 0x63, 0x63, 0xa5), TABLE_WORD(0xf8, 0x7c, 0x7c, 0x84),
+    TABLE_WORD(0xee, 0x77, 0x77, 0x99), TABLE_WORD(0xf6, 0x7b, 0x7b, 0x8d),
+    TABLE_WORD(0xff, 0xf2, 0xf2, 0x0d), TABLE_WORD(0xd6, 0x6b, 0x6b, 0xbd),
+    TABLE_WORD(0xde, 0x6f, 0x6f, 0xb1), TABLE_WORD(0x91, 0xc5, 0xc5, 0x54),
+    TABLE_WORD(0x60, 0x30, 0x30, 0x50), TABLE_WORD(0x02, 0x01, 0x01, 0x03),
+    TABLE_WORD(0xce, 0x67, 0x67, 0xa9), TABLE_WORD(0x56, 0x2b, 0x2b, 0x7d),
+    TABLE_WORD(0xe7, 0xfe, 0xfe, 0x19), TABLE_WORD(0xb5, 0xd7, 0xd7, 0x62),
+    TABLE_WORD(0x4d, 0xab, 0xab, 0xe6), TABLE_WORD(0xec, 0x76, 0x76, 0x9a),
+    TABLE_WORD(0x8f, 0xca, 0xca, 0x45), TABLE_WORD(0x1f, 0x82, 0x82, 0x9d),
+    TABLE_WORD(0x89, 0xc9, 0xc9, 0x40), TABLE_WORD(0xfa, 0x7d, 0x7d, 0x87),
+    TABLE_WORD(0xef, 0xfa, 0xfa, 0x15), TABLE_WORD(0xb2, 0x59, 0x59, 0xeb),
+    TABLE_WORD(0x8e, 0x47, 0x47, 0xc9), TABLE_WORD(0xfb, 0xf0, 0xf0, 0x0b),
+    TABLE_WORD(0x41, 0xad, 0xad, 0xec), TABLE_WORD(0xb3, 0xd4, 0xd4, 0x67),
+    TABLE_WORD(0x5f, 0xa2, 0xa2, 0xfd), TABLE_WORD(0x45, 0xaf, 0xaf, 0xea),
+    TABLE_WORD(0x23, 0x9c, 0x9c, 0xbf), TABLE_WORD(0x53, 0xa4, 0xa4, 0xf7),
+    TABLE_WORD(0xe4, 0x72, 0x72, 0x96), TABLE_WORD(0x9b, 0xc0, 0xc0, 0x5b),
+    TABLE_WORD(0x75, 0xb7, 0xb7, 0xc2), TABLE_WORD(0xe1, 0xfd, 0xfd, 0x1c),
+    TABLE_WORD(0x3d, 0x93, 0x93, 0xae), TABLE_WORD(0x4c, 0x26, 0x26, 0x6a),
+    TABLE_WORD(0x6c, 0x36, 0x36, 0x5a), TABLE_WORD(0x7e, 0x3f, 0x3f, 0x41),
+    TABLE_WORD(0xf5, 0xf7, 0xf7, 0x02), TABLE_WORD(0x83, 0xcc, 0xcc, 0x4f),
+    TABLE_WORD(0x68, 0x34, 0x34, 0x5c), TABLE_WORD(0x51, 0xa5, 0xa5, 0xf4),
+    TABLE_WORD(0xd1, 0xe5, 0xe5, 0x34), TABLE_WORD(0xf9, 0xf1, 0xf1, 0x08),
+    TABLE_WORD(0xe2, 0x71, 0x71, 0x93), TABLE_WORD(0xab, 0xd8, 0xd8, 0x73),
+    TABLE_WORD(0x62, 0x31, 0x31, 0x53), TABLE_WORD(0x2a, 0x15, 0x15, 0x3f),
+    TABLE_WORD(0x08, 0x04, 0x04, 0x0c), TABLE_WORD(0x95, 0xc7, 0xc7, 0x52),
+    TABLE_WORD(0x46, 0x23, 0x23, 0x65), TABLE_WORD(0x9d, 0xc3, 0xc3, 0x5e),
+    TABLE_WORD(0x30, 0x18, 0x18, 0x28), TABLE_WORD(0x37, 0x96, 0x96, 0xa1),
+    TABLE_WORD(0x0a, 0x05, 0x05, 0x0f), TABLE_WORD(0x2f, 0x9a, 0x9a, 0xb5),
+    TABLE_WORD(0x0e, 0x07, 0x07, 0x09), TABLE_WORD(0x24, 0x12, 0x12, 0x36),
+    TABLE_WORD(0x1b, 0x80, 0x80, 0x9b), TABLE_WORD(0xdf, 0xe2, 0xe2, 0x3d),
+    TABLE_WORD(0xcd, 0xeb, 0xeb, 0x26), TABLE_WORD(0x4e, 0x27, 0x27, 0x69),
+    TABLE_WORD(0x7f, 0xb2, 0xb2, 0xcd), TABLE_WORD(0xea, 0x75, 0x75, 0x9f),
+    TABLE_WORD(0x12, 0x09, 0x09, 0x1b), TABLE_WORD(0x1d, 0x83, 0x83, 0x9e),
+    TABLE_WORD(0x58, 0x2c, 0x2c, 0x74), TABLE_WORD(0x34, 0x1a, 0x1a, 0x2e),
+    TABLE_WORD(0x36, 0x1b, 0x1b, 0x2d), TABLE_WORD(0xdc, 0x6e, 0x6e, 0xb2),
+    TABLE_WORD(0xb4, 0x5a, 0x5a, 0xee), TABLE_WORD(0x5b, 0xa0, 0xa0, 0xfb),
+    TABLE_WORD(0xa4, 0x52, 0x52, 0xf6), TABLE_WORD(0x76, 0x3b, 0x3b, 0x4d),
+    TABLE_WORD(0xb7, 0xd6, 0xd6, 0x61), TABLE_WORD(0x7d, 0xb3, 0xb3, 0xce),
+    TABLE_WORD(0x52, 0x29, 0x29, 0x7b), TABLE_WORD(0xdd, 0xe3, 0xe3, 0x3e),
+    TABLE_WORD(0x5e, 0x2f, 0x2f, 0x71), TABLE_WORD(0x13, 0x84, 0x84, 0x97),
+    TABLE_WORD(0xa6, 0x53, 0x53, 0xf5), TABLE_WORD(0xb9, 0xd1, 0xd1, 0x68),
+    TABLE_WORD(0x00, 0x00, 0x00, 0x00), TABLE_WORD(0xc1, 0xed, 0xed, 0x2c),
+    TABLE_WORD(0x40, 0x20, 0x20, 0x60), TABLE_WORD(0xe3, 0xfc, 0xfc, 0x1f),
+    TABLE_WORD(0x79, 0xb1, 0xb1, 0xc8), TABLE_WORD(0xb6, 0x5b, 0x5b, 0xed),
+    TABLE_WORD(0xd4, 0x6a, 0x6a, 0xbe), TABLE_WORD(0x8d, 0xcb, 0xcb, 0x46),
+    TABLE_WORD(0x67, 0xbe, 0xbe, 0xd9), TABLE_WORD(0x72, 0x39, 0x39, 0x4b),
+    TABLE_WORD(0x94, 0x4a, 0x4a, 0xde), TABLE_WORD(0x98, 0x4c, 0x4c, 0xd4),
+    TABLE_WORD(0xb0, 0x58, 0x58, 0xe8), TABLE_WORD(0x85, 0xcf, 0xcf, 0x4a),
+    TABLE_WORD(0xbb, 0xd0, 0xd0, 0x6b), TABLE_WORD(0xc5, 0xef, 0xef, 0x2a),
+    TABLE_WORD(0x4f, 0xaa, 0xaa, 0xe5), TABLE_WORD(0xed, 0xfb, 0xfb, 0x16),
+    TABLE_WORD(0x86, 0x43, 0x43, 0xc5), TABLE_WORD(0x9a, 0x4d, 0x4d, 0xd7),
+    TABLE_WORD(0x66, 0x33, 0x33, 0x55), TABLE_WORD(0x11, 0x85, 0x85, 0x94),
+    TABLE_WORD(0x8a, 0x45, 0x45, 0xcf), TABLE_WORD(0xe9, 0xf9, 0xf9, 0x10),
+    TABLE_WORD(0x04, 0x02, 0x02, 0x06), TABLE_WORD(0xfe, 0x7f, 0x7f, 0x81),
+    TABLE_WORD(0xa0, 0x50, 0x50, 0xf0), TABLE_WORD(0x78, 0x3c, 0x3c, 0x44),
+    TABLE_WORD(0x25, 0x9f, 0x9f, 0xba), TABLE_WORD(0x4b, 0xa8, 0xa8, 0xe3),
+    TABLE_WORD(0xa2, 0x51, 0x51, 0xf3), TABLE_WORD(0x5d, 0xa3, 0xa3, 0xfe),
+    TABLE_WORD(0x80, 0x40, 0x40, 0xc0), TABLE_WORD(0x05, 0x8f, 0x8f, 0x8a),
+    TABLE_WORD(0x3f, 0x92, 0x92, 0xad), TABLE_WORD(0x21, 0x9d, 0x9d, 0xbc),
+    TABLE_WORD(0x70, 0x38, 0x38, 0x48), TABLE_WORD(0xf1, 0xf5, 0xf5, 0x04),
+    TABLE_WORD(0x63, 0xbc, 0xbc, 0xdf), TABLE_WORD(0x77, 0xb6, 0xb6, 0xc1),
+    TABLE_WORD(0xaf, 0xda, 0xda, 0x75), TABLE_WORD(0x42, 0x21, 0x21, 0x63),
+    TABLE_WORD(0x20, 0x10, 0x10, 0x30), TABLE_WORD(0xe5, 0xff, 0xff, 0x1a),
+    TABLE_WORD(0xfd, 0xf3, 0xf3, 0x0e), TABLE_WORD(0xbf, 0xd2, 0xd2, 0x6d),
+    TABLE_WORD(0x81, 0xcd, 0xcd, 0x4c), TABLE_WORD(0x18, 0x0c, 0x0c, 0x14),
+    TABLE_WORD(0x26, 0x13, 0x13, 0x35), TABLE_WORD(0xc3, 0xec, 0xec, 0x2f),
+    TABLE_WORD(0xbe, 0x5f, 0x5f, 0xe1), TABLE_WORD(0x35, 0x97, 0x97, 0xa2),
+    TABLE_WORD(0x88, 0x44, 0x44, 0xcc), TABLE_WORD(0x2e, 0x17, 0x17, 0x39),
+    TABLE_WORD(0x93, 0xc4, 0xc4, 0x57), TABLE_WORD(0x55, 0xa7, 0xa7, 0xf2),
+    TABLE_WORD(0xfc, 0x7e, 0x7e, 0x82), TABLE_WORD(0x7a, 0x3d, 0x3d, 0x47),
+    TABLE_WORD(0xc8, 0x64, 0x64, 0xac), TABLE_WORD(0xba, 0x5d, 0x5d, 0xe7),
+    TABLE_WORD(0x32, 0x19, 0x19, 0x2b), TABLE_WORD(0xe6, 0x73, 0x73, 0x95),
+    TABLE_WORD(0xc0, 0x60, 0x60, 0xa0), TABLE_WORD(0x19, 0x81, 0x81, 0x98),
+    TABLE_WORD(0x9e, 0x4f, 0x4f, 0xd1), TABLE_WORD(0xa3, 0xdc, 0xdc, 0x7f),
+    TABLE_WORD(0x44, 0x22, 0x22, 0x66), TABLE_WORD(0x54, 0x2a, 0x2a, 0x7e),
+    TABLE_WORD(0x3b, 0x90, 0x90, 0xab), TABLE_WORD(0x0b, 0x88, 0x88, 0x83),
+    TABLE_WORD(0x8c, 0x46, 0x46, 0xca), TABLE_WORD(0xc7, 0xee, 0xee, 0x29),
+    TABLE_WORD(0x6b, 0xb8, 0xb8, 0xd3), TABLE_WORD(0x28, 0x14, 0x14, 0x3c),
+    TABLE_WORD(0xa7, 0xde, 0xde, 0x79), TABLE_WORD(0xbc, 0x5e, 0x5e, 0xe2),
+    TABLE_WORD(0x16, 0x0b, 0x0b, 0x1d), TABLE_WORD(0xad, 0xdb, 0xdb, 0x76),
+    TABLE_WORD(0xdb, 0xe0, 0xe0, 0x3b), TABLE_WORD(0x64, 0x32, 0x32, 0x56),
+    TABLE_WORD(0x74, 0x3a, 0x3a, 0x4e), TABLE_WORD(0x14, 0x0a, 0x0a, 0x1e),
+    TABLE_WORD(0x92, 0x49, 0x49, 0xdb), TABLE_WORD(0x0c, 0x06, 0x06, 0x0a),
+    TABLE_WORD(0x48, 0x24, 0x24, 0x6c), TABLE_WORD(0xb8, 0x5c, 0x5c, 0xe4),
+    TABLE_WORD(0x9f, 0xc2, 0xc2, 0x5d), TABLE_WORD(0xbd, 0xd3, 0xd3, 0x6e),
+    TABLE_WORD(0x43, 0xac, 0xac, 0xef), TABLE_WORD(0xc4, 0x62, 0x62, 0xa6),
+    TABLE_WORD(0x39, 0x91, 0x91, 0xa8), TABLE_WORD(0x31, 0x95, 0x95, 0xa4),
+    TABLE_WORD(0xd3, 0xe4, 0xe4, 0x37), TABLE_WORD(0xf2, 0x79, 0x79, 0x8b),
+    TABLE_WORD(0xd5, 0xe7, 0xe7, 0x32), TABLE_WORD(0x8b, 0xc8, 0xc8, 0x43),
+    TABLE_WORD(0x6e, 0x37, 0x37, 0x59), TABLE_WORD(0xda, 0x6d, 0x6d, 0xb7),
+    TABLE_WORD(0x01, 0x8d, 0x8d, 0x8c), TABLE_WORD(0xb1, 0xd5, 0xd5, 0x64),
+    TABLE_WORD(0x9c, 0x4e, 0x4e, 0xd2), TABLE_WORD(0x49, 0xa9, 0xa9, 0xe0),
+    TABLE_WORD(0xd8, 0x6c, 0x6c, 0xb4), TABLE_WORD(0xac, 0x56, 0x56, 0xfa),
+    TABLE_WORD(0xf3, 0xf4, 0xf4, 0x07), TABLE_WORD(0xcf, 0xea, 0xea, 0x25),
+    TABLE_WORD(0xca, 0x65, 0x65, 0xaf), TABLE_WORD(0xf4, 0x7a, 0x7a, 0x8e),
+    TABLE_WORD(0x47, 0xae, 0xae, 0xe9), TABLE_WORD(0x10, 0x08, 0x08, 0x18),
+    TABLE_WORD(0x6f, 0xba, 0xba, 0xd5), TABLE_WORD(0xf0, 0x78, 0x78, 0x88),
+    TABLE_WORD(0x4a, 0x25, 0x25, 0x6f), TABLE_WORD(0x5c, 0x2e, 0x2e, 0x72),
+    TABLE_WORD(0x38, 0x1c, 0x1c, 0x24), TABLE_WORD(0x57, 0xa6, 0xa6, 0xf1),
+    TABLE_WORD(0x73, 0xb4, 0xb4, 0xc7), TABLE_WORD(0x97, 0xc6, 0xc6, 0x51),
+    TABLE_WORD(0xcb, 0xe8, 0xe8, 0x23), TABLE_WORD(0xa1, 0xdd, 0xdd, 0x7c),
+    TABLE_WORD(0xe8, 0x74, 0x74, 0x9c), TABLE_WORD(0x3e, 0x1f, 0x1f, 0x21),
+    TABLE_WORD(0x96, 0x4b, 0x4b, 0xdd), TABLE_WORD(0x61, 0xbd, 0xbd, 0xdc),
+    TABLE_WORD(0x0d, 0x8b, 0x8b, 0x86), TABLE_WORD(0x0f, 0x8a, 0x8a, 0x85),
+    TABLE_WORD(0xe0, 0x70, 0x70, 0x90), TABLE_WORD(0x7c, 0x3e, 0x3e, 0x42),
+    TABLE_WORD(0x71, 0xb5, 0xb5, 0xc4), TABLE_WORD(0xcc, 0x66, 0x66, 0xaa),
+    TABLE_WORD(0x90, 0x48, 0x48, 0xd8), TABLE_WORD(0x06, 0x03, 0x03, 0x05),
+    TABLE_WORD(0xf7, 0xf6, 0xf6, 0x01), TABLE_WORD(0x1c, 0x0e, 0x0e, 0x12),
+    TABLE_WORD(0xc2, 0x61, 0x61, 0xa3), TABLE_WORD(0x6a, 0x35, 0x35, 0x5f),
+    TABLE_WORD(0xae, 0x57, 0x57, 0xf9), TABLE_WORD(0x69, 0xb9, 0xb9, 0xd0),
+    TABLE_WORD(0x17, 0x86, 0x86, 0x91), TABLE_WORD(0x99, 0xc1, 0xc1, 0x58),
+    TABLE_WORD(0x3a, 0x1d, 0x1d, 0x27), TABLE_WORD(0x27, 0x9e, 0x9e, 0xb9),
+    TABLE_WORD(0xd9, 0xe1, 0xe1, 0x38), TABLE_WORD(0xeb, 0xf8, 0xf8, 0x13),
+    TABLE_WORD(0x2b, 0x98, 0x98, 0xb3), TABLE_WORD(0x22, 0x11, 0x11, 0x33),
+    TABLE_WORD(0xd2, 0x69, 0x69, 0xbb), TABLE_WORD(0xa9, 0xd9, 0xd9, 0x70),
+    TABLE_WORD(0x07, 0x8e, 0x8e, 0x89), TABLE_WORD(0x33, 0x94, 0x94, 0xa7),
+    TABLE_WORD(0x2d, 0x9b, 0x9b, 0xb6), TABLE_WORD(0x3c, 0x1e, 0x1e, 0x22),
+    TABLE_WORD(0x15, 0x87, 0x87, 0x92), TABLE_WORD(0xc9, 0xe9, 0xe9, 0x20),
+    TABLE_WORD(0x87, 0xce, 0xce, 0x49), TABLE_WORD(0xaa, 0x55, 0x55, 0xff),
+    TABLE_WORD(0x50, 0x28, 0x28, 0x78), TABLE_WORD(0xa5, 0xdf, 0xdf, 0x7a),
+    TABLE_WORD(0x03, 0x8c, 0x8c, 0x8f), TABLE_WORD(0x59, 0xa1, 0xa1, 0xf8),
+    TABLE_WORD(0x09, 0x89, 0x89, 0x80), TABLE_WORD(0x1a, 0x0d, 0x0d, 0x17),
+    TABLE_WORD(0x65, 0xbf, 0xbf, 0xda), TABLE_WORD(0xd7, 0xe6, 0xe6, 0x31),
+    TABLE_WORD(0x84, 0x42, 0x42, 0xc6), TABLE_WORD(0xd0, 0x68, 0x68, 0xb8),
+    TABLE_WORD(0x82, 0x41, 0x41, 0xc3), TABLE_WORD(0x29, 0x99, 0x99, 0xb0),
+    TABLE_WORD(0x5a, 0x2d, 0x2d, 0x77), TABLE_WORD(0x1e, 0x0f, 0x0f, 0x11),
+    TABLE_WORD(0x7b, 0xb0, 0xb0, 0xcb), TABLE_WORD(0xa8, 0x54, 0x54, 0xfc),
+    TABLE_WORD(0x6d, 0xbb, 0xbb, 0xd6), TABLE_WORD(0x2c, 0x16, 0x16, 0x3a),
+};
+
+# ifndef AES_MONOTABLE
+const uint32_t T1_fwd_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0xa5, 0xc6, 0x63, 0x63), TABLE_WORD(0x84, 0xf8, 0x7c, 0x7c),
+    TABLE_WORD(0x99, 0xee, 0x77, 0x77), TABLE_WORD(0x8d, 0xf6, 0x7b, 0x7b),
+    TABLE_WORD(0x0d, 0xff, 0xf2, 0xf2), TABLE_WORD(0xbd, 0xd6, 0x6b, 0x6b),
+    TABLE_WORD(0xb1, 0xde, 0x6f, 0x6f), TABLE_WORD(0x54, 0x91, 0xc5, 0xc5),
+    TABLE_WORD(0x50, 0x60, 0x30, 0x30), TABLE_WORD(0x03, 0x02, 0x01, 0x01),
+    TABLE_WORD(0xa9, 0xce, 0x67, 0x67), TABLE_WORD(0x7d, 0x56, 0x2b, 0x2b),
+    TABLE_WORD(0x19, 0xe7, 0xfe, 0xfe), TABLE_WORD(0x62, 0xb5, 0xd7, 0xd7),
+    TABLE_WORD(0xe6, 0x4d, 0xab, 0xab), TABLE_WORD(0x9a, 0xec, 0x76, 0x76),
+    TABLE_WORD(0x45, 0x8f, 0xca, 0xca), TABLE_WORD(0x9d, 0x1f, 0x82, 0x82),
+    TABLE_WORD(0x40, 0x89, 0xc9, 0xc9), TABLE_WORD(0x87, 0xfa, 0x7d, 0x7d),
+    TABLE_WORD(0x15, 0xef, 0xfa, 0xfa), TABLE_WORD(0xeb, 0xb2, 0x59, 0x59),
+    TABLE_WORD(0xc9, 0x8e, 0x47, 0x47), TABLE_WORD(0x0b, 0xfb, 0xf0, 0xf0),
+    TABLE_WORD(0xec, 0x41, 0xad, 0xad), TABLE_WORD(0x67, 0xb3, 0xd4, 0xd4),
+    TABLE_WORD(0xfd, 0x5f, 0xa2, 0xa2), TABLE_WORD(0xea, 0x45, 0xaf, 0xaf),
+    TABLE_WORD(0xbf, 0x23, 0x9c, 0x9c), TABLE_WORD(0xf7, 0x53, 0xa4, 0xa4),
+    TABLE_WORD(0x96, 0xe4, 0x72, 0x72), TABLE_WORD(0x5b, 0x9b, 0xc0, 0xc0),
+    TABLE_WORD(0xc2, 0x75, 0xb7, 0xb7), TABLE_WORD(0x1c, 0xe1, 0xfd, 0xfd),
+    TABLE_WORD(0xae, 0x3d, 0x93, 0x93), TABLE_WORD(0x6a, 0x4c, 0x26, 0x26),
+    TABLE_WORD(0x5a, 0x6c, 0x36, 0x36), TABLE_WORD(0x41, 0x7e, 0x3f, 0x3f),
+    TABLE_WORD(0x02, 0xf5, 0xf7, 0xf7), TABLE_WORD(0x4f, 0x83, 0xcc, 0xcc),
+    TABLE_WORD(0x5c, 0x68, 0x34, 0x34), TABLE_WORD(0xf4, 0x51, 0xa5, 0xa5),
+    TABLE_WORD(0x34, 0xd1, 0xe5, 0xe5), TABLE_WORD(0x08, 0xf9, 0xf1, 0xf1),
+    TABLE_WORD(0x93, 0xe2, 0x71, 0x71), TABLE_WORD(0x73, 0xab, 0xd8, 0xd8),
+    TABLE_WORD(0x53, 0x62, 0x31, 0x31), TABLE_WORD(0x3f, 0x2a, 0x15, 0x15),
+    TABLE_WORD(0x0c, 0x08, 0x04, 0x04), TABLE_WORD(0x52, 0x95, 0xc7, 0xc7),
+    TABLE_WORD(0x65, 0x46, 0x23, 0x23), TABLE_WORD(0x5e, 0x9d, 0xc3, 0xc3),
+    TABLE_WORD(0x28, 0x30, 0x18, 0x18), TABLE_WORD(0xa1, 0x37, 0x96, 0x96),
+    TABLE_WORD(0x0f, 0x0a, 0x05, 0x05), TABLE_WORD(0xb5, 0x2f, 0x9a, 0x9a),
+    TABLE_WORD(0x09, 0x0e, 0x07, 0x07), TABLE_WORD(0x36, 0x24, 0x12, 0x12),
+    TABLE_WORD(0x9b, 0x1b, 0x80, 0x80), TABLE_WORD(0x3d, 0xdf, 0xe2, 0xe2),
+    TABLE_WORD(0x26, 0xcd, 0xeb, 0xeb), TABLE_WORD(0x69, 0x4e, 0x27, 0x27),
+    TABLE_WORD(0xcd, 0x7f, 0xb2, 0xb2), TABLE_WORD(0x9f, 0xea, 0x75, 0x75),
+    TABLE_WORD(0x1b, 0x12, 0x09, 0x09), TABLE_WORD(0x9e, 0x1d, 0x83, 0x83),
+    TABLE_WORD(0x74, 0x58, 0x2c, 0x2c), TABLE_WORD(0x2e, 0x34, 0x1a, 0x1a),
+    TABLE_WORD(0x2d, 0x36, 0x1b, 0x1b), TABLE_WORD(0xb2, 0xdc, 0x6e, 0x6e),
+    TABLE_WORD(0xee, 0xb4, 0x5a, 0x5a), TABLE_WORD(0xfb, 0x5b, 0xa0, 0xa0),
+    TABLE_WORD(0xf6, 0xa4, 0x52, 0x52), TABLE_WORD(0x4d, 0x76, 0x3b, 0x3b),
+    TABLE_WORD(0x61, 0xb7, 0xd6, 0xd6), TABLE_WORD(0xce, 0x7d, 0xb3, 0xb3),
+    TABLE_WORD(0x7b, 0x52, 0x29, 0x29), TABLE_WORD(0x3e, 0xdd, 0xe3, 0xe3),
+    TABLE_WORD(0x71, 0x5e, 0x2f, 0x2f), TABLE_WORD(0x97, 0x13, 0x84, 0x84),
+    TABLE_WORD(0xf5, 0xa6, 0x53, 0x53), TABLE_WORD(0x68, 0xb9, 0xd1, 0xd1),
+    TABLE_WORD(0x00, 0x00, 0x00, 0x00), TABLE_WORD(0x2c, 0xc1, 0xed, 0xed),
+    TABLE_WORD(0x60, 0x40, 0x20, 0x20), TABLE_WORD(0x1f, 0xe3, 0xfc, 0xfc),
+    TABLE_WORD(0xc8, 0x79, 0xb1, 0xb1), TABLE_WORD(0xed, 0xb6, 0x5b, 0x5b),
+    TABLE_WORD(0xbe, 0xd4, 0x6a, 0x6a), TABLE_WORD(0x46, 0x8d, 0xcb, 0xcb),
+    TABLE_WORD(0xd9, 0x67, 0xbe, 0xbe), TABLE_WORD(0x4b, 0x72, 0x39, 0x39),
+    TABLE_WORD(0xde, 0x94, 0x4a, 0x4a), TABLE_WORD(0xd4, 0x98, 0x4c, 0x4c),
+    TABLE_WORD(0xe8, 0xb0, 0x58, 0x58), TABLE_WORD(0x4a, 0x85, 0xcf, 0xcf),
+    TABLE_WORD(0x6b, 0xbb, 0xd0, 0xd0), TABLE_WORD(0x2a, 0xc5, 0xef, 0xef),
+    TABLE_WORD(0xe5, 0x4f, 0xaa, 0xaa), TABLE_WORD(0x16, 0xed, 0xfb, 0xfb),
+    TABLE_WORD(0xc5, 0x86, 0x43, 0x43), TABLE_WORD(0xd7, 0x9a, 0x4d, 0x4d),
+    TABLE_WORD(0x55, 0x66, 0x33, 0x33), TABLE_WORD(0x94, 0x11, 0x85, 0x85),
+    TABLE_WORD(0xcf, 0x8a, 0x45, 0x45), TABLE_WORD(0x10, 0xe9, 0xf9, 0xf9),
+    TABLE_WORD(0x06, 0x04, 0x02, 0x02), TABLE_WORD(0x81, 0xfe, 0x7f, 0x7f),
+    TABLE_WORD(0xf0, 0xa0, 0x50, 0x50), TABLE_WORD(0x44, 0x78, 0x3c, 0x3c),
+    TABLE_WORD(0xba, 0x25, 0x9f, 0x9f), TABLE_WORD(0xe3, 0x4b, 0xa8, 0xa8),
+    TABLE_WORD(0xf3, 0xa2, 0x51, 0x51), TABLE_WORD(0xfe, 0x5d, 0xa3, 0xa3),
+    TABLE_WORD(0xc0, 0x80, 0x40, 0x40), TABLE_WORD(0x8a, 0x05, 0x8f, 0x8f),
+    TABLE_WORD(0xad, 0x3f, 0x92, 0x92), TABLE_WORD(0xbc, 0x21, 0x9d, 0x9d),
+    TABLE_WORD(0x48, 0x70, 0x38, 0x38), TABLE_WORD(0x04, 0xf1, 0xf5, 0xf5),
+    TABLE_WORD(0xdf, 0x63, 0xbc, 0xbc), TABLE_WORD(0xc1, 0x77, 0xb6, 0xb6),
+    TABLE_WORD(0x75, 0xaf, 0xda, 0xda), TABLE_WORD(0x63, 0x42, 0x21, 0x21),
+    TABLE_WORD(0x30, 0x20, 0x10, 0x10), TABLE_WORD(0x1a, 0xe5, 0xff, 0xff),
+    TABLE_WORD(0x0e, 0xfd, 0xf3, 0xf3), TABLE_WORD(0x6d, 0xbf, 0xd2, 0xd2),
+    TABLE_WORD(0x4c, 0x81, 0xcd, 0xcd), TABLE_WORD(0x14, 0x18, 0x0c, 0x0c),
+    TABLE_WORD(0x35, 0x26, 0x13, 0x13), TABLE_WORD(0x2f, 0xc3, 0xec, 0xec),
+    TABLE_WORD(0xe1, 0xbe, 0x5f, 0x5f), TABLE_WORD(0xa2, 0x35, 0x97, 0x97),
+    TABLE_WORD(0xcc, 0x88, 0x44, 0x44), TABLE_WORD(0x39, 0x2e, 0x17, 0x17),
+    TABLE_WORD(0x57, 0x93, 0xc4, 0xc4), TABLE_WORD(0xf2, 0x55, 0xa7, 0xa7),
+    TABLE_WORD(0x82, 0xfc, 0x7e, 0x7e), TABLE_WORD(0x47, 0x7a, 0x3d, 0x3d),
+    TABLE_WORD(0xac, 0xc8, 0x64, 0x64), TABLE_WORD(0xe7, 0xba, 0x5d, 0x5d),
+    TABLE_WORD(0x2b, 0x32, 0x19, 0x19), TABLE_WORD(0x95, 0xe6, 0x73, 0x73),
+    TABLE_WORD(0xa0, 0xc0, 0x60, 0x60), TABLE_WORD(0x98, 0x19, 0x81, 0x81),
+    TABLE_WORD(0xd1, 0x9e, 0x4f, 0x4f), TABLE_WORD(0x7f, 0xa3, 0xdc, 0xdc),
+    TABLE_WORD(0x66, 0x44, 0x22, 0x22), TABLE_WORD(0x7e, 0x54, 0x2a, 0x2a),
+    TABLE_WORD(0xab, 0x3b, 0x90, 0x90), TABLE_WORD(0x83, 0x0b, 0x88, 0x88),
+    TABLE_WORD(0xca, 0x8c, 0x46, 0x46), TABLE_WORD(0x29, 0xc7, 0xee, 0xee),
+    TABLE_WORD(0xd3, 0x6b, 0xb8, 0xb8), TABLE_WORD(0x3c, 0x28, 0x14, 0x14),
+    TABLE_WORD(0x79, 0xa7, 0xde, 0xde), TABLE_WORD(0xe2, 0xbc, 0x5e, 0x5e),
+    TABLE_WORD(0x1d, 0x16, 0x0b, 0x0b), TABLE_WORD(0x76, 0xad, 0xdb, 0xdb),
+    TABLE_WORD(0x3b, 0xdb, 0xe0, 0xe0), TABLE_WORD(0x56, 0x64, 0x32, 0x32),
+    TABLE_WORD(0x4e, 0x74, 0x3a, 0x3a), TABLE_WORD(0x1e, 0x14, 0x0a, 0x0a),
+    TABLE_WORD(0xdb, 0x92, 0x49, 0x49), TABLE_WORD(0x0a, 0x0c, 0x06, 0x06),
+    TABLE_WORD(0x6c, 0x48, 0x24, 0x24), TABLE_WORD(0xe4, 0xb8, 0x5c, 0x5c),
+    TABLE_WORD(0x5d, 0x9f, 0xc2, 0xc2), TABLE_WORD(0x6e, 0xbd, 0xd3, 0xd3),
+    TABLE_WORD(0xef, 0x43, 0xac, 0xac), TABLE_WORD(0xa6, 0xc4, 0x62, 0x62),
+    TABLE_WORD(0xa8, 0x39, 0x91, 0x91), TABLE_WORD(0xa4, 0x31, 0x95, 0x95),
+    TABLE_WORD(0x37, 0xd3, 0xe4, 0xe4), TABLE_WORD(0x8b, 0xf2, 0x79, 0x79),
+    TABLE_WORD(0x32, 0xd5, 0xe7, 0xe7), TABLE_WORD(0x43, 0x8b, 0xc8, 0xc8),
+    TABLE_WORD(0x59, 0x6e, 0x37, 0x37), TABLE_WORD(0xb7, 0xda, 0x6d, 0x6d),
+    TABLE_WORD(0x8c, 0x01, 0x8d, 0x8d), TABLE_WORD(0x64, 0xb1, 0xd5, 0xd5),
+    TABLE_WORD(0xd2, 0x9c, 0x4e, 0x4e), TABLE_WORD(0xe0, 0x49, 0xa9, 0xa9),
+    TABLE_WORD(0xb4, 0xd8, 0x6c, 0x6c), TABLE_WORD(0xfa, 0xac, 0x56, 0x56),
+    TABLE_WORD(0x07, 0xf3, 0xf4, 0xf4), TABLE_WORD(0x25, 0xcf, 0xea, 0xea),
+    TABLE_WORD(0xaf, 0xca, 0x65, 0x65), TABLE_WORD(0x8e, 0xf4, 0x7a, 0x7a),
+    TABLE_WORD(0xe9, 0x47, 0xae, 0xae), TABLE_WORD(0x18, 0x10, 0x08, 0x08),
+    TABLE_WORD(0xd5, 0x6f, 0xba, 0xba), TABLE_WORD(0x88, 0xf0, 0x78, 0x78),
+    TABLE_WORD(0x6f, 0x4a, 0x25, 0x25), TABLE_WORD(0x72, 0x5c, 0x2e, 0x2e),
+    TABLE_WORD(0x24, 0x38, 0x1c, 0x1c), TABLE_WORD(0xf1, 0x57, 0xa6, 0xa6),
+    TABLE_WORD(0xc7, 0x73, 0xb4, 0xb4), TABLE_WORD(0x51, 0x97, 0xc6, 0xc6),
+    TABLE_WORD(0x23, 0xcb, 0xe8, 0xe8), TABLE_WORD(0x7c, 0xa1, 0xdd, 0xdd),
+    TABLE_WORD(0x9c, 0xe8, 0x74, 0x74), TABLE_WORD(0x21, 0x3e, 0x1f, 0x1f),
+    TABLE_WORD(0xdd, 0x96, 0x4b, 0x4b), TABLE_WORD(0xdc, 0x61, 0xbd, 0xbd),
+    TABLE_WORD(0x86, 0x0d, 0x8b, 0x8b), TABLE_WORD(0x85, 0x0f, 0x8a, 0x8a),
+    TABLE_WORD(0x90, 0xe0, 0x70, 0x70), TABLE_WORD(0x42, 0x7c, 0x3e, 0x3e),
+    TABLE_WORD(0xc4, 0x71, 0xb5, 0xb5), TABLE_WORD(0xaa, 0xcc, 0x66, 0x66),
+    TABLE_WORD(0xd8, 0x90, 0x48, 0x48), TABLE_WORD(0x05, 0x06, 0x03, 0x03),
+    TABLE_WORD(0x01, 0xf7, 0xf6, 0xf6), TABLE_WORD(0x12, 0x1c, 0x0e, 0x0e),
+    TABLE_WORD(0xa3, 0xc2, 0x61, 0x61), TABLE_WORD(0x5f, 0x6a, 0x35, 0x35),
+    TABLE_WORD(0xf9, 0xae, 0x57, 0x57), TABLE_WORD(0xd0, 0x69, 0xb9, 0xb9),
+    TABLE_WORD(0x91, 0x17, 0x86, 0x86), TABLE_WORD(0x58, 0x99, 0xc1, 0xc1),
+    TABLE_WORD(0x27, 0x3a, 0x1d, 0x1d), TABLE_WORD(0xb9, 0x27, 0x9e, 0x9e),
+    TABLE_WORD(0x38, 0xd9, 0xe1, 0xe1), TABLE_WORD(0x13, 0xeb, 0xf8, 0xf8),
+    TABLE_WORD(0xb3, 0x2b, 0x98, 0x98), TABLE_WORD(0x33, 0x22, 0x11, 0x11),
+    TABLE_WORD(0xbb, 0xd2, 0x69, 0x69), TABLE_WORD(0x70, 0xa9, 0xd9, 0xd9),
+    TABLE_WORD(0x89, 0x07, 0x8e, 0x8e), TABLE_WORD(0xa7, 0x33, 0x94, 0x94),
+    TABLE_WORD(0xb6, 0x2d, 0x9b, 0x9b), TABLE_WORD(0x22, 0x3c, 0x1e, 0x1e),
+    TABLE_WORD(0x92, 0x15, 0x87, 0x87), TABLE_WORD(0x20, 0xc9, 0xe9, 0xe9),
+    TABLE_WORD(0x49, 0x87, 0xce, 0xce), TABLE_WORD(0xff, 0xaa, 0x55, 0x55),
+    TABLE_WORD(0x78, 0x50, 0x28, 0x28), TABLE_WORD(0x7a, 0xa5, 0xdf, 0xdf),
+    TABLE_WORD(0x8f, 0x03, 0x8c, 0x8c), TABLE_WORD(0xf8, 0x59, 0xa1, 0xa1),
+    TABLE_WORD(0x80, 0x09, 0x89, 0x89), TABLE_WORD(0x17, 0x1a, 0x0d, 0x0d),
+    TABLE_WORD(0xda, 0x65, 0xbf, 0xbf), TABLE_WORD(0x31, 0xd7, 0xe6, 0xe6),
+    TABLE_WORD(0xc6, 0x84, 0x42, 0x42), TABLE_WORD(0xb8, 0xd0, 0x68, 0x68),
+    TABLE_WORD(0xc3, 0x82, 0x41, 0x41), TABLE_WORD(0xb0, 0x29, 0x99, 0x99),
+    TABLE_WORD(0x77, 0x5a, 0x2d, 0x2d), TABLE_WORD(0x11, 0x1e, 0x0f, 0x0f),
+    TABLE_WORD(0xcb, 0x7b, 0xb0, 0xb0), TABLE_WORD(0xfc, 0xa8, 0x54, 0x54),
+    TABLE_WORD(0xd6, 0x6d, 0xbb, 0xbb), TABLE_WORD(0x3a, 0x2c, 0x16, 0x16),
+};
+
+const uint32_t T2_fwd_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0x63, 0xa5, 0xc6, 0x63), TABLE_WORD(0x7c, 0x84, 0xf8, 0x7c),
+    TABLE_WORD(0x77, 0x99, 0xee, 0x77), TABLE_WORD(0x7b, 0x8d, 0xf6, 0x7b),
+    TABLE_WORD(0xf2, 0x0d, 0xff, 0xf2), TABLE_WORD(0x6b, 0xbd, 0xd6, 0x6b),
+    TABLE_WORD(0x6f, 0xb1, 0xde, 0x6f), TABLE_WORD(0xc5, 0x54, 0x91, 0xc5),
+    TABLE_WORD(0x30, 0x50, 0x60, 0x30), TABLE_WORD(0x01, 0x03, 0x02, 0x01),
+    TABLE_WORD(0x67, 0xa9, 0xce, 0x67), TABLE_WORD(0x2b, 0x7d, 0x56, 0x2b),
+    TABLE_WORD(0xfe, 0x19, 0xe7, 0xfe), TABLE_WORD(0xd7, 0x62, 0xb5, 0xd7),
+    TABLE_WORD(0xab, 0xe6, 0x4d, 0xab), TABLE_WORD(0x76, 0x9a, 0xec, 0x76),
+    TABLE_WORD(0xca, 0x45, 0x8f, 0xca), TABLE_WORD(0x82, 0x9d, 0x1f, 0x82),
+    TABLE_WORD(0xc9, 0x40, 0x89, 0xc9), TABLE_WORD(0x7d, 0x87, 0xfa, 0x7d),
+    TABLE_WORD(0xfa, 0x15, 0xef, 0xfa), TABLE_WORD(0x59, 0xeb, 0xb2, 0x59),
+    TABLE_WORD(0x47, 0xc9, 0x8e, 0x47), TABLE_WORD(0xf0, 0x0b, 0xfb, 0xf0),
+    TABLE_WORD(0xad, 0xec, 0x41, 0xad), TABLE_WORD(0xd4, 0x67, 0xb3, 0xd4),
+    TABLE_WORD(0xa2, 0xfd, 0x5f, 0xa2), TABLE_WORD(0xaf, 0xea, 0x45, 0xaf),
+    TABLE_WORD(0x9c, 0xbf, 0x23, 0x9c), TABLE_WORD(0xa4, 0xf7, 0x53, 0xa4),
+    TABLE_WORD(0x72, 0x96, 0xe4, 0x72), TABLE_WORD(0xc0, 0x5b, 0x9b, 0xc0),
+    TABLE_WORD(0xb7, 0xc2, 0x75, 0xb7), TABLE_WORD(0xfd, 0x1c, 0xe1, 0xfd),
+    TABLE_WORD(0x93, 0xae, 0x3d, 0x93), TABLE_WORD(0x26, 0x6a, 0x4c, 0x26),
+    TABLE_WORD(0x36, 0x5a, 0x6c, 0x36), TABLE_WORD(0x3f, 0x41, 0x7e, 0x3f),
+    TABLE_WORD(0xf7, 0x02, 0xf5, 0xf7), TABLE_WORD(0xcc, 0x4f, 0x83, 0xcc),
+    TABLE_WORD(0x34, 0x5c, 0x68, 0x34), TABLE_WORD(0xa5, 0xf4, 0x51, 0xa5),
+    TABLE_WORD(0xe5, 0x34, 0xd1, 0xe5), TABLE_WORD(0xf1, 0x08, 0xf9, 0xf1),
+    TABLE_WORD(0x71, 0x93, 0xe2, 0x71), TABLE_WORD(0xd8, 0x73, 0xab, 0xd8),
+    TABLE_WORD(0x31, 0x53, 0x62, 0x31), TABLE_WORD(0x15, 0x3f, 0x2a, 0x15),
+    TABLE_WORD(0x04, 0x0c, 0x08, 0x04), TABLE_WORD(0xc7, 0x52, 0x95, 0xc7),
+    TABLE_WORD(0x23, 0x65, 0x46, 0x23), TABLE_WORD(0xc3, 0x5e, 0x9d, 0xc3),
+    TABLE_WORD(0x18, 0x28, 0x30, 0x18), TABLE_WORD(0x96, 0xa1, 0x37, 0x96),
+    TABLE_WORD(0x05, 0x0f, 0x0a, 0x05), TABLE_WORD(0x9a, 0xb5, 0x2f, 0x9a),
+    TABLE_WORD(0x07, 0x09, 0x0e, 0x07), TABLE_WORD(0x12, 0x36, 0x24, 0x12),
+    TABLE_WORD(0x80, 0x9b, 0x1b, 0x80), TABLE_WORD(0xe2, 0x3d, 0xdf, 0xe2),
+    TABLE_WORD(0xeb, 0x26, 0xcd, 0xeb), TABLE_WORD(0x27, 0x69, 0x4e, 0x27),
+    TABLE_WORD(0xb2, 0xcd, 0x7f, 0xb2), TABLE_WORD(0x75, 0x9f, 0xea, 0x75),
+    TABLE_WORD(0x09, 0x1b, 0x12, 0x09), TABLE_WORD(0x83, 0x9e, 0x1d, 0x83),
+    TABLE_WORD(0x2c, 0x74, 0x58, 0x2c), TABLE_WORD(0x1a, 0x2e, 0x34, 0x1a),
+    TABLE_WORD(0x1b, 0x2d, 0x36, 0x1b), TABLE_WORD(0x6e, 0xb2, 0xdc, 0x6e),
+    TABLE_WORD(0x5a, 0xee, 0xb4, 0x5a), TABLE_WORD(0xa0, 0xfb, 0x5b, 0xa0),
+    TABLE_WORD(0x52, 0xf6, 0xa4, 0x52), TABLE_WORD(0x3b, 0x4d, 0x76, 0x3b),
+    TABLE_WORD(0xd6, 0x61, 0xb7, 0xd6), TABLE_WORD(0xb3, 0xce, 0x7d, 0xb3),
+    TABLE_WORD(0x29, 0x7b, 0x52, 0x29), TABLE_WORD(0xe3, 0x3e, 0xdd, 0xe3),
+    TABLE_WORD(0x2f, 0x71, 0x5e, 0x2f), TABLE_WORD(0x84, 0x97, 0x13, 0x84),
+    TABLE_WORD(0x53, 0xf5, 0xa6, 0x53), TABLE_WORD(0xd1, 0x68, 0xb9, 0xd1),
+    TABLE_WORD(0x00, 0x00, 0x00, 0x00), TABLE_WORD(0xed, 0x2c, 0xc1, 0xed),
+    TABLE_WORD(0x20, 0x60, 0x40, 0x20), TABLE_WORD(0xfc, 0x1f, 0xe3, 0xfc),
+    TABLE_WORD(0xb1, 0xc8, 0x79, 0xb1), TABLE_WORD(0x5b, 0xed, 0xb6, 0x5b),
+    TABLE_WORD(0x6a, 0xbe, 0xd4, 0x6a), TABLE_WORD(0xcb, 0x46, 0x8d, 0xcb),
+    TABLE_WORD(0xbe, 0xd9, 0x67, 0xbe), TABLE_WORD(0x39, 0x4b, 0x72, 0x39),
+    TABLE_WORD(0x4a, 0xde, 0x94, 0x4a), TABLE_WORD(0x4c, 0xd4, 0x98, 0x4c),
+    TABLE_WORD(0x58, 0xe8, 0xb0, 0x58), TABLE_WORD(0xcf, 0x4a, 0x85, 0xcf),
+    TABLE_WORD(0xd0, 0x6b, 0xbb, 0xd0), TABLE_WORD(0xef, 0x2a, 0xc5, 0xef),
+    TABLE_WORD(0xaa, 0xe5, 0x4f, 0xaa), TABLE_WORD(0xfb, 0x16, 0xed, 0xfb),
+    TABLE_WORD(0x43, 0xc5, 0x86, 0x43), TABLE_WORD(0x4d, 0xd7, 0x9a, 0x4d),
+    TABLE_WORD(0x33, 0x55, 0x66, 0x33), TABLE_WORD(0x85, 0x94, 0x11, 0x85),
+    TABLE_WORD(0x45, 0xcf, 0x8a, 0x45), TABLE_WORD(0xf9, 0x10, 0xe9, 0xf9),
+    TABLE_WORD(0x02, 0x06, 0x04, 0x02), TABLE_WORD(0x7f, 0x81, 0xfe, 0x7f),
+    TABLE_WORD(0x50, 0xf0, 0xa0, 0x50), TABLE_WORD(0x3c, 0x44, 0x78, 0x3c),
+    TABLE_WORD(0x9f, 0xba, 0x25, 0x9f), TABLE_WORD(0xa8, 0xe3, 0x4b, 0xa8),
+    TABLE_WORD(0x51, 0xf3, 0xa2, 0x51), TABLE_WORD(0xa3, 0xfe, 0x5d, 0xa3),
+    TABLE_WORD(0x40, 0xc0, 0x80, 0x40), TABLE_WORD(0x8f, 0x8a, 0x05, 0x8f),
+    TABLE_WORD(0x92, 0xad, 0x3f, 0x92), TABLE_WORD(0x9d, 0xbc, 0x21, 0x9d),
+    TABLE_WORD(0x38, 0x48, 0x70, 0x38), TABLE_WORD(0xf5, 0x04, 0xf1, 0xf5),
+    TABLE_WORD(0xbc, 0xdf, 0x63, 0xbc), TABLE_WORD(0xb6, 0xc1, 0x77, 0xb6),
+    TABLE_WORD(0xda, 0x75, 0xaf, 0xda), TABLE_WORD(0x21, 0x63, 0x42, 0x21),
+    TABLE_WORD(0x10, 0x30, 0x20, 0x10), TABLE_WORD(0xff, 0x1a, 0xe5, 0xff),
+    TABLE_WORD(0xf3, 0x0e, 0xfd, 0xf3), TABLE_WORD(0xd2, 0x6d, 0xbf, 0xd2),
+    TABLE_WORD(0xcd, 0x4c, 0x81, 0xcd), TABLE_WORD(0x0c, 0x14, 0x18, 0x0c),
+    TABLE_WORD(0x13, 0x35, 0x26, 0x13), TABLE_WORD(0xec, 0x2f, 0xc3, 0xec),
+    TABLE_WORD(0x5f, 0xe1, 0xbe, 0x5f), TABLE_WORD(0x97, 0xa2, 0x35, 0x97),
+    TABLE_WORD(0x44, 0xcc, 0x88, 0x44), TABLE_WORD(0x17, 0x39, 0x2e, 0x17),
+    TABLE_WORD(0xc4, 0x57, 0x93, 0xc4), TABLE_WORD(0xa7, 0xf2, 0x55, 0xa7),
+    TABLE_WORD(0x7e, 0x82, 0xfc, 0x7e), TABLE_WORD(0x3d, 0x47, 0x7a, 0x3d),
+    TABLE_WORD(0x64, 0xac, 0xc8, 0x64), TABLE_WORD(0x5d, 0xe7, 0xba, 0x5d),
+    TABLE_WORD(0x19, 0x2b, 0x32, 0x19), TABLE_WORD(0x73, 0x95, 0xe6, 0x73),
+    TABLE_WORD(0x60, 0xa0, 0xc0, 0x60), TABLE_WORD(0x81, 0x98, 0x19, 0x81),
+    TABLE_WORD(0x4f, 0xd1, 0x9e, 0x4f), TABLE_WORD(0xdc, 0x7f, 0xa3, 0xdc),
+    TABLE_WORD(0x22, 0x66, 0x44, 0x22), TABLE_WORD(0x2a, 0x7e, 0x54, 0x2a),
+    TABLE_WORD(0x90, 0xab, 0x3b, 0x90), TABLE_WORD(0x88, 0x83, 0x0b, 0x88),
+    TABLE_WORD(0x46, 0xca, 0x8c, 0x46), TABLE_WORD(0xee, 0x29, 0xc7, 0xee),
+    TABLE_WORD(0xb8, 0xd3, 0x6b, 0xb8), TABLE_WORD(0x14, 0x3c, 0x28, 0x14),
+    TABLE_WORD(0xde, 0x79, 0xa7, 0xde), TABLE_WORD(0x5e, 0xe2, 0xbc, 0x5e),
+    TABLE_WORD(0x0b, 0x1d, 0x16, 0x0b), TABLE_WORD(0xdb, 0x76, 0xad, 0xdb),
+    TABLE_WORD(0xe0, 0x3b, 0xdb, 0xe0), TABLE_WORD(0x32, 0x56, 0x64, 0x32),
+    TABLE_WORD(0x3a, 0x4e, 0x74, 0x3a), TABLE_WORD(0x0a, 0x1e, 0x14, 0x0a),
+    TABLE_WORD(0x49, 0xdb, 0x92, 0x49), TABLE_WORD(0x06, 0x0a, 0x0c, 0x06),
+    TABLE_WORD(0x24, 0x6c, 0x48, 0x24), TABLE_WORD(0x5c, 0xe4, 0xb8, 0x5c),
+    TABLE_WORD(0xc2, 0x5d, 0x9f, 0xc2), TABLE_WORD(0xd3, 0x6e, 0xbd, 0xd3),
+    TABLE_WORD(0xac, 0xef, 0x43, 0xac), TABLE_WORD(0x62, 0xa6, 0xc4, 0x62),
+    TABLE_WORD(0x91, 0xa8, 0x39, 0x91), TABLE_WORD(0x95, 0xa4, 0x31, 0x95),
+    TABLE_WORD(0xe4, 0x37, 0xd3, 0xe4), TABLE_WORD(0x79, 0x8b, 0xf2, 0x79),
+    TABLE_WORD(0xe7, 0x32, 0xd5, 0xe7), TABLE_WORD(0xc8, 0x43, 0x8b, 0xc8),
+    TABLE_WORD(0x37, 0x59, 0x6e, 0x37), TABLE_WORD(0x6d, 0xb7, 0xda, 0x6d),
+    TABLE_WORD(0x8d, 0x8c, 0x01, 0x8d), TABLE_WORD(0xd5, 0x64, 0xb1, 0xd5),
+    TABLE_WORD(0x4e, 0xd2, 0x9c, 0x4e), TABLE_WORD(0xa9, 0xe0, 0x49, 0xa9),
+    TABLE_WORD(0x6c, 0xb4, 0xd8, 0x6c), TABLE_WORD(0x56, 0xfa, 0xac, 0x56),
+    TABLE_WORD(0xf4, 0x07, 0xf3, 0xf4), TABLE_WORD(0xea, 0x25, 0xcf, 0xea),
+    TABLE_WORD(0x65, 0xaf, 0xca, 0x65), TABLE_WORD(0x7a, 0x8e, 0xf4, 0x7a),
+    TABLE_WORD(0xae, 0xe9, 0x47, 0xae), TABLE_WORD(0x08, 0x18, 0x10, 0x08),
+    TABLE_WORD(0xba, 0xd5, 0x6f, 0xba), TABLE_WORD(0x78, 0x88, 0xf0, 0x78),
+    TABLE_WORD(0x25, 0x6f, 0x4a, 0x25), TABLE_WORD(0x2e, 0x72, 0x5c, 0x2e),
+    TABLE_WORD(0x1c, 0x24, 0x38, 0x1c), TABLE_WORD(0xa6, 0xf1, 0x57, 0xa6),
+    TABLE_WORD(0xb4, 0xc7, 0x73, 0xb4), TABLE_WORD(0xc6, 0x51, 0x97, 0xc6),
+    TABLE_WORD(0xe8, 0x23, 0xcb, 0xe8), TABLE_WORD(0xdd, 0x7c, 0xa1, 0xdd),
+    TABLE_WORD(0x74, 0x9c, 0xe8, 0x74), TABLE_WORD(0x1f, 0x21, 0x3e, 0x1f),
+    TABLE_WORD(0x4b, 0xdd, 0x96, 0x4b), TABLE_WORD(0xbd, 0xdc, 0x61, 0xbd),
+    TABLE_WORD(0x8b, 0x86, 0x0d, 0x8b), TABLE_WORD(0x8a, 0x85, 0x0f, 0x8a),
+    TABLE_WORD(0x70, 0x90, 0xe0, 0x70), TABLE_WORD(0x3e, 0x42, 0x7c, 0x3e),
+    TABLE_WORD(0xb5, 0xc4, 0x71, 0xb5), TABLE_WORD(0x66, 0xaa, 0xcc, 0x66),
+    TABLE_WORD(0x48, 0xd8, 0x90, 0x48), TABLE_WORD(0x03, 0x05, 0x06, 0x03),
+    TABLE_WORD(0xf6, 0x01, 0xf7, 0xf6), TABLE_WORD(0x0e, 0x12, 0x1c, 0x0e),
+    TABLE_WORD(0x61, 0xa3, 0xc2, 0x61), TABLE_WORD(0x35, 0x5f, 0x6a, 0x35),
+    TABLE_WORD(0x57, 0xf9, 0xae, 0x57), TABLE_WORD(0xb9, 0xd0, 0x69, 0xb9),
+    TABLE_WORD(0x86, 0x91, 0x17, 0x86), TABLE_WORD(0xc1, 0x58, 0x99, 0xc1),
+    TABLE_WORD(0x1d, 0x27, 0x3a, 0x1d), TABLE_WORD(0x9e, 0xb9, 0x27, 0x9e),
+    TABLE_WORD(0xe1, 0x38, 0xd9, 0xe1), TABLE_WORD(0xf8, 0x13, 0xeb, 0xf8),
+    TABLE_WORD(0x98, 0xb3, 0x2b, 0x98), TABLE_WORD(0x11, 0x33, 0x22, 0x11),
+    TABLE_WORD(0x69, 0xbb, 0xd2, 0x69), TABLE_WORD(0xd9, 0x70, 0xa9, 0xd9),
+    TABLE_WORD(0x8e, 0x89, 0x07, 0x8e), TABLE_WORD(0x94, 0xa7, 0x33, 0x94),
+    TABLE_WORD(0x9b, 0xb6, 0x2d, 0x9b), TABLE_WORD(0x1e, 0x22, 0x3c, 0x1e),
+    TABLE_WORD(0x87, 0x92, 0x15, 0x87), TABLE_WORD(0xe9, 0x20, 0xc9, 0xe9),
+    TABLE_WORD(0xce, 0x49, 0x87, 0xce), TABLE_WORD(0x55, 0xff, 0xaa, 0x55),
+    TABLE_WORD(0x28, 0x78, 0x50, 0x28), TABLE_WORD(0xdf, 0x7a, 0xa5, 0xdf),
+    TABLE_WORD(0x8c, 0x8f, 0x03, 0x8c), TABLE_WORD(0xa1, 0xf8, 0x59, 0xa1),
+    TABLE_WORD(0x89, 0x80, 0x09, 0x89), TABLE_WORD(0x0d, 0x17, 0x1a, 0x0d),
+    TABLE_WORD(0xbf, 0xda, 0x65, 0xbf), TABLE_WORD(0xe6, 0x31, 0xd7, 0xe6),
+    TABLE_WORD(0x42, 0xc6, 0x84, 0x42), TABLE_WORD(0x68, 0xb8, 0xd0, 0x68),
+    TABLE_WORD(0x41, 0xc3, 0x82, 0x41), TABLE_WORD(0x99, 0xb0, 0x29, 0x99),
+    TABLE_WORD(0x2d, 0x77, 0x5a, 0x2d), TABLE_WORD(0x0f, 0x11, 0x1e, 0x0f),
+    TABLE_WORD(0xb0, 0xcb, 0x7b, 0xb0), TABLE_WORD(0x54, 0xfc, 0xa8, 0x54),
+    TABLE_WORD(0xbb, 0xd6, 0x6d, 0xbb), TABLE_WORD(0x16, 0x3a, 0x2c, 0x16),
+};
+
+const uint32_t T3_fwd_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0x63, 0x63, 0xa5, 0xc6), TABLE_WORD(0x7c, 0x7c, 0x84, 0xf8),
+    TABLE_WORD(0x77, 0x77, 0x99, 0xee), TABLE_WORD(0x7b, 0x7b, 0x8d, 0xf6),
+    TABLE_WORD(0xf2, 0xf2, 0x0d, 0xff), TABLE_WORD(0x6b, 0x6b, 0xbd, 0xd6),
+    TABLE_WORD(0x6f, 0x6f, 0xb1, 0xde), TABLE_WORD(0xc5, 0xc5, 0x54, 0x91),
+    TABLE_WORD(0x30, 0x30, 0x50, 0x60), TABLE_WORD(0x01, 0x01, 0x03, 0x02),
+    TABLE_WORD(0x67, 0x67, 0xa9, 0xce), TABLE_WORD(0x2b, 0x2b, 0x7d, 0x56),
+    TABLE_WORD(0xfe, 0xfe, 0x19, 0xe7), TABLE_WORD(0xd7, 0xd7, 0x62, 0xb5),
+    TABLE_WORD(0xab, 0xab, 0xe6, 0x4d), TABLE_WORD(0x76, 0x76, 0x9a, 0xec),
+    TABLE_WORD(0xca, 0xca, 0x45, 0x8f), TABLE_WORD(0x82, 0x82, 0x9d, 0x1f),
+    TABLE_WORD(0xc9, 0xc9, 0x40, 0x89), TABLE_WORD(0x7d, 0x7d, 0x87, 0xfa),
+    TABLE_WORD(0xfa, 0xfa, 0x15, 0xef), TABLE_WORD(0x59, 0x59, 0xeb, 0xb2),
+    TABLE_WORD(0x47, 0x47, 0xc9, 0x8e), TABLE_WORD(0xf0, 0xf0, 0x0b, 0xfb),
+    TABLE_WORD(0xad, 0xad, 0xec, 0x41), TABLE_WORD(0xd4, 0xd4, 0x67, 0xb3),
+    TABLE_WORD(0xa2, 0xa2, 0xfd, 0x5f), TABLE_WORD(0xaf, 0xaf, 0xea, 0x45),
+    TABLE_WORD(0x9c, 0x9c, 0xbf, 0x23), TABLE_WORD(0xa4, 0xa4, 0xf7, 0x53),
+    TABLE_WORD(0x72, 0x72, 0x96, 0xe4), TABLE_WORD(0xc0, 0xc0, 0x5b, 0x9b),
+    TABLE_WORD(0xb7, 0xb7, 0xc2, 0x75), TABLE_WORD(0xfd, 0xfd, 0x1c, 0xe1),
+    TABLE_WORD(0x93, 0x93, 0xae, 0x3d), TABLE_WORD(0x26, 0x26, 0x6a, 0x4c),
+    TABLE_WORD(0x36, 0x36, 0x5a, 0x6c), TABLE_WORD(0x3f, 0x3f, 0x41, 0x7e),
+    TABLE_WORD(0xf7, 0xf7, 0x02, 0xf5), TABLE_WORD(0xcc, 0xcc, 0x4f, 0x83),
+    TABLE_WORD(0x34, 0x34, 0x5c, 0x68), TABLE_WORD(0xa5, 0xa5, 0xf4, 0x51),
+    TABLE_WORD(0xe5, 0xe5, 0x34, 0xd1), TABLE_WORD(0xf1, 0xf1, 0x08, 0xf9),
+    TABLE_WORD(0x71, 0x71, 0x93, 0xe2), TABLE_WORD(0xd8, 0xd8, 0x73, 0xab),
+    TABLE_WORD(0x31, 0x31, 0x53, 0x62), TABLE_WORD(0x15, 0x15, 0x3f, 0x2a),
+    TABLE_WORD(0x04, 0x04, 0x0c, 0x08), TABLE_WORD(0xc7, 0xc7, 0x52, 0x95),
+    TABLE_WORD(0x23, 0x23, 0x65, 0x46), TABLE_WORD(0xc3, 0xc3, 0x5e, 0x9d),
+    TABLE_WORD(0x18, 0x18, 0x28, 0x30), TABLE_WORD(0x96, 0x96, 0xa1, 0x37),
+    TABLE_WORD(0x05, 0x05, 0x0f, 0x0a), TABLE_WORD(0x9a, 0x9a, 0xb5, 0x2f),
+    TABLE_WORD(0x07, 0x07, 0x09, 0x0e), TABLE_WORD(0x12, 0x12, 0x36, 0x24),
+    TABLE_WORD(0x80, 0x80, 0x9b, 0x1b), TABLE_WORD(0xe2, 0xe2, 0x3d, 0xdf),
+    TABLE_WORD(0xeb, 0xeb, 0x26, 0xcd), TABLE_WORD(0x27, 0x27, 0x69, 0x4e),
+    TABLE_WORD(0xb2, 0xb2, 0xcd, 0x7f), TABLE_WORD(0x75, 0x75, 0x9f, 0xea),
+    TABLE_WORD(0x09, 0x09, 0x1b, 0x12), TABLE_WORD(0x83, 0x83, 0x9e, 0x1d),
+    TABLE_WORD(0x2c, 0x2c, 0x74, 0x58), TABLE_WORD(0x1a, 0x1a, 0x2e, 0x34),
+    TABLE_WORD(0x1b, 0x1b, 0x2d, 0x36), TABLE_WORD(0x6e, 0x6e, 0xb2, 0xdc),
+    TABLE_WORD(0x5a, 0x5a, 0xee, 0xb4), TABLE_WORD(0xa0, 0xa0, 0xfb, 0x5b),
+    TABLE_WORD(0x52, 0x52, 0xf6, 0xa4), TABLE_WORD(0x3b, 0x3b, 0x4d, 0x76),
+    TABLE_WORD(0xd6, 0xd6, 0x61, 0xb7), TABLE_WORD(0xb3, 0xb3, 0xce, 0x7d),
+    TABLE_WORD(0x29, 0x29, 0x7b, 0x52), TABLE_WORD(0xe3, 0xe3, 0x3e, 0xdd),
+    TABLE_WORD(0x2f, 0x2f, 0x71, 0x5e), TABLE_WORD(0x84, 0x84, 0x97, 0x13),
+    TABLE_WORD(0x53, 0x53, 0xf5, 0xa6), TABLE_WORD(0xd1, 0xd1, 0x68, 0xb9),
+    TABLE_WORD(0x00, 0x00, 0x00, 0x00), TABLE_WORD(0xed, 0xed, 0x2c, 0xc1),
+    TABLE_WORD(0x20, 0x20, 0x60, 0x40), TABLE_WORD(0xfc, 0xfc, 0x1f, 0xe3),
+    TABLE_WORD(0xb1, 0xb1, 0xc8, 0x79), TABLE_WORD(0x5b, 0x5b, 0xed, 0xb6),
+    TABLE_WORD(0x6a, 0x6a, 0xbe, 0xd4), TABLE_WORD(0xcb, 0xcb, 0x46, 0x8d),
+    TABLE_WORD(0xbe, 0xbe, 0xd9, 0x67), TABLE_WORD(0x39, 0x39, 0x4b, 0x72),
+    TABLE_WORD(0x4a, 0x4a, 0xde, 0x94), TABLE_WORD(0x4c, 0x4c, 0xd4, 0x98),
+    TABLE_WORD(0x58, 0x58, 0xe8, 0xb0), TABLE_WORD(0xcf, 0xcf, 0x4a, 0x85),
+    TABLE_WORD(0xd0, 0xd0, 0x6b, 0xbb), TABLE_WORD(0xef, 0xef, 0x2a, 0xc5),
+    TABLE_WORD(0xaa, 0xaa, 0xe5, 0x4f), TABLE_WORD(0xfb, 0xfb, 0x16, 0xed),
+    TABLE_WORD(0x43, 0x43, 0xc5, 0x86), TABLE_WORD(0x4d, 0x4d, 0xd7, 0x9a),
+    TABLE_WORD(0x33, 0x33, 0x55, 0x66), TABLE_WORD(0x85, 0x85, 0x94, 0x11),
+    TABLE_WORD(0x45, 0x45, 0xcf, 0x8a), TABLE_WORD(0xf9, 0xf9, 0x10, 0xe9),
+    TABLE_WORD(0x02, 0x02, 0x06, 0x04), TABLE_WORD(0x7f, 0x7f, 0x81, 0xfe),
+    TABLE_WORD(0x50, 0x50, 0xf0, 0xa0), TABLE_WORD(0x3c, 0x3c, 0x44, 0x78),
+    TABLE_WORD(0x9f, 0x9f, 0xba, 0x25), TABLE_WORD(0xa8, 0xa8, 0xe3, 0x4b),
+    TABLE_WORD(0x51, 0x51, 0xf3, 0xa2), TABLE_WORD(0xa3, 0xa3, 0xfe, 0x5d),
+    TABLE_WORD(0x40, 0x40, 0xc0, 0x80), TABLE_WORD(0x8f, 0x8f, 0x8a, 0x05),
+    TABLE_WORD(0x92, 0x92, 0xad, 0x3f), TABLE_WORD(0x9d, 0x9d, 0xbc, 0x21),
+    TABLE_WORD(0x38, 0x38, 0x48, 0x70), TABLE_WORD(0xf5, 0xf5, 0x04, 0xf1),
+    TABLE_WORD(0xbc, 0xbc, 0xdf, 0x63), TABLE_WORD(0xb6, 0xb6, 0xc1, 0x77),
+    TABLE_WORD(0xda, 0xda, 0x75, 0xaf), TABLE_WORD(0x21, 0x21, 0x63, 0x42),
+    TABLE_WORD(0x10, 0x10, 0x30, 0x20), TABLE_WORD(0xff, 0xff, 0x1a, 0xe5),
+    TABLE_WORD(0xf3, 0xf3, 0x0e, 0xfd), TABLE_WORD(0xd2, 0xd2, 0x6d, 0xbf),
+    TABLE_WORD(0xcd, 0xcd, 0x4c, 0x81), TABLE_WORD(0x0c, 0x0c, 0x14, 0x18),
+    TABLE_WORD(0x13, 0x13, 0x35, 0x26), TABLE_WORD(0xec, 0xec, 0x2f, 0xc3),
+    TABLE_WORD(0x5f, 0x5f, 0xe1, 0xbe), TABLE_WORD(0x97, 0x97, 0xa2, 0x35),
+    TABLE_WORD(0x44, 0x44, 0xcc, 0x88), TABLE_WORD(0x17, 0x17, 0x39, 0x2e),
+    TABLE_WORD(0xc4, 0xc4, 0x57, 0x93), TABLE_WORD(0xa7, 0xa7, 0xf2, 0x55),
+    TABLE_WORD(0x7e, 0x7e, 0x82, 0xfc), TABLE_WORD(0x3d, 0x3d, 0x47, 0x7a),
+    TABLE_WORD(0x64, 0x64, 0xac, 0xc8), TABLE_WORD(0x5d, 0x5d, 0xe7, 0xba),
+    TABLE_WORD(0x19, 0x19, 0x2b, 0x32), TABLE_WORD(0x73, 0x73, 0x95, 0xe6),
+    TABLE_WORD(0x60, 0x60, 0xa0, 0xc0), TABLE_WORD(0x81, 0x81, 0x98, 0x19),
+    TABLE_WORD(0x4f, 0x4f, 0xd1, 0x9e), TABLE_WORD(0xdc, 0xdc, 0x7f, 0xa3),
+    TABLE_WORD(0x22, 0x22, 0x66, 0x44), TABLE_WORD(0x2a, 0x2a, 0x7e, 0x54),
+    TABLE_WORD(0x90, 0x90, 0xab, 0x3b), TABLE_WORD(0x88, 0x88, 0x83, 0x0b),
+    TABLE_WORD(0x46, 0x46, 0xca, 0x8c), TABLE_WORD(0xee, 0xee, 0x29, 0xc7),
+    TABLE_WORD(0xb8, 0xb8, 0xd3, 0x6b), TABLE_WORD(0x14, 0x14, 0x3c, 0x28),
+    TABLE_WORD(0xde, 0xde, 0x79, 0xa7), TABLE_WORD(0x5e, 0x5e, 0xe2, 0xbc),
+    TABLE_WORD(0x0b, 0x0b, 0x1d, 0x16), TABLE_WORD(0xdb, 0xdb, 0x76, 0xad),
+    TABLE_WORD(0xe0, 0xe0, 0x3b, 0xdb), TABLE_WORD(0x32, 0x32, 0x56, 0x64),
+    TABLE_WORD(0x3a, 0x3a, 0x4e, 0x74), TABLE_WORD(0x0a, 0x0a, 0x1e, 0x14),
+    TABLE_WORD(0x49, 0x49, 0xdb, 0x92), TABLE_WORD(0x06, 0x06, 0x0a, 0x0c),
+    TABLE_WORD(0x24, 0x24, 0x6c, 0x48), TABLE_WORD(0x5c, 0x5c, 0xe4, 0xb8),
+    TABLE_WORD(0xc2, 0xc2, 0x5d, 0x9f), TABLE_WORD(0xd3, 0xd3, 0x6e, 0xbd),
+    TABLE_WORD(0xac, 0xac, 0xef, 0x43), TABLE_WORD(0x62, 0x62, 0xa6, 0xc4),
+    TABLE_WORD(0x91, 0x91, 0xa8, 0x39), TABLE_WORD(0x95, 0x95, 0xa4, 0x31),
+    TABLE_WORD(0xe4, 0xe4, 0x37, 0xd3), TABLE_WORD(0x79, 0x79, 0x8b, 0xf2),
+    TABLE_WORD(0xe7, 0xe7, 0x32, 0xd5), TABLE_WORD(0xc8, 0xc8, 0x43, 0x8b),
+    TABLE_WORD(0x37, 0x37, 0x59, 0x6e), TABLE_WORD(0x6d, 0x6d, 0xb7, 0xda),
+    TABLE_WORD(0x8d, 0x8d, 0x8c, 0x01), TABLE_WORD(0xd5, 0xd5, 0x64, 0xb1),
+    TABLE_WORD(0x4e, 0x4e, 0xd2, 0x9c), TABLE_WORD(0xa9, 0xa9, 0xe0, 0x49),
+    TABLE_WORD(0x6c, 0x6c, 0xb4, 0xd8), TABLE_WORD(0x56, 0x56, 0xfa, 0xac),
+    TABLE_WORD(0xf4, 0xf4, 0x07, 0xf3), TABLE_WORD(0xea, 0xea, 0x25, 0xcf),
+    TABLE_WORD(0x65, 0x65, 0xaf, 0xca), TABLE_WORD(0x7a, 0x7a, 0x8e, 0xf4),
+    TABLE_WORD(0xae, 0xae, 0xe9, 0x47), TABLE_WORD(0x08, 0x08, 0x18, 0x10),
+    TABLE_WORD(0xba, 0xba, 0xd5, 0x6f), TABLE_WORD(0x78, 0x78, 0x88, 0xf0),
+    TABLE_WORD(0x25, 0x25, 0x6f, 0x4a), TABLE_WORD(0x2e, 0x2e, 0x72, 0x5c),
+    TABLE_WORD(0x1c, 0x1c, 0x24, 0x38), TABLE_WORD(0xa6, 0xa6, 0xf1, 0x57),
+    TABLE_WORD(0xb4, 0xb4, 0xc7, 0x73), TABLE_WORD(0xc6, 0xc6, 0x51, 0x97),
+    TABLE_WORD(0xe8, 0xe8, 0x23, 0xcb), TABLE_WORD(0xdd, 0xdd, 0x7c, 0xa1),
+    TABLE_WORD(0x74, 0x74, 0x9c, 0xe8), TABLE_WORD(0x1f, 0x1f, 0x21, 0x3e),
+    TABLE_WORD(0x4b, 0x4b, 0xdd, 0x96), TABLE_WORD(0xbd, 0xbd, 0xdc, 0x61),
+    TABLE_WORD(0x8b, 0x8b, 0x86, 0x0d), TABLE_WORD(0x8a, 0x8a, 0x85, 0x0f),
+    TABLE_WORD(0x70, 0x70, 0x90, 0xe0), TABLE_WORD(0x3e, 0x3e, 0x42, 0x7c),
+    TABLE_WORD(0xb5, 0xb5, 0xc4, 0x71), TABLE_WORD(0x66, 0x66, 0xaa, 0xcc),
+    TABLE_WORD(0x48, 0x48, 0xd8, 0x90), TABLE_WORD(0x03, 0x03, 0x05, 0x06),
+    TABLE_WORD(0xf6, 0xf6, 0x01, 0xf7), TABLE_WORD(0x0e, 0x0e, 0x12, 0x1c),
+    TABLE_WORD(0x61, 0x61, 0xa3, 0xc2), TABLE_WORD(0x35, 0x35, 0x5f, 0x6a),
+    TABLE_WORD(0x57, 0x57, 0xf9, 0xae), TABLE_WORD(0xb9, 0xb9, 0xd0, 0x69),
+    TABLE_WORD(0x86, 0x86, 0x91, 0x17), TABLE_WORD(0xc1, 0xc1, 0x58, 0x99),
+    TABLE_WORD(0x1d, 0x1d, 0x27, 0x3a), TABLE_WORD(0x9e, 0x9e, 0xb9, 0x27),
+    TABLE_WORD(0xe1, 0xe1, 0x38, 0xd9), TABLE_WORD(0xf8, 0xf8, 0x13, 0xeb),
+    TABLE_WORD(0x98, 0x98, 0xb3, 0x2b), TABLE_WORD(0x11, 0x11, 0x33, 0x22),
+    TABLE_WORD(0x69, 0x69, 0xbb, 0xd2), TABLE_WORD(0xd9, 0xd9, 0x70, 0xa9),
+    TABLE_WORD(0x8e, 0x8e, 0x89, 0x07), TABLE_WORD(0x94, 0x94, 0xa7, 0x33),
+    TABLE_WORD(0x9b, 0x9b, 0xb6, 0x2d), TABLE_WORD(0x1e, 0x1e, 0x22, 0x3c),
+    TABLE_WORD(0x87, 0x87, 0x92, 0x15), TABLE_WORD(0xe9, 0xe9, 0x20, 0xc9),
+    TABLE_WORD(0xce, 0xce, 0x49, 0x87), TABLE_WORD(0x55, 0x55, 0xff, 0xaa),
+    TABLE_WORD(0x28, 0x28, 0x78, 0x50), TABLE_WORD(0xdf, 0xdf, 0x7a, 0xa5),
+    TABLE_WORD(0x8c, 0x8c, 0x8f, 0x03), TABLE_WORD(0xa1, 0xa1, 0xf8, 0x59),
+    TABLE_WORD(0x89, 0x89, 0x80, 0x09), TABLE_WORD(0x0d, 0x0d, 0x17, 0x1a),
+    TABLE_WORD(0xbf, 0xbf, 0xda, 0x65), TABLE_WORD(0xe6, 0xe6, 0x31, 0xd7),
+    TABLE_WORD(0x42, 0x42, 0xc6, 0x84), TABLE_WORD(0x68, 0x68, 0xb8, 0xd0),
+    TABLE_WORD(0x41, 0x41, 0xc3, 0x82), TABLE_WORD(0x99, 0x99, 0xb0, 0x29),
+    TABLE_WORD(0x2d, 0x2d, 0x77, 0x5a), TABLE_WORD(0x0f, 0x0f, 0x11, 0x1e),
+    TABLE_WORD(0xb0, 0xb0, 0xcb, 0x7b), TABLE_WORD(0x54, 0x54, 0xfc, 0xa8),
+    TABLE_WORD(0xbb, 0xbb, 0xd6, 0x6d), TABLE_WORD(0x16, 0x16, 0x3a, 0x2c),
+};
+
+# endif
+
+const uint32_t T0_inv_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0x51, 0xf4, 0xa7, 0x50), TABLE_WORD(0x7e, 0x41, 0x65, 0x53),
+    TABLE_WORD(0x1a, 0x17, 0xa4, 0xc3), TABLE_WORD(0x3a, 0x27, 0x5e, 0x96),
+    TABLE_WORD(0x3b, 0xab, 0x6b, 0xcb), TABLE_WORD(0x1f, 0x9d, 0x45, 0xf1),
+    TABLE_WORD(0xac, 0xfa, 0x58, 0xab), TABLE_WORD(0x4b, 0xe3, 0x03, 0x93),
+    TABLE_WORD(0x20, 0x30, 0xfa, 0x55), TABLE_WORD(0xad, 0x76, 0x6d, 0xf6),
+    TABLE_WORD(0x88, 0xcc, 0x76, 0x91), TABLE_WORD(0xf5, 0x02, 0x4c, 0x25),
+    TABLE_WORD(0x4f, 0xe5, 0xd7, 0xfc), TABLE_WORD(0xc5, 0x2a, 0xcb, 0xd7),
+    TABLE_WORD(0x26, 0x35, 0x44, 0x80), TABLE_WORD(0xb5, 0x62, 0xa3, 0x8f),
+    TABLE_WORD(0xde, 0xb1, 0x5a, 0x49), TABLE_WORD(0x25, 0xba, 0x1b, 0x67),
+    TABLE_WORD(0x45, 0xea, 0x0e, 0x98), TABLE_WORD(0x5d, 0xfe, 0xc0, 0xe1),
+    TABLE_WORD(0xc3, 0x2f, 0x75, 0x02), TABLE_WORD(0x81, 0x4c, 0xf0, 0x12),
+    TABLE_WORD(0x8d, 0x46, 0x97, 0xa3), TABLE_WORD(0x6b, 0xd3, 0xf9, 0xc6),
+    TABLE_WORD(0x03, 0x8f, 0x5f, 0xe7), TABLE_WORD(0x15, 0x92, 0x9c, 0x95),
+    TABLE_WORD(0xbf, 0x6d, 0x7a, 0xeb), TABLE_WORD(0x95, 0x52, 0x59, 0xda),
+    TABLE_WORD(0xd4, 0xbe, 0x83, 0x2d), TABLE_WORD(0x58, 0x74, 0x21, 0xd3),
+    TABLE_WORD(0x49, 0xe0, 0x69, 0x29), TABLE_WORD(0x8e, 0xc9, 0xc8, 0x44),
+    TABLE_WORD(0x75, 0xc2, 0x89, 0x6a), TABLE_WORD(0xf4, 0x8e, 0x79, 0x78),
+    TABLE_WORD(0x99, 0x58, 0x3e, 0x6b), TABLE_WORD(0x27, 0xb9, 0x71, 0xdd),
+    TABLE_WORD(0xbe, 0xe1, 0x4f, 0xb6), TABLE_WORD(0xf0, 0x88, 0xad, 0x17),
+    TABLE_WORD(0xc9, 0x20, 0xac, 0x66), TABLE_WORD(0x7d, 0xce, 0x3a, 0xb4),
+    TABLE_WORD(0x63, 0xdf, 0x4a, 0x18), TABLE_WORD(0xe5, 0x1a, 0x31, 0x82),
+    TABLE_WORD(0x97, 0x51, 0x33, 0x60), TABLE_WORD(0x62, 0x53, 0x7f, 0x45),
+    TABLE_WORD(0xb1, 0x64, 0x77, 0xe0), TABLE_WORD(0xbb, 0x6b, 0xae, 0x84),
+    TABLE_WORD(0xfe, 0x81, 0xa0, 0x1c), TABLE_WORD(0xf9, 0x08, 0x2b, 0x94),
+    TABLE_WORD(0x70, 0x48, 0x68, 0x58), TABLE_WORD(0x8f, 0x45, 0xfd, 0x19),
+    TABLE_WORD(0x94, 0xde, 0x6c, 0x87), TABLE_WORD(0x52, 0x7b, 0xf8, 0xb7),
+    TABLE_WORD(0xab, 0x73, 0xd3, 0x23), TABLE_WORD(0x72, 0x4b, 0x02, 0xe2),
+    TABLE_WORD(0xe3, 0x1f, 0x8f, 0x57), TABLE_WORD(0x66, 0x55, 0xab, 0x2a),
+    TABLE_WORD(0xb2, 0xeb, 0x28, 0x07), TABLE_WORD(0x2f, 0xb5, 0xc2, 0x03),
+    TABLE_WORD(0x86, 0xc5, 0x7b, 0x9a), TABLE_WORD(0xd3, 0x37, 0x08, 0xa5),
+    TABLE_WORD(0x30, 0x28, 0x87, 0xf2), TABLE_WORD(0x23, 0xbf, 0xa5, 0xb2),
+    TABLE_WORD(0x02, 0x03, 0x6a, 0xba), TABLE_WORD(0xed, 0x16, 0x82, 0x5c),
+    TABLE_WORD(0x8a, 0xcf, 0x1c, 0x2b), TABLE_WORD(0xa7, 0x79, 0xb4, 0x92),
+    TABLE_WORD(0xf3, 0x07, 0xf2, 0xf0), TABLE_WORD(0x4e, 0x69, 0xe2, 0xa1),
+    TABLE_WORD(0x65, 0xda, 0xf4, 0xcd), TABLE_WORD(0x06, 0x05, 0xbe, 0xd5),
+    TABLE_WORD(0xd1, 0x34, 0x62, 0x1f), TABLE_WORD(0xc4, 0xa6, 0xfe, 0x8a),
+    TABLE_WORD(0x34, 0x2e, 0x53, 0x9d), TABLE_WORD(0xa2, 0xf3, 0x55, 0xa0),
+    TABLE_WORD(0x05, 0x8a, 0xe1, 0x32), TABLE_WORD(0xa4, 0xf6, 0xeb, 0x75),
+    TABLE_WORD(0x0b, 0x83, 0xec, 0x39), TABLE_WORD(0x40, 0x60, 0xef, 0xaa),
+    TABLE_WORD(0x5e, 0x71, 0x9f, 0x06), TABLE_WORD(0xbd, 0x6e, 0x10, 0x51),
+    TABLE_WORD(0x3e, 0x21, 0x8a, 0xf9), TABLE_WORD(0x96, 0xdd, 0x06, 0x3d),
+    TABLE_WORD(0xdd, 0x3e, 0x05, 0xae), TABLE_WORD(0x4d, 0xe6, 0xbd, 0x46),
+    TABLE_WORD(0x91, 0x54, 0x8d, 0xb5), TABLE_WORD(0x71, 0xc4, 0x5d, 0x05),
+    TABLE_WORD(0x04, 0x06, 0xd4, 0x6f), TABLE_WORD(0x60, 0x50, 0x15, 0xff),
+    TABLE_WORD(0x19, 0x98, 0xfb, 0x24), TABLE_WORD(0xd6, 0xbd, 0xe9, 0x97),
+    TABLE_WORD(0x89, 0x40, 0x43, 0xcc), TABLE_WORD(0x67, 0xd9, 0x9e, 0x77),
+    TABLE_WORD(0xb0, 0xe8, 0x42, 0xbd), TABLE_WORD(0x07, 0x89, 0x8b, 0x88),
+    TABLE_WORD(0xe7, 0x19, 0x5b, 0x38), TABLE_WORD(0x79, 0xc8, 0xee, 0xdb),
+    TABLE_WORD(0xa1, 0x7c, 0x0a, 0x47), TABLE_WORD(0x7c, 0x42, 0x0f, 0xe9),
+    TABLE_WORD(0xf8, 0x84, 0x1e, 0xc9), TABLE_WORD(0x00, 0x00, 0x00, 0x00),
+    TABLE_WORD(0x09, 0x80, 0x86, 0x83), TABLE_WORD(0x32, 0x2b, 0xed, 0x48),
+    TABLE_WORD(0x1e, 0x11, 0x70, 0xac), TABLE_WORD(0x6c, 0x5a, 0x72, 0x4e),
+    TABLE_WORD(0xfd, 0x0e, 0xff, 0xfb), TABLE_WORD(0x0f, 0x85, 0x38, 0x56),
+    TABLE_WORD(0x3d, 0xae, 0xd5, 0x1e), TABLE_WORD(0x36, 0x2d, 0x39, 0x27),
+    TABLE_WORD(0x0a, 0x0f, 0xd9, 0x64), TABLE_WORD(0x68, 0x5c, 0xa6, 0x21),
+    TABLE_WORD(0x9b, 0x5b, 0x54, 0xd1), TABLE_WORD(0x24, 0x36, 0x2e, 0x3a),
+    TABLE_WORD(0x0c, 0x0a, 0x67, 0xb1), TABLE_WORD(0x93, 0x57, 0xe7, 0x0f),
+    TABLE_WORD(0xb4, 0xee, 0x96, 0xd2), TABLE_WORD(0x1b, 0x9b, 0x91, 0x9e),
+    TABLE_WORD(0x80, 0xc0, 0xc5, 0x4f), TABLE_WORD(0x61, 0xdc, 0x20, 0xa2),
+    TABLE_WORD(0x5a, 0x77, 0x4b, 0x69), TABLE_WORD(0x1c, 0x12, 0x1a, 0x16),
+    TABLE_WORD(0xe2, 0x93, 0xba, 0x0a), TABLE_WORD(0xc0, 0xa0, 0x2a, 0xe5),
+    TABLE_WORD(0x3c, 0x22, 0xe0, 0x43), TABLE_WORD(0x12, 0x1b, 0x17, 0x1d),
+    TABLE_WORD(0x0e, 0x09, 0x0d, 0x0b), TABLE_WORD(0xf2, 0x8b, 0xc7, 0xad),
+    TABLE_WORD(0x2d, 0xb6, 0xa8, 0xb9), TABLE_WORD(0x14, 0x1e, 0xa9, 0xc8),
+    TABLE_WORD(0x57, 0xf1, 0x19, 0x85), TABLE_WORD(0xaf, 0x75, 0x07, 0x4c),
+    TABLE_WORD(0xee, 0x99, 0xdd, 0xbb), TABLE_WORD(0xa3, 0x7f, 0x60, 0xfd),
+    TABLE_WORD(0xf7, 0x01, 0x26, 0x9f), TABLE_WORD(0x5c, 0x72, 0xf5, 0xbc),
+    TABLE_WORD(0x44, 0x66, 0x3b, 0xc5), TABLE_WORD(0x5b, 0xfb, 0x7e, 0x34),
+    TABLE_WORD(0x8b, 0x43, 0x29, 0x76), TABLE_WORD(0xcb, 0x23, 0xc6, 0xdc),
+    TABLE_WORD(0xb6, 0xed, 0xfc, 0x68), TABLE_WORD(0xb8, 0xe4, 0xf1, 0x63),
+    TABLE_WORD(0xd7, 0x31, 0xdc, 0xca), TABLE_WORD(0x42, 0x63, 0x85, 0x10),
+    TABLE_WORD(0x13, 0x97, 0x22, 0x40), TABLE_WORD(0x84, 0xc6, 0x11, 0x20),
+    TABLE_WORD(0x85, 0x4a, 0x24, 0x7d), TABLE_WORD(0xd2, 0xbb, 0x3d, 0xf8),
+    TABLE_WORD(0xae, 0xf9, 0x32, 0x11), TABLE_WORD(0xc7, 0x29, 0xa1, 0x6d),
+    TABLE_WORD(0x1d, 0x9e, 0x2f, 0x4b), TABLE_WORD(0xdc, 0xb2, 0x30, 0xf3),
+    TABLE_WORD(0x0d, 0x86, 0x52, 0xec), TABLE_WORD(0x77, 0xc1, 0xe3, 0xd0),
+    TABLE_WORD(0x2b, 0xb3, 0x16, 0x6c), TABLE_WORD(0xa9, 0x70, 0xb9, 0x99),
+    TABLE_WORD(0x11, 0x94, 0x48, 0xfa), TABLE_WORD(0x47, 0xe9, 0x64, 0x22),
+    TABLE_WORD(0xa8, 0xfc, 0x8c, 0xc4), TABLE_WORD(0xa0, 0xf0, 0x3f, 0x1a),
+    TABLE_WORD(0x56, 0x7d, 0x2c, 0xd8), TABLE_WORD(0x22, 0x33, 0x90, 0xef),
+    TABLE_WORD(0x87, 0x49, 0x4e, 0xc7), TABLE_WORD(0xd9, 0x38, 0xd1, 0xc1),
+    TABLE_WORD(0x8c, 0xca, 0xa2, 0xfe), TABLE_WORD(0x98, 0xd4, 0x0b, 0x36),
+    TABLE_WORD(0xa6, 0xf5, 0x81, 0xcf), TABLE_WORD(0xa5, 0x7a, 0xde, 0x28),
+    TABLE_WORD(0xda, 0xb7, 0x8e, 0x26), TABLE_WORD(0x3f, 0xad, 0xbf, 0xa4),
+    TABLE_WORD(0x2c, 0x3a, 0x9d, 0xe4), TABLE_WORD(0x50, 0x78, 0x92, 0x0d),
+    TABLE_WORD(0x6a, 0x5f, 0xcc, 0x9b), TABLE_WORD(0x54, 0x7e, 0x46, 0x62),
+    TABLE_WORD(0xf6, 0x8d, 0x13, 0xc2), TABLE_WORD(0x90, 0xd8, 0xb8, 0xe8),
+    TABLE_WORD(0x2e, 0x39, 0xf7, 0x5e), TABLE_WORD(0x82, 0xc3, 0xaf, 0xf5),
+    TABLE_WORD(0x9f, 0x5d, 0x80, 0xbe), TABLE_WORD(0x69, 0xd0, 0x93, 0x7c),
+    TABLE_WORD(0x6f, 0xd5, 0x2d, 0xa9), TABLE_WORD(0xcf, 0x25, 0x12, 0xb3),
+    TABLE_WORD(0xc8, 0xac, 0x99, 0x3b), TABLE_WORD(0x10, 0x18, 0x7d, 0xa7),
+    TABLE_WORD(0xe8, 0x9c, 0x63, 0x6e), TABLE_WORD(0xdb, 0x3b, 0xbb, 0x7b),
+    TABLE_WORD(0xcd, 0x26, 0x78, 0x09), TABLE_WORD(0x6e, 0x59, 0x18, 0xf4),
+    TABLE_WORD(0xec, 0x9a, 0xb7, 0x01), TABLE_WORD(0x83, 0x4f, 0x9a, 0xa8),
+    TABLE_WORD(0xe6, 0x95, 0x6e, 0x65), TABLE_WORD(0xaa, 0xff, 0xe6, 0x7e),
+    TABLE_WORD(0x21, 0xbc, 0xcf, 0x08), TABLE_WORD(0xef, 0x15, 0xe8, 0xe6),
+    TABLE_WORD(0xba, 0xe7, 0x9b, 0xd9), TABLE_WORD(0x4a, 0x6f, 0x36, 0xce),
+    TABLE_WORD(0xea, 0x9f, 0x09, 0xd4), TABLE_WORD(0x29, 0xb0, 0x7c, 0xd6),
+    TABLE_WORD(0x31, 0xa4, 0xb2, 0xaf), TABLE_WORD(0x2a, 0x3f, 0x23, 0x31),
+    TABLE_WORD(0xc6, 0xa5, 0x94, 0x30), TABLE_WORD(0x35, 0xa2, 0x66, 0xc0),
+    TABLE_WORD(0x74, 0x4e, 0xbc, 0x37), TABLE_WORD(0xfc, 0x82, 0xca, 0xa6),
+    TABLE_WORD(0xe0, 0x90, 0xd0, 0xb0), TABLE_WORD(0x33, 0xa7, 0xd8, 0x15),
+    TABLE_WORD(0xf1, 0x04, 0x98, 0x4a), TABLE_WORD(0x41, 0xec, 0xda, 0xf7),
+    TABLE_WORD(0x7f, 0xcd, 0x50, 0x0e), TABLE_WORD(0x17, 0x91, 0xf6, 0x2f),
+    TABLE_WORD(0x76, 0x4d, 0xd6, 0x8d), TABLE_WORD(0x43, 0xef, 0xb0, 0x4d),
+    TABLE_WORD(0xcc, 0xaa, 0x4d, 0x54), TABLE_WORD(0xe4, 0x96, 0x04, 0xdf),
+    TABLE_WORD(0x9e, 0xd1, 0xb5, 0xe3), TABLE_WORD(0x4c, 0x6a, 0x88, 0x1b),
+    TABLE_WORD(0xc1, 0x2c, 0x1f, 0xb8), TABLE_WORD(0x46, 0x65, 0x51, 0x7f),
+    TABLE_WORD(0x9d, 0x5e, 0xea, 0x04), TABLE_WORD(0x01, 0x8c, 0x35, 0x5d),
+    TABLE_WORD(0xfa, 0x87, 0x74, 0x73), TABLE_WORD(0xfb, 0x0b, 0x41, 0x2e),
+    TABLE_WORD(0xb3, 0x67, 0x1d, 0x5a), TABLE_WORD(0x92, 0xdb, 0xd2, 0x52),
+    TABLE_WORD(0xe9, 0x10, 0x56, 0x33), TABLE_WORD(0x6d, 0xd6, 0x47, 0x13),
+    TABLE_WORD(0x9a, 0xd7, 0x61, 0x8c), TABLE_WORD(0x37, 0xa1, 0x0c, 0x7a),
+    TABLE_WORD(0x59, 0xf8, 0x14, 0x8e), TABLE_WORD(0xeb, 0x13, 0x3c, 0x89),
+    TABLE_WORD(0xce, 0xa9, 0x27, 0xee), TABLE_WORD(0xb7, 0x61, 0xc9, 0x35),
+    TABLE_WORD(0xe1, 0x1c, 0xe5, 0xed), TABLE_WORD(0x7a, 0x47, 0xb1, 0x3c),
+    TABLE_WORD(0x9c, 0xd2, 0xdf, 0x59), TABLE_WORD(0x55, 0xf2, 0x73, 0x3f),
+    TABLE_WORD(0x18, 0x14, 0xce, 0x79), TABLE_WORD(0x73, 0xc7, 0x37, 0xbf),
+    TABLE_WORD(0x53, 0xf7, 0xcd, 0xea), TABLE_WORD(0x5f, 0xfd, 0xaa, 0x5b),
+    TABLE_WORD(0xdf, 0x3d, 0x6f, 0x14), TABLE_WORD(0x78, 0x44, 0xdb, 0x86),
+    TABLE_WORD(0xca, 0xaf, 0xf3, 0x81), TABLE_WORD(0xb9, 0x68, 0xc4, 0x3e),
+    TABLE_WORD(0x38, 0x24, 0x34, 0x2c), TABLE_WORD(0xc2, 0xa3, 0x40, 0x5f),
+    TABLE_WORD(0x16, 0x1d, 0xc3, 0x72), TABLE_WORD(0xbc, 0xe2, 0x25, 0x0c),
+    TABLE_WORD(0x28, 0x3c, 0x49, 0x8b), TABLE_WORD(0xff, 0x0d, 0x95, 0x41),
+    TABLE_WORD(0x39, 0xa8, 0x01, 0x71), TABLE_WORD(0x08, 0x0c, 0xb3, 0xde),
+    TABLE_WORD(0xd8, 0xb4, 0xe4, 0x9c), TABLE_WORD(0x64, 0x56, 0xc1, 0x90),
+    TABLE_WORD(0x7b, 0xcb, 0x84, 0x61), TABLE_WORD(0xd5, 0x32, 0xb6, 0x70),
+    TABLE_WORD(0x48, 0x6c, 0x5c, 0x74), TABLE_WORD(0xd0, 0xb8, 0x57, 0x42),
+};
+
+# ifndef AES_MONOTABLE
+const uint32_t T1_inv_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0x50, 0x51, 0xf4, 0xa7), TABLE_WORD(0x53, 0x7e, 0x41, 0x65),
+    TABLE_WORD(0xc3, 0x1a, 0x17, 0xa4), TABLE_WORD(0x96, 0x3a, 0x27, 0x5e),
+    TABLE_WORD(0xcb, 0x3b, 0xab, 0x6b), TABLE_WORD(0xf1, 0x1f, 0x9d, 0x45),
+    TABLE_WORD(0xab, 0xac, 0xfa, 0x58), TABLE_WORD(0x93, 0x4b, 0xe3, 0x03),
+    TABLE_WORD(0x55, 0x20, 0x30, 0xfa), TABLE_WORD(0xf6, 0xad, 0x76, 0x6d),
+    TABLE_WORD(0x91, 0x88, 0xcc, 0x76), TABLE_WORD(0x25, 0xf5, 0x02, 0x4c),
+    TABLE_WORD(0xfc, 0x4f, 0xe5, 0xd7), TABLE_WORD(0xd7, 0xc5, 0x2a, 0xcb),
+    TABLE_WORD(0x80, 0x26, 0x35, 0x44), TABLE_WORD(0x8f, 0xb5, 0x62, 0xa3),
+    TABLE_WORD(0x49, 0xde, 0xb1, 0x5a), TABLE_WORD(0x67, 0x25, 0xba, 0x1b),
+    TABLE_WORD(0x98, 0x45, 0xea, 0x0e), TABLE_WORD(0xe1, 0x5d, 0xfe, 0xc0),
+    TABLE_WORD(0x02, 0xc3, 0x2f, 0x75), TABLE_WORD(0x12, 0x81, 0x4c, 0xf0),
+    TABLE_WORD(0xa3, 0x8d, 0x46, 0x97), TABLE_WORD(0xc6, 0x6b, 0xd3, 0xf9),
+    TABLE_WORD(0xe7, 0x03, 0x8f, 0x5f), TABLE_WORD(0x95, 0x15, 0x92, 0x9c),
+    TABLE_WORD(0xeb, 0xbf, 0x6d, 0x7a), TABLE_WORD(0xda, 0x95, 0x52, 0x59),
+    TABLE_WORD(0x2d, 0xd4, 0xbe, 0x83), TABLE_WORD(0xd3, 0x58, 0x74, 0x21),
+    TABLE_WORD(0x29, 0x49, 0xe0, 0x69), TABLE_WORD(0x44, 0x8e, 0xc9, 0xc8),
+    TABLE_WORD(0x6a, 0x75, 0xc2, 0x89), TABLE_WORD(0x78, 0xf4, 0x8e, 0x79),
+    TABLE_WORD(0x6b, 0x99, 0x58, 0x3e), TABLE_WORD(0xdd, 0x27, 0xb9, 0x71),
+    TABLE_WORD(0xb6, 0xbe, 0xe1, 0x4f), TABLE_WORD(0x17, 0xf0, 0x88, 0xad),
+    TABLE_WORD(0x66, 0xc9, 0x20, 0xac), TABLE_WORD(0xb4, 0x7d, 0xce, 0x3a),
+    TABLE_WORD(0x18, 0x63, 0xdf, 0x4a), TABLE_WORD(0x82, 0xe5, 0x1a, 0x31),
+    TABLE_WORD(0x60, 0x97, 0x51, 0x33), TABLE_WORD(0x45, 0x62, 0x53, 0x7f),
+    TABLE_WORD(0xe0, 0xb1, 0x64, 0x77), TABLE_WORD(0x84, 0xbb, 0x6b, 0xae),
+    TABLE_WORD(0x1c, 0xfe, 0x81, 0xa0), TABLE_WORD(0x94, 0xf9, 0x08, 0x2b),
+    TABLE_WORD(0x58, 0x70, 0x48, 0x68), TABLE_WORD(0x19, 0x8f, 0x45, 0xfd),
+    TABLE_WORD(0x87, 0x94, 0xde, 0x6c), TABLE_WORD(0xb7, 0x52, 0x7b, 0xf8),
+    TABLE_WORD(0x23, 0xab, 0x73, 0xd3), TABLE_WORD(0xe2, 0x72, 0x4b, 0x02),
+    TABLE_WORD(0x57, 0xe3, 0x1f, 0x8f), TABLE_WORD(0x2a, 0x66, 0x55, 0xab),
+    TABLE_WORD(0x07, 0xb2, 0xeb, 0x28), TABLE_WORD(0x03, 0x2f, 0xb5, 0xc2),
+    TABLE_WORD(0x9a, 0x86, 0xc5, 0x7b), TABLE_WORD(0xa5, 0xd3, 0x37, 0x08),
+    TABLE_WORD(0xf2, 0x30, 0x28, 0x87), TABLE_WORD(0xb2, 0x23, 0xbf, 0xa5),
+    TABLE_WORD(0xba, 0x02, 0x03, 0x6a), TABLE_WORD(0x5c, 0xed, 0x16, 0x82),
+    TABLE_WORD(0x2b, 0x8a, 0xcf, 0x1c), TABLE_WORD(0x92, 0xa7, 0x79, 0xb4),
+    TABLE_WORD(0xf0, 0xf3, 0x07, 0xf2), TABLE_WORD(0xa1, 0x4e, 0x69, 0xe2),
+    TABLE_WORD(0xcd, 0x65, 0xda, 0xf4), TABLE_WORD(0xd5, 0x06, 0x05, 0xbe),
+    TABLE_WORD(0x1f, 0xd1, 0x34, 0x62), TABLE_WORD(0x8a, 0xc4, 0xa6, 0xfe),
+    TABLE_WORD(0x9d, 0x34, 0x2e, 0x53), TABLE_WORD(0xa0, 0xa2, 0xf3, 0x55),
+    TABLE_WORD(0x32, 0x05, 0x8a, 0xe1), TABLE_WORD(0x75, 0xa4, 0xf6, 0xeb),
+    TABLE_WORD(0x39, 0x0b, 0x83, 0xec), TABLE_WORD(0xaa, 0x40, 0x60, 0xef),
+    TABLE_WORD(0x06, 0x5e, 0x71, 0x9f), TABLE_WORD(0x51, 0xbd, 0x6e, 0x10),
+    TABLE_WORD(0xf9, 0x3e, 0x21, 0x8a), TABLE_WORD(0x3d, 0x96, 0xdd, 0x06),
+    TABLE_WORD(0xae, 0xdd, 0x3e, 0x05), TABLE_WORD(0x46, 0x4d, 0xe6, 0xbd),
+    TABLE_WORD(0xb5, 0x91, 0x54, 0x8d), TABLE_WORD(0x05, 0x71, 0xc4, 0x5d),
+    TABLE_WORD(0x6f, 0x04, 0x06, 0xd4), TABLE_WORD(0xff, 0x60, 0x50, 0x15),
+    TABLE_WORD(0x24, 0x19, 0x98, 0xfb), TABLE_WORD(0x97, 0xd6, 0xbd, 0xe9),
+    TABLE_WORD(0xcc, 0x89, 0x40, 0x43), TABLE_WORD(0x77, 0x67, 0xd9, 0x9e),
+    TABLE_WORD(0xbd, 0xb0, 0xe8, 0x42), TABLE_WORD(0x88, 0x07, 0x89, 0x8b),
+    TABLE_WORD(0x38, 0xe7, 0x19, 0x5b), TABLE_WORD(0xdb, 0x79, 0xc8, 0xee),
+    TABLE_WORD(0x47, 0xa1, 0x7c, 0x0a), TABLE_WORD(0xe9, 0x7c, 0x42, 0x0f),
+    TABLE_WORD(0xc9, 0xf8, 0x84, 0x1e), TABLE_WORD(0x00, 0x00, 0x00, 0x00),
+    TABLE_WORD(0x83, 0x09, 0x80, 0x86), TABLE_WORD(0x48, 0x32, 0x2b, 0xed),
+    TABLE_WORD(0xac, 0x1e, 0x11, 0x70), TABLE_WORD(0x4e, 0x6c, 0x5a, 0x72),
+    TABLE_WORD(0xfb, 0xfd, 0x0e, 0xff), TABLE_WORD(0x56, 0x0f, 0x85, 0x38),
+    TABLE_WORD(0x1e, 0x3d, 0xae, 0xd5), TABLE_WORD(0x27, 0x36, 0x2d, 0x39),
+    TABLE_WORD(0x64, 0x0a, 0x0f, 0xd9), TABLE_WORD(0x21, 0x68, 0x5c, 0xa6),
+    TABLE_WORD(0xd1, 0x9b, 0x5b, 0x54), TABLE_WORD(0x3a, 0x24, 0x36, 0x2e),
+    TABLE_WORD(0xb1, 0x0c, 0x0a, 0x67), TABLE_WORD(0x0f, 0x93, 0x57, 0xe7),
+    TABLE_WORD(0xd2, 0xb4, 0xee, 0x96), TABLE_WORD(0x9e, 0x1b, 0x9b, 0x91),
+    TABLE_WORD(0x4f, 0x80, 0xc0, 0xc5), TABLE_WORD(0xa2, 0x61, 0xdc, 0x20),
+    TABLE_WORD(0x69, 0x5a, 0x77, 0x4b), TABLE_WORD(0x16, 0x1c, 0x12, 0x1a),
+    TABLE_WORD(0x0a, 0xe2, 0x93, 0xba), TABLE_WORD(0xe5, 0xc0, 0xa0, 0x2a),
+    TABLE_WORD(0x43, 0x3c, 0x22, 0xe0), TABLE_WORD(0x1d, 0x12, 0x1b, 0x17),
+    TABLE_WORD(0x0b, 0x0e, 0x09, 0x0d), TABLE_WORD(0xad, 0xf2, 0x8b, 0xc7),
+    TABLE_WORD(0xb9, 0x2d, 0xb6, 0xa8), TABLE_WORD(0xc8, 0x14, 0x1e, 0xa9),
+    TABLE_WORD(0x85, 0x57, 0xf1, 0x19), TABLE_WORD(0x4c, 0xaf, 0x75, 0x07),
+    TABLE_WORD(0xbb, 0xee, 0x99, 0xdd), TABLE_WORD(0xfd, 0xa3, 0x7f, 0x60),
+    TABLE_WORD(0x9f, 0xf7, 0x01, 0x26), TABLE_WORD(0xbc, 0x5c, 0x72, 0xf5),
+    TABLE_WORD(0xc5, 0x44, 0x66, 0x3b), TABLE_WORD(0x34, 0x5b, 0xfb, 0x7e),
+    TABLE_WORD(0x76, 0x8b, 0x43, 0x29), TABLE_WORD(0xdc, 0xcb, 0x23, 0xc6),
+    TABLE_WORD(0x68, 0xb6, 0xed, 0xfc), TABLE_WORD(0x63, 0xb8, 0xe4, 0xf1),
+    TABLE_WORD(0xca, 0xd7, 0x31, 0xdc), TABLE_WORD(0x10, 0x42, 0x63, 0x85),
+    TABLE_WORD(0x40, 0x13, 0x97, 0x22), TABLE_WORD(0x20, 0x84, 0xc6, 0x11),
+    TABLE_WORD(0x7d, 0x85, 0x4a, 0x24), TABLE_WORD(0xf8, 0xd2, 0xbb, 0x3d),
+    TABLE_WORD(0x11, 0xae, 0xf9, 0x32), TABLE_WORD(0x6d, 0xc7, 0x29, 0xa1),
+    TABLE_WORD(0x4b, 0x1d, 0x9e, 0x2f), TABLE_WORD(0xf3, 0xdc, 0xb2, 0x30),
+    TABLE_WORD(0xec, 0x0d, 0x86, 0x52), TABLE_WORD(0xd0, 0x77, 0xc1, 0xe3),
+    TABLE_WORD(0x6c, 0x2b, 0xb3, 0x16), TABLE_WORD(0x99, 0xa9, 0x70, 0xb9),
+    TABLE_WORD(0xfa, 0x11, 0x94, 0x48), TABLE_WORD(0x22, 0x47, 0xe9, 0x64),
+    TABLE_WORD(0xc4, 0xa8, 0xfc, 0x8c), TABLE_WORD(0x1a, 0xa0, 0xf0, 0x3f),
+    TABLE_WORD(0xd8, 0x56, 0x7d, 0x2c), TABLE_WORD(0xef, 0x22, 0x33, 0x90),
+    TABLE_WORD(0xc7, 0x87, 0x49, 0x4e), TABLE_WORD(0xc1, 0xd9, 0x38, 0xd1),
+    TABLE_WORD(0xfe, 0x8c, 0xca, 0xa2), TABLE_WORD(0x36, 0x98, 0xd4, 0x0b),
+    TABLE_WORD(0xcf, 0xa6, 0xf5, 0x81), TABLE_WORD(0x28, 0xa5, 0x7a, 0xde),
+    TABLE_WORD(0x26, 0xda, 0xb7, 0x8e), TABLE_WORD(0xa4, 0x3f, 0xad, 0xbf),
+    TABLE_WORD(0xe4, 0x2c, 0x3a, 0x9d), TABLE_WORD(0x0d, 0x50, 0x78, 0x92),
+    TABLE_WORD(0x9b, 0x6a, 0x5f, 0xcc), TABLE_WORD(0x62, 0x54, 0x7e, 0x46),
+    TABLE_WORD(0xc2, 0xf6, 0x8d, 0x13), TABLE_WORD(0xe8, 0x90, 0xd8, 0xb8),
+    TABLE_WORD(0x5e, 0x2e, 0x39, 0xf7), TABLE_WORD(0xf5, 0x82, 0xc3, 0xaf),
+    TABLE_WORD(0xbe, 0x9f, 0x5d, 0x80), TABLE_WORD(0x7c, 0x69, 0xd0, 0x93),
+    TABLE_WORD(0xa9, 0x6f, 0xd5, 0x2d), TABLE_WORD(0xb3, 0xcf, 0x25, 0x12),
+    TABLE_WORD(0x3b, 0xc8, 0xac, 0x99), TABLE_WORD(0xa7, 0x10, 0x18, 0x7d),
+    TABLE_WORD(0x6e, 0xe8, 0x9c, 0x63), TABLE_WORD(0x7b, 0xdb, 0x3b, 0xbb),
+    TABLE_WORD(0x09, 0xcd, 0x26, 0x78), TABLE_WORD(0xf4, 0x6e, 0x59, 0x18),
+    TABLE_WORD(0x01, 0xec, 0x9a, 0xb7), TABLE_WORD(0xa8, 0x83, 0x4f, 0x9a),
+    TABLE_WORD(0x65, 0xe6, 0x95, 0x6e), TABLE_WORD(0x7e, 0xaa, 0xff, 0xe6),
+    TABLE_WORD(0x08, 0x21, 0xbc, 0xcf), TABLE_WORD(0xe6, 0xef, 0x15, 0xe8),
+    TABLE_WORD(0xd9, 0xba, 0xe7, 0x9b), TABLE_WORD(0xce, 0x4a, 0x6f, 0x36),
+    TABLE_WORD(0xd4, 0xea, 0x9f, 0x09), TABLE_WORD(0xd6, 0x29, 0xb0, 0x7c),
+    TABLE_WORD(0xaf, 0x31, 0xa4, 0xb2), TABLE_WORD(0x31, 0x2a, 0x3f, 0x23),
+    TABLE_WORD(0x30, 0xc6, 0xa5, 0x94), TABLE_WORD(0xc0, 0x35, 0xa2, 0x66),
+    TABLE_WORD(0x37, 0x74, 0x4e, 0xbc), TABLE_WORD(0xa6, 0xfc, 0x82, 0xca),
+    TABLE_WORD(0xb0, 0xe0, 0x90, 0xd0), TABLE_WORD(0x15, 0x33, 0xa7, 0xd8),
+    TABLE_WORD(0x4a, 0xf1, 0x04, 0x98), TABLE_WORD(0xf7, 0x41, 0xec, 0xda),
+    TABLE_WORD(0x0e, 0x7f, 0xcd, 0x50), TABLE_WORD(0x2f, 0x17, 0x91, 0xf6),
+    TABLE_WORD(0x8d, 0x76, 0x4d, 0xd6), TABLE_WORD(0x4d, 0x43, 0xef, 0xb0),
+    TABLE_WORD(0x54, 0xcc, 0xaa, 0x4d), TABLE_WORD(0xdf, 0xe4, 0x96, 0x04),
+    TABLE_WORD(0xe3, 0x9e, 0xd1, 0xb5), TABLE_WORD(0x1b, 0x4c, 0x6a, 0x88),
+    TABLE_WORD(0xb8, 0xc1, 0x2c, 0x1f), TABLE_WORD(0x7f, 0x46, 0x65, 0x51),
+    TABLE_WORD(0x04, 0x9d, 0x5e, 0xea), TABLE_WORD(0x5d, 0x01, 0x8c, 0x35),
+    TABLE_WORD(0x73, 0xfa, 0x87, 0x74), TABLE_WORD(0x2e, 0xfb, 0x0b, 0x41),
+    TABLE_WORD(0x5a, 0xb3, 0x67, 0x1d), TABLE_WORD(0x52, 0x92, 0xdb, 0xd2),
+    TABLE_WORD(0x33, 0xe9, 0x10, 0x56), TABLE_WORD(0x13, 0x6d, 0xd6, 0x47),
+    TABLE_WORD(0x8c, 0x9a, 0xd7, 0x61), TABLE_WORD(0x7a, 0x37, 0xa1, 0x0c),
+    TABLE_WORD(0x8e, 0x59, 0xf8, 0x14), TABLE_WORD(0x89, 0xeb, 0x13, 0x3c),
+    TABLE_WORD(0xee, 0xce, 0xa9, 0x27), TABLE_WORD(0x35, 0xb7, 0x61, 0xc9),
+    TABLE_WORD(0xed, 0xe1, 0x1c, 0xe5), TABLE_WORD(0x3c, 0x7a, 0x47, 0xb1),
+    TABLE_WORD(0x59, 0x9c, 0xd2, 0xdf), TABLE_WORD(0x3f, 0x55, 0xf2, 0x73),
+    TABLE_WORD(0x79, 0x18, 0x14, 0xce), TABLE_WORD(0xbf, 0x73, 0xc7, 0x37),
+    TABLE_WORD(0xea, 0x53, 0xf7, 0xcd), TABLE_WORD(0x5b, 0x5f, 0xfd, 0xaa),
+    TABLE_WORD(0x14, 0xdf, 0x3d, 0x6f), TABLE_WORD(0x86, 0x78, 0x44, 0xdb),
+    TABLE_WORD(0x81, 0xca, 0xaf, 0xf3), TABLE_WORD(0x3e, 0xb9, 0x68, 0xc4),
+    TABLE_WORD(0x2c, 0x38, 0x24, 0x34), TABLE_WORD(0x5f, 0xc2, 0xa3, 0x40),
+    TABLE_WORD(0x72, 0x16, 0x1d, 0xc3), TABLE_WORD(0x0c, 0xbc, 0xe2, 0x25),
+    TABLE_WORD(0x8b, 0x28, 0x3c, 0x49), TABLE_WORD(0x41, 0xff, 0x0d, 0x95),
+    TABLE_WORD(0x71, 0x39, 0xa8, 0x01), TABLE_WORD(0xde, 0x08, 0x0c, 0xb3),
+    TABLE_WORD(0x9c, 0xd8, 0xb4, 0xe4), TABLE_WORD(0x90, 0x64, 0x56, 0xc1),
+    TABLE_WORD(0x61, 0x7b, 0xcb, 0x84), TABLE_WORD(0x70, 0xd5, 0x32, 0xb6),
+    TABLE_WORD(0x74, 0x48, 0x6c, 0x5c), TABLE_WORD(0x42, 0xd0, 0xb8, 0x57),
+};
+
+const uint32_t T2_inv_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0xa7, 0x50, 0x51, 0xf4), TABLE_WORD(0x65, 0x53, 0x7e, 0x41),
+    TABLE_WORD(0xa4, 0xc3, 0x1a, 0x17), TABLE_WORD(0x5e, 0x96, 0x3a, 0x27),
+    TABLE_WORD(0x6b, 0xcb, 0x3b, 0xab), TABLE_WORD(0x45, 0xf1, 0x1f, 0x9d),
+    TABLE_WORD(0x58, 0xab, 0xac, 0xfa), TABLE_WORD(0x03, 0x93, 0x4b, 0xe3),
+    TABLE_WORD(0xfa, 0x55, 0x20, 0x30), TABLE_WORD(0x6d, 0xf6, 0xad, 0x76),
+    TABLE_WORD(0x76, 0x91, 0x88, 0xcc), TABLE_WORD(0x4c, 0x25, 0xf5, 0x02),
+    TABLE_WORD(0xd7, 0xfc, 0x4f, 0xe5), TABLE_WORD(0xcb, 0xd7, 0xc5, 0x2a),
+    TABLE_WORD(0x44, 0x80, 0x26, 0x35), TABLE_WORD(0xa3, 0x8f, 0xb5, 0x62),
+    TABLE_WORD(0x5a, 0x49, 0xde, 0xb1), TABLE_WORD(0x1b, 0x67, 0x25, 0xba),
+    TABLE_WORD(0x0e, 0x98, 0x45, 0xea), TABLE_WORD(0xc0, 0xe1, 0x5d, 0xfe),
+    TABLE_WORD(0x75, 0x02, 0xc3, 0x2f), TABLE_WORD(0xf0, 0x12, 0x81, 0x4c),
+    TABLE_WORD(0x97, 0xa3, 0x8d, 0x46), TABLE_WORD(0xf9, 0xc6, 0x6b, 0xd3),
+    TABLE_WORD(0x5f, 0xe7, 0x03, 0x8f), TABLE_WORD(0x9c, 0x95, 0x15, 0x92),
+    TABLE_WORD(0x7a, 0xeb, 0xbf, 0x6d), TABLE_WORD(0x59, 0xda, 0x95, 0x52),
+    TABLE_WORD(0x83, 0x2d, 0xd4, 0xbe), TABLE_WORD(0x21, 0xd3, 0x58, 0x74),
+    TABLE_WORD(0x69, 0x29, 0x49, 0xe0), TABLE_WORD(0xc8, 0x44, 0x8e, 0xc9),
+    TABLE_WORD(0x89, 0x6a, 0x75, 0xc2), TABLE_WORD(0x79, 0x78, 0xf4, 0x8e),
+    TABLE_WORD(0x3e, 0x6b, 0x99, 0x58), TABLE_WORD(0x71, 0xdd, 0x27, 0xb9),
+    TABLE_WORD(0x4f, 0xb6, 0xbe, 0xe1), TABLE_WORD(0xad, 0x17, 0xf0, 0x88),
+    TABLE_WORD(0xac, 0x66, 0xc9, 0x20), TABLE_WORD(0x3a, 0xb4, 0x7d, 0xce),
+    TABLE_WORD(0x4a, 0x18, 0x63, 0xdf), TABLE_WORD(0x31, 0x82, 0xe5, 0x1a),
+    TABLE_WORD(0x33, 0x60, 0x97, 0x51), TABLE_WORD(0x7f, 0x45, 0x62, 0x53),
+    TABLE_WORD(0x77, 0xe0, 0xb1, 0x64), TABLE_WORD(0xae, 0x84, 0xbb, 0x6b),
+    TABLE_WORD(0xa0, 0x1c, 0xfe, 0x81), TABLE_WORD(0x2b, 0x94, 0xf9, 0x08),
+    TABLE_WORD(0x68, 0x58, 0x70, 0x48), TABLE_WORD(0xfd, 0x19, 0x8f, 0x45),
+    TABLE_WORD(0x6c, 0x87, 0x94, 0xde), TABLE_WORD(0xf8, 0xb7, 0x52, 0x7b),
+    TABLE_WORD(0xd3, 0x23, 0xab, 0x73), TABLE_WORD(0x02, 0xe2, 0x72, 0x4b),
+    TABLE_WORD(0x8f, 0x57, 0xe3, 0x1f), TABLE_WORD(0xab, 0x2a, 0x66, 0x55),
+    TABLE_WORD(0x28, 0x07, 0xb2, 0xeb), TABLE_WORD(0xc2, 0x03, 0x2f, 0xb5),
+    TABLE_WORD(0x7b, 0x9a, 0x86, 0xc5), TABLE_WORD(0x08, 0xa5, 0xd3, 0x37),
+    TABLE_WORD(0x87, 0xf2, 0x30, 0x28), TABLE_WORD(0xa5, 0xb2, 0x23, 0xbf),
+    TABLE_WORD(0x6a, 0xba, 0x02, 0x03), TABLE_WORD(0x82, 0x5c, 0xed, 0x16),
+    TABLE_WORD(0x1c, 0x2b, 0x8a, 0xcf), TABLE_WORD(0xb4, 0x92, 0xa7, 0x79),
+    TABLE_WORD(0xf2, 0xf0, 0xf3, 0x07), TABLE_WORD(0xe2, 0xa1, 0x4e, 0x69),
+    TABLE_WORD(0xf4, 0xcd, 0x65, 0xda), TABLE_WORD(0xbe, 0xd5, 0x06, 0x05),
+    TABLE_WORD(0x62, 0x1f, 0xd1, 0x34), TABLE_WORD(0xfe, 0x8a, 0xc4, 0xa6),
+    TABLE_WORD(0x53, 0x9d, 0x34, 0x2e), TABLE_WORD(0x55, 0xa0, 0xa2, 0xf3),
+    TABLE_WORD(0xe1, 0x32, 0x05, 0x8a), TABLE_WORD(0xeb, 0x75, 0xa4, 0xf6),
+    TABLE_WORD(0xec, 0x39, 0x0b, 0x83), TABLE_WORD(0xef, 0xaa, 0x40, 0x60),
+    TABLE_WORD(0x9f, 0x06, 0x5e, 0x71), TABLE_WORD(0x10, 0x51, 0xbd, 0x6e),
+    TABLE_WORD(0x8a, 0xf9, 0x3e, 0x21), TABLE_WORD(0x06, 0x3d, 0x96, 0xdd),
+    TABLE_WORD(0x05, 0xae, 0xdd, 0x3e), TABLE_WORD(0xbd, 0x46, 0x4d, 0xe6),
+    TABLE_WORD(0x8d, 0xb5, 0x91, 0x54), TABLE_WORD(0x5d, 0x05, 0x71, 0xc4),
+    TABLE_WORD(0xd4, 0x6f, 0x04, 0x06), TABLE_WORD(0x15, 0xff, 0x60, 0x50),
+    TABLE_WORD(0xfb, 0x24, 0x19, 0x98), TABLE_WORD(0xe9, 0x97, 0xd6, 0xbd),
+    TABLE_WORD(0x43, 0xcc, 0x89, 0x40), TABLE_WORD(0x9e, 0x77, 0x67, 0xd9),
+    TABLE_WORD(0x42, 0xbd, 0xb0, 0xe8), TABLE_WORD(0x8b, 0x88, 0x07, 0x89),
+    TABLE_WORD(0x5b, 0x38, 0xe7, 0x19), TABLE_WORD(0xee, 0xdb, 0x79, 0xc8),
+    TABLE_WORD(0x0a, 0x47, 0xa1, 0x7c), TABLE_WORD(0x0f, 0xe9, 0x7c, 0x42),
+    TABLE_WORD(0x1e, 0xc9, 0xf8, 0x84), TABLE_WORD(0x00, 0x00, 0x00, 0x00),
+    TABLE_WORD(0x86, 0x83, 0x09, 0x80), TABLE_WORD(0xed, 0x48, 0x32, 0x2b),
+    TABLE_WORD(0x70, 0xac, 0x1e, 0x11), TABLE_WORD(0x72, 0x4e, 0x6c, 0x5a),
+    TABLE_WORD(0xff, 0xfb, 0xfd, 0x0e), TABLE_WORD(0x38, 0x56, 0x0f, 0x85),
+    TABLE_WORD(0xd5, 0x1e, 0x3d, 0xae), TABLE_WORD(0x39, 0x27, 0x36, 0x2d),
+    TABLE_WORD(0xd9, 0x64, 0x0a, 0x0f), TABLE_WORD(0xa6, 0x21, 0x68, 0x5c),
+    TABLE_WORD(0x54, 0xd1, 0x9b, 0x5b), TABLE_WORD(0x2e, 0x3a, 0x24, 0x36),
+    TABLE_WORD(0x67, 0xb1, 0x0c, 0x0a), TABLE_WORD(0xe7, 0x0f, 0x93, 0x57),
+    TABLE_WORD(0x96, 0xd2, 0xb4, 0xee), TABLE_WORD(0x91, 0x9e, 0x1b, 0x9b),
+    TABLE_WORD(0xc5, 0x4f, 0x80, 0xc0), TABLE_WORD(0x20, 0xa2, 0x61, 0xdc),
+    TABLE_WORD(0x4b, 0x69, 0x5a, 0x77), TABLE_WORD(0x1a, 0x16, 0x1c, 0x12),
+    TABLE_WORD(0xba, 0x0a, 0xe2, 0x93), TABLE_WORD(0x2a, 0xe5, 0xc0, 0xa0),
+    TABLE_WORD(0xe0, 0x43, 0x3c, 0x22), TABLE_WORD(0x17, 0x1d, 0x12, 0x1b),
+    TABLE_WORD(0x0d, 0x0b, 0x0e, 0x09), TABLE_WORD(0xc7, 0xad, 0xf2, 0x8b),
+    TABLE_WORD(0xa8, 0xb9, 0x2d, 0xb6), TABLE_WORD(0xa9, 0xc8, 0x14, 0x1e),
+    TABLE_WORD(0x19, 0x85, 0x57, 0xf1), TABLE_WORD(0x07, 0x4c, 0xaf, 0x75),
+    TABLE_WORD(0xdd, 0xbb, 0xee, 0x99), TABLE_WORD(0x60, 0xfd, 0xa3, 0x7f),
+    TABLE_WORD(0x26, 0x9f, 0xf7, 0x01), TABLE_WORD(0xf5, 0xbc, 0x5c, 0x72),
+    TABLE_WORD(0x3b, 0xc5, 0x44, 0x66), TABLE_WORD(0x7e, 0x34, 0x5b, 0xfb),
+    TABLE_WORD(0x29, 0x76, 0x8b, 0x43), TABLE_WORD(0xc6, 0xdc, 0xcb, 0x23),
+    TABLE_WORD(0xfc, 0x68, 0xb6, 0xed), TABLE_WORD(0xf1, 0x63, 0xb8, 0xe4),
+    TABLE_WORD(0xdc, 0xca, 0xd7, 0x31), TABLE_WORD(0x85, 0x10, 0x42, 0x63),
+    TABLE_WORD(0x22, 0x40, 0x13, 0x97), TABLE_WORD(0x11, 0x20, 0x84, 0xc6),
+    TABLE_WORD(0x24, 0x7d, 0x85, 0x4a), TABLE_WORD(0x3d, 0xf8, 0xd2, 0xbb),
+    TABLE_WORD(0x32, 0x11, 0xae, 0xf9), TABLE_WORD(0xa1, 0x6d, 0xc7, 0x29),
+    TABLE_WORD(0x2f, 0x4b, 0x1d, 0x9e), TABLE_WORD(0x30, 0xf3, 0xdc, 0xb2),
+    TABLE_WORD(0x52, 0xec, 0x0d, 0x86), TABLE_WORD(0xe3, 0xd0, 0x77, 0xc1),
+    TABLE_WORD(0x16, 0x6c, 0x2b, 0xb3), TABLE_WORD(0xb9, 0x99, 0xa9, 0x70),
+    TABLE_WORD(0x48, 0xfa, 0x11, 0x94), TABLE_WORD(0x64, 0x22, 0x47, 0xe9),
+    TABLE_WORD(0x8c, 0xc4, 0xa8, 0xfc), TABLE_WORD(0x3f, 0x1a, 0xa0, 0xf0),
+    TABLE_WORD(0x2c, 0xd8, 0x56, 0x7d), TABLE_WORD(0x90, 0xef, 0x22, 0x33),
+    TABLE_WORD(0x4e, 0xc7, 0x87, 0x49), TABLE_WORD(0xd1, 0xc1, 0xd9, 0x38),
+    TABLE_WORD(0xa2, 0xfe, 0x8c, 0xca), TABLE_WORD(0x0b, 0x36, 0x98, 0xd4),
+    TABLE_WORD(0x81, 0xcf, 0xa6, 0xf5), TABLE_WORD(0xde, 0x28, 0xa5, 0x7a),
+    TABLE_WORD(0x8e, 0x26, 0xda, 0xb7), TABLE_WORD(0xbf, 0xa4, 0x3f, 0xad),
+    TABLE_WORD(0x9d, 0xe4, 0x2c, 0x3a), TABLE_WORD(0x92, 0x0d, 0x50, 0x78),
+    TABLE_WORD(0xcc, 0x9b, 0x6a, 0x5f), TABLE_WORD(0x46, 0x62, 0x54, 0x7e),
+    TABLE_WORD(0x13, 0xc2, 0xf6, 0x8d), TABLE_WORD(0xb8, 0xe8, 0x90, 0xd8),
+    TABLE_WORD(0xf7, 0x5e, 0x2e, 0x39), TABLE_WORD(0xaf, 0xf5, 0x82, 0xc3),
+    TABLE_WORD(0x80, 0xbe, 0x9f, 0x5d), TABLE_WORD(0x93, 0x7c, 0x69, 0xd0),
+    TABLE_WORD(0x2d, 0xa9, 0x6f, 0xd5), TABLE_WORD(0x12, 0xb3, 0xcf, 0x25),
+    TABLE_WORD(0x99, 0x3b, 0xc8, 0xac), TABLE_WORD(0x7d, 0xa7, 0x10, 0x18),
+    TABLE_WORD(0x63, 0x6e, 0xe8, 0x9c), TABLE_WORD(0xbb, 0x7b, 0xdb, 0x3b),
+    TABLE_WORD(0x78, 0x09, 0xcd, 0x26), TABLE_WORD(0x18, 0xf4, 0x6e, 0x59),
+    TABLE_WORD(0xb7, 0x01, 0xec, 0x9a), TABLE_WORD(0x9a, 0xa8, 0x83, 0x4f),
+    TABLE_WORD(0x6e, 0x65, 0xe6, 0x95), TABLE_WORD(0xe6, 0x7e, 0xaa, 0xff),
+    TABLE_WORD(0xcf, 0x08, 0x21, 0xbc), TABLE_WORD(0xe8, 0xe6, 0xef, 0x15),
+    TABLE_WORD(0x9b, 0xd9, 0xba, 0xe7), TABLE_WORD(0x36, 0xce, 0x4a, 0x6f),
+    TABLE_WORD(0x09, 0xd4, 0xea, 0x9f), TABLE_WORD(0x7c, 0xd6, 0x29, 0xb0),
+    TABLE_WORD(0xb2, 0xaf, 0x31, 0xa4), TABLE_WORD(0x23, 0x31, 0x2a, 0x3f),
+    TABLE_WORD(0x94, 0x30, 0xc6, 0xa5), TABLE_WORD(0x66, 0xc0, 0x35, 0xa2),
+    TABLE_WORD(0xbc, 0x37, 0x74, 0x4e), TABLE_WORD(0xca, 0xa6, 0xfc, 0x82),
+    TABLE_WORD(0xd0, 0xb0, 0xe0, 0x90), TABLE_WORD(0xd8, 0x15, 0x33, 0xa7),
+    TABLE_WORD(0x98, 0x4a, 0xf1, 0x04), TABLE_WORD(0xda, 0xf7, 0x41, 0xec),
+    TABLE_WORD(0x50, 0x0e, 0x7f, 0xcd), TABLE_WORD(0xf6, 0x2f, 0x17, 0x91),
+    TABLE_WORD(0xd6, 0x8d, 0x76, 0x4d), TABLE_WORD(0xb0, 0x4d, 0x43, 0xef),
+    TABLE_WORD(0x4d, 0x54, 0xcc, 0xaa), TABLE_WORD(0x04, 0xdf, 0xe4, 0x96),
+    TABLE_WORD(0xb5, 0xe3, 0x9e, 0xd1), TABLE_WORD(0x88, 0x1b, 0x4c, 0x6a),
+    TABLE_WORD(0x1f, 0xb8, 0xc1, 0x2c), TABLE_WORD(0x51, 0x7f, 0x46, 0x65),
+    TABLE_WORD(0xea, 0x04, 0x9d, 0x5e), TABLE_WORD(0x35, 0x5d, 0x01, 0x8c),
+    TABLE_WORD(0x74, 0x73, 0xfa, 0x87), TABLE_WORD(0x41, 0x2e, 0xfb, 0x0b),
+    TABLE_WORD(0x1d, 0x5a, 0xb3, 0x67), TABLE_WORD(0xd2, 0x52, 0x92, 0xdb),
+    TABLE_WORD(0x56, 0x33, 0xe9, 0x10), TABLE_WORD(0x47, 0x13, 0x6d, 0xd6),
+    TABLE_WORD(0x61, 0x8c, 0x9a, 0xd7), TABLE_WORD(0x0c, 0x7a, 0x37, 0xa1),
+    TABLE_WORD(0x14, 0x8e, 0x59, 0xf8), TABLE_WORD(0x3c, 0x89, 0xeb, 0x13),
+    TABLE_WORD(0x27, 0xee, 0xce, 0xa9), TABLE_WORD(0xc9, 0x35, 0xb7, 0x61),
+    TABLE_WORD(0xe5, 0xed, 0xe1, 0x1c), TABLE_WORD(0xb1, 0x3c, 0x7a, 0x47),
+    TABLE_WORD(0xdf, 0x59, 0x9c, 0xd2), TABLE_WORD(0x73, 0x3f, 0x55, 0xf2),
+    TABLE_WORD(0xce, 0x79, 0x18, 0x14), TABLE_WORD(0x37, 0xbf, 0x73, 0xc7),
+    TABLE_WORD(0xcd, 0xea, 0x53, 0xf7), TABLE_WORD(0xaa, 0x5b, 0x5f, 0xfd),
+    TABLE_WORD(0x6f, 0x14, 0xdf, 0x3d), TABLE_WORD(0xdb, 0x86, 0x78, 0x44),
+    TABLE_WORD(0xf3, 0x81, 0xca, 0xaf), TABLE_WORD(0xc4, 0x3e, 0xb9, 0x68),
+    TABLE_WORD(0x34, 0x2c, 0x38, 0x24), TABLE_WORD(0x40, 0x5f, 0xc2, 0xa3),
+    TABLE_WORD(0xc3, 0x72, 0x16, 0x1d), TABLE_WORD(0x25, 0x0c, 0xbc, 0xe2),
+    TABLE_WORD(0x49, 0x8b, 0x28, 0x3c), TABLE_WORD(0x95, 0x41, 0xff, 0x0d),
+    TABLE_WORD(0x01, 0x71, 0x39, 0xa8), TABLE_WORD(0xb3, 0xde, 0x08, 0x0c),
+    TABLE_WORD(0xe4, 0x9c, 0xd8, 0xb4), TABLE_WORD(0xc1, 0x90, 0x64, 0x56),
+    TABLE_WORD(0x84, 0x61, 0x7b, 0xcb), TABLE_WORD(0xb6, 0x70, 0xd5, 0x32),
+    TABLE_WORD(0x5c, 0x74, 0x48, 0x6c), TABLE_WORD(0x57, 0x42, 0xd0, 0xb8),
+};
+
+const uint32_t T3_inv_words[256] TABLE_ALIGN = {
+    TABLE_WORD(0xf4, 0xa7, 0x50, 0x51), TABLE_WORD(0x41, 0x65, 0x53, 0x7e),
+    TABLE_WORD(0x17, 0xa4, 0xc3, 0x1a), TABLE_WORD(0x27, 0x5e, 0x96, 0x3a),
+    TABLE_WORD(0xab, 0x6b, 0xcb, 0x3b), TABLE_WORD(0x9d, 0x45, 0xf1, 0x1f),
+    TABLE_WORD(0xfa, 0x58, 0xab, 0xac), TABLE_WORD(0xe3, 0x03, 0x93, 0x4b),
+    TABLE_WORD(0x30, 0xfa, 0x55, 0x20), TABLE_WORD(0x76, 0x6d, 0xf6, 0xad),
+    TABLE_WORD(0xcc, 0x76, 0x91, 0x88), TABLE_WORD(0x02, 0x4c, 0x25, 0xf5),
+    TABLE_WORD(0xe5, 0xd7, 0xfc, 0x4f), TABLE_WORD(0x2a, 0xcb, 0xd7, 0xc5),
+    TABLE_WORD(0x35, 0x44, 0x80, 0x26), TABLE_WORD(0x62, 0xa3, 0x8f, 0xb5),
+    TABLE_WORD(0xb1, 0x5a, 0x49, 0xde), TABLE_WORD(0xba, 0x1b, 0x67, 0x25),
+    TABLE_WORD(0xea, 0x0e, 0x98, 0x45), TABLE_WORD(0xfe, 0xc0, 0xe1, 0x5d),
+    TABLE_WORD(0x2f, 0x75, 0x02, 0xc3), TABLE_WORD(0x4c, 0xf0, 0x12, 0x81),
+    TABLE_WORD(0x46, 0x97, 0xa3, 0x8d), TABLE_WORD(0xd3, 0xf9, 0xc6, 0x6b),
+    TABLE_WORD(0x8f, 0x5f, 0xe7, 0x03), TABLE_WORD(0x92, 0x9c, 0x95, 0x15),
+    TABLE_WORD(0x6d, 0x7a, 0xeb, 0xbf), TABLE_WORD(0x52, 0x59, 0xda, 0x95),
+    TABLE_WORD(0xbe, 0x83, 0x2d, 0xd4), TABLE_WORD(0x74, 0x21, 0xd3, 0x58),
+    TABLE_WORD(0xe0, 0x69, 0x29, 0x49), TABLE_WORD(0xc9, 0xc8, 0x44, 0x8e),
+    TABLE_WORD(0xc2, 0x89, 0x6a, 0x75), TABLE_WORD(0x8e, 0x79, 0x78, 0xf4),
+    TABLE_WORD(0x58, 0x3e, 0x6b, 0x99), TABLE_WORD(0xb9, 0x71, 0xdd, 0x27),
+    TABLE_WORD(0xe1, 0x4f, 0xb6, 0xbe), TABLE_WORD(0x88, 0xad, 0x17, 0xf0),
+    TABLE_WORD(0x20, 0xac, 0x66, 0xc9), TABLE_WORD(0xce, 0x3a, 0xb4, 0x7d),
+    TABLE_WORD(0xdf, 0x4a, 0x18, 0x63), TABLE_WORD(0x1a, 0x31, 0x82, 0xe5),
+    TABLE_WORD(0x51, 0x33, 0x60, 0x97), TABLE_WORD(0x53, 0x7f, 0x45, 0x62),
+    TABLE_WORD(0x64, 0x77, 0xe0, 0xb1), TABLE_WORD(0x6b, 0xae, 0x84, 0xbb),
+    TABLE_WORD(0x81, 0xa0, 0x1c, 0xfe), TABLE_WORD(0x08, 0x2b, 0x94, 0xf9),
+    TABLE_WORD(0x48, 0x68, 0x58, 0x70), TABLE_WORD(0x45, 0xfd, 0x19, 0x8f),
+    TABLE_WORD(0xde, 0x6c, 0x87, 0x94), TABLE_WORD(0x7b, 0xf8, 0xb7, 0x52),
+    TABLE_WORD(0x73, 0xd3, 0x23, 0xab), TABLE_WORD(0x4b, 0x02, 0xe2, 0x72),
+    TABLE_WORD(0x1f, 0x8f, 0x57, 0xe3), TABLE_WORD(0x55, 0xab, 0x2a, 0x66),
+    TABLE_WORD(0xeb, 0x28, 0x07, 0xb2), TABLE_WORD(0xb5, 0xc2, 0x03, 0x2f),
+    TABLE_WORD(0xc5, 0x7b, 0x9a, 0x86), TABLE_WORD(0x37, 0x08, 0xa5, 0xd3),
+    TABLE_WORD(0x28, 0x87, 0xf2, 0x30), TABLE_WORD(0xbf, 0xa5, 0xb2, 0x23),
+    TABLE_WORD(0x03, 0x6a, 0xba, 0x02), TABLE_WORD(0x16, 0x82, 0x5c, 0xed),
+    TABLE_WORD(0xcf, 0x1c, 0x2b, 0x8a), TABLE_WORD(0x79, 0xb4, 0x92, 0xa7),
+    TABLE_WORD(0x07, 0xf2, 0xf0, 0xf3), TABLE_WORD(0x69, 0xe2, 0xa1, 0x4e),
+    TABLE_WORD(0xda, 0xf4, 0xcd, 0x65), TABLE_WORD(0x05, 0xbe, 0xd5, 0x06),
+    TABLE_WORD(0x34, 0x62, 0x1f, 0xd1), TABLE_WORD(0xa6, 0xfe, 0x8a, 0xc4),
+    TABLE_WORD(0x2e, 0x53, 0x9d, 0x34), TABLE_WORD(0xf3, 0x55, 0xa0, 0xa2),
+    TABLE_WORD(0x8a, 0xe1, 0x32, 0x05), TABLE_WORD(0xf6, 0xeb, 0x75, 0xa4),
+    TABLE_WORD(0x83, 0xec, 0x39, 0x0b), TABLE_WORD(0x60, 0xef, 0xaa, 0x40),
+    TABLE_WORD(0x71, 0x9f, 0x06, 0x5e), TABLE_WORD(0x6e, 0x10, 0x51, 0xbd),
+    TABLE_WORD(0x21, 0x8a, 0xf9, 0x3e), TABLE_WORD(0xdd, 0x06, 0x3d, 0x96),
+    TABLE_WORD(0x3e, 0x05, 0xae, 0xdd), TABLE_WORD(0xe6, 0xbd, 0x46, 0x4d),
+    TABLE_WORD(0x54, 0x8d, 0xb5, 0x91), TABLE_WORD(0xc4, 0x5d, 0x05, 0x71),
+    TABLE_WORD(0x06, 0xd4, 0x6f, 0x04), TABLE_WORD(0x50, 0x15, 0xff, 0x60),
+    TABLE_WORD(0x98, 0xfb, 0x24, 0x19), TABLE_WORD(0xbd, 0xe9, 0x97, 0xd6),
+    TABLE_WORD(0x40, 0x43, 0xcc, 0x89), TABLE_WORD(0xd9, 0x9e, 0x77, 0x67),
+    TABLE_WORD(0xe8, 0x42, 0xbd, 0xb0), TABLE_WORD(0x89, 0x8b, 0x88, 0x07),
+    TABLE_WORD(0x19, 0x5b, 0x38, 0xe7), TABLE_WORD(0xc8, 0xee, 0xdb, 0x79),
+    TABLE_WORD(0x7c, 0x0a, 0x47, 0xa1), TABLE_WORD(0x42, 0x0f, 0xe9, 0x7c),
+    TABLE_WORD(0x84, 0x1e, 0xc9, 0xf8), TABLE_WORD(0x00, 0x00, 0x00, 0x00),
+    TABLE_WORD(0x80, 0x86, 0x83, 0x09), TABLE_WORD(0x2b, 0xed, 0x48, 0x32),
+    TABLE_WORD(0x11, 0x70, 0xac, 0x1e), TABLE_WORD(0x5a, 0x72, 0x4e, 0x6c),
+    TABLE_WORD(0x0e, 0xff, 0xfb, 0xfd), TABLE_WORD(0x85, 0x38, 0x56, 0x0f),
+    TABLE_WORD(0xae, 0xd5, 0x1e, 0x3d), TABLE_WORD(0x2d, 0x39, 0x27, 0x36),
+    TABLE_WORD(0x0f, 0xd9, 0x64, 0x0a), TABLE_WORD(0x5c, 0xa6, 0x21, 0x68),
+    TABLE_WORD(0x5b, 0x54, 0xd1, 0x9b), TABLE_WORD(0x36, 0x2e, 0x3a, 0x24),
+    TABLE_WORD(0x0a, 0x67, 0xb1, 0x0c), TABLE_WORD(0x57, 0xe7, 0x0f, 0x93),
+    TABLE_WORD(0xee, 0x96, 0xd2, 0xb4), TABLE_WORD(0x9b, 0x91, 0x9e, 0x1b),
+    TABLE_WORD(0xc0, 0xc5, 0x4f, 0x80), TABLE_WORD(0xdc, 0x20, 0xa2, 0x61),
+    TABLE_WORD(0x77, 0x4b, 0x69, 0x5a), TABLE_WORD(0x12, 0x1a, 0x16, 0x1c),
+    TABLE_WORD(0x93, 0xba, 0x0a, 0xe2), TABLE_WORD(0xa0, 0x2a, 0xe5, 0xc0),
+    TABLE_WORD(0x22, 0xe0, 0x43, 0x3c), TABLE_WORD(0x1b, 0x17, 0x1d, 0x12),
+    TABLE_WORD(0x09, 0x0d, 0x0b, 0x0e), TABLE_WORD(0x8b, 0xc7, 0xad, 0xf2),
+    TABLE_WORD(0xb6, 0xa8, 0xb9, 0x2d), TABLE_WORD(0x1e, 0xa9, 0xc8, 0x14),
+    TABLE_WORD(0xf1, 0x19, 0x85, 0x57), TABLE_WORD(0x75, 0x07, 0x4c, 0xaf),
+    TABLE_WORD(0x99, 0xdd, 0xbb, 0xee), TABLE_WORD(0x7f, 0x60, 0xfd, 0xa3),
+    TABLE_WORD(0x01, 0x26, 0x9f, 0xf7), TABLE_WORD(0x72, 0xf5, 0xbc, 0x5c),
+    TABLE_WORD(0x66, 0x3b, 0xc5, 0x44), TABLE_WORD(0xfb, 0x7e, 0x34, 0x5b),
+    TABLE_WORD(0x43, 0x29, 0x76, 0x8b), TABLE_WORD(0x23, 0xc6, 0xdc, 0xcb),
+    TABLE_WORD(0xed, 0xfc, 0x68, 0xb6), TABLE_WORD(0xe4, 0xf1, 0x63, 0xb8),
+    TABLE_WORD(0x31, 0xdc, 0xca, 0xd7), TABLE_WORD(0x63, 0x85, 0x10, 0x42),
+    TABLE_WORD(0x97, 0x22, 0x40, 0x13), TABLE_WORD(0xc6, 0x11, 0x20, 0x84),
+    TABLE_WORD(0x4a, 0x24, 0x7d, 0x85), TABLE_WORD(0xbb, 0x3d, 0xf8, 0xd2),
+    TABLE_WORD(0xf9, 0x32, 0x11, 0xae), TABLE_WORD(0x29, 0xa1, 0x6d, 0xc7),
+    TABLE_WORD(0x9e, 0x2f, 0x4b, 0x1d), TABLE_WORD(0xb2, 0x30, 0xf3, 0xdc),
+    TABLE_WORD(0x86, 0x52, 0xec, 0x0d), TABLE_WORD(0xc1, 0xe3, 0xd0, 0x77),
+    TABLE_WORD(0xb3, 0x16, 0x6c, 0x2b), TABLE_WORD(0x70, 0xb9, 0x99, 0xa9),
+    TABLE_WORD(0x94, 0x48, 0xfa, 0x11), TABLE_WORD(0xe9, 0x64, 0x22, 0x47),
+    TABLE_WORD(0xfc, 0x8c, 0xc4, 0xa8), TABLE_WORD(0xf0, 0x3f, 0x1a, 0xa0),
+    TABLE_WORD(0x7d, 0x2c, 0xd8, 0x56), TABLE_WORD(0x33, 0x90, 0xef, 0x22),
+    TABLE_WORD(0x49, 0x4e, 0xc7, 0x87), TABLE_WORD(0x38, 0xd1, 0xc1, 0xd9),
+    TABLE_WORD(0xca, 0xa2, 0xfe, 0x8c), TABLE_WORD(0xd4, 0x0b, 0x36, 0x98),
+    TABLE_WORD(0xf5, 0x81, 0xcf, 0xa6), TABLE_WORD(0x7a, 0xde, 0x28, 0xa5),
+    TABLE_WORD(0xb7, 0x8e, 0x26, 0xda), TABLE_WORD(0xad, 0xbf, 0xa4, 0x3f),
+    TABLE_WORD(0x3a, 0x9d, 0xe4, 0x2c), TABLE_WORD(0x78, 0x92, 0x0d, 0x50),
+    TABLE_WORD(0x5f, 0xcc, 0x9b, 0x6a), TABLE_WORD(0x7e, 0x46, 0x62, 0x54),
+    TABLE_WORD(0x8d, 0x13, 0xc2, 0xf6), TABLE_WORD(0xd8, 0xb8, 0xe8, 0x90),
+    TABLE_WORD(0x39, 0xf7, 0x5e, 0x2e), TABLE_WORD(0xc3, 0xaf, 0xf5, 0x82),
+    TABLE_WORD(0x5d, 0x80, 0xbe, 0x9f), TABLE_WORD(0xd0, 0x93, 0x7c, 0x69),
+    TABLE_WORD(0xd5, 0x2d, 0xa9, 0x6f), TABLE_WORD(0x25, 0x12, 0xb3, 0xcf),
+    TABLE_WORD(0xac, 0x99, 0x3b, 0xc8), TABLE_WORD(0x18, 0x7d, 0xa7, 0x10),
+    TABLE_WORD(0x9c, 0x63, 0x6e, 0xe8), TABLE_WORD(0x3b, 0xbb, 0x7b, 0xdb),
+    TABLE_WORD(0x26, 0x78, 0x09, 0xcd), TABLE_WORD(0x59, 0x18, 0xf4, 0x6e),
+    TABLE_WORD(0x9a, 0xb7, 0x01, 0xec), TABLE_WORD(0x4f, 0x9a, 0xa8, 0x83),
+    TABLE_WORD(0x95, 0x6e, 0x65, 0xe6), TABLE_WORD(0xff, 0xe6, 0x7e, 0xaa),
+    TABLE_WORD(0xbc, 0xcf, 0x08, 0x21), TABLE_WORD(0x15, 0xe8, 0xe6, 0xef),
+    TABLE_WORD(0xe7, 0x9b, 0xd9, 0xba), TABLE_WORD(0x6f, 0x36, 0xce, 0x4a),
+    TABLE_WORD(0x9f, 0x09, 0xd4, 0xea), TABLE_WORD(0xb0, 0x7c, 0xd6, 0x29),
+    TABLE_WORD(0xa4, 0xb2, 0xaf, 0x31), TABLE_WORD(0x3f, 0x23, 0x31, 0x2a),
+    TABLE_WORD(0xa5, 0x94, 0x30, 0xc6), TABLE_WORD(0xa2, 0x66, 0xc0, 0x35),
+    TABLE_WORD(0x4e, 0xbc, 0x37, 0x74), TABLE_WORD(0x82, 0xca, 0xa6, 0xfc),
+    TABLE_WORD(0x90, 0xd0, 0xb0, 0xe0), TABLE_WORD(0xa7, 0xd8, 0x15, 0x33),
+    TABLE_WORD(0x04, 0x98, 0x4a, 0xf1), TABLE_WORD(0xec, 0xda, 0xf7, 0x41),
+    TABLE_WORD(0xcd, 0x50, 0x0e, 0x7f), TABLE_WORD(0x91, 0xf6, 0x2f, 0x17),
+    TABLE_WORD(0x4d, 0xd6, 0x8d, 0x76), TABLE_WORD(0xef, 0xb0, 0x4d, 0x43),
+    TABLE_WORD(0xaa, 0x4d, 0x54, 0xcc), TABLE_WORD(0x96, 0x04, 0xdf, 0xe4),
+    TABLE_WORD(0xd1, 0xb5, 0xe3, 0x9e), TABLE_WORD(0x6a, 0x88, 0x1b, 0x4c),
+    TABLE_WORD(0x2c, 0x1f, 0xb8, 0xc1), TABLE_WORD(0x65, 0x51, 0x7f, 0x46),
+    TABLE_WORD(0x5e, 0xea, 0x04, 0x9d), TABLE_WORD(0x8c, 0x35, 0x5d, 0x01),
+    TABLE_WORD(0x87, 0x74, 0x73, 0xfa), TABLE_WORD(0x0b, 0x41, 0x2e, 0xfb),
+    TABLE_WORD(0x67, 0x1d, 0x5a, 0xb3), TABLE_WORD(0xdb, 0xd2, 0x52, 0x92),
+    TABLE_WORD(0x10, 0x56, 0x33, 0xe9), TABLE_WORD(0xd6, 0x47, 0x13, 0x6d),
+    TABLE_WORD(0xd7, 0x61, 0x8c, 0x9a), TABLE_WORD(0xa1, 0x0c, 0x7a, 0x37),
+    TABLE_WORD(0xf8, 0x14, 0x8e, 0x59), TABLE_WORD(0x13, 0x3c, 0x89, 0xeb),
+    TABLE_WORD(0xa9, 0x27, 0xee, 0xce), TABLE_WORD(0x61, 0xc9, 0x35, 0xb7),
+    TABLE_WORD(0x1c, 0xe5, 0xed, 0xe1), TABLE_WORD(0x47, 0xb1, 0x3c, 0x7a),
+    TABLE_WORD(0xd2, 0xdf, 0x59, 0x9c), TABLE_WORD(0xf2, 0x73, 0x3f, 0x55),
+    TABLE_WORD(0x14, 0xce, 0x79, 0x18), TABLE_WORD(0xc7, 0x37, 0xbf, 0x73),
+    TABLE_WORD(0xf7, 0xcd, 0xea, 0x53), TABLE_WORD(0xfd, 0xaa, 0x5b, 0x5f),
+    TABLE_WORD(0x3d, 0x6f, 0x14, 0xdf), TABLE_WORD(0x44, 0xdb, 0x86, 0x78),
+    TABLE_WORD(0xaf, 0xf3, 0x81, 0xca), TABLE_WORD(0x68, 0xc4, 0x3e, 0xb9),
+    TABLE_WORD(0x24, 0x34, 0x2c, 0x38), TABLE_WORD(0xa3, 0x40, 0x5f, 0xc2),
+    TABLE_WORD(0x1d, 0xc3, 0x72, 0x16), TABLE_WORD(0xe2, 0x25, 0x0c, 0xbc),
+    TABLE_WORD(0x3c, 0x49, 0x8b, 0x28), TABLE_WORD(0x0d, 0x95, 0x41, 0xff),
+    TABLE_WORD(0xa8, 0x01, 0x71, 0x39), TABLE_WORD(0x0c, 0xb3, 0xde, 0x08),
+    TABLE_WORD(0xb4, 0xe4, 0x9c, 0xd8), TABLE_WORD(0x56, 0xc1, 0x90, 0x64),
+    TABLE_WORD(0xcb, 0x84, 0x61, 0x7b), TABLE_WORD(0x32, 0xb6, 0x70, 0xd5),
+    TABLE_WORD(0x6c, 0x5c, 0x74, 0x48), TABLE_WORD(0xb8, 0x57, 0x42, 0xd0),
+};
+
+# endif
+
+#endif
+
+#ifdef AES_SBOXWORDS
+
+const uint32_t S_fwd_words[256] TABLE_ALIGN = {
+    0x63636363, 0x7c7c7c7c, 0x77777777, 0x7b7b7b7b, 0xf2f2f2f2, 0x6b6b6b6b, 0x6f6f6f6f, 0xc5c5c5c5,
+    0x30303030, 0x01010101, 0x67676767, 0x2b2b2b2b, 0xfefefefe, 0xd7d7d7d7, 0xabababab, 0x76767676,
+    0xcacacaca, 0x82828282, 0xc9c9c9c9, 0x7d7d7d7d, 0xfafafafa, 0x59595959, 0x47474747, 0xf0f0f0f0,
+    0xadadadad, 0xd4d4d4d4, 0xa2a2a2a2, 0xafafafaf, 0x9c9c9c9c, 0xa4a4a4a4, 0x72727272, 0xc0c0c0c0,
+    0xb7b7b7b7, 0xfdfdfdfd, 0x93939393, 0x26262626, 0x36363636, 0x3f3f3f3f, 0xf7f7f7f7, 0xcccccccc,
+    0x34343434, 0xa5a5a5a5, 0xe5e5e5e5, 0xf1f1f1f1, 0x71717171, 0xd8d8d8d8, 0x31313131, 0x15151515,
+    0x04040404, 0xc7c7c7c7, 0x23232323, 0xc3c3c3c3, 0x18181818, 0x96969696, 0x05050505, 0x9a9a9a9a,
+    0x07070707, 0x12121212, 0x80808080, 0xe2e2e2e2, 0xebebebeb, 0x27272727, 0xb2b2b2b2, 0x75757575,
+    0x09090909, 0x83838383, 0x2c2c2c2c, 0x1a1a1a1a, 0x1b1b1b1b, 0x6e6e6e6e, 0x5a5a5a5a, 0xa0a0a0a0,
+    0x52525252, 0x3b3b3b3b, 0xd6d6d6d6, 0xb3b3b3b3, 0x29292929, 0xe3e3e3e3, 0x2f2f2f2f, 0x84848484,
+    0x53535353, 0xd1d1d1d1, 0x00000000, 0xedededed, 0x20202020, 0xfcfcfcfc, 0xb1b1b1b1, 0x5b5b5b5b,
+    0x6a6a6a6a, 0xcbcbcbcb, 0xbebebebe, 0x39393939, 0x4a4a4a4a, 0x4c4c4c4c, 0x58585858, 0xcfcfcfcf,
+    0xd0d0d0d0, 0xefefefef, 0xaaaaaaaa, 0xfbfbfbfb, 0x43434343, 0x4d4d4d4d, 0x33333333, 0x85858585,
+    0x45454545, 0xf9f9f9f9, 0x02020202, 0x7f7f7f7f, 0x50505050, 0x3c3c3c3c, 0x9f9f9f9f, 0xa8a8a8a8,
+    0x51515151, 0xa3a3a3a3, 0x40404040, 0x8f8f8f8f, 0x92929292, 0x9d9d9d9d, 0x38383838, 0xf5f5f5f5,
+    0xbcbcbcbc, 0xb6b6b6b6, 0xdadadada, 0x21212121, 0x10101010, 0xffffffff, 0xf3f3f3f3, 0xd2d2d2d2,
+    0xcdcdcdcd, 0x0c0c0c0c, 0x13131313, 0xecececec, 0x5f5f5f5f, 0x97979797, 0x44444444, 0x17171717,
+    0xc4c4c4c4, 0xa7a7a7a7, 0x7e7e7e7e, 0x3d3d3d3d, 0x64646464, 0x5d5d5d5d, 0x19191919, 0x73737373,
+    0x60606060, 0x81818181, 0x4f4f4f4f, 0xdcdcdcdc, 0x22222222, 0x2a2a2a2a, 0x90909090, 0x88888888,
+    0x46464646, 0xeeeeeeee, 0xb8b8b8b8, 0x14141414, 0xdededede, 0x5e5e5e5e, 0x0b0b0b0b, 0xdbdbdbdb,
+    0xe0e0e0e0, 0x32323232, 0x3a3a3a3a, 0x0a0a0a0a, 0x49494949, 0x06060606, 0x24242424, 0x5c5c5c5c,
+    0xc2c2c2c2, 0xd3d3d3d3, 0xacacacac, 0x62626262, 0x91919191, 0x95959595, 0xe4e4e4e4, 0x79797979,
+    0xe7e7e7e7, 0xc8c8c8c8, 0x37373737, 0x6d6d6d6d, 0x8d8d8d8d, 0xd5d5d5d5, 0x4e4e4e4e, 0xa9a9a9a9,
+    0x6c6c6c6c, 0x56565656, 0xf4f4f4f4, 0xeaeaeaea, 0x65656565, 0x7a7a7a7a, 0xaeaeaeae, 0x08080808,
+    0xbabababa, 0x78787878, 0x25252525, 0x2e2e2e2e, 0x1c1c1c1c, 0xa6a6a6a6, 0xb4b4b4b4, 0xc6c6c6c6,
+    0xe8e8e8e8, 0xdddddddd, 0x74747474, 0x1f1f1f1f, 0x4b4b4b4b, 0xbdbdbdbd, 0x8b8b8b8b, 0x8a8a8a8a,
+    0x70707070, 0x3e3e3e3e, 0xb5b5b5b5, 0x66666666, 0x48484848, 0x03030303, 0xf6f6f6f6, 0x0e0e0e0e,
+    0x61616161, 0x35353535, 0x57575757, 0xb9b9b9b9, 0x86868686, 0xc1c1c1c1, 0x1d1d1d1d, 0x9e9e9e9e,
+    0xe1e1e1e1, 0xf8f8f8f8, 0x98989898, 0x11111111, 0x69696969, 0xd9d9d9d9, 0x8e8e8e8e, 0x94949494,
+    0x9b9b9b9b, 0x1e1e1e1e, 0x87878787, 0xe9e9e9e9, 0xcececece, 0x55555555, 0x28282828, 0xdfdfdfdf,
+    0x8c8c8c8c, 0xa1a1a1a1, 0x89898989, 0x0d0d0d0d, 0xbfbfbfbf, 0xe6e6e6e6, 0x42424242, 0x68686868,
+    0x41414141, 0x99999999, 0x2d2d2d2d, 0x0f0f0f0f, 0xb0b0b0b0, 0x54545454, 0xbbbbbbbb, 0x16161616,
+};
+
+const uint32_t S_inv_words[256] TABLE_ALIGN = {
+    0x52525252, 0x09090909, 0x6a6a6a6a, 0xd5d5d5d5, 0x30303030, 0x36363636, 0xa5a5a5a5, 0x38383838,
+    0xbfbfbfbf, 0x40404040, 0xa3a3a3a3, 0x9e9e9e9e, 0x81818181, 0xf3f3f3f3, 0xd7d7d7d7, 0xfbfbfbfb,
+    0x7c7c7c7c, 0xe3e3e3e3, 0x39393939, 0x82828282, 0x9b9b9b9b, 0x2f2f2f2f, 0xffffffff, 0x87878787,
+    0x34343434, 0x8e8e8e8e, 0x43434343, 0x44444444, 0xc4c4c4c4, 0xdededede, 0xe9e9e9e9, 0xcbcbcbcb,
+    0x54545454, 0x7b7b7b7b, 0x94949494, 0x32323232, 0xa6a6a6a6, 0xc2c2c2c2, 0x23232323, 0x3d3d3d3d,
+    0xeeeeeeee, 0x4c4c4c4c, 0x95959595, 0x0b0b0b0b, 0x42424242, 0xfafafafa, 0xc3c3c3c3, 0x4e4e4e4e,
+    0x08080808, 0x2e2e2e2e, 0xa1a1a1a1, 0x66666666, 0x28282828, 0xd9d9d9d9, 0x24242424, 0xb2b2b2b2,
+    0x76767676, 0x5b5b5b5b, 0xa2a2a2a2, 0x49494949, 0x6d6d6d6d, 0x8b8b8b8b, 0xd1d1d1d1, 0x25252525,
+    0x72727272, 0xf8f8f8f8, 0xf6f6f6f6, 0x64646464, 0x86868686, 0x68686868, 0x98989898, 0x16161616,
+    0xd4d4d4d4, 0xa4a4a4a4, 0x5c5c5c5c, 0xcccccccc, 0x5d5d5d5d, 0x65656565, 0xb6b6b6b6, 0x92929292,
+    0x6c6c6c6c, 0x70707070, 0x48484848, 0x50505050, 0xfdfdfdfd, 0xedededed, 0xb9b9b9b9, 0xdadadada,
+    0x5e5e5e5e, 0x15151515, 0x46464646, 0x57575757, 0xa7a7a7a7, 0x8d8d8d8d, 0x9d9d9d9d, 0x84848484,
+    0x90909090, 0xd8d8d8d8, 0xabababab, 0x00000000, 0x8c8c8c8c, 0xbcbcbcbc, 0xd3d3d3d3, 0x0a0a0a0a,
+    0xf7f7f7f7, 0xe4e4e4e4, 0x58585858, 0x05050505, 0xb8b8b8b8, 0xb3b3b3b3, 0x45454545, 0x06060606,
+    0xd0d0d0d0, 0x2c2c2c2c, 0x1e1e1e1e, 0x8f8f8f8f, 0xcacacaca, 0x3f3f3f3f, 0x0f0f0f0f, 0x02020202,
+    0xc1c1c1c1, 0xafafafaf, 0xbdbdbdbd, 0x03030303, 0x01010101, 0x13131313, 0x8a8a8a8a, 0x6b6b6b6b,
+    0x3a3a3a3a, 0x91919191, 0x11111111, 0x41414141, 0x4f4f4f4f, 0x67676767, 0xdcdcdcdc, 0xeaeaeaea,
+    0x97979797, 0xf2f2f2f2, 0xcfcfcfcf, 0xcececece, 0xf0f0f0f0, 0xb4b4b4b4, 0xe6e6e6e6, 0x73737373,
+    0x96969696, 0xacacacac, 0x74747474, 0x22222222, 0xe7e7e7e7, 0xadadadad, 0x35353535, 0x85858585,
+    0xe2e2e2e2, 0xf9f9f9f9, 0x37373737, 0xe8e8e8e8, 0x1c1c1c1c, 0x75757575, 0xdfdfdfdf, 0x6e6e6e6e,
+    0x47474747, 0xf1f1f1f1, 0x1a1a1a1a, 0x71717171, 0x1d1d1d1d, 0x29292929, 0xc5c5c5c5, 0x89898989,
+    0x6f6f6f6f, 0xb7b7b7b7, 0x62626262, 0x0e0e0e0e, 0xaaaaaaaa, 0x18181818, 0xbebebebe, 0x1b1b1b1b,
+    0xfcfcfcfc, 0x56565656, 0x3e3e3e3e, 0x4b4b4b4b, 0xc6c6c6c6, 0xd2d2d2d2, 0x79797979, 0x20202020,
+    0x9a9a9a9a, 0xdbdbdbdb, 0xc0c0c0c0, 0xfefefefe, 0x78787878, 0xcdcdcdcd, 0x5a5a5a5a, 0xf4f4f4f4,
+    0x1f1f1f1f, 0xdddddddd, 0xa8a8a8a8, 0x33333333, 0x88888888, 0x07070707, 0xc7c7c7c7, 0x31313131,
+    0xb1b1b1b1, 0x12121212, 0x10101010, 0x59595959, 0x27272727, 0x80808080, 0xecececec, 0x5f5f5f5f,
+    0x60606060, 0x51515151, 0x7f7f7f7f, 0xa9a9a9a9, 0x19191919, 0xb5b5b5b5, 0x4a4a4a4a, 0x0d0d0d0d,
+    0x2d2d2d2d, 0xe5e5e5e5, 0x7a7a7a7a, 0x9f9f9f9f, 0x93939393, 0xc9c9c9c9, 0x9c9c9c9c, 0xefefefef,
+    0xa0a0a0a0, 0xe0e0e0e0, 0x3b3b3b3b, 0x4d4d4d4d, 0xaeaeaeae, 0x2a2a2a2a, 0xf5f5f5f5, 0xb0b0b0b0,
+    0xc8c8c8c8, 0xebebebeb, 0xbbbbbbbb, 0x3c3c3c3c, 0x83838383, 0x53535353, 0x99999999, 0x61616161,
+    0x17171717, 0x2b2b2b2b, 0x04040404, 0x7e7e7e7e, 0xbabababa, 0x77777777, 0xd6d6d6d6, 0x26262626,
+    0xe1e1e1e1, 0x69696969, 0x14141414, 0x63636363, 0x55555555, 0x21212121, 0x0c0c0c0c, 0x7d7d7d7d,
+};
+
+#endif
+
 #endif
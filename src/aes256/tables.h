@@ -2,16 +2,94 @@
 #define TABLES_H
 
 #include <stdint.h>
+#include <string.h>
 
-extern const uint8_t T0_fwd[256][4];
-extern const uint8_t T0_inv[256][4];
-#ifndef AES_MONOTABLE
-extern const uint8_t T1_fwd[256][4];
-extern const uint8_t T2_fwd[256][4];
-extern const uint8_t T3_fwd[256][4];
-extern const uint8_t T1_inv[256][4];
-extern const uint8_t T2_inv[256][4];
-extern const uint8_t T3_inv[256][4];
+// With ALIGNED, every table starts on a 64-byte cache line, so a table
+// of n bytes spans exactly n / 64 lines instead of possibly one more
+#ifdef AES_ALIGNED
+# define TABLE_ALIGN __attribute__((aligned(64)))
+#else
+# define TABLE_ALIGN
+#endif
+
+// With LAZYTABLES, tables.c is left out and lazytables.c fills in
+// writable copies of the tables the first time each direction is used,
+// see tables_init_fwd() and tables_init_inv()
+#ifdef AES_LAZYTABLES
+# define TABLE_CONST
+extern void tables_init_fwd(void);
+extern void tables_init_inv(void);
+#else
+# define TABLE_CONST const
+#endif
+
+// For the table and monotable implementations (the latter only uses
+// T0)
+extern TABLE_CONST uint8_t T0_fwd[256][4];
+extern TABLE_CONST uint8_t T0_inv[256][4];
+extern TABLE_CONST uint8_t T1_fwd[256][4];
+extern TABLE_CONST uint8_t T2_fwd[256][4];
+extern TABLE_CONST uint8_t T3_fwd[256][4];
+extern TABLE_CONST uint8_t T1_inv[256][4];
+extern TABLE_CONST uint8_t T2_inv[256][4];
+extern TABLE_CONST uint8_t T3_inv[256][4];
+
+// The word tables below are for the unrolled implementation. They hold
+// the same entries as the byte tables above, laid out so that byte k of
+// an entry sits at byte k of the word in memory. That way a state
+// column loaded straight from memory as a uint32_t can be XORed with
+// table words directly. TABLE_WORD() builds such a word from its bytes,
+// TABLE_BYTE() pulls byte k back out, and TABLE_ROT() moves every byte
+// k places up (wrapping around), which is how we get T1, T2 and T3
+// from T0 with MONOTABLE
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+# define TABLE_WORD(b0, b1, b2, b3) \
+    (((uint32_t)(b0) << 24) | ((uint32_t)(b1) << 16) \
+     | ((uint32_t)(b2) << 8) | (uint32_t)(b3))
+# define TABLE_BYTE(word, k) (((word) >> (24 - 8 * (k))) & 0xff)
+# define TABLE_ROT(word, k) (((word) >> (8 * (k))) | ((word) << (32 - 8 * (k))))
+# define TABLE_MASK(k) ((uint32_t)0xff << (24 - 8 * (k)))
+#else
+# define TABLE_WORD(b0, b1, b2, b3) \
+    (((uint32_t)(b3) << 24) | ((uint32_t)(b2) << 16) \
+     | ((uint32_t)(b1) << 8) | (uint32_t)(b0))
+# define TABLE_BYTE(word, k) (((word) >> (8 * (k))) & 0xff)
+# define TABLE_ROT(word, k) (((word) << (8 * (k))) | ((word) >> (32 - 8 * (k))))
+# define TABLE_MASK(k) ((uint32_t)0xff << (8 * (k)))
+#endif
+
+// DUPTABLE stores each T0 entry twice in a row, so that T1, T2 and T3
+// (T0 rotated by 1, 2 and 3 bytes) are just unaligned reads starting 3,
+// 2 and 1 bytes into the entry. That gives all four tables in 2 KB
+// without any rotates. TABLE_DUP() reads Tn out of such an entry
+#define TABLE_DUP(entry, n) table_dup_word((entry) + (4 - (n)) % 4)
+static inline uint32_t table_dup_word(const uint8_t *bytes) {
+    uint32_t word;
+    memcpy(&word, bytes, sizeof word);
+    return word;
+}
+
+#ifdef AES_DUPTABLE
+extern TABLE_CONST uint8_t T_fwd_dup[256][8];
+extern TABLE_CONST uint8_t T_inv_dup[256][8];
+#else
+extern TABLE_CONST uint32_t T0_fwd_words[256];
+extern TABLE_CONST uint32_t T0_inv_words[256];
+# ifndef AES_MONOTABLE
+extern TABLE_CONST uint32_t T1_fwd_words[256];
+extern TABLE_CONST uint32_t T2_fwd_words[256];
+extern TABLE_CONST uint32_t T3_fwd_words[256];
+extern TABLE_CONST uint32_t T1_inv_words[256];
+extern TABLE_CONST uint32_t T2_inv_words[256];
+extern TABLE_CONST uint32_t T3_inv_words[256];
+# endif
+#endif
+
+// The S-box (or inverse S-box) entry repeated in all four bytes, for
+// the last round, see FWD_LAST_COL() in aes256.c
+#ifdef AES_SBOXWORDS
+extern TABLE_CONST uint32_t S_fwd_words[256];
+extern TABLE_CONST uint32_t S_inv_words[256];
 #endif
 
 #endif
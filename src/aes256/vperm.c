@@ -0,0 +1,569 @@
+#include "aes256.h"
+#include "vperm.h"
+
+#ifdef VPERM_SUPPORTED
+
+#include <immintrin.h>
+
+// Same idea as AESNI_TARGET. Everything here must be reached through
+// vperm_available() first, and the AVX2 functions through have_avx2()
+#define VPERM_TARGET __attribute__((target("ssse3")))
+#define VPERM_AVX2_TARGET __attribute__((target("avx2")))
+
+// Number of registers to interleave, like PAR_BLOCKS. Each holds one
+// block with SSSE3 or two with AVX2
+#define VPERM_PAR 4
+
+// CTR and CBC decryption work through their input in chunks of this
+// many blocks, see vperm_ctr()
+#define VPERM_CHUNK 64
+
+// SubBytes computed with vector permutes (PSHUFB) instead of table
+// lookups indexed by secret bytes, after Hamburg's "Accelerating AES
+// with Vector Permute Instructions" (CHES 2009). PSHUFB looks up every
+// byte of a register in a 16-byte table held in another register at
+// once, so the tables are indexed by nibbles and never touch memory.
+//
+// We view GF(2^8) as GF(2^4)[t]/(t^2 + t + 1/c), where GF(2^4) is
+// GF(2)[y]/(y^4 + y + 1) and c = {2}, and write a byte x as u.t + k.
+// Its nibbles are then taken to be i = u/c (high) and k (low). With
+// j = i + k, the two GF(2^4) values
+//
+//     io = 1/(1/i + c/k) + j    jo = 1/(1/j + c/k) + i
+//
+// determine 1/x: 1/io is its constant coefficient and 1/jo a linear
+// combination of both coefficients. Each division is a PSHUFB, so the
+// whole inversion takes six. in_lo and in_hi take each nibble of a
+// byte into this representation (and undo the affine transformation
+// for the inverse S-box), and out_io and out_jo map io and jo back to
+// the output byte. 1/0 is 0x80 in gf16_inv and gf16_c_div, which PSHUFB
+// looks up as zero. That covers every case where i, j or k is zero,
+// except that the forward S-box still needs its constant {63} XORed in
+// separately
+typedef struct {
+    uint8_t in_lo[16];
+    uint8_t in_hi[16];
+    uint8_t out_io[16];
+    uint8_t out_jo[16];
+    uint8_t out_const;
+} vperm_sbox_t;
+
+static const uint8_t gf16_inv[16] = {
+    0x80, 0x01, 0x09, 0x0e, 0x0d, 0x0b, 0x07, 0x06,
+    0x0f, 0x02, 0x0c, 0x05, 0x0a, 0x04, 0x03, 0x08,
+};
+
+static const uint8_t gf16_c_div[16] = {
+    0x80, 0x02, 0x01, 0x0f, 0x09, 0x05, 0x0e, 0x0c,
+    0x0d, 0x04, 0x0b, 0x0a, 0x07, 0x08, 0x06, 0x03,
+};
+
+static const vperm_sbox_t fwd_sbox = {
+    .in_lo = {
+        0x00, 0x01, 0x1c, 0x1d, 0x2d, 0x2c, 0x31, 0x30,
+        0x27, 0x26, 0x3b, 0x3a, 0x0a, 0x0b, 0x16, 0x17,
+    },
+    .in_hi = {
+        0x00, 0x86, 0xfd, 0x7b, 0x8e, 0x08, 0x73, 0xf5,
+        0x77, 0xf1, 0x8a, 0x0c, 0xf9, 0x7f, 0x04, 0x82,
+    },
+    .out_io = {
+        0x00, 0xcb, 0xd7, 0xb0, 0x21, 0x8d, 0x67, 0xac,
+        0x7b, 0x5a, 0xea, 0x3d, 0x46, 0xf6, 0x91, 0x1c,
+    },
+    .out_jo = {
+        0x00, 0x9f, 0x61, 0x16, 0xc2, 0x2a, 0x77, 0xe8,
+        0x89, 0x4b, 0x5d, 0x3c, 0xb5, 0xa3, 0xd4, 0xfe,
+    },
+    .out_const = 0x63,
+};
+
+static const vperm_sbox_t inv_sbox = {
+    .in_lo = {
+        0x2c, 0x99, 0xf0, 0x45, 0xf7, 0x42, 0x2b, 0x9e,
+        0x38, 0x8d, 0xe4, 0x51, 0xe3, 0x56, 0x3f, 0x8a,
+    },
+    .in_hi = {
+        0x00, 0xa7, 0xa8, 0x0f, 0xed, 0x4a, 0x45, 0xe2,
+        0xd1, 0x76, 0x79, 0xde, 0x3c, 0x9b, 0x94, 0x33,
+    },
+    .out_io = {
+        0x00, 0x3b, 0xe4, 0xc8, 0x03, 0x14, 0x2c, 0x17,
+        0xf3, 0xf0, 0x38, 0xdc, 0x2f, 0xe7, 0xcb, 0xdf,
+    },
+    .out_jo = {
+        0x00, 0x24, 0x91, 0x19, 0x23, 0x8f, 0x88, 0xac,
+        0x3d, 0x1e, 0x07, 0x96, 0xab, 0xb2, 0x3a, 0xb5,
+    },
+    .out_const = 0x00,
+};
+
+// PSHUFB masks for ShiftRows, InvShiftRows, and rotating every column
+// up by one or two rows (byte 4c + r is row r of column c)
+static const uint8_t shift_rows_mask[16] = {
+    0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12, 1, 6, 11,
+};
+static const uint8_t inv_shift_rows_mask[16] = {
+    0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3,
+};
+static const uint8_t rot1_mask[16] = {
+    1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+};
+static const uint8_t rot2_mask[16] = {
+    2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+};
+
+static int have_avx2(void);
+VPERM_TARGET static void cipher_blocks(const uint8_t *, uint8_t *, const uint32_t *,
+                                       int, int);
+VPERM_AVX2_TARGET static int cipher_blocks_avx2(const uint8_t *, uint8_t *,
+                                                const uint32_t *, int, int);
+VPERM_TARGET static void cipher(__m128i *, int, const __m128i *);
+VPERM_TARGET static void inv_cipher(__m128i *, int, const __m128i *);
+VPERM_AVX2_TARGET static void cipher_avx2(__m256i *, int, const __m256i *);
+VPERM_AVX2_TARGET static void inv_cipher_avx2(__m256i *, int, const __m256i *);
+VPERM_TARGET static inline __m128i load_table(const uint8_t *);
+VPERM_TARGET static inline uint32_t sub_word(uint32_t);
+VPERM_TARGET static inline __m128i sub_bytes(__m128i, const vperm_sbox_t *);
+VPERM_TARGET static inline __m128i mix_columns(__m128i);
+VPERM_TARGET static inline __m128i inv_mix_columns(__m128i);
+VPERM_TARGET static inline __m128i xtime(__m128i);
+VPERM_AVX2_TARGET static inline __m256i load_table_avx2(const uint8_t *);
+VPERM_AVX2_TARGET static inline __m256i sub_bytes_avx2(__m256i, const vperm_sbox_t *);
+VPERM_AVX2_TARGET static inline __m256i mix_columns_avx2(__m256i);
+VPERM_AVX2_TARGET static inline __m256i inv_mix_columns_avx2(__m256i);
+VPERM_AVX2_TARGET static inline __m256i xtime_avx2(__m256i);
+VPERM_TARGET static inline void load_round_keys(const uint32_t *, __m128i *);
+VPERM_TARGET static inline __m128i ctr_block(uint64_t, uint64_t);
+
+// Unlike AES-NI, we always want this when we can have it: the PSHUFB
+// S-box beats T-table lookups on everything with SSSE3 we have tried,
+// and takes the same time regardless of what is in the cache
+int vperm_available(void) {
+    // -1 means we have not asked yet
+    static int available = -1;
+
+    if (available < 0) {
+        // Unlike CPUID alone, this also checks that the OS saves the
+        // registers we need, which matters for AVX2
+        __builtin_cpu_init();
+        available = __builtin_cpu_supports("ssse3");
+    }
+
+    return available;
+}
+
+static int have_avx2(void) {
+    static int available = -1;
+
+    if (available < 0) {
+        __builtin_cpu_init();
+        available = __builtin_cpu_supports("avx2");
+    }
+
+    return available;
+}
+
+VPERM_TARGET
+void vperm_enc_ecb(const uint8_t *in, const uint32_t *key_sched, uint8_t *out, int nblocks) {
+    cipher_blocks(in, out, key_sched, nblocks, 0);
+}
+
+VPERM_TARGET
+void vperm_dec_ecb(const uint8_t *in, const uint32_t *key_sched, uint8_t *out, int nblocks) {
+    cipher_blocks(in, out, key_sched, nblocks, 1);
+}
+
+// Serial, so one block at a time with SSSE3 no matter what
+VPERM_TARGET
+void vperm_enc_cbc(const uint8_t *iv, const uint8_t *in, const uint32_t *key_sched,
+                   uint8_t *out, int nblocks) {
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    __m128i state = _mm_loadu_si128((const __m128i *)iv);
+
+    for (int b = 0; b < nblocks; b++) {
+        state = _mm_xor_si128(state, _mm_loadu_si128(in_blocks + b));
+        cipher(&state, 1, round_keys);
+        _mm_storeu_si128(out_blocks + b, state);
+    }
+}
+
+VPERM_TARGET
+void vperm_dec_cbc(const uint8_t *iv, const uint8_t *in, const uint32_t *key_sched,
+                   uint8_t *out, int nblocks) {
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+    __m128i next_iv = _mm_loadu_si128((const __m128i *)iv);
+
+    // Decrypt a chunk at a time with cipher_blocks(), then do the CBC
+    // XORs with the ciphertext blocks that went in
+    for (int b = 0; b < nblocks; b += VPERM_CHUNK) {
+        int chunk = nblocks - b < VPERM_CHUNK? nblocks - b : VPERM_CHUNK;
+        __m128i buf[VPERM_CHUNK];
+
+        cipher_blocks(in + (size_t)b * BLOCK_SIZE, (uint8_t *)buf, key_sched, chunk, 1);
+
+        for (int i = 0; i < chunk; i++) {
+            __m128i ciphertext = _mm_loadu_si128(in_blocks + b + i);
+            _mm_storeu_si128(out_blocks + b + i, _mm_xor_si128(buf[i], next_iv));
+            next_iv = ciphertext;
+        }
+    }
+}
+
+VPERM_TARGET
+void vperm_ctr(const uint8_t *init_ctr, const uint8_t *in, const uint32_t *key_sched,
+               uint8_t *out, int nblocks) {
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+
+    // Same counter handling as aesni_ctr()
+    uint64_t ctr_hi = 0, ctr_lo = 0;
+    for (int i = 0; i < 8; i++) {
+        ctr_hi = (ctr_hi << 8) | init_ctr[i];
+        ctr_lo = (ctr_lo << 8) | init_ctr[8 + i];
+    }
+
+    // Lay out a chunk of counter blocks so that cipher_blocks() can
+    // encrypt them with as much parallelism as it has
+    for (int b = 0; b < nblocks; b += VPERM_CHUNK) {
+        int chunk = nblocks - b < VPERM_CHUNK? nblocks - b : VPERM_CHUNK;
+        __m128i keystream[VPERM_CHUNK];
+
+        for (int i = 0; i < chunk; i++) {
+            keystream[i] = ctr_block(ctr_hi, ctr_lo);
+            ctr_hi += !++ctr_lo;
+        }
+
+        cipher_blocks((uint8_t *)keystream, (uint8_t *)keystream, key_sched, chunk, 0);
+
+        for (int i = 0; i < chunk; i++) {
+            _mm_storeu_si128(out_blocks + b + i,
+                             _mm_xor_si128(keystream[i], _mm_loadu_si128(in_blocks + b + i)));
+        }
+    }
+}
+
+// Same schedule and layout as aes256_key_exp() and aesni_key_exp(), but
+// with SubWord and InvMixColumns done the same way as in the cipher, so
+// that the key never indexes a table either
+VPERM_TARGET
+void vperm_key_exp(const uint8_t *key, uint32_t *key_sched, int inv_mix_cols) {
+    // x86 is little endian, so byte 0 of a word is its low byte
+    static const uint32_t rcon[] = {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40};
+    const uint32_t *key_words = (const uint32_t *)key;
+    int i;
+
+    for (i = 0; i < Nk; i++) {
+        key_sched[i] = key_words[i];
+    }
+
+    for (; i < Nb * (Nr + 1); i++) {
+        uint32_t temp = key_sched[i - 1];
+        if (!(i % Nk)) {
+            // RotWord is a rotation towards byte 0, i.e., a right shift
+            temp = sub_word((temp >> 8) | (temp << 24)) ^ rcon[i / Nk];
+        } else if (i % Nk == 4) {
+            temp = sub_word(temp);
+        }
+        key_sched[i] = key_sched[i - Nk] ^ temp;
+    }
+
+    if (inv_mix_cols) {
+        for (int r = 1; r < Nr; r++) {
+            __m128i *round_key = (__m128i *)(key_sched + (Nb * r));
+            _mm_storeu_si128(round_key, inv_mix_columns(_mm_loadu_si128(round_key)));
+        }
+    }
+}
+
+// Run the (inverse, if inverse is set) cipher on nblocks blocks with
+// AVX2 if we have it, and on whatever it leaves over with SSSE3
+VPERM_TARGET
+static void cipher_blocks(const uint8_t *in, uint8_t *out, const uint32_t *key_sched,
+                          int nblocks, int inverse) {
+    int b = have_avx2()? cipher_blocks_avx2(in, out, key_sched, nblocks, inverse) : 0;
+    if (b == nblocks) {
+        return;
+    }
+
+    __m128i round_keys[Nr + 1];
+    load_round_keys(key_sched, round_keys);
+
+    const __m128i *in_blocks = (const __m128i *)in;
+    __m128i *out_blocks = (__m128i *)out;
+
+    for (; b < nblocks; b += VPERM_PAR) {
+        int n = nblocks - b < VPERM_PAR? nblocks - b : VPERM_PAR;
+        __m128i state[VPERM_PAR];
+
+        for (int i = 0; i < n; i++) {
+            state[i] = _mm_loadu_si128(in_blocks + b + i);
+        }
+        if (inverse) {
+            inv_cipher(state, n, round_keys);
+        } else {
+            cipher(state, n, round_keys);
+        }
+        for (int i = 0; i < n; i++) {
+            _mm_storeu_si128(out_blocks + b + i, state[i]);
+        }
+    }
+}
+
+// Handle as many pairs of blocks as possible for cipher_blocks(), with
+// one pair per AVX2 register, and return how many blocks that was
+VPERM_AVX2_TARGET
+static int cipher_blocks_avx2(const uint8_t *in, uint8_t *out, const uint32_t *key_sched,
+                              int nblocks, int inverse) {
+    __m256i round_keys[Nr + 1];
+    for (int r = 0; r <= Nr; r++) {
+        round_keys[r] = load_table_avx2((const uint8_t *)(key_sched + (Nb * r)));
+    }
+
+    const __m256i *in_pairs = (const __m256i *)in;
+    __m256i *out_pairs = (__m256i *)out;
+    int npairs = nblocks / 2;
+
+    for (int p = 0; p < npairs; p += VPERM_PAR) {
+        int n = npairs - p < VPERM_PAR? npairs - p : VPERM_PAR;
+        __m256i state[VPERM_PAR];
+
+        for (int i = 0; i < n; i++) {
+            state[i] = _mm256_loadu_si256(in_pairs + p + i);
+        }
+        if (inverse) {
+            inv_cipher_avx2(state, n, round_keys);
+        } else {
+            cipher_avx2(state, n, round_keys);
+        }
+        for (int i = 0; i < n; i++) {
+            _mm256_storeu_si256(out_pairs + p + i, state[i]);
+        }
+    }
+
+    return 2 * npairs;
+}
+
+// n (at most VPERM_PAR) blocks at once, one round at a time like
+// rounds_enc_ecb() in aes256.c. ShiftRows goes first since it commutes
+// with SubBytes, and the shuffle is cheaper on the way in
+VPERM_TARGET
+static void cipher(__m128i *state, int n, const __m128i *round_keys) {
+    const __m128i shift_rows = load_table(shift_rows_mask);
+
+    for (int i = 0; i < n; i++) {
+        state[i] = _mm_xor_si128(state[i], round_keys[0]);
+    }
+
+    for (int round = 1; round <= Nr; round++) {
+        for (int i = 0; i < n; i++) {
+            state[i] = sub_bytes(_mm_shuffle_epi8(state[i], shift_rows), &fwd_sbox);
+            if (round < Nr) {
+                state[i] = mix_columns(state[i]);
+            }
+            state[i] = _mm_xor_si128(state[i], round_keys[round]);
+        }
+    }
+}
+
+// Equivalent inverse cipher, see aes256_inv_cipher()
+VPERM_TARGET
+static void inv_cipher(__m128i *state, int n, const __m128i *round_keys) {
+    const __m128i inv_shift_rows = load_table(inv_shift_rows_mask);
+
+    for (int i = 0; i < n; i++) {
+        state[i] = _mm_xor_si128(state[i], round_keys[Nr]);
+    }
+
+    for (int round = Nr - 1; round >= 0; round--) {
+        for (int i = 0; i < n; i++) {
+            state[i] = sub_bytes(_mm_shuffle_epi8(state[i], inv_shift_rows), &inv_sbox);
+            if (round > 0) {
+                state[i] = inv_mix_columns(state[i]);
+            }
+            state[i] = _mm_xor_si128(state[i], round_keys[round]);
+        }
+    }
+}
+
+// cipher() with two blocks in every register. VPSHUFB shuffles each
+// 128-bit half separately, so the same masks and tables work on both
+VPERM_AVX2_TARGET
+static void cipher_avx2(__m256i *state, int n, const __m256i *round_keys) {
+    const __m256i shift_rows = load_table_avx2(shift_rows_mask);
+
+    for (int i = 0; i < n; i++) {
+        state[i] = _mm256_xor_si256(state[i], round_keys[0]);
+    }
+
+    for (int round = 1; round <= Nr; round++) {
+        for (int i = 0; i < n; i++) {
+            state[i] = sub_bytes_avx2(_mm256_shuffle_epi8(state[i], shift_rows), &fwd_sbox);
+            if (round < Nr) {
+                state[i] = mix_columns_avx2(state[i]);
+            }
+            state[i] = _mm256_xor_si256(state[i], round_keys[round]);
+        }
+    }
+}
+
+VPERM_AVX2_TARGET
+static void inv_cipher_avx2(__m256i *state, int n, const __m256i *round_keys) {
+    const __m256i inv_shift_rows = load_table_avx2(inv_shift_rows_mask);
+
+    for (int i = 0; i < n; i++) {
+        state[i] = _mm256_xor_si256(state[i], round_keys[Nr]);
+    }
+
+    for (int round = Nr - 1; round >= 0; round--) {
+        for (int i = 0; i < n; i++) {
+            state[i] = sub_bytes_avx2(_mm256_shuffle_epi8(state[i], inv_shift_rows),
+                                      &inv_sbox);
+            if (round > 0) {
+                state[i] = inv_mix_columns_avx2(state[i]);
+            }
+            state[i] = _mm256_xor_si256(state[i], round_keys[round]);
+        }
+    }
+}
+
+VPERM_TARGET
+static inline __m128i load_table(const uint8_t *table) {
+    return _mm_loadu_si128((const __m128i *)table);
+}
+
+// See vperm_sbox_t for what is going on here
+VPERM_TARGET
+static inline __m128i sub_bytes(__m128i x, const vperm_sbox_t *sbox) {
+    const __m128i lo_nibbles = _mm_set1_epi8(0x0f);
+    const __m128i inv = load_table(gf16_inv);
+    const __m128i c_div = load_table(gf16_c_div);
+
+    x = _mm_xor_si128(
+        _mm_shuffle_epi8(load_table(sbox->in_lo), _mm_and_si128(x, lo_nibbles)),
+        _mm_shuffle_epi8(load_table(sbox->in_hi),
+                         _mm_and_si128(_mm_srli_epi16(x, 4), lo_nibbles)));
+
+    __m128i k = _mm_and_si128(x, lo_nibbles);
+    __m128i i = _mm_and_si128(_mm_srli_epi16(x, 4), lo_nibbles);
+    __m128i j = _mm_xor_si128(i, k);
+    __m128i c_div_k = _mm_shuffle_epi8(c_div, k);
+    __m128i io = _mm_xor_si128(
+        _mm_shuffle_epi8(inv, _mm_xor_si128(_mm_shuffle_epi8(inv, i), c_div_k)), j);
+    __m128i jo = _mm_xor_si128(
+        _mm_shuffle_epi8(inv, _mm_xor_si128(_mm_shuffle_epi8(inv, j), c_div_k)), i);
+
+    return _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(load_table(sbox->out_io), io),
+                                       _mm_shuffle_epi8(load_table(sbox->out_jo), jo)),
+                         _mm_set1_epi8((char)sbox->out_const));
+}
+
+VPERM_TARGET
+static inline uint32_t sub_word(uint32_t word) {
+    return (uint32_t)_mm_cvtsi128_si32(sub_bytes(_mm_cvtsi32_si128((int)word), &fwd_sbox));
+}
+
+// {02}.a_r ^ {03}.a_{r+1} ^ a_{r+2} ^ a_{r+3}
+//     = {02}.(a_r ^ a_{r+1}) ^ a_{r+1} ^ a_{r+2} ^ a_{r+3}
+VPERM_TARGET
+static inline __m128i mix_columns(__m128i x) {
+    __m128i rot1 = _mm_shuffle_epi8(x, load_table(rot1_mask));
+    __m128i rot2 = _mm_shuffle_epi8(x, load_table(rot2_mask));
+    __m128i rot3 = _mm_shuffle_epi8(rot2, load_table(rot1_mask));
+
+    return _mm_xor_si128(_mm_xor_si128(xtime(_mm_xor_si128(x, rot1)), rot1),
+                         _mm_xor_si128(rot2, rot3));
+}
+
+// Same trick as the bitsliced inv_mix_columns(): XOR {04}.(a_r ^ a_{r+2})
+// into every a_r and finish with MixColumns
+VPERM_TARGET
+static inline __m128i inv_mix_columns(__m128i x) {
+    __m128i rot2 = _mm_shuffle_epi8(x, load_table(rot2_mask));
+    return mix_columns(_mm_xor_si128(x, xtime(xtime(_mm_xor_si128(x, rot2)))));
+}
+
+// Double every byte and reduce the ones whose top bit fell off
+VPERM_TARGET
+static inline __m128i xtime(__m128i x) {
+    __m128i overflow = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+    return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(overflow, _mm_set1_epi8(0x1b)));
+}
+
+// The AVX2 versions below are the same as the ones above, with the
+// 16-byte tables copied into both halves of the register
+
+VPERM_AVX2_TARGET
+static inline __m256i load_table_avx2(const uint8_t *table) {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)table));
+}
+
+VPERM_AVX2_TARGET
+static inline __m256i sub_bytes_avx2(__m256i x, const vperm_sbox_t *sbox) {
+    const __m256i lo_nibbles = _mm256_set1_epi8(0x0f);
+    const __m256i inv = load_table_avx2(gf16_inv);
+    const __m256i c_div = load_table_avx2(gf16_c_div);
+
+    x = _mm256_xor_si256(
+        _mm256_shuffle_epi8(load_table_avx2(sbox->in_lo), _mm256_and_si256(x, lo_nibbles)),
+        _mm256_shuffle_epi8(load_table_avx2(sbox->in_hi),
+                            _mm256_and_si256(_mm256_srli_epi16(x, 4), lo_nibbles)));
+
+    __m256i k = _mm256_and_si256(x, lo_nibbles);
+    __m256i i = _mm256_and_si256(_mm256_srli_epi16(x, 4), lo_nibbles);
+    __m256i j = _mm256_xor_si256(i, k);
+    __m256i c_div_k = _mm256_shuffle_epi8(c_div, k);
+    __m256i io = _mm256_xor_si256(
+        _mm256_shuffle_epi8(inv, _mm256_xor_si256(_mm256_shuffle_epi8(inv, i), c_div_k)), j);
+    __m256i jo = _mm256_xor_si256(
+        _mm256_shuffle_epi8(inv, _mm256_xor_si256(_mm256_shuffle_epi8(inv, j), c_div_k)), i);
+
+    return _mm256_xor_si256(
+        _mm256_xor_si256(_mm256_shuffle_epi8(load_table_avx2(sbox->out_io), io),
+                         _mm256_shuffle_epi8(load_table_avx2(sbox->out_jo), jo)),
+        _mm256_set1_epi8((char)sbox->out_const));
+}
+
+VPERM_AVX2_TARGET
+static inline __m256i mix_columns_avx2(__m256i x) {
+    __m256i rot1 = _mm256_shuffle_epi8(x, load_table_avx2(rot1_mask));
+    __m256i rot2 = _mm256_shuffle_epi8(x, load_table_avx2(rot2_mask));
+    __m256i rot3 = _mm256_shuffle_epi8(rot2, load_table_avx2(rot1_mask));
+
+    return _mm256_xor_si256(_mm256_xor_si256(xtime_avx2(_mm256_xor_si256(x, rot1)), rot1),
+                            _mm256_xor_si256(rot2, rot3));
+}
+
+VPERM_AVX2_TARGET
+static inline __m256i inv_mix_columns_avx2(__m256i x) {
+    __m256i rot2 = _mm256_shuffle_epi8(x, load_table_avx2(rot2_mask));
+    return mix_columns_avx2(_mm256_xor_si256(x, xtime_avx2(xtime_avx2(_mm256_xor_si256(x, rot2)))));
+}
+
+VPERM_AVX2_TARGET
+static inline __m256i xtime_avx2(__m256i x) {
+    __m256i overflow = _mm256_cmpgt_epi8(_mm256_setzero_si256(), x);
+    return _mm256_xor_si256(_mm256_add_epi8(x, x),
+                            _mm256_and_si256(overflow, _mm256_set1_epi8(0x1b)));
+}
+
+VPERM_TARGET
+static inline void load_round_keys(const uint32_t *key_sched, __m128i *round_keys) {
+    for (int r = 0; r <= Nr; r++) {
+        round_keys[r] = _mm_loadu_si128((const __m128i *)(key_sched + (Nb * r)));
+    }
+}
+
+// See the aesni.c version
+VPERM_TARGET
+static inline __m128i ctr_block(uint64_t hi, uint64_t lo) {
+    return _mm_set_epi64x((long long)__builtin_bswap64(lo),
+                          (long long)__builtin_bswap64(hi));
+}
+
+#endif
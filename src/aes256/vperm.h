@@ -0,0 +1,23 @@
+#ifndef VPERM_H
+#define VPERM_H
+
+#include <stdint.h>
+
+// Like AES-NI, x86-only and left out elsewhere
+#if defined(__x86_64__) || defined(__i386__)
+#define VPERM_SUPPORTED
+
+extern int vperm_available(void);
+extern void vperm_key_exp(const uint8_t *, uint32_t *, int);
+// Same interface as the aesni_*() modes
+extern void vperm_enc_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+extern void vperm_dec_ecb(const uint8_t *, const uint32_t *, uint8_t *, int);
+extern void vperm_enc_cbc(const uint8_t *, const uint8_t *, const uint32_t *,
+                          uint8_t *, int);
+extern void vperm_dec_cbc(const uint8_t *, const uint8_t *, const uint32_t *,
+                          uint8_t *, int);
+extern void vperm_ctr(const uint8_t *, const uint8_t *, const uint32_t *,
+                      uint8_t *, int);
+#endif
+
+#endif
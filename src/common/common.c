@@ -1,21 +1,48 @@
 #include <stdio.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "common.h"
 
 int read_to_buf(char *path, char **buf_out, int *len_out) {
+    return read_range_to_buf(path, 0, -1, buf_out, len_out);
+}
+
+// Read at most len bytes (or the rest of the file if len is negative)
+// starting offset bytes in, without reading anything before them. A
+// range past the end of the file comes out short or empty
+int read_range_to_buf(char *path, off_t offset, int len, char **buf_out,
+                      int *len_out) {
     FILE *f;
     if (!(f = fopen(path, "r"))) {
         perror("fopen");
         return -1;
     }
 
+    if (offset && fseeko(f, offset, SEEK_SET) < 0) {
+        perror("fseeko");
+        fclose(f);
+        return -1;
+    }
+
     int buf_cap = 0, buf_len = 0;
     char *buf = NULL;
-    int c;
-    errno = 0;
-    while ((c = getc(f)) != EOF) {
+    size_t got;
+    do {
         if (buf_len == buf_cap) {
-            buf_cap = (buf_cap + 1) * 2;
+            if (buf_cap > INT_MAX / 2) {
+                fprintf(stderr, "`%s' is too big\n", path);
+                free(buf);
+                fclose(f);
+                return -1;
+            }
+            buf_cap = buf_cap? buf_cap * 2 : BUFSIZ;
             char *new_buf;
             if (!(new_buf = realloc(buf, buf_cap))) {
                 perror("realloc");
@@ -26,16 +53,26 @@ int read_to_buf(char *path, char **buf_out, int *len_out) {
             buf = new_buf;
         }
 
-        buf[buf_len] = c;
-        buf_len++;
-    }
-    if (errno) {
-        perror("getc");
+        int want = buf_cap - buf_len;
+        if (len >= 0 && want > len - buf_len) {
+            want = len - buf_len;
+        }
+        got = fread(buf + buf_len, 1, want, f);
+        buf_len += got;
+    } while (got && (len < 0 || buf_len < len));
+    if (ferror(f)) {
+        perror("fread");
         free(buf);
         fclose(f);
         return -1;
     }
 
+    // An empty range comes back as NULL, as it always has
+    if (!buf_len) {
+        free(buf);
+        buf = NULL;
+    }
+
     *len_out = buf_len;
     *buf_out = buf;
 
@@ -43,3 +80,235 @@ int read_to_buf(char *path, char **buf_out, int *len_out) {
     return 0;
 }
 
+// Map at most len bytes (or the rest of the file if len is negative)
+// starting offset bytes in, read only, the same way read_range_to_buf()
+// reads them. An empty range has a NULL buf. Only what has to be read
+// into a buffer is limited to what fits in an int
+int map_input(char *path, off_t offset, off_t len, mapped_file_t *file) {
+    memset(file, 0, sizeof *file);
+    file->fd = -1;
+
+    int fd;
+    struct stat st;
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        perror("open");
+        return -1;
+    }
+    if (fstat(fd, &st) < 0) {
+        perror("fstat");
+        close(fd);
+        return -1;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        if (len > INT_MAX) {
+            fprintf(stderr, "`%s' is too big\n", path);
+            return -1;
+        }
+
+        int got;
+        if (read_range_to_buf(path, offset, len, &file->buf, &got) < 0) {
+            return -1;
+        }
+        file->len = got;
+        return 0;
+    }
+    file->mapped = 1;
+
+    off_t avail = offset < st.st_size? st.st_size - offset : 0;
+    if (len < 0 || len > avail) {
+        len = avail;
+    }
+    if ((uint64_t)len > SIZE_MAX) {
+        fprintf(stderr, "`%s' is too big\n", path);
+        close(fd);
+        return -1;
+    }
+    if (!len) {
+        close(fd);
+        return 0;
+    }
+
+    // mmap() only takes offsets on a page boundary, so map from the one
+    // before and skip the difference
+    off_t start = offset - offset % sysconf(_SC_PAGESIZE);
+    file->map_len = len + (offset - start);
+    if ((file->map = mmap(NULL, file->map_len, PROT_READ, MAP_PRIVATE, fd,
+                          start)) == MAP_FAILED) {
+        perror("mmap");
+        file->map = NULL;
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    // We go through it once, front to back, so read well ahead and drop
+    // pages behind us
+    madvise(file->map, file->map_len, MADV_SEQUENTIAL);
+    file->buf = (char *)file->map + (offset - start);
+    file->len = len;
+    return 0;
+}
+
+void unmap_input(mapped_file_t *file) {
+    if (file->map) {
+        munmap(file->map, file->map_len);
+    } else if (!file->mapped) {
+        free(file->buf);
+    }
+}
+
+// Set up output of at most len bytes to path. A regular file (or
+// anything that does not exist yet) gets written as a temporary file
+// next to it, mapped writable, which finish_output() cuts down to
+// however many bytes end up used and renames over path. Until then path
+// is left alone, so it can be the file we are reading from, and output
+// that fails to authenticate never replaces what was there. Nothing is
+// written until then for anything but a regular file either
+int map_output(char *path, size_t len, mapped_file_t *file) {
+    memset(file, 0, sizeof *file);
+    file->path = path;
+    file->len = len;
+
+    // Devices and pipes (e.g., /dev/stdout) cannot be mapped or sized,
+    // and might not open for reading either
+    struct stat st;
+    int exists = stat(path, &st) == 0;
+    file->mapped = !exists || S_ISREG(st.st_mode);
+
+    if (!file->mapped) {
+        if ((file->fd = open(path, O_WRONLY)) < 0) {
+            perror("open");
+            return -1;
+        }
+        if (len && !(file->buf = malloc(len))) {
+            perror("malloc");
+            close(file->fd);
+            return -1;
+        }
+        return 0;
+    }
+
+    // Replace what a symlink points to rather than the link, like
+    // writing through it would
+    char *target = exists? realpath(path, NULL) : NULL;
+    if (!(file->tmp_path = malloc(strlen(target? target : path) + sizeof ".XXXXXX"))) {
+        perror("malloc");
+        free(target);
+        return -1;
+    }
+    strcpy(file->tmp_path, target? target : path);
+    strcat(file->tmp_path, ".XXXXXX");
+    if (target) {
+        file->path = file->target = target;
+    }
+
+    if ((file->fd = mkstemp(file->tmp_path)) < 0) {
+        perror("mkstemp");
+        free(file->tmp_path);
+        free(file->target);
+        return -1;
+    }
+
+    // mkstemp() makes it private, so give it the permissions the file
+    // it replaces had, or that a new one would have gotten
+    mode_t mode;
+    if (exists) {
+        mode = st.st_mode & 07777;
+    } else {
+        mode_t mask = umask(0);
+        umask(mask);
+        mode = 0666 & ~mask;
+    }
+    if (fchmod(file->fd, mode) < 0) {
+        perror("fchmod");
+        discard_output(file);
+        return -1;
+    }
+
+    if (ftruncate(file->fd, len) < 0) {
+        perror("ftruncate");
+        discard_output(file);
+        return -1;
+    }
+    if (!len) {
+        return 0;
+    }
+
+    if ((file->map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd,
+                          0)) == MAP_FAILED) {
+        perror("mmap");
+        file->map = NULL;
+        discard_output(file);
+        return -1;
+    }
+    madvise(file->map, len, MADV_SEQUENTIAL);
+    file->map_len = len;
+    file->buf = file->map;
+    return 0;
+}
+
+// Keep the first len bytes of output (at most what map_output() made
+// room for), close the file, and put it in place
+int finish_output(mapped_file_t *file, size_t len) {
+    int ret = 0;
+
+    if (file->mapped) {
+        // The mapping is shared, so the kernel already has everything
+        // we wrote to it
+        if (file->map) {
+            munmap(file->map, file->map_len);
+        }
+        if (ftruncate(file->fd, len) < 0) {
+            perror("ftruncate");
+            ret = -1;
+        }
+    } else {
+        for (size_t done = 0; done < len && !ret;) {
+            ssize_t n = write(file->fd, file->buf + done, len - done);
+            if (n < 0 && errno != EINTR) {
+                perror("write");
+                ret = -1;
+            } else if (n > 0) {
+                done += n;
+            }
+        }
+        free(file->buf);
+    }
+
+    if (close(file->fd) < 0) {
+        perror("close");
+        ret = -1;
+    }
+
+    if (file->mapped) {
+        if (!ret && rename(file->tmp_path, file->path) < 0) {
+            perror("rename");
+            ret = -1;
+        }
+        if (ret) {
+            unlink(file->tmp_path);
+        }
+        free(file->tmp_path);
+        free(file->target);
+    }
+    return ret;
+}
+
+// Give up on output, e.g. if it failed to authenticate, removing the
+// temporary file map_output() created and leaving path as it was
+void discard_output(mapped_file_t *file) {
+    if (file->map) {
+        munmap(file->map, file->map_len);
+    } else if (!file->mapped) {
+        free(file->buf);
+    }
+    close(file->fd);
+
+    if (file->mapped) {
+        unlink(file->tmp_path);
+        free(file->tmp_path);
+        free(file->target);
+    }
+}
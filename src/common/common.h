@@ -1,6 +1,35 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <stddef.h>
+#include <sys/types.h>
+
+// A file, or a range of one, in memory. Regular files get mapped, so
+// reading and writing them is just touching the page cache. Anything
+// else (e.g., a pipe) gets read into or written out of an ordinary
+// buffer instead, so callers never need to care which they have
+typedef struct {
+    char *buf;
+    size_t len;
+    // Whether this is a regular file, mapped, rather than an ordinary
+    // buffer, and what to unmap (NULL if it was empty)
+    int mapped;
+    void *map;
+    size_t map_len;
+    // Output only: the open file, where it goes, and (if mapped) the
+    // temporary file it is until then and the path a symlink led to
+    int fd;
+    char *path;
+    char *tmp_path;
+    char *target;
+} mapped_file_t;
+
 extern int read_to_buf(char *, char **, int *);
+extern int read_range_to_buf(char *, off_t, int, char **, int *);
+extern int map_input(char *, off_t, off_t, mapped_file_t *);
+extern void unmap_input(mapped_file_t *);
+extern int map_output(char *, size_t, mapped_file_t *);
+extern int finish_output(mapped_file_t *, size_t);
+extern void discard_output(mapped_file_t *);
 
 #endif
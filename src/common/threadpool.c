@@ -0,0 +1,349 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "threadpool.h"
+
+// Ranges only get pushed by halving another one, so a deque never holds
+// more than about one per bit of an int. Past this, we stop splitting
+#define DEQUE_CAP 64
+
+typedef struct {
+    int first;
+    int count;
+} range_t;
+
+// A ring of ranges. The owner pushes and pops at the bottom, which has
+// the smallest ranges, nearest to what it just finished. Thieves take
+// from the top, which has the biggest
+typedef struct {
+    pthread_mutex_t lock;
+    range_t ranges[DEQUE_CAP];
+    int top;
+    int count;
+} deque_t;
+
+typedef struct {
+    threadpool_t *pool;
+    int id;
+    pthread_t thread;
+} worker_t;
+
+struct threadpool {
+    // Including the thread that calls threadpool_parallel_for(), which
+    // pitches in as thread 0, so there are nthreads - 1 workers
+    int nthreads;
+    worker_t *workers;
+    deque_t *deques;
+
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    // Bumped by every loop, so that workers can tell one from a
+    // spurious wakeup
+    unsigned long generation;
+    int shutdown;
+    // Iterations of the current loop that have not finished yet
+    int remaining;
+    // Bumped whenever a range gets split, so that threads with nothing
+    // to do can sleep on changed until there might be something to
+    // steal or the loop is done
+    unsigned long splits;
+    pthread_cond_t changed;
+
+    // The current loop. Set before any of its ranges are pushed, and
+    // only read after taking one out of a deque, so the deque locks
+    // order them
+    threadpool_fn_t *fn;
+    void *arg;
+    int grain;
+};
+
+static void *worker_main(void *);
+static void run_ranges(threadpool_t *, int);
+static unsigned long splits_so_far(threadpool_t *);
+static int wait_for_change(threadpool_t *, unsigned long);
+static void announce_split(threadpool_t *);
+static int push_bottom(deque_t *, range_t);
+static int pop_bottom(deque_t *, range_t *);
+static int steal(threadpool_t *, int, range_t *);
+
+// Start a pool of nthreads threads (counting the caller), or one per
+// CPU if nthreads is 0. With pin, worker n only runs on CPU n, leaving
+// CPU 0 to the caller, whose own affinity we do not touch. Returns NULL
+// if we are out of memory. If we cannot start some of the threads, the
+// pool is just smaller
+threadpool_t *threadpool_create(int nthreads, int pin) {
+    long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpus < 1) {
+        ncpus = 1;
+    }
+    if (nthreads <= 0) {
+        nthreads = ncpus;
+    }
+
+    threadpool_t *pool;
+    if (!(pool = calloc(1, sizeof *pool))) {
+        return NULL;
+    }
+    if (!(pool->workers = calloc(nthreads, sizeof *pool->workers))
+            || !(pool->deques = calloc(nthreads, sizeof *pool->deques))) {
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->changed, NULL);
+    pthread_mutex_init(&pool->deques[0].lock, NULL);
+
+    pool->nthreads = 1;
+    for (int t = 1; t < nthreads; t++) {
+        worker_t *worker = &pool->workers[t];
+        worker->pool = pool;
+        worker->id = t;
+
+        pthread_mutex_init(&pool->deques[t].lock, NULL);
+        if (pthread_create(&worker->thread, NULL, worker_main, worker)) {
+            pthread_mutex_destroy(&pool->deques[t].lock);
+            break;
+        }
+        pool->nthreads++;
+
+        if (pin) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(t % ncpus, &cpus);
+            // Only a hint, so carry on if it fails
+            pthread_setaffinity_np(worker->thread, sizeof cpus, &cpus);
+        }
+    }
+
+    return pool;
+}
+
+void threadpool_destroy(threadpool_t *pool) {
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int t = 1; t < pool->nthreads; t++) {
+        pthread_join(pool->workers[t].thread, NULL);
+    }
+
+    for (int t = 0; t < pool->nthreads; t++) {
+        pthread_mutex_destroy(&pool->deques[t].lock);
+    }
+    pthread_cond_destroy(&pool->changed);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->deques);
+    free(pool->workers);
+    free(pool);
+}
+
+// Number of threads, counting the caller of threadpool_parallel_for()
+int threadpool_size(const threadpool_t *pool) {
+    return pool? pool->nthreads : 1;
+}
+
+// Call fn on ranges covering iterations [0, n) and return once they are
+// all done. Ranges are at most grain iterations long, and all of them
+// start at a multiple of grain, so grain can line ranges up with
+// whatever the caller batches up (e.g. CHUNK_BLOCKS). A NULL pool runs
+// the whole loop on the calling thread. Only one thread at a time
+// should run loops on a pool
+void threadpool_parallel_for(threadpool_t *pool, int n, int grain,
+                             threadpool_fn_t *fn, void *arg) {
+    if (n <= 0) {
+        return;
+    }
+    if (!pool) {
+        fn(arg, 0, n);
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->grain = grain;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->remaining = n;
+    pthread_mutex_unlock(&pool->lock);
+
+    // Deal out contiguous shares of whole grains, one per thread, the
+    // way a static schedule would. Stealing takes care of the rest
+    int ngrains = n / grain + (n % grain != 0);
+    int first = 0;
+    for (int t = 0; t < pool->nthreads && first < n; t++) {
+        int share = ngrains / pool->nthreads + (t < ngrains % pool->nthreads);
+        range_t range = {first, share * grain < n - first? share * grain : n - first};
+        if (range.count > 0) {
+            push_bottom(&pool->deques[t], range);
+            first += range.count;
+        }
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    run_ranges(pool, 0);
+}
+
+static void *worker_main(void *arg) {
+    worker_t *worker = arg;
+    threadpool_t *pool = worker->pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+
+        pthread_mutex_unlock(&pool->lock);
+        run_ranges(pool, worker->id);
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+// Work on the current loop until every iteration is done, not just the
+// ones we can find, since someone might still split a range we can steal
+static void run_ranges(threadpool_t *pool, int id) {
+    deque_t *own = &pool->deques[id];
+
+    for (;;) {
+        // Read this before looking, so that a split we miss wakes us up
+        unsigned long splits = splits_so_far(pool);
+
+        range_t range;
+        if (!pop_bottom(own, &range) && !steal(pool, id, &range)) {
+            if (!wait_for_change(pool, splits)) {
+                return;
+            }
+            continue;
+        }
+
+        // Halve the range until only one grain is left, pushing the
+        // upper halves for later (or for thieves)
+        int grain = pool->grain;
+        while (range.count > grain) {
+            int ngrains = range.count / grain + (range.count % grain != 0);
+            int keep = ngrains / 2 * grain;
+            range_t rest = {range.first + keep, range.count - keep};
+            if (!push_bottom(own, rest)) {
+                break;
+            }
+            announce_split(pool);
+            range.count = keep;
+        }
+
+        pool->fn(pool->arg, range.first, range.count);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->remaining -= range.count;
+        if (!pool->remaining) {
+            pthread_cond_broadcast(&pool->changed);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static unsigned long splits_so_far(threadpool_t *pool) {
+    pthread_mutex_lock(&pool->lock);
+    unsigned long splits = pool->splits;
+    pthread_mutex_unlock(&pool->lock);
+
+    return splits;
+}
+
+// Wake up anyone waiting for something to steal
+static void announce_split(threadpool_t *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->splits++;
+    pthread_cond_broadcast(&pool->changed);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Sleep until a range gets split after the first splits splits, or the
+// loop finishes. Returns 0 once the loop is done
+static int wait_for_change(threadpool_t *pool, unsigned long splits) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->remaining && pool->splits == splits) {
+        pthread_cond_wait(&pool->changed, &pool->lock);
+    }
+    int remaining = pool->remaining;
+    pthread_mutex_unlock(&pool->lock);
+
+    return remaining;
+}
+
+// Returns 0 if the deque is full
+static int push_bottom(deque_t *deque, range_t range) {
+    int pushed = 0;
+
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count < DEQUE_CAP) {
+        deque->ranges[(deque->top + deque->count) % DEQUE_CAP] = range;
+        deque->count++;
+        pushed = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+
+    return pushed;
+}
+
+// Returns 0 if the deque is empty
+static int pop_bottom(deque_t *deque, range_t *range) {
+    int popped = 0;
+
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count) {
+        deque->count--;
+        *range = deque->ranges[(deque->top + deque->count) % DEQUE_CAP];
+        popped = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+
+    return popped;
+}
+
+// Take the top range of the first other deque that has one, starting
+// after our own so that thieves spread out. Returns 0 if all are empty
+static int steal(threadpool_t *pool, int id, range_t *range) {
+    for (int i = 1; i < pool->nthreads; i++) {
+        deque_t *victim = &pool->deques[(id + i) % pool->nthreads];
+        int stolen = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->count) {
+            *range = victim->ranges[victim->top];
+            victim->top = (victim->top + 1) % DEQUE_CAP;
+            victim->count--;
+            stolen = 1;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (stolen) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
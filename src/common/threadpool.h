@@ -0,0 +1,19 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+// A fixed set of threads for splitting loops over blocks, files, or
+// anything else we can count across cores. Every thread has a deque of
+// ranges of the loop that it works through from the bottom, and a
+// thread that runs out steals from the top of someone else's, so
+// uneven work still evens out
+typedef struct threadpool threadpool_t;
+
+// Runs iterations [first, first + count) of the loop
+typedef void threadpool_fn_t(void *arg, int first, int count);
+
+extern threadpool_t *threadpool_create(int, int);
+extern void threadpool_destroy(threadpool_t *);
+extern int threadpool_size(const threadpool_t *);
+extern void threadpool_parallel_for(threadpool_t *, int, int, threadpool_fn_t *, void *);
+
+#endif
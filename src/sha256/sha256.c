@@ -1,10 +1,16 @@
 #include <stdint.h>
+#include <string.h>
 #include "sha256.h"
 
+// 1 GiB, well short of where 64-byte offsets overflow 32 bits
+#define UNPADDED_PIECE_BLOCKS (1u << 24)
+
 static const uint32_t K[64];
 static const uint32_t Hzero[8];
-static void pad_message(uint8_t *, uint32_t);
-static void sha256_hash(uint8_t *, uint32_t, uint8_t *);
+static void pad_message(uint8_t *, uint64_t);
+static void sha256_hash(const uint8_t *, uint32_t, uint8_t *);
+static void sha256_blocks(uint32_t *, const uint8_t *, uint32_t);
+static void store_digest(const uint32_t *, uint8_t *);
 static uint32_t rotr(int, uint32_t);
 static uint32_t ch(uint32_t, uint32_t, uint32_t);
 static uint32_t maj(uint32_t, uint32_t, uint32_t);
@@ -14,31 +20,60 @@ static uint32_t sigma0(uint32_t);
 static uint32_t sigma1(uint32_t);
 
 void sha256(uint8_t *buf, uint32_t n_bytes, uint8_t *digest_out) {
-    pad_message(buf, n_bytes);
+    pad_message(buf + n_bytes, n_bytes);
     uint32_t N = PADDED_SIZE_BYTES(n_bytes) / 64;
     sha256_hash(buf, N, digest_out);
 }
 
-static void pad_message(uint8_t *buf, uint32_t n_bytes) {
+// Like sha256(), but without room for the padding after the message,
+// which might even be read only (e.g., a mapped file). Whole blocks get
+// hashed where they are, and only the last one or two, with the
+// padding, get copied. Unlike sha256(), it takes files of 4 GiB and up
+void sha256_unpadded(const uint8_t *buf, uint64_t n_bytes, uint8_t *digest_out) {
+    uint32_t H[8];
+    memcpy(H, Hzero, sizeof H);
+
+    // sha256_blocks() counts blocks and bytes in 32 bits, so give it a
+    // GiB at a time
+    uint64_t N = n_bytes / 64;
+    for (uint64_t done = 0; done < N;) {
+        uint32_t n = N - done < UNPADDED_PIECE_BLOCKS? N - done : UNPADDED_PIECE_BLOCKS;
+        sha256_blocks(H, buf + 64 * done, n);
+        done += n;
+    }
+
+    uint32_t rem = n_bytes % 64;
+    uint8_t last[128];
+    if (rem) {
+        memcpy(last, buf + 64 * N, rem);
+    }
+    pad_message(last + rem, n_bytes);
+    sha256_blocks(H, last, PADDED_SIZE_BYTES(rem) / 64);
+
+    store_digest(H, digest_out);
+}
+
+// Write the padding for a message of n_bytes starting at end, right
+// after the message
+static void pad_message(uint8_t *end, uint64_t n_bytes) {
     // Obligatory first padding byte (with highest-order bit set)
-    *(buf + n_bytes) = 0x80;
+    *end = 0x80;
 
     uint32_t zero_bytes = PADDING_BYTES(n_bytes);
     for (uint32_t i = 0; i < zero_bytes; i++) {
-        *(buf + n_bytes + 1 + i) = 0x00;
+        *(end + 1 + i) = 0x00;
     }
 
     // CRITICAL: this is bits, not bytes!
     // We need to multiply n_bytes by 8 to get the number of bits. So we
     // effectively need to do n_bytes << 3. But also, this is a 64-bit
     // field in memory. So break this field into two 32-bit words. To
-    // achieve this << 3, use the three highest-order bits of n_bytes as
-    // the three lowest-order bits in the high 32-bit word, and then use
-    // the 29 lowest-order bits of n_bytes as the 29 highest-order bits
-    // of the lower 32-bit word
+    // achieve this << 3, use everything above the 29 lowest-order bits
+    // of n_bytes as the high 32-bit word, and then use those 29 bits as
+    // the 29 highest-order bits of the lower 32-bit word
     uint32_t n_bits_hi = n_bytes >> 29;
-    uint32_t n_bits_lo = n_bytes << 3;
-    uint8_t *l = buf + n_bytes + 1 + zero_bytes;
+    uint32_t n_bits_lo = (uint32_t)n_bytes << 3;
+    uint8_t *l = end + 1 + zero_bytes;
     // Need to store this as big endian
     l[0] = (n_bits_hi >> 24) & 0xff;
     l[1] = (n_bits_hi >> 16) & 0xff;
@@ -50,17 +85,23 @@ static void pad_message(uint8_t *buf, uint32_t n_bytes) {
     l[7] = n_bits_lo & 0xff;
 }
 
-static inline uint32_t ijth_M(uint8_t *M, uint32_t i, int j) {
-    uint8_t *msg = M + 64*(i-1) + 4*j;
+static inline uint32_t ijth_M(const uint8_t *M, uint32_t i, int j) {
+    const uint8_t *msg = M + 64*(i-1) + 4*j;
     return (msg[0] << 24) | (msg[1] << 16) | (msg[2] << 8) | msg[3];
 }
 
-static void sha256_hash(uint8_t *M, uint32_t N, uint8_t *digest_out) {
+static void sha256_hash(const uint8_t *M, uint32_t N, uint8_t *digest_out) {
     uint32_t H[8];
     for (int i = 0; i < 8; i++) {
         H[i] = Hzero[i];
     }
 
+    sha256_blocks(H, M, N);
+    store_digest(H, digest_out);
+}
+
+// Fold N 64-byte blocks of M into the hash state H
+static void sha256_blocks(uint32_t *H, const uint8_t *M, uint32_t N) {
     for (uint32_t i = 1; i <= N; i++) {
         uint32_t W[64];
         for (int t = 0; t < 64; t++) {
@@ -103,7 +144,9 @@ static void sha256_hash(uint8_t *M, uint32_t N, uint8_t *digest_out) {
         H[6] += g;
         H[7] += h;
     }
+}
 
+static void store_digest(const uint32_t *H, uint8_t *digest_out) {
     for (int i = 0; i < 8; i++) {
         uint8_t *here = digest_out + 4 * i;
         // Big endian
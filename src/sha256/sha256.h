@@ -48,5 +48,6 @@
 #define DIGEST_BYTES 32
 
 extern void sha256(uint8_t *, uint32_t, uint8_t *);
+extern void sha256_unpadded(const uint8_t *, uint64_t, uint8_t *);
 
 #endif
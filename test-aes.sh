@@ -1,7 +1,7 @@
 #!/bin/bash
 
-[[ $# -ne 2 ]] && {
-    printf 'usage: %s cbc|ecb|ctr <test>\n' "$0" >&2
+[[ $# -ne 2 && $# -ne 3 ]] && {
+    printf 'usage: %s cbc|ecb|ctr|gcm|xts|cmac|chunked <test> [<threads>]\n' "$0" >&2
     printf '\n' >&2
     printf 'try %s skittles.png\n' "$0" >&2
     exit 1
@@ -9,21 +9,137 @@
 
 mode=$1
 test=$2
+threads=${3:-1}
 
 [[ ! -f tests/$test || ! -f tests/$test.key ]] && {
     printf 'could not locate test %s in tests/\n' "$test" >&2
     exit 1
 }
 
-printf 'testing %s with %s...\n' "$test" "$mode"
+printf 'testing %s with %s (%d threads)...\n' "$test" "$mode" "$threads"
 
 pushd tests >/dev/null
     key=$(hexdump -e '16/1 "%02x"' "$test.key")
     iv=$(hexdump -e '16/1 "%02x"' "$test.iv")
-    openssl aes-256-$mode -in "$test" -out "$test.enc-$mode.want" -K "$key" -iv "$iv"
-    ../aes256 enc-$mode "$test.iv" "$test" "$test.key" "$test.enc-$mode.got"
+    ivfile=$test.iv
+    keyfile=$test.key
 
-    if cmp "$test.enc-$mode."{got,want}; then
+    # A MAC has nothing to decrypt, so it only needs to match openssl
+    if [[ $mode = cmac ]]; then
+        openssl mac -binary -cipher AES-256-CBC -macopt "hexkey:$key" -in "$test" \
+            -out "$test.$mode.want" CMAC
+        ../aes256 cmac "$ivfile" "$test" "$keyfile" "$test.$mode.got"
+
+        if cmp "$test.$mode."{got,want}; then
+            printf '✅ MAC passed\n'
+        else
+            printf '🙏 MAC failed, start praying son\n'
+            printf 'expected:\n'
+            xxd "$test.$mode.want"
+            printf 'actual:\n'
+            xxd "$test.$mode.got"
+        fi
+        popd >/dev/null
+        exit
+    fi
+
+    # openssl knows nothing of our containers, so check that they
+    # decrypt back to the file, both whole and a chunk at a time, and
+    # that tampering gets caught
+    if [[ $mode = chunked ]]; then
+        chunk=4096
+        size=$(stat -c %s "$test")
+        ../aes256 -j "$threads" --chunk-size $chunk enc-$mode "$ivfile" "$test" "$keyfile" \
+            "$test.$mode.got"
+        ../aes256 -j "$threads" dec-$mode "$ivfile" "$test.$mode.got" "$keyfile" \
+            "$test.dec-$mode"
+
+        if cmp "$test"{,.dec-$mode}; then
+            printf '✅ decryption passed\n'
+        else
+            printf '🙏 decryption failed, start praying son\n'
+        fi
+
+        : >"$test.$mode.each"
+        for ((c = 0; c == 0 || c * chunk < size; c++)); do
+            ../aes256 --chunk $c dec-$mode "$ivfile" "$test.$mode.got" "$keyfile" \
+                "$test.$mode.chunk"
+            cat "$test.$mode.chunk" >>"$test.$mode.each"
+        done
+
+        if cmp "$test"{,.$mode.each}; then
+            printf '✅ chunk extraction passed\n'
+        else
+            printf '🙏 chunk extraction failed, start praying son\n'
+        fi
+
+        # Flip a bit of the last tag in the index, right before the
+        # 16-byte footer
+        cp "$test.$mode.got" "$test.$mode.forged"
+        at=$(($(stat -c %s "$test.$mode.forged") - 17))
+        byte=$(dd if="$test.$mode.forged" bs=1 skip=$at count=1 2>/dev/null | xxd -p)
+        printf "\\x$(printf '%02x' $((0x$byte ^ 1)))" \
+            | dd of="$test.$mode.forged" bs=1 conv=notrunc seek=$at 2>/dev/null
+
+        if ../aes256 -j "$threads" dec-$mode "$ivfile" "$test.$mode.forged" "$keyfile" \
+               "$test.dec-$mode.forged" 2>/dev/null; then
+            printf '🙏 tampered container accepted, tamper check failed\n'
+        else
+            printf '✅ tampered container rejected\n'
+        fi
+        popd >/dev/null
+        exit
+    fi
+
+    # What to compare against openssl
+    ciphertext=$test.enc-$mode.got
+    if [[ $mode = gcm ]]; then
+        # openssl enc cannot do AEAD ciphers, but with a 96-bit IV the
+        # GCM ciphertext is CTR starting from the IV followed by the
+        # counter 2, so check that much against openssl and the tag by
+        # decrypting. Our .iv files are 128 bits, so use the first 96
+        head -c 12 "$test.iv" >"$test.iv12"
+        ivfile=$test.iv12
+        openssl aes-256-ctr -in "$test" -out "$test.enc-$mode.want" -K "$key" -iv "${iv:0:24}00000002"
+        ../aes256 -j "$threads" enc-$mode "$ivfile" "$test" "$test.key" "$test.enc-$mode.got"
+        ciphertext=$test.enc-$mode.got-notag
+        head -c -16 "$test.enc-$mode.got" >"$ciphertext"
+    elif [[ $mode = xts ]]; then
+        # openssl enc cannot do XTS either, so check that the whole file
+        # comes out the same as encrypting each sector on its own with
+        # --first-sector, which is what lets us rewrite one sector at a
+        # time. XTS keys are 512 bits, so pad ours out with the IV
+        sector=1024
+        size=$(stat -c %s "$test")
+        keyfile=$test.key512
+        cat "$test.key" "$test.iv" "$test.iv" >"$keyfile"
+
+        if ((size % sector && size % sector < 16)); then
+            if ../aes256 -j "$threads" --sector-size $sector enc-$mode "$ivfile" "$test" \
+                   "$keyfile" "$test.enc-$mode.got" 2>/dev/null; then
+                printf '🙏 short last sector accepted, encryption failed\n'
+            else
+                printf '✅ short last sector rejected\n'
+            fi
+            popd >/dev/null
+            exit
+        fi
+
+        : >"$test.enc-$mode.want"
+        for ((s = 0; s * sector < size; s++)); do
+            dd if="$test" of="$test.sector" bs=$sector skip=$s count=1 2>/dev/null
+            ../aes256 --sector-size $sector --first-sector $s enc-$mode "$ivfile" \
+                "$test.sector" "$keyfile" "$test.sector.enc"
+            cat "$test.sector.enc" >>"$test.enc-$mode.want"
+        done
+        ../aes256 -j "$threads" --sector-size $sector enc-$mode "$ivfile" "$test" \
+            "$keyfile" "$test.enc-$mode.got"
+    else
+        openssl aes-256-$mode -in "$test" -out "$test.enc-$mode.want" -K "$key" -iv "$iv"
+        ../aes256 -j "$threads" enc-$mode "$ivfile" "$test" "$test.key" "$test.enc-$mode.got"
+    fi
+
+    if cmp "$ciphertext" "$test.enc-$mode.want"; then
         printf '✅ encryption passed\n'
     else
         printf '🙏 encryption failed, start praying son\n'
@@ -33,7 +149,8 @@ pushd tests >/dev/null
         xxd "$test.enc-$mode.got" | head
     fi
 
-    ../aes256 dec-$mode "$test.iv" "$test.enc-$mode.got" "$test.key" "$test.dec-$mode"
+    ../aes256 -j "$threads" ${sector:+--sector-size $sector} dec-$mode "$ivfile" \
+        "$test.enc-$mode.got" "$keyfile" "$test.dec-$mode"
 
     if cmp "$test"{,.dec-$mode}; then
         printf '✅ decryption passed\n'
@@ -44,4 +161,47 @@ pushd tests >/dev/null
         printf 'actual:\n'
         xxd "$test.dec-$mode" | head
     fi
+
+    if [[ $mode = ctr ]]; then
+        # Decrypt a window that starts and ends in the middle of a block
+        # straight out of the ciphertext, without the rest of the file
+        offset=37 length=1000
+        tail -c +$((offset + 1)) "$test" | head -c $length >"$test.range.want"
+        ../aes256 --offset $offset --length $length dec-$mode "$ivfile" \
+            "$test.enc-$mode.got" "$keyfile" "$test.range.got"
+
+        if cmp "$test.range."{got,want}; then
+            printf '✅ range decryption passed\n'
+        else
+            printf '🙏 range decryption failed, start praying son\n'
+            printf 'expected:\n'
+            xxd "$test.range.want" | head
+            printf 'actual:\n'
+            xxd "$test.range.got" | head
+        fi
+    fi
+
+    if [[ $mode = gcm ]]; then
+        # Flip the last bit of the tag, which decryption has to refuse,
+        cp "$test.enc-$mode.got" "$test.enc-$mode.forged"
+        last=$(tail -c 1 "$test.enc-$mode.got" | xxd -p)
+        printf "\\x$(printf '%02x' $((0x$last ^ 1)))" \
+            | dd of="$test.enc-$mode.forged" bs=1 conv=notrunc \
+                 seek=$(($(stat -c %s "$test.enc-$mode.forged") - 1)) 2>/dev/null
+
+        # and without touching whatever was already at the output path
+        printf 'keep me\n' >"$test.dec-$mode.forged"
+        if ../aes256 -j "$threads" dec-$mode "$ivfile" "$test.enc-$mode.forged" "$test.key" \
+               "$test.dec-$mode.forged" 2>/dev/null; then
+            printf '🙏 forged tag accepted, forgery check failed\n'
+        else
+            printf '✅ forged tag rejected\n'
+        fi
+
+        if [[ $(cat "$test.dec-$mode.forged") = 'keep me' ]]; then
+            printf '✅ existing output kept\n'
+        else
+            printf '🙏 existing output clobbered, failed\n'
+        fi
+    fi
 popd >/dev/null
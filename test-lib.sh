@@ -0,0 +1,21 @@
+#!/bin/bash
+
+[[ $# -ne 1 && $# -ne 2 ]] && {
+    printf 'usage: %s <selftest> [<threads>]\n' "$0" >&2
+    printf '\n' >&2
+    printf 'try %s batch\n' "$0" >&2
+    exit 1
+}
+
+test=$1
+threads=${2:-1}
+
+printf 'testing %s (%d threads)...\n' "$test" "$threads"
+
+# The checks themselves live in src/aes256/selftest.c and print their
+# own results, so this only has to catch one dying partway through
+./aes256 -j "$threads" selftest "$test" 2>&1
+status=$?
+if ((status > 1)); then
+    printf '🙏 %s exited with status %d, failed\n' "$test" "$status"
+fi
@@ -0,0 +1,53 @@
+#!/bin/bash
+
+[[ $# -gt 1 ]] && {
+    printf 'usage: %s [<threads>]\n' "$0" >&2
+    exit 1
+}
+
+threads=${1:-1}
+
+printf 'testing rand (%d threads)...\n' "$threads"
+
+# Output with a fixed seed gets checked against known answers in
+# src/aes256/selftest.c
+./aes256 selftest drbg 2>&1
+
+# Output from /dev/urandom has nothing to check against, so make sure
+# we get the right amount of it, that no two keys come out the same,
+# and that gzip cannot find any patterns in a MiB of it. It goes in a
+# directory of its own, since all-tests.sh runs every key in tests/
+aes256=$PWD/aes256
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+pushd "$tmp" >/dev/null
+    "$aes256" -j "$threads" rand 32 rand.{1,2,3}.key
+    "$aes256" -j "$threads" rand 16 rand.{1,2,3}.iv
+    "$aes256" -j "$threads" rand 1048576 rand.big
+
+    sizes=$(stat -c %s rand.{1,2,3}.key rand.{1,2,3}.iv rand.big | tr '\n' ' ')
+    if [[ $sizes = '32 32 32 16 16 16 1048576 ' ]]; then
+        printf '✅ sizes passed\n'
+    else
+        printf '🙏 sizes failed, start praying son\n'
+        printf 'actual: %s\n' "$sizes"
+    fi
+
+    if ! cmp -s rand.{1,2}.key && ! cmp -s rand.{2,3}.key && ! cmp -s rand.{1,3}.key \
+            && ! cmp -s rand.{1,2}.iv && ! cmp -s rand.{2,3}.iv && ! cmp -s rand.{1,3}.iv; then
+        printf '✅ distinct keys passed\n'
+    else
+        printf '🙏 repeated key, distinct keys failed\n'
+        xxd rand.1.key
+        xxd rand.2.key
+        xxd rand.3.key
+    fi
+
+    compressed=$(gzip -c rand.big | wc -c)
+    if ((compressed >= 1048576)); then
+        printf '✅ incompressible passed\n'
+    else
+        printf '🙏 gzip got %d bytes down to %d, incompressible failed\n' 1048576 "$compressed"
+    fi
+popd >/dev/null